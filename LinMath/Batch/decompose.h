@@ -0,0 +1,128 @@
+#ifndef DECOMPOSE_H
+#define DECOMPOSE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "vec3Batch.h"
+#include "mat3Batch.h"
+#include "mat4Batch.h"
+#include "../Parallel/threadpool.h"
+#include "../Simd/decompose.h"
+#include "../Simd/svd.h"
+
+namespace linmath {
+
+    namespace simd {
+
+        // Decompositions split over a thread pool at whole blocks of lanes matricies, small batches stay on the calling thread
+        constexpr size_t decomposeGrain = 4096;
+
+        template <typename T, typename F>
+        void decompose(size_t n, size_t lanes, ThreadPool& pool, F f) {
+            pool.parallelRange((n + lanes - 1) / lanes, decomposeGrain / lanes, [&](size_t begin, size_t end) {
+                f(begin*lanes, end*lanes < n ? end*lanes : n);
+            });
+        }
+    }
+
+    // Cholesky factors of many symmetric positive definite 3x3 and 4x4 matricies, such as per cluster covariances,
+    // l[i] is a[i].cholesky() and failed[i] is 1 where it is not positive, failed must hold at least a.size() flags
+    // l may be a and is resized to it
+    template <typename T>
+    void cholesky(const Mat3Batch<T>& a, Mat3Batch<T>& l, std::span<uint8_t> failed) {
+        l.resize(a.size());
+        simd::cholesky<T, 3>(0, a.size(), Mat3Batch<T>::lanes, a.data(), l.data(), failed.data());
+    }
+    template <typename T>
+    void cholesky(const Mat3Batch<T>& a, Mat3Batch<T>& l, std::span<uint8_t> failed, ThreadPool& pool) {
+        l.resize(a.size());
+        simd::decompose<T>(a.size(), Mat3Batch<T>::lanes, pool, [&](size_t begin, size_t end) {
+            simd::cholesky<T, 3>(begin, end, Mat3Batch<T>::lanes, a.data(), l.data(), failed.data());
+        });
+    }
+    template <typename T>
+    void cholesky(const Mat4Batch<T>& a, Mat4Batch<T>& l, std::span<uint8_t> failed) {
+        l.resize(a.size());
+        simd::cholesky<T, 4>(0, a.size(), Mat4Batch<T>::lanes, a.data(), l.data(), failed.data());
+    }
+    template <typename T>
+    void cholesky(const Mat4Batch<T>& a, Mat4Batch<T>& l, std::span<uint8_t> failed, ThreadPool& pool) {
+        l.resize(a.size());
+        simd::decompose<T>(a.size(), Mat4Batch<T>::lanes, pool, [&](size_t begin, size_t end) {
+            simd::cholesky<T, 4>(begin, end, Mat4Batch<T>::lanes, a.data(), l.data(), failed.data());
+        });
+    }
+
+    // Eigen decompositions of many symmetric 3x3 matricies, such as per cluster covariances or inertia tensors
+    // values[i] holds the ascending eigenvalues of a[i] and row r of vectors[i] the unit eigenvector of value r,
+    // as in a[i].eigen(), only the lower triangles are read and values and vectors are resized to a
+    template <typename T>
+    void eigen(const Mat3Batch<T>& a, Vec3Batch<T>& values, Mat3Batch<T>& vectors) {
+        values.resize(a.size());
+        vectors.resize(a.size());
+        simd::eigen3<T>(0, a.size(), Mat3Batch<T>::lanes, a.data(), vectors.data(), values.x(), values.stride());
+    }
+    template <typename T>
+    void eigen(const Mat3Batch<T>& a, Vec3Batch<T>& values, Mat3Batch<T>& vectors, ThreadPool& pool) {
+        values.resize(a.size());
+        vectors.resize(a.size());
+        simd::decompose<T>(a.size(), Mat3Batch<T>::lanes, pool, [&](size_t begin, size_t end) {
+            simd::eigen3<T>(begin, end, Mat3Batch<T>::lanes, a.data(), vectors.data(), values.x(), values.stride());
+        });
+    }
+
+    // Singular value decompositions of many 3x3 matricies, a[i] = u[i]*diag(sigma[i])*v[i]^T as in a[i].svd()
+    // u, sigma and v are resized to a
+    template <typename T>
+    void svd(const Mat3Batch<T>& a, Mat3Batch<T>& u, Vec3Batch<T>& sigma, Mat3Batch<T>& v) {
+        u.resize(a.size());
+        sigma.resize(a.size());
+        v.resize(a.size());
+        simd::svd3<T, 3>(0, a.size(), Mat3Batch<T>::lanes, a.data(), u.data(), sigma.x(), sigma.stride(), v.data());
+    }
+    template <typename T>
+    void svd(const Mat3Batch<T>& a, Mat3Batch<T>& u, Vec3Batch<T>& sigma, Mat3Batch<T>& v, ThreadPool& pool) {
+        u.resize(a.size());
+        sigma.resize(a.size());
+        v.resize(a.size());
+        simd::decompose<T>(a.size(), Mat3Batch<T>::lanes, pool, [&](size_t begin, size_t end) {
+            simd::svd3<T, 3>(begin, end, Mat3Batch<T>::lanes, a.data(), u.data(), sigma.x(), sigma.stride(), v.data());
+        });
+    }
+
+    // Polar decompositions of many 3x3 matricies, a[i] = rotation[i]*stretch[i] as in a[i].polar()
+    // rotation may be a and the outputs are resized to it
+    template <typename T>
+    void polar(const Mat3Batch<T>& a, Mat3Batch<T>& rotation, Mat3Batch<T>& stretch) {
+        rotation.resize(a.size());
+        stretch.resize(a.size());
+        simd::polar3<T, 3>(0, a.size(), Mat3Batch<T>::lanes, a.data(), rotation.data(), stretch.data());
+    }
+    template <typename T>
+    void polar(const Mat3Batch<T>& a, Mat3Batch<T>& rotation, Mat3Batch<T>& stretch, ThreadPool& pool) {
+        rotation.resize(a.size());
+        stretch.resize(a.size());
+        simd::decompose<T>(a.size(), Mat3Batch<T>::lanes, pool, [&](size_t begin, size_t end) {
+            simd::polar3<T, 3>(begin, end, Mat3Batch<T>::lanes, a.data(), rotation.data(), stretch.data());
+        });
+    }
+
+    // Rotations of many transforms, the rotation of the polar decomposition of the top left 3x3 as in a[i].polar()
+    // so scale and shear are removed, rotation is resized to a
+    template <typename T>
+    void polar(const Mat4Batch<T>& a, Mat3Batch<T>& rotation) {
+        rotation.resize(a.size());
+        simd::polar3<T, 4>(0, a.size(), Mat4Batch<T>::lanes, a.data(), rotation.data(), nullptr);
+    }
+    template <typename T>
+    void polar(const Mat4Batch<T>& a, Mat3Batch<T>& rotation, ThreadPool& pool) {
+        rotation.resize(a.size());
+        simd::decompose<T>(a.size(), Mat4Batch<T>::lanes, pool, [&](size_t begin, size_t end) {
+            simd::polar3<T, 4>(begin, end, Mat4Batch<T>::lanes, a.data(), rotation.data(), nullptr);
+        });
+    }
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef MAGNITUDE_H
+#define MAGNITUDE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "vec3Batch.h"
+#include "vec4Batch.h"
+
+namespace linmath {
+
+    namespace detail {
+
+        // Type of the squared length of a vector
+        template <typename V>
+        using Magnitude = std::remove_cvref_t<decltype(std::declval<const V&>().lengthSquared())>;
+
+        // Unsigned key ordered like a non-negative magnitude, the bits of a positive float compare like its value
+        template <typename T>
+        auto radixKey(T t) {
+            if constexpr (std::is_same_v<T, float>)
+                return std::bit_cast<uint32_t>(t);
+            else if constexpr (std::is_same_v<T, double>)
+                return std::bit_cast<uint64_t>(t);
+            else {
+                static_assert(std::is_integral_v<T>, "magnitudes must be float, double or integral");
+                return std::make_unsigned_t<T>(t);
+            }
+        }
+
+        // Indices of magnitudes in increasing order, a stable LSD radix sort over the key bytes
+        // Bytes that are the same in every key, as the exponents of similar magnitudes often are, skip their pass
+        template <typename T>
+        std::vector<size_t> radixOrder(const std::vector<T>& magnitudes) {
+            using Key = decltype(radixKey(T()));
+            constexpr size_t passes = sizeof(Key);
+            size_t n = magnitudes.size();
+
+            std::vector<size_t> order(n);
+            if (n == 0)
+                return order;
+            std::vector<size_t> orderTmp(n);
+            std::vector<Key> keys(n);
+            std::vector<Key> keysTmp(n);
+
+            size_t counts[passes][256] = {};
+            for (size_t i=0; i<n; i++) {
+                keys[i] = radixKey(magnitudes[i]);
+                order[i] = i;
+                for (size_t p=0; p<passes; p++)
+                    counts[p][(keys[i] >> 8*p) & 0xFF]++;
+            }
+
+            for (size_t p=0; p<passes; p++) {
+                size_t* count = counts[p];
+                if (count[(keys[0] >> 8*p) & 0xFF] == n)
+                    continue;
+
+                size_t offset = 0;
+                for (size_t b=0; b<256; b++) {
+                    size_t c = count[b];
+                    count[b] = offset;
+                    offset += c;
+                }
+                for (size_t i=0; i<n; i++) {
+                    size_t j = count[(keys[i] >> 8*p) & 0xFF]++;
+                    keysTmp[j] = keys[i];
+                    orderTmp[j] = order[i];
+                }
+                keys.swap(keysTmp);
+                order.swap(orderTmp);
+            }
+            return order;
+        }
+
+        template <typename V>
+        std::vector<Magnitude<V>> magnitudes(std::span<V> vecs) {
+            std::vector<Magnitude<V>> sq(vecs.size());
+            for (size_t i=0; i<vecs.size(); i++)
+                sq[i] = vecs[i].lengthSquared();
+            return sq;
+        }
+    }
+
+    // Indices of vecs in order of increasing length, vecs[order[0]] is the shortest
+    // Sorts the squared lengths, computed once per vector, with a radix sort, equal lengths keep their order
+    // Works on spans of any vector with lengthSquared(), float, double or integral
+    template <typename V>
+    std::vector<size_t> magnitudeOrder(std::span<V> vecs) {
+        return detail::radixOrder(detail::magnitudes(vecs));
+    }
+    template <typename T>
+    std::vector<size_t> magnitudeOrder(const Vec3Batch<T>& batch) {
+        return detail::radixOrder(batch.lengthSquared());
+    }
+    template <typename T>
+    std::vector<size_t> magnitudeOrder(const Vec4Batch<T>& batch) {
+        return detail::radixOrder(batch.lengthSquared());
+    }
+
+    // Sorts vecs by increasing length in place
+    template <typename V>
+    void sortByMagnitude(std::span<V> vecs) {
+        std::vector<size_t> order = magnitudeOrder(vecs);
+        std::vector<V> sorted;
+        sorted.reserve(vecs.size());
+        for (size_t i : order)
+            sorted.push_back(vecs[i]);
+        std::copy(sorted.begin(), sorted.end(), vecs.begin());
+    }
+
+    // Moves the vectors shorter than length to the front of vecs and returns how many there are
+    // Both parts keep their order, the squared lengths are compared to length squared
+    template <typename V>
+    size_t partitionByMagnitude(std::span<V> vecs, detail::Magnitude<V> length) {
+        detail::Magnitude<V> limit = length*length;
+        std::vector<V> longer;
+        size_t shorter = 0;
+        for (size_t i=0; i<vecs.size(); i++) {
+            if (vecs[i].lengthSquared() < limit)
+                vecs[shorter++] = vecs[i];
+            else
+                longer.push_back(vecs[i]);
+        }
+        std::copy(longer.begin(), longer.end(), vecs.begin() + shorter);
+        return shorter;
+    }
+}
+
+#endif
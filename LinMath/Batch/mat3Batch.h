@@ -0,0 +1,166 @@
+#ifndef MAT3BATCH_H
+#define MAT3BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../Matrix/mat3.h"
+#include "../Parallel/threadpool.h"
+#include "../Simd/aligned.h"
+#include "../Simd/mat3.h"
+
+namespace linmath {
+
+    // Many Mat3 stored lane interleaved like Mat4Batch, element k of matrix j in a block of lanes is at block[k*lanes + j]
+    // so inverses and determinants run a full register of matricies per instruction
+    template <typename T>
+    class Mat3Batch {
+
+        protected:
+        size_t n = 0;
+        size_t blocks = 0;
+        T* values = nullptr;
+
+        public:
+        static constexpr size_t lanes = simd::cacheLine / sizeof(T) ? simd::cacheLine / sizeof(T) : 1;
+
+        // Constructors
+        Mat3Batch() {}
+        Mat3Batch(size_t size) {
+            resize(size);
+            for (size_t i=0; i<9*lanes*blocks; i++)
+                values[i] = T(0);
+        }
+        Mat3Batch(const Mat3<T>* mats, size_t size) {
+            load(mats, size);
+        }
+        Mat3Batch(const std::vector<Mat3<T>>& mats) {
+            load(mats.data(), mats.size());
+        }
+
+        // Copy and move
+        Mat3Batch(const Mat3Batch<T>& batch) {
+            *this = batch;
+        }
+        Mat3Batch(Mat3Batch<T>&& batch) noexcept {
+            *this = std::move(batch);
+        }
+        Mat3Batch<T>& operator=(const Mat3Batch<T>& batch) {
+            if (this != &batch) {
+                resize(batch.n);
+                for (size_t i=0; i<9*lanes*blocks; i++)
+                    values[i] = batch.values[i];
+            }
+            return *this;
+        }
+        Mat3Batch<T>& operator=(Mat3Batch<T>&& batch) noexcept {
+            std::swap(n, batch.n);
+            std::swap(blocks, batch.blocks);
+            std::swap(values, batch.values);
+            return *this;
+        }
+        ~Mat3Batch() {
+            if (values)
+                simd::alignedFree(values);
+        }
+
+
+        // Size and storage, padding lanes of the last block are kept zero
+        size_t size()const {
+            return n;
+        }
+        void resize(size_t size) {
+            size_t grown = (size + lanes - 1) / lanes;
+            if (grown != blocks) {
+                T* grownValues = simd::alignedAlloc<T>(9*lanes*grown);
+                size_t kept = grown < blocks ? grown : blocks;
+                for (size_t i=0; i<9*lanes*kept; i++)
+                    grownValues[i] = values[i];
+                for (size_t i=9*lanes*kept; i<9*lanes*grown; i++)
+                    grownValues[i] = T(0);
+                if (values)
+                    simd::alignedFree(values);
+                values = grownValues;
+                blocks = grown;
+            }
+            for (size_t i=size; i<n && i<blocks*lanes; i++)
+                set(i, Mat3<T>(T(0)));
+            n = size;
+        }
+        T* data() {
+            return values;
+        }
+        const T* data()const {
+            return values;
+        }
+
+        // Conversion with Mat3
+        Mat3<T> get(size_t i)const {
+            const T* block = values + (i/lanes)*9*lanes + i%lanes;
+            Mat3<T> mat = Mat3<T>();
+            for (uint8_t k=0; k<9; k++)
+                mat[k] = block[k*lanes];
+            return mat;
+        }
+        void set(size_t i, const Mat3<T>& mat) {
+            T* block = values + (i/lanes)*9*lanes + i%lanes;
+            for (uint8_t k=0; k<9; k++)
+                block[k*lanes] = mat[k];
+        }
+        void load(const Mat3<T>* mats, size_t size) {
+            resize(size);
+            for (size_t i=0; i<n; i++)
+                set(i, mats[i]);
+        }
+        void store(Mat3<T>* mats)const {
+            for (size_t i=0; i<n; i++)
+                mats[i] = get(i);
+        }
+        std::vector<Mat3<T>> matricies()const {
+            std::vector<Mat3<T>> mats(n);
+            store(mats.data());
+            return mats;
+        }
+
+        // Inverses of every matrix, out may be this batch itself
+        // A singular matrix, determinant 0, gets an all zero inverse and singular[i] = 1, the others 0,
+        // singular must hold at least size() flags
+        Mat3Batch<T> inversed(std::span<uint8_t> singular)const {
+            Mat3Batch<T> out = Mat3Batch<T>();
+            inverse(out, singular);
+            return out;
+        }
+        void inverse(Mat3Batch<T>& out, std::span<uint8_t> singular)const {
+            out.resize(n);
+            simd::mat3InverseInterleaved(n, lanes, values, out.values, singular.data());
+        }
+        void inverse(Mat3Batch<T>& out, std::span<uint8_t> singular, ThreadPool& pool)const {
+            out.resize(n);
+            pool.parallelRange(blocks, 256, [&](size_t begin, size_t end) {
+                size_t last = end*lanes < n ? end*lanes : n;
+                simd::mat3InverseInterleaved(last - begin*lanes, lanes, values + 9*lanes*begin, out.values + 9*lanes*begin, singular.data() + begin*lanes);
+            });
+        }
+
+        // Determinants of every matrix, det must hold at least size() values
+        void determinant(std::span<T> det)const {
+            simd::mat3DetInterleaved(n, lanes, values, det.data());
+        }
+        void determinant(std::span<T> det, ThreadPool& pool)const {
+            pool.parallelRange(blocks, 256, [&](size_t begin, size_t end) {
+                size_t last = end*lanes < n ? end*lanes : n;
+                simd::mat3DetInterleaved(last - begin*lanes, lanes, values + 9*lanes*begin, det.data() + begin*lanes);
+            });
+        }
+
+        // Array functionality, by value since the elements are not adjacent
+        Mat3<T> operator[](size_t i)const {
+            return get(i);
+        }
+    };
+}
+
+#endif
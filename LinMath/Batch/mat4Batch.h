@@ -0,0 +1,212 @@
+#ifndef MAT4BATCH_H
+#define MAT4BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../Matrix/mat4.h"
+#include "../Parallel/threadpool.h"
+#include "../Simd/aligned.h"
+#include "../Simd/mat4.h"
+
+namespace linmath {
+
+    // Many Mat4 stored lane interleaved (array of structures of arrays)
+    // Matricies are grouped in cache line wide blocks of lanes, element k of matrix j in a block is at block[k*lanes + j],
+    // so products run a full register of matricies per instruction without any shuffles
+    template <typename T>
+    class Mat4Batch {
+
+        protected:
+        size_t n = 0;
+        size_t blocks = 0;
+        T* values = nullptr;
+
+        public:
+        static constexpr size_t lanes = simd::cacheLine / sizeof(T) ? simd::cacheLine / sizeof(T) : 1;
+
+        // Constructors
+        Mat4Batch() {}
+        Mat4Batch(size_t size) {
+            resize(size);
+            for (size_t i=0; i<16*lanes*blocks; i++)
+                values[i] = T(0);
+        }
+        Mat4Batch(const Mat4<T>* mats, size_t size) {
+            load(mats, size);
+        }
+        Mat4Batch(const std::vector<Mat4<T>>& mats) {
+            load(mats.data(), mats.size());
+        }
+
+        // Copy and move
+        Mat4Batch(const Mat4Batch<T>& batch) {
+            *this = batch;
+        }
+        Mat4Batch(Mat4Batch<T>&& batch) noexcept {
+            *this = std::move(batch);
+        }
+        Mat4Batch<T>& operator=(const Mat4Batch<T>& batch) {
+            if (this != &batch) {
+                resize(batch.n);
+                for (size_t i=0; i<16*lanes*blocks; i++)
+                    values[i] = batch.values[i];
+            }
+            return *this;
+        }
+        Mat4Batch<T>& operator=(Mat4Batch<T>&& batch) noexcept {
+            std::swap(n, batch.n);
+            std::swap(blocks, batch.blocks);
+            std::swap(values, batch.values);
+            return *this;
+        }
+        ~Mat4Batch() {
+            if (values)
+                simd::alignedFree(values);
+        }
+
+
+        // Size and storage, padding lanes of the last block are kept zero
+        size_t size()const {
+            return n;
+        }
+        void resize(size_t size) {
+            size_t grown = (size + lanes - 1) / lanes;
+            if (grown != blocks) {
+                T* grownValues = simd::alignedAlloc<T>(16*lanes*grown);
+                size_t kept = grown < blocks ? grown : blocks;
+                for (size_t i=0; i<16*lanes*kept; i++)
+                    grownValues[i] = values[i];
+                for (size_t i=16*lanes*kept; i<16*lanes*grown; i++)
+                    grownValues[i] = T(0);
+                if (values)
+                    simd::alignedFree(values);
+                values = grownValues;
+                blocks = grown;
+            }
+            for (size_t i=size; i<n && i<blocks*lanes; i++)
+                set(i, Mat4<T>(T(0)));
+            n = size;
+        }
+        T* data() {
+            return values;
+        }
+        const T* data()const {
+            return values;
+        }
+
+        // Conversion with Mat4
+        Mat4<T> get(size_t i)const {
+            const T* block = values + (i/lanes)*16*lanes + i%lanes;
+            Mat4<T> mat = Mat4<T>();
+            for (uint8_t k=0; k<16; k++)
+                mat[k] = block[k*lanes];
+            return mat;
+        }
+        void set(size_t i, const Mat4<T>& mat) {
+            T* block = values + (i/lanes)*16*lanes + i%lanes;
+            for (uint8_t k=0; k<16; k++)
+                block[k*lanes] = mat[k];
+        }
+        void load(const Mat4<T>* mats, size_t size) {
+            resize(size);
+            for (size_t i=0; i<n; i++)
+                set(i, mats[i]);
+        }
+        void store(Mat4<T>* mats)const {
+            for (size_t i=0; i<n; i++)
+                mats[i] = get(i);
+        }
+        std::vector<Mat4<T>> matricies()const {
+            std::vector<Mat4<T>> mats(n);
+            store(mats.data());
+            return mats;
+        }
+
+        // Dot product of matching matricies
+        Mat4Batch<T> dot(const Mat4Batch<T>& batch)const {
+            Mat4Batch<T> out = Mat4Batch<T>();
+            out.resize(n);
+            simd::mat4DotInterleaved(blocks, lanes, values, batch.values, out.values);
+            return out;
+        }
+        void dot(const Mat4Batch<T>& batch, Mat4Batch<T>& out)const {
+            out.resize(n);
+            simd::mat4DotInterleaved(blocks, lanes, values, batch.values, out.values);
+        }
+        void dot(const Mat4Batch<T>& batch, Mat4Batch<T>& out, ThreadPool& pool)const {
+            out.resize(n);
+            pool.parallelRange(blocks, 256, [&](size_t begin, size_t end) {
+                simd::mat4DotInterleaved(end - begin, lanes, values + 16*lanes*begin, batch.values + 16*lanes*begin, out.values + 16*lanes*begin);
+            });
+        }
+
+        // Inverses of every matrix, out may be this batch itself
+        // A singular matrix, determinant 0, gets an all zero inverse and singular[i] = 1, the others 0,
+        // singular must hold at least size() flags
+        Mat4Batch<T> inversed(std::span<uint8_t> singular)const {
+            Mat4Batch<T> out = Mat4Batch<T>();
+            inverse(out, singular);
+            return out;
+        }
+        void inverse(Mat4Batch<T>& out, std::span<uint8_t> singular)const {
+            out.resize(n);
+            simd::mat4InverseInterleaved(n, lanes, values, out.values, singular.data());
+        }
+        void inverse(Mat4Batch<T>& out, std::span<uint8_t> singular, ThreadPool& pool)const {
+            out.resize(n);
+            pool.parallelRange(blocks, 256, [&](size_t begin, size_t end) {
+                size_t last = end*lanes < n ? end*lanes : n;
+                simd::mat4InverseInterleaved(last - begin*lanes, lanes, values + 16*lanes*begin, out.values + 16*lanes*begin, singular.data() + begin*lanes);
+            });
+        }
+
+        // Determinants of every matrix, det must hold at least size() values
+        void determinant(std::span<T> det)const {
+            simd::mat4DetInterleaved(n, lanes, values, det.data());
+        }
+        void determinant(std::span<T> det, ThreadPool& pool)const {
+            pool.parallelRange(blocks, 256, [&](size_t begin, size_t end) {
+                size_t last = end*lanes < n ? end*lanes : n;
+                simd::mat4DetInterleaved(last - begin*lanes, lanes, values + 16*lanes*begin, det.data() + begin*lanes);
+            });
+        }
+
+        // Array functionality, by value since the elements are not adjacent
+        Mat4<T> operator[](size_t i)const {
+            return get(i);
+        }
+    };
+
+    // Products of matching matricies stored one after another, out[i] = a[i].dot(b[i]) for n matricies
+    // out may be a or b itself, the overloads taking a pool split large arrays across its threads
+    template <typename T>
+    void dot(const Mat4<T>* a, const Mat4<T>* b, Mat4<T>* out, size_t n) {
+        simd::mat4DotArray(n, reinterpret_cast<const T*>(a), reinterpret_cast<const T*>(b), reinterpret_cast<T*>(out));
+    }
+    template <typename T>
+    void dot(const Mat4<T>* a, const Mat4<T>* b, Mat4<T>* out, size_t n, ThreadPool& pool) {
+        pool.parallelRange(n, 4096, [&](size_t begin, size_t end) {
+            simd::mat4DotArray(end - begin, reinterpret_cast<const T*>(a + begin), reinterpret_cast<const T*>(b + begin), reinterpret_cast<T*>(out + begin));
+        });
+    }
+
+    // Span forms, out must hold at least a.size() matricies
+    inline void dot(std::span<const Mat4<float>> a, std::span<const Mat4<float>> b, std::span<Mat4<float>> out) {
+        dot(a.data(), b.data(), out.data(), a.size());
+    }
+    inline void dot(std::span<const Mat4<float>> a, std::span<const Mat4<float>> b, std::span<Mat4<float>> out, ThreadPool& pool) {
+        dot(a.data(), b.data(), out.data(), a.size(), pool);
+    }
+    inline void dot(std::span<const Mat4<double>> a, std::span<const Mat4<double>> b, std::span<Mat4<double>> out) {
+        dot(a.data(), b.data(), out.data(), a.size());
+    }
+    inline void dot(std::span<const Mat4<double>> a, std::span<const Mat4<double>> b, std::span<Mat4<double>> out, ThreadPool& pool) {
+        dot(a.data(), b.data(), out.data(), a.size(), pool);
+    }
+}
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef ROTATION_H
+#define ROTATION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "vec3Batch.h"
+#include "transform.h"
+#include "../Quaternion/quat.h"
+#include "../Parallel/threadpool.h"
+#include "../Simd/quat.h"
+#include "../Simd/sincos.h"
+
+namespace linmath {
+
+    namespace simd {
+
+        // Rotation matricies from blocks of angles, the sines and cosines of a block are found by the sincos kernel
+        // into buffers on the stack and build(i, sin, cos) writes matrix i from them
+        constexpr size_t rotationBlock = 256;
+
+        template <typename T, typename F>
+        void rotations(size_t n, const T* angles, F build) {
+            alignas(64) T s[rotationBlock];
+            alignas(64) T c[rotationBlock];
+            for (size_t begin=0; begin<n; begin+=rotationBlock) {
+                size_t count = std::min(rotationBlock, n - begin);
+                sincos<T>(count, angles + begin, s, c);
+                for (size_t i=0; i<count; i++)
+                    build(begin + i, s[i], c[i]);
+            }
+        }
+    }
+
+    // Sine and cosine of every angle, within 2 ulp of the correctly rounded ones for the ranges simd::sincos gives, s and c must hold at least as many values
+    template <typename T>
+    void sincos(std::span<const std::type_identity_t<T>> angles, std::span<T> s, std::span<T> c) {
+        simd::sincos<T>(angles.size(), angles.data(), s.data(), c.data());
+    }
+
+    // Rotation matricies of many angles in radians, out[i] is the builder's matrix for angles[i] to within 2 ulp
+    // One vectorized sincos covers every angle instead of a sin and a cos call per matrix,
+    // out must hold at least as many matricies
+    template <typename T>
+    void rotations(std::span<const std::type_identity_t<T>> angles, std::span<Mat3<T>> out) {
+        simd::rotations<T>(angles.size(), angles.data(), [&](size_t i, T s, T c) {
+            out[i] = Mat3<T>(c, -s, 0, s, c, 0, 0, 0, 1);
+        });
+    }
+    template <typename T>
+    void rotationsX(std::span<const std::type_identity_t<T>> angles, std::span<Mat4<T>> out) {
+        simd::rotations<T>(angles.size(), angles.data(), [&](size_t i, T s, T c) {
+            out[i] = Mat4<T>( 1, 0, 0, 0,
+                              0, c, s, 0,
+                              0, -s, c, 0,
+                              0, 0, 0, 1);
+        });
+    }
+    template <typename T>
+    void rotationsY(std::span<const std::type_identity_t<T>> angles, std::span<Mat4<T>> out) {
+        simd::rotations<T>(angles.size(), angles.data(), [&](size_t i, T s, T c) {
+            out[i] = Mat4<T>( c, 0, -s, 0,
+                              0, 1, 0, 0,
+                              s, 0, c, 0,
+                              0, 0, 0, 1);
+        });
+    }
+    template <typename T>
+    void rotationsZ(std::span<const std::type_identity_t<T>> angles, std::span<Mat4<T>> out) {
+        simd::rotations<T>(angles.size(), angles.data(), [&](size_t i, T s, T c) {
+            out[i] = Mat4<T>( c, s, 0, 0,
+                              -s, c, 0, 0,
+                              0, 0, 1, 0,
+                              0, 0, 0, 1);
+        });
+    }
+
+    // Rotates every vector of in by quat, as quat.rotate does, and writes the results to out
+    // The quaternion is turned into a matrix once and the vectors go through the affine transform kernels,
+    // 9 multiply-adds per vector, out may be in itself and must hold at least as many vectors
+    // The conjugate's matrix is the transpose, laid out for the kernels that multiply column vectors
+    template <typename T>
+    void rotate(const Quat<T>& quat, std::span<const Vec3<std::type_identity_t<T>>> in, std::span<Vec3<std::type_identity_t<T>>> out) {
+        Mat4<T> mat = quat.conjugate().mat4();
+        simd::transformInterleaved<T, 3, simd::Transform::Affine>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()));
+    }
+    template <typename T>
+    void rotate(const Quat<T>& quat, std::span<const Vec3<std::type_identity_t<T>>> in, std::span<Vec3<std::type_identity_t<T>>> out, ThreadPool& pool) {
+        Mat4<T> mat = quat.conjugate().mat4();
+        simd::transformInterleaved<T, 3, simd::Transform::Affine>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()), pool);
+    }
+    template <typename T>
+    void rotate(const Quat<T>& quat, const Vec3Batch<T>& in, Vec3Batch<T>& out) {
+        Mat4<T> mat = quat.conjugate().mat4();
+        out.resize(in.size());
+        simd::transformPlanar<T, 3, simd::Transform::Affine>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride());
+    }
+    template <typename T>
+    void rotate(const Quat<T>& quat, const Vec3Batch<T>& in, Vec3Batch<T>& out, ThreadPool& pool) {
+        Mat4<T> mat = quat.conjugate().mat4();
+        out.resize(in.size());
+        simd::transformPlanar<T, 3, simd::Transform::Affine>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride(), pool);
+    }
+
+    // Interpolates every pair a[i], b[i] at t[i] as the single nlerp and slerp do, for sampling many animation channels
+    // out may be a or b and must hold at least as many quaternions, slerp matches the single one to within rounding
+    template <typename T>
+    void nlerp(std::span<const Quat<std::type_identity_t<T>>> a, std::span<const Quat<std::type_identity_t<T>>> b, std::span<const std::type_identity_t<T>> t, std::span<Quat<T>> out) {
+        simd::nlerp<T>(a.size(), reinterpret_cast<const T*>(a.data()), reinterpret_cast<const T*>(b.data()), t.data(), reinterpret_cast<T*>(out.data()));
+    }
+    template <typename T>
+    void slerp(std::span<const Quat<std::type_identity_t<T>>> a, std::span<const Quat<std::type_identity_t<T>>> b, std::span<const std::type_identity_t<T>> t, std::span<Quat<T>> out) {
+        simd::slerp<T>(a.size(), reinterpret_cast<const T*>(a.data()), reinterpret_cast<const T*>(b.data()), t.data(), reinterpret_cast<T*>(out.data()));
+    }
+}
+
+#endif
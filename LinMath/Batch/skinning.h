@@ -0,0 +1,144 @@
+#ifndef SKINNING_H
+#define SKINNING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "vec3Batch.h"
+#include "../Matrix/mat4.h"
+#include "../Quaternion/dualQuat.h"
+#include "../Parallel/threadpool.h"
+#include "../Simd/aligned.h"
+#include "../Simd/skin.h"
+
+namespace linmath {
+
+    // Bone influences of many vertices as structure of arrays, the same number of them for every vertex
+    // Influence j of all vertices is one array of bone indices and one of weights, unused influences have weight 0
+    // The weights of a vertex should sum to 1 for linear blending and must not all be 0 for dual quaternion blending
+    template <typename T>
+    class SkinWeights {
+
+        protected:
+        size_t n = 0;
+        size_t k = 0;
+        simd::AlignedVector<int32_t> indices;
+        simd::AlignedVector<T> values;
+
+        public:
+
+        // Constructors, every influence starts as bone 0 with weight 0
+        SkinWeights() {}
+        SkinWeights(size_t size, size_t influences) : n(size), k(influences), indices(size*influences, 0), values(size*influences, T(0)) {}
+
+        // Size and storage
+        size_t size()const {
+            return n;
+        }
+        size_t influences()const {
+            return k;
+        }
+        int32_t* bones(size_t j) {
+            return indices.data() + j*n;
+        }
+        const int32_t* bones(size_t j)const {
+            return indices.data() + j*n;
+        }
+        T* weights(size_t j) {
+            return values.data() + j*n;
+        }
+        const T* weights(size_t j)const {
+            return values.data() + j*n;
+        }
+
+        // Influence j of vertex i
+        void set(size_t i, size_t j, int32_t bone, T weight) {
+            bones(j)[i] = bone;
+            weights(j)[i] = weight;
+        }
+    };
+
+    namespace simd {
+
+        // Skinning split into ranges over a thread pool, small meshes stay on the calling thread
+        constexpr size_t skinGrain = 4096;
+
+        template <typename T>
+        Skin<T> skin(const T* palette, const SkinWeights<T>& weights, const Vec3Batch<T>& positions, Vec3Batch<T>& outPositions) {
+            outPositions.resize(positions.size());
+            return Skin<T>{palette, weights.influences(), weights.bones(0), weights.weights(0), weights.size(),
+                           positions.x(), positions.stride(), outPositions.x(), outPositions.stride()};
+        }
+        template <typename T>
+        Skin<T> skin(const T* palette, const SkinWeights<T>& weights, const Vec3Batch<T>& positions, const Vec3Batch<T>& normals, Vec3Batch<T>& outPositions, Vec3Batch<T>& outNormals) {
+            Skin<T> arrays = skin(palette, weights, positions, outPositions);
+            outNormals.resize(normals.size());
+            arrays.normals = normals.x();
+            arrays.normalStride = normals.stride();
+            arrays.outNormals = outNormals.x();
+            arrays.outNormalStride = outNormals.stride();
+            return arrays;
+        }
+
+        template <typename T>
+        void skinLinear(size_t n, const Skin<T>& skin, ThreadPool& pool) {
+            pool.parallelRange(n, skinGrain, [&](size_t begin, size_t end) {
+                skinLinear<T>(begin, end, skin);
+            });
+        }
+        template <typename T>
+        void skinDualQuat(size_t n, const Skin<T>& skin, ThreadPool& pool) {
+            pool.parallelRange(n, skinGrain, [&](size_t begin, size_t end) {
+                skinDualQuat<T>(begin, end, skin);
+            });
+        }
+    }
+
+    // Linear blend skinning, every vertex is transformed by the weighted sum of its bone matricies
+    // The palette matricies apply to column vectors as mat4x4vec and transform do, the transpozed builder layout,
+    // so a DualQuat's bone is dq.mat4().transpozed(), normals go through the top left 3x3 and are renormalized
+    // Every bone index must be in the palette, out may be the input batch and is resized to it
+    template <typename T>
+    void skinLinear(std::span<const Mat4<std::type_identity_t<T>>> palette, const SkinWeights<T>& weights, const Vec3Batch<T>& positions, Vec3Batch<T>& outPositions) {
+        simd::skinLinear<T>(0, positions.size(), simd::skin(reinterpret_cast<const T*>(palette.data()), weights, positions, outPositions));
+    }
+    template <typename T>
+    void skinLinear(std::span<const Mat4<std::type_identity_t<T>>> palette, const SkinWeights<T>& weights, const Vec3Batch<T>& positions, Vec3Batch<T>& outPositions, ThreadPool& pool) {
+        simd::skinLinear<T>(positions.size(), simd::skin(reinterpret_cast<const T*>(palette.data()), weights, positions, outPositions), pool);
+    }
+    template <typename T>
+    void skinLinear(std::span<const Mat4<std::type_identity_t<T>>> palette, const SkinWeights<T>& weights, const Vec3Batch<T>& positions, const Vec3Batch<T>& normals, Vec3Batch<T>& outPositions, Vec3Batch<T>& outNormals) {
+        simd::skinLinear<T>(0, positions.size(), simd::skin(reinterpret_cast<const T*>(palette.data()), weights, positions, normals, outPositions, outNormals));
+    }
+    template <typename T>
+    void skinLinear(std::span<const Mat4<std::type_identity_t<T>>> palette, const SkinWeights<T>& weights, const Vec3Batch<T>& positions, const Vec3Batch<T>& normals, Vec3Batch<T>& outPositions, Vec3Batch<T>& outNormals, ThreadPool& pool) {
+        simd::skinLinear<T>(positions.size(), simd::skin(reinterpret_cast<const T*>(palette.data()), weights, positions, normals, outPositions, outNormals), pool);
+    }
+
+    // Dual quaternion skinning, every vertex is transformed by the normalized weighted sum of its bones as DualQuat::transform does
+    // Unlike linear blending the blend stays rigid, so twisting joints keep their volume and normals stay unit length
+    template <typename T>
+    void skinDualQuat(std::span<const DualQuat<std::type_identity_t<T>>> palette, const SkinWeights<T>& weights, const Vec3Batch<T>& positions, Vec3Batch<T>& outPositions) {
+        static_assert(sizeof(DualQuat<T>) == 8*sizeof(T), "the kernels read 8 values per bone");
+        simd::skinDualQuat<T>(0, positions.size(), simd::skin(reinterpret_cast<const T*>(palette.data()), weights, positions, outPositions));
+    }
+    template <typename T>
+    void skinDualQuat(std::span<const DualQuat<std::type_identity_t<T>>> palette, const SkinWeights<T>& weights, const Vec3Batch<T>& positions, Vec3Batch<T>& outPositions, ThreadPool& pool) {
+        static_assert(sizeof(DualQuat<T>) == 8*sizeof(T), "the kernels read 8 values per bone");
+        simd::skinDualQuat<T>(positions.size(), simd::skin(reinterpret_cast<const T*>(palette.data()), weights, positions, outPositions), pool);
+    }
+    template <typename T>
+    void skinDualQuat(std::span<const DualQuat<std::type_identity_t<T>>> palette, const SkinWeights<T>& weights, const Vec3Batch<T>& positions, const Vec3Batch<T>& normals, Vec3Batch<T>& outPositions, Vec3Batch<T>& outNormals) {
+        static_assert(sizeof(DualQuat<T>) == 8*sizeof(T), "the kernels read 8 values per bone");
+        simd::skinDualQuat<T>(0, positions.size(), simd::skin(reinterpret_cast<const T*>(palette.data()), weights, positions, normals, outPositions, outNormals));
+    }
+    template <typename T>
+    void skinDualQuat(std::span<const DualQuat<std::type_identity_t<T>>> palette, const SkinWeights<T>& weights, const Vec3Batch<T>& positions, const Vec3Batch<T>& normals, Vec3Batch<T>& outPositions, Vec3Batch<T>& outNormals, ThreadPool& pool) {
+        static_assert(sizeof(DualQuat<T>) == 8*sizeof(T), "the kernels read 8 values per bone");
+        simd::skinDualQuat<T>(positions.size(), simd::skin(reinterpret_cast<const T*>(palette.data()), weights, positions, normals, outPositions, outNormals), pool);
+    }
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef SOLVE_H
+#define SOLVE_H
+
+#include <cstddef>
+
+#include "vec3Batch.h"
+#include "vec4Batch.h"
+#include "mat4Batch.h"
+#include "../Parallel/threadpool.h"
+#include "../Simd/solve.h"
+
+namespace linmath {
+
+    namespace simd {
+
+        // Solves split into ranges over a thread pool, small batches stay on the calling thread
+        constexpr size_t solveGrain = 4096;
+
+        template <typename T, size_t N>
+        void solve(size_t n, const Systems<T>& systems, ThreadPool& pool) {
+            pool.parallelRange(n, solveGrain, [&](size_t begin, size_t end) {
+                solve<T, N>(begin, end, systems);
+            });
+        }
+    }
+
+    // Many independent 3x3 and 4x4 systems, x[i] solves a[i]*x = b[i] as solve(a[i], b[i]) does for one of them
+    // The matricies are planar, element (row, col) of system i at a[(N*row + col)*stride + i] with stride at least
+    // the batch size, or a Mat4Batch, and every system pivots on its own in its lane of the vector registers
+    // A singular system gets infinities or NaN, x may be b and is resized to it
+    template <typename T>
+    void solve(const T* a, size_t stride, const Vec3Batch<T>& b, Vec3Batch<T>& x) {
+        x.resize(b.size());
+        simd::solve<T, 3>(0, b.size(), simd::Systems<T>{a, stride, b.x(), b.stride(), x.x(), x.stride()});
+    }
+    template <typename T>
+    void solve(const T* a, size_t stride, const Vec3Batch<T>& b, Vec3Batch<T>& x, ThreadPool& pool) {
+        x.resize(b.size());
+        simd::solve<T, 3>(b.size(), simd::Systems<T>{a, stride, b.x(), b.stride(), x.x(), x.stride()}, pool);
+    }
+    template <typename T>
+    void solve(const T* a, size_t stride, const Vec4Batch<T>& b, Vec4Batch<T>& x) {
+        x.resize(b.size());
+        simd::solve<T, 4>(0, b.size(), simd::Systems<T>{a, stride, b.x(), b.stride(), x.x(), x.stride()});
+    }
+    template <typename T>
+    void solve(const T* a, size_t stride, const Vec4Batch<T>& b, Vec4Batch<T>& x, ThreadPool& pool) {
+        x.resize(b.size());
+        simd::solve<T, 4>(b.size(), simd::Systems<T>{a, stride, b.x(), b.stride(), x.x(), x.stride()}, pool);
+    }
+
+    // The pool splits a Mat4Batch at whole blocks
+    template <typename T>
+    void solve(const Mat4Batch<T>& a, const Vec4Batch<T>& b, Vec4Batch<T>& x) {
+        x.resize(b.size());
+        simd::solve<T, 4>(0, b.size(), simd::Systems<T>{a.data(), Mat4Batch<T>::lanes, b.x(), b.stride(), x.x(), x.stride()});
+    }
+    template <typename T>
+    void solve(const Mat4Batch<T>& a, const Vec4Batch<T>& b, Vec4Batch<T>& x, ThreadPool& pool) {
+        constexpr size_t lanes = Mat4Batch<T>::lanes;
+        x.resize(b.size());
+        simd::Systems<T> systems{a.data(), lanes, b.x(), b.stride(), x.x(), x.stride()};
+        size_t n = b.size();
+        pool.parallelRange((n + lanes - 1) / lanes, simd::solveGrain / lanes, [&](size_t begin, size_t end) {
+            simd::solve<T, 4>(begin*lanes, end*lanes < n ? end*lanes : n, systems);
+        });
+    }
+}
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "vec3Batch.h"
+#include "vec4Batch.h"
+#include "../Matrix/affine3.h"
+#include "../Matrix/mat4.h"
+#include "../Parallel/threadpool.h"
+#include "../Simd/transform.h"
+
+namespace linmath {
+
+    namespace simd {
+
+        // Transforms split into ranges over a thread pool, small inputs stay on the calling thread
+        constexpr size_t transformGrain = 16384;
+
+        template <typename T, size_t D, Transform mode, Convention order = Convention::ColumnVectors>
+        void transformInterleaved(size_t n, const T* m, const T* in, T* out, ThreadPool& pool) {
+            pool.parallelRange(n, transformGrain, [&](size_t begin, size_t end) {
+                transformInterleaved<T, D, mode, order>(end - begin, m, in + D*begin, out + D*begin);
+            });
+        }
+        template <typename T, size_t D, Transform mode, Convention order = Convention::ColumnVectors>
+        void transformPlanar(size_t n, const T* m, const T* in, size_t si, T* out, size_t so, ThreadPool& pool) {
+            pool.parallelRange(n, transformGrain, [&](size_t begin, size_t end) {
+                transformPlanar<T, D, mode, order>(end - begin, m, in + begin, si, out + begin, so);
+            });
+        }
+    }
+
+    // Applies mat to every vector of in, as mat4x4vec does, and writes the results to out
+    // With Convention::RowVectors as the first template argument it applies them as vec4x4mat does instead, the
+    // convention of the Mat4 builders, so their matricies need no transpose
+    // Vec3 are points with w = 1, out may be in itself and must hold at least as many vectors
+    // transformHomogeneous divides by the transformed w, transformAffine skips the row or column of mat that holds
+    // the projection, the bottom row for column vectors and the last column for row vectors, and keeps the translation
+    // The overloads taking a pool split large inputs across its threads
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transform(const Mat4<T>& mat, std::span<const Vec3<std::type_identity_t<T>>> in, std::span<Vec3<std::type_identity_t<T>>> out) {
+        simd::transformInterleaved<T, 3, simd::Transform::Full, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()));
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transform(const Mat4<T>& mat, std::span<const Vec3<std::type_identity_t<T>>> in, std::span<Vec3<std::type_identity_t<T>>> out, ThreadPool& pool) {
+        simd::transformInterleaved<T, 3, simd::Transform::Full, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()), pool);
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transform(const Mat4<T>& mat, std::span<const Vec4<std::type_identity_t<T>>> in, std::span<Vec4<std::type_identity_t<T>>> out) {
+        simd::transformInterleaved<T, 4, simd::Transform::Full, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()));
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transform(const Mat4<T>& mat, std::span<const Vec4<std::type_identity_t<T>>> in, std::span<Vec4<std::type_identity_t<T>>> out, ThreadPool& pool) {
+        simd::transformInterleaved<T, 4, simd::Transform::Full, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()), pool);
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transform(const Mat4<T>& mat, const Vec3Batch<T>& in, Vec3Batch<T>& out) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 3, simd::Transform::Full, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride());
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transform(const Mat4<T>& mat, const Vec3Batch<T>& in, Vec3Batch<T>& out, ThreadPool& pool) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 3, simd::Transform::Full, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride(), pool);
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transform(const Mat4<T>& mat, const Vec4Batch<T>& in, Vec4Batch<T>& out) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 4, simd::Transform::Full, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride());
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transform(const Mat4<T>& mat, const Vec4Batch<T>& in, Vec4Batch<T>& out, ThreadPool& pool) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 4, simd::Transform::Full, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride(), pool);
+    }
+
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformHomogeneous(const Mat4<T>& mat, std::span<const Vec3<std::type_identity_t<T>>> in, std::span<Vec3<std::type_identity_t<T>>> out) {
+        simd::transformInterleaved<T, 3, simd::Transform::Homogeneous, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()));
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformHomogeneous(const Mat4<T>& mat, std::span<const Vec3<std::type_identity_t<T>>> in, std::span<Vec3<std::type_identity_t<T>>> out, ThreadPool& pool) {
+        simd::transformInterleaved<T, 3, simd::Transform::Homogeneous, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()), pool);
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformHomogeneous(const Mat4<T>& mat, std::span<const Vec4<std::type_identity_t<T>>> in, std::span<Vec4<std::type_identity_t<T>>> out) {
+        simd::transformInterleaved<T, 4, simd::Transform::Homogeneous, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()));
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformHomogeneous(const Mat4<T>& mat, std::span<const Vec4<std::type_identity_t<T>>> in, std::span<Vec4<std::type_identity_t<T>>> out, ThreadPool& pool) {
+        simd::transformInterleaved<T, 4, simd::Transform::Homogeneous, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()), pool);
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformHomogeneous(const Mat4<T>& mat, const Vec3Batch<T>& in, Vec3Batch<T>& out) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 3, simd::Transform::Homogeneous, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride());
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformHomogeneous(const Mat4<T>& mat, const Vec3Batch<T>& in, Vec3Batch<T>& out, ThreadPool& pool) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 3, simd::Transform::Homogeneous, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride(), pool);
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformHomogeneous(const Mat4<T>& mat, const Vec4Batch<T>& in, Vec4Batch<T>& out) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 4, simd::Transform::Homogeneous, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride());
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformHomogeneous(const Mat4<T>& mat, const Vec4Batch<T>& in, Vec4Batch<T>& out, ThreadPool& pool) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 4, simd::Transform::Homogeneous, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride(), pool);
+    }
+
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformAffine(const Mat4<T>& mat, std::span<const Vec3<std::type_identity_t<T>>> in, std::span<Vec3<std::type_identity_t<T>>> out) {
+        simd::transformInterleaved<T, 3, simd::Transform::Affine, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()));
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformAffine(const Mat4<T>& mat, std::span<const Vec3<std::type_identity_t<T>>> in, std::span<Vec3<std::type_identity_t<T>>> out, ThreadPool& pool) {
+        simd::transformInterleaved<T, 3, simd::Transform::Affine, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()), pool);
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformAffine(const Mat4<T>& mat, std::span<const Vec4<std::type_identity_t<T>>> in, std::span<Vec4<std::type_identity_t<T>>> out) {
+        simd::transformInterleaved<T, 4, simd::Transform::Affine, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()));
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformAffine(const Mat4<T>& mat, std::span<const Vec4<std::type_identity_t<T>>> in, std::span<Vec4<std::type_identity_t<T>>> out, ThreadPool& pool) {
+        simd::transformInterleaved<T, 4, simd::Transform::Affine, order>(in.size(), &mat[0], reinterpret_cast<const T*>(in.data()), reinterpret_cast<T*>(out.data()), pool);
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformAffine(const Mat4<T>& mat, const Vec3Batch<T>& in, Vec3Batch<T>& out) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 3, simd::Transform::Affine, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride());
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformAffine(const Mat4<T>& mat, const Vec3Batch<T>& in, Vec3Batch<T>& out, ThreadPool& pool) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 3, simd::Transform::Affine, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride(), pool);
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformAffine(const Mat4<T>& mat, const Vec4Batch<T>& in, Vec4Batch<T>& out) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 4, simd::Transform::Affine, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride());
+    }
+    template <Convention order = Convention::ColumnVectors, typename T>
+    void transformAffine(const Mat4<T>& mat, const Vec4Batch<T>& in, Vec4Batch<T>& out, ThreadPool& pool) {
+        out.resize(in.size());
+        simd::transformPlanar<T, 4, simd::Transform::Affine, order>(in.size(), &mat[0], in.x(), in.stride(), out.x(), out.stride(), pool);
+    }
+
+    // Affine3 transforms row vectors and keeps its translation in the bottom row
+    template <typename T>
+    void transformAffine(const Affine3<T>& affine, std::span<const Vec3<std::type_identity_t<T>>> in, std::span<Vec3<std::type_identity_t<T>>> out) {
+        transformAffine<Convention::RowVectors>(Mat4<T>(affine), in, out);
+    }
+    template <typename T>
+    void transformAffine(const Affine3<T>& affine, std::span<const Vec3<std::type_identity_t<T>>> in, std::span<Vec3<std::type_identity_t<T>>> out, ThreadPool& pool) {
+        transformAffine<Convention::RowVectors>(Mat4<T>(affine), in, out, pool);
+    }
+    template <typename T>
+    void transformAffine(const Affine3<T>& affine, std::span<const Vec4<std::type_identity_t<T>>> in, std::span<Vec4<std::type_identity_t<T>>> out) {
+        transformAffine<Convention::RowVectors>(Mat4<T>(affine), in, out);
+    }
+    template <typename T>
+    void transformAffine(const Affine3<T>& affine, std::span<const Vec4<std::type_identity_t<T>>> in, std::span<Vec4<std::type_identity_t<T>>> out, ThreadPool& pool) {
+        transformAffine<Convention::RowVectors>(Mat4<T>(affine), in, out, pool);
+    }
+    template <typename T>
+    void transformAffine(const Affine3<T>& affine, const Vec3Batch<T>& in, Vec3Batch<T>& out) {
+        transformAffine<Convention::RowVectors>(Mat4<T>(affine), in, out);
+    }
+    template <typename T>
+    void transformAffine(const Affine3<T>& affine, const Vec3Batch<T>& in, Vec3Batch<T>& out, ThreadPool& pool) {
+        transformAffine<Convention::RowVectors>(Mat4<T>(affine), in, out, pool);
+    }
+    template <typename T>
+    void transformAffine(const Affine3<T>& affine, const Vec4Batch<T>& in, Vec4Batch<T>& out) {
+        transformAffine<Convention::RowVectors>(Mat4<T>(affine), in, out);
+    }
+    template <typename T>
+    void transformAffine(const Affine3<T>& affine, const Vec4Batch<T>& in, Vec4Batch<T>& out, ThreadPool& pool) {
+        transformAffine<Convention::RowVectors>(Mat4<T>(affine), in, out, pool);
+    }
+}
+
+#endif
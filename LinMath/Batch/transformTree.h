@@ -0,0 +1,213 @@
+#ifndef TRANSFORMTREE_H
+#define TRANSFORMTREE_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../Matrix/mat4.h"
+#include "../Parallel/threadpool.h"
+#include "../Parallel/workstealing.h"
+#include "../Simd/dispatch.h"
+#include "../Simd/mat4.h"
+#include "../Simd/transform.h"
+
+namespace linmath {
+
+    // Hierarchy of local Mat4 where world of a root is its local, and for row vectors as the Mat4 builders and
+    // vec4x4mat take them world(i) = local(i) * world(parent(i)), so a child's translation turns with its parent
+    // A tree built with Convention::ColumnVectors composes world(i) = world(parent(i)) * local(i) for mat4x4vec instead
+    // Nodes are stored parent first, a node can only be added below a node that already exists
+    // Changing a local marks the node in a dirty bitset and update() recomputes only the dirty subtrees
+    // in index order, the pool version runs the dirty subtrees side by side, each one in index order as well
+    template <typename T>
+    class TransformTree {
+
+        protected:
+        std::vector<size_t> parents;
+        std::vector<Mat4<T>> locals;
+        std::vector<Mat4<T>> worlds;
+        std::vector<uint64_t> dirty;
+        Convention order;
+
+        // Highest index in the subtree of every node, rebuilt after nodes are added, so the subtree of i
+        // lies in the index range from i to last[i] with nodes of other subtrees between its own
+        std::vector<size_t> last;
+        // Dirty root every dirty node is recomputed under, set by spread()
+        std::vector<size_t> owners;
+        bool linked = true;
+
+        void mark(size_t i) {
+            dirty[i/64] |= uint64_t(1) << (i%64);
+        }
+        bool marked(size_t i)const {
+            return dirty[i/64] >> (i%64) & 1;
+        }
+
+        void link() {
+            // Children come after their parent, so one backwards pass carries the highest index up
+            size_t n = parents.size();
+            last.resize(n);
+            for (size_t i=0; i<n; i++)
+                last[i] = i;
+            for (size_t i=n; i-- > 0;)
+                if (parents[i] != root && last[i] > last[parents[i]])
+                    last[parents[i]] = last[i];
+            owners.resize(n);
+            linked = true;
+        }
+
+        void compute(size_t i) {
+            size_t parent = parents[i];
+            if (parent == root)
+                worlds[i] = locals[i];
+            else {
+                const T* a = order == Convention::RowVectors ? &locals[i][0] : &worlds[parent][0];
+                const T* b = order == Convention::RowVectors ? &worlds[parent][0] : &locals[i][0];
+                if constexpr (simd::vectorized<T>)
+                    simd::mat4Dot(a, b, &worlds[i][0]);
+                else
+                    simd::scalar::mat4Dot(a, b, &worlds[i][0]);
+            }
+        }
+
+        // Index of the first dirty node, nothing before it needs recomputing
+        size_t firstDirty()const {
+            for (size_t word=0; word<dirty.size(); word++)
+                if (dirty[word])
+                    return 64*word + std::countr_zero(dirty[word]);
+            return parents.size();
+        }
+
+        // Marks every node below a dirty node in one pass in index order, since a parent always comes first,
+        // and records the dirty root above every dirty node
+        // Returns the dirty nodes without a dirty parent in index order, their subtrees are disjoint and cover all marked nodes
+        std::vector<size_t> spread() {
+            std::vector<size_t> roots;
+            for (size_t i=firstDirty(); i<parents.size(); i++) {
+                size_t parent = parents[i];
+                if (parent != root && marked(parent)) {
+                    mark(i);
+                    owners[i] = owners[parent];
+                }
+                else if (marked(i)) {
+                    owners[i] = i;
+                    roots.push_back(i);
+                }
+            }
+            return roots;
+        }
+
+        // Recomputes the subtree of a dirty root in index order, as the serial pass does, skipping the nodes
+        // of other subtrees in its range, which only reads the bitset and the owners while other tasks run
+        void propagate(size_t node) {
+            for (size_t i=node; i<=last[node]; i++)
+                if (marked(i) && owners[i] == node)
+                    compute(i);
+        }
+
+        public:
+        static constexpr size_t root = size_t(-1);
+
+        // Constructors
+        explicit TransformTree(Convention order = Convention::RowVectors) : order(order) {}
+
+        // Building, a new node starts dirty
+        size_t add(const Mat4<T>& local) {
+            return add(root, local);
+        }
+        size_t add(size_t parent, const Mat4<T>& local) {
+            size_t i = parents.size();
+            parents.push_back(parent);
+            locals.push_back(local);
+            worlds.push_back(local);
+            if (dirty.size() < i/64 + 1)
+                dirty.push_back(0);
+            mark(i);
+            linked = false;
+            return i;
+        }
+        void reserve(size_t size) {
+            parents.reserve(size);
+            locals.reserve(size);
+            worlds.reserve(size);
+            dirty.reserve((size + 63)/64);
+        }
+        void clear() {
+            parents.clear();
+            locals.clear();
+            worlds.clear();
+            dirty.clear();
+            linked = false;
+        }
+
+        // Access
+        size_t size()const {
+            return parents.size();
+        }
+        size_t parent(size_t i)const {
+            return parents[i];
+        }
+        const Mat4<T>& local(size_t i)const {
+            return locals[i];
+        }
+        const Mat4<T>& world(size_t i)const {
+            return worlds[i];
+        }
+        Convention convention()const {
+            return order;
+        }
+        bool isDirty(size_t i)const {
+            return marked(i);
+        }
+        void setLocal(size_t i, const Mat4<T>& local) {
+            locals[i] = local;
+            mark(i);
+        }
+
+        // Recomputes the world matricies of the dirty subtrees and clears the dirty bits
+        // Serially a single pass in index order does it, which walks the matricies in memory order
+        void update() {
+            for (size_t i=firstDirty(); i<parents.size(); i++) {
+                size_t parent = parents[i];
+                if (marked(i) || (parent != root && marked(parent))) {
+                    mark(i);
+                    compute(i);
+                }
+            }
+            dirty.assign(dirty.size(), 0);
+        }
+
+        // Same, with the dirty subtrees spread over the pool by work stealing, dirty roots next to each other
+        // are taken together until their ranges cover grain nodes, a pool of one thread runs the serial pass
+        void update(ThreadPool& pool, size_t grain = 1024) {
+            if (pool.size() == 1) {
+                update();
+                return;
+            }
+            if (!linked)
+                link();
+            std::vector<size_t> roots = spread();
+
+            // Task t takes the roots from starts[t] to starts[t + 1] - 1
+            std::vector<size_t> starts, tasks;
+            for (size_t r=0, covered=grain; r<roots.size(); r++) {
+                if (covered >= grain) {
+                    tasks.push_back(starts.size());
+                    starts.push_back(r);
+                    covered = 0;
+                }
+                covered += last[roots[r]] - roots[r] + 1;
+            }
+            starts.push_back(roots.size());
+            WorkStealing::run(pool, tasks.data(), tasks.size(), [&](size_t task, WorkStealing::Worker&) {
+                for (size_t r=starts[task]; r<starts[task + 1]; r++)
+                    propagate(roots[r]);
+            });
+            dirty.assign(dirty.size(), 0);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,355 @@
+#ifndef VEC4BATCH_H
+#define VEC4BATCH_H
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "../Vector/vec4.h"
+#include "../Simd/aligned.h"
+#include "../Simd/batch.h"
+
+namespace linmath {
+
+    // Many Vec4 stored as structure of arrays, every operation runs over the whole batch
+    // The x, y, z and w arrays are cache line aligned and stride() values apart in one allocation
+    template <typename T>
+    class Vec4Batch {
+
+        protected:
+        size_t n = 0;
+        size_t capacity = 0;
+        T* values = nullptr;
+
+        public:
+
+        // Constructors
+        Vec4Batch() {}
+        Vec4Batch(size_t size) : Vec4Batch(size, Vec4<T>()) {}
+        Vec4Batch(size_t size, const Vec4<T>& vec) {
+            resize(size);
+            for (size_t i=0; i<n; i++) {
+                x()[i] = vec.x;
+                y()[i] = vec.y;
+                z()[i] = vec.z;
+                w()[i] = vec.w;
+            }
+        }
+        Vec4Batch(const Vec4<T>* vecs, size_t size) {
+            load(vecs, size);
+        }
+        Vec4Batch(const std::vector<Vec4<T>>& vecs) {
+            load(vecs.data(), vecs.size());
+        }
+
+        // Copy and move
+        Vec4Batch(const Vec4Batch<T>& batch) {
+            *this = batch;
+        }
+        Vec4Batch(Vec4Batch<T>&& batch) noexcept {
+            *this = std::move(batch);
+        }
+        Vec4Batch<T>& operator=(const Vec4Batch<T>& batch) {
+            if (this != &batch) {
+                resize(batch.n);
+                for (size_t i=0; i<n; i++) {
+                    x()[i] = batch.x()[i];
+                    y()[i] = batch.y()[i];
+                    z()[i] = batch.z()[i];
+                    w()[i] = batch.w()[i];
+                }
+            }
+            return *this;
+        }
+        Vec4Batch<T>& operator=(Vec4Batch<T>&& batch) noexcept {
+            std::swap(n, batch.n);
+            std::swap(capacity, batch.capacity);
+            std::swap(values, batch.values);
+            return *this;
+        }
+        ~Vec4Batch() {
+            if (values)
+                simd::alignedFree(values);
+        }
+
+
+        // Size and storage
+        size_t size()const {
+            return n;
+        }
+        size_t stride()const {
+            return capacity;
+        }
+        void reserve(size_t size) {
+            if (size <= capacity)
+                return;
+            size_t lanes = simd::cacheLine / sizeof(T) ? simd::cacheLine / sizeof(T) : 1;
+            size_t grown = (size + lanes - 1) / lanes * lanes;
+            T* grownValues = simd::alignedAlloc<T>(4*grown);
+            for (size_t c=0; c<4; c++)
+                for (size_t i=0; i<n; i++)
+                    grownValues[c*grown + i] = values[c*capacity + i];
+            if (values)
+                simd::alignedFree(values);
+            values = grownValues;
+            capacity = grown;
+        }
+        void resize(size_t size) {
+            reserve(size);
+            n = size;
+        }
+        void push(const Vec4<T>& vec) {
+            if (n == capacity)
+                reserve(n ? 2*n : 16);
+            set(n++, vec);
+        }
+        void clear() {
+            n = 0;
+        }
+
+        // Component arrays
+        T* x() {
+            return values;
+        }
+        T* y() {
+            return values + capacity;
+        }
+        T* z() {
+            return values + 2*capacity;
+        }
+        T* w() {
+            return values + 3*capacity;
+        }
+        const T* x()const {
+            return values;
+        }
+        const T* y()const {
+            return values + capacity;
+        }
+        const T* z()const {
+            return values + 2*capacity;
+        }
+        const T* w()const {
+            return values + 3*capacity;
+        }
+
+        // Conversion with Vec4
+        Vec4<T> get(size_t i)const {
+            return Vec4<T>(x()[i], y()[i], z()[i], w()[i]);
+        }
+        void set(size_t i, const Vec4<T>& vec) {
+            x()[i] = vec.x;
+            y()[i] = vec.y;
+            z()[i] = vec.z;
+            w()[i] = vec.w;
+        }
+        void load(const Vec4<T>* vecs, size_t size) {
+            resize(size);
+            T* xs = x();
+            T* ys = y();
+            T* zs = z();
+            T* ws = w();
+            for (size_t i=0; i<n; i++) {
+                xs[i] = vecs[i].x;
+                ys[i] = vecs[i].y;
+                zs[i] = vecs[i].z;
+                ws[i] = vecs[i].w;
+            }
+        }
+        void store(Vec4<T>* vecs)const {
+            const T* xs = x();
+            const T* ys = y();
+            const T* zs = z();
+            const T* ws = w();
+            for (size_t i=0; i<n; i++) {
+                vecs[i].x = xs[i];
+                vecs[i].y = ys[i];
+                vecs[i].z = zs[i];
+                vecs[i].w = ws[i];
+            }
+        }
+        std::vector<Vec4<T>> vectors()const {
+            std::vector<Vec4<T>> vecs(n);
+            store(vecs.data());
+            return vecs;
+        }
+
+        // Squared length, the dot product of every vector with itself
+        std::vector<T> lengthSquared()const {
+            std::vector<T> sq(n);
+            simd::dot<T, 4>(n, values, capacity, values, capacity, sq.data());
+            return sq;
+        }
+
+        // Directional normalization, Precision::Fast uses the rsqrt estimate as the single vectors do
+        template <Precision p = Precision::Exact>
+        std::vector<T> length()const {
+            std::vector<T> len(n);
+            simd::length<T, 4, p>(n, values, capacity, len.data());
+            return len;
+        }
+        template <Precision p = Precision::Exact>
+        void normalize() {
+            simd::normalize<T, 4, p>(n, values, capacity, values, capacity);
+        }
+        template <Precision p = Precision::Exact>
+        Vec4Batch<T> normalized()const {
+            Vec4Batch<T> batch = Vec4Batch<T>();
+            batch.resize(n);
+            simd::normalize<T, 4, p>(n, values, capacity, batch.values, batch.capacity);
+            return batch;
+        }
+
+        // Dot product
+        std::vector<T> dot(const Vec4Batch<T>& batch)const {
+            std::vector<T> dot(n);
+            simd::dot<T, 4>(n, values, capacity, batch.values, batch.capacity, dot.data());
+            return dot;
+        }
+
+        // Negation
+        Vec4Batch<T> operator-()const {
+            Vec4Batch<T> out = Vec4Batch<T>();
+            out.resize(n);
+            for (size_t c=0; c<4; c++)
+                simd::negate(n, values + c*capacity, out.values + c*out.capacity);
+            return out;
+        }
+
+        // Operations with scalars
+        Vec4Batch<T> operator+(const T t)const {
+            Vec4Batch<T> out = Vec4Batch<T>();
+            out.resize(n);
+            for (size_t c=0; c<4; c++)
+                simd::addScalar(n, values + c*capacity, t, out.values + c*out.capacity);
+            return out;
+        }
+        Vec4Batch<T> operator-(const T t)const {
+            Vec4Batch<T> out = Vec4Batch<T>();
+            out.resize(n);
+            for (size_t c=0; c<4; c++)
+                simd::subScalar(n, values + c*capacity, t, out.values + c*out.capacity);
+            return out;
+        }
+        Vec4Batch<T> operator*(const T t)const {
+            Vec4Batch<T> out = Vec4Batch<T>();
+            out.resize(n);
+            for (size_t c=0; c<4; c++)
+                simd::mulScalar(n, values + c*capacity, t, out.values + c*out.capacity);
+            return out;
+        }
+        Vec4Batch<T> operator/(const T t)const {
+            Vec4Batch<T> out = Vec4Batch<T>();
+            out.resize(n);
+            for (size_t c=0; c<4; c++)
+                simd::divScalar(n, values + c*capacity, t, out.values + c*out.capacity);
+            return out;
+        }
+        void operator+=(const T t) {
+            for (size_t c=0; c<4; c++)
+                simd::addScalar(n, values + c*capacity, t, values + c*capacity);
+        }
+        void operator-=(const T t) {
+            for (size_t c=0; c<4; c++)
+                simd::subScalar(n, values + c*capacity, t, values + c*capacity);
+        }
+        void operator*=(const T t) {
+            for (size_t c=0; c<4; c++)
+                simd::mulScalar(n, values + c*capacity, t, values + c*capacity);
+        }
+        void operator/=(const T t) {
+            for (size_t c=0; c<4; c++)
+                simd::divScalar(n, values + c*capacity, t, values + c*capacity);
+        }
+
+        // Operations with batches of the same size
+        Vec4Batch<T> operator+(const Vec4Batch<T>& batch)const {
+            Vec4Batch<T> out = Vec4Batch<T>();
+            out.resize(n);
+            for (size_t c=0; c<4; c++)
+                simd::add(n, values + c*capacity, batch.values + c*batch.capacity, out.values + c*out.capacity);
+            return out;
+        }
+        Vec4Batch<T> operator-(const Vec4Batch<T>& batch)const {
+            Vec4Batch<T> out = Vec4Batch<T>();
+            out.resize(n);
+            for (size_t c=0; c<4; c++)
+                simd::sub(n, values + c*capacity, batch.values + c*batch.capacity, out.values + c*out.capacity);
+            return out;
+        }
+        Vec4Batch<T> operator*(const Vec4Batch<T>& batch)const {
+            Vec4Batch<T> out = Vec4Batch<T>();
+            out.resize(n);
+            for (size_t c=0; c<4; c++)
+                simd::mul(n, values + c*capacity, batch.values + c*batch.capacity, out.values + c*out.capacity);
+            return out;
+        }
+        Vec4Batch<T> operator/(const Vec4Batch<T>& batch)const {
+            Vec4Batch<T> out = Vec4Batch<T>();
+            out.resize(n);
+            for (size_t c=0; c<4; c++)
+                simd::div(n, values + c*capacity, batch.values + c*batch.capacity, out.values + c*out.capacity);
+            return out;
+        }
+        void operator+=(const Vec4Batch<T>& batch) {
+            for (size_t c=0; c<4; c++)
+                simd::add(n, values + c*capacity, batch.values + c*batch.capacity, values + c*capacity);
+        }
+        void operator-=(const Vec4Batch<T>& batch) {
+            for (size_t c=0; c<4; c++)
+                simd::sub(n, values + c*capacity, batch.values + c*batch.capacity, values + c*capacity);
+        }
+        void operator*=(const Vec4Batch<T>& batch) {
+            for (size_t c=0; c<4; c++)
+                simd::mul(n, values + c*capacity, batch.values + c*batch.capacity, values + c*capacity);
+        }
+        void operator/=(const Vec4Batch<T>& batch) {
+            for (size_t c=0; c<4; c++)
+                simd::div(n, values + c*capacity, batch.values + c*batch.capacity, values + c*capacity);
+        }
+
+        // Comparison between batches
+        bool operator==(const Vec4Batch<T>& batch)const {
+            if (n != batch.n) return false;
+            for (size_t c=0; c<4; c++)
+                for (size_t i=0; i<n; i++)
+                    if (values[c*capacity + i] != batch.values[c*batch.capacity + i]) return false;
+            return true;
+        }
+        bool operator!=(const Vec4Batch<T>& batch)const {
+            return !(*this == batch);
+        }
+
+        // Array functionality, by value since the components are not adjacent
+        Vec4<T> operator[](size_t i)const {
+            return get(i);
+        }
+
+        // Input and output
+        friend std::ostream& operator<<(std::ostream& output, const Vec4Batch<T>& batch) {
+            for (size_t i=0; i<batch.n; i++)
+                output << batch.get(i) << (i + 1 < batch.n ? "\n" : "");
+            return output;
+        }
+        friend std::istream& operator>>(std::istream& input, Vec4Batch<T>& batch) {
+            Vec4<T> vec;
+            for (size_t i=0; i<batch.n; i++) {
+                input >> vec;
+                batch.set(i, vec);
+            }
+            return input;
+        }
+    };
+
+    // Overload functions
+    template <typename T, typename K>
+    Vec4Batch<T> operator+(const K k, const Vec4Batch<T>& batch) {
+        return batch + T(k);
+    }
+    template <typename T, typename K>
+    Vec4Batch<T> operator*(const K k, const Vec4Batch<T>& batch) {
+        return batch * T(k);
+    }
+}
+
+#endif
@@ -0,0 +1,265 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "../Simd/simd.h"
+
+namespace linmath {
+
+    // Base of everything that can appear in an elementwise expression, VecN and MatNM and the lazy nodes below
+    // Operators on expressions only build nodes, the whole tree is evaluated in a single loop when it is
+    // assigned to a VecN or MatNM, so a*s + b*t - c makes one pass and no temporaries
+    // Nodes hold the VecN and MatNM they read by reference, so they must not outlive the statement they are built in
+    // pack<Q>(i) evaluates the elements from i on as one pack Q of Simd/pack.h, for the vectorized VecN loops
+    template <typename E>
+    class Expression {
+
+        public:
+        const E& self()const {
+            return static_cast<const E&>(*this);
+        }
+
+        // Forces evaluation into the vector or matrix type of the expression
+        auto eval()const {
+            return typename E::Shape(self());
+        }
+    };
+
+    template <typename E>
+    concept IsExpression = std::is_base_of_v<Expression<E>, E>;
+
+    namespace expr {
+
+        // Marks the lazy nodes, which are held by value inside other nodes
+        class Node {};
+
+        template <typename E>
+        using Operand = std::conditional_t<std::is_base_of_v<Node, E>, const E, const E&>;
+
+        // Result shape of two operands, a scalar takes the shape of the other side
+        template <typename L, typename R>
+        using Shape = std::conditional_t<std::is_void_v<typename L::Shape>, typename R::Shape, typename L::Shape>;
+
+        // Elementwise operations
+        struct Add {
+            template <typename T>
+            static T apply(T a, T b) {
+                return a + b;
+            }
+        };
+        struct Sub {
+            template <typename T>
+            static T apply(T a, T b) {
+                return a - b;
+            }
+        };
+        struct Mul {
+            template <typename T>
+            static T apply(T a, T b) {
+                return a * b;
+            }
+        };
+        struct Div {
+            template <typename T>
+            static T apply(T a, T b) {
+                return a / b;
+            }
+        };
+        struct Mod {
+            template <typename T>
+            static T apply(T a, T b) {
+                return a % b;
+            }
+        };
+        struct Negate {
+            template <typename T>
+            static T apply(T a) {
+                return -a;
+            }
+        };
+
+        // a*b + c, fused when the target has fused multiply-adds
+        template <typename T>
+        inline T fma(T a, T b, T c) {
+            if constexpr (LINMATH_FMA && std::is_floating_point_v<T>)
+                return std::fma(a, b, c);
+            else
+                return a*b + c;
+        }
+
+        template <typename Op, typename L, typename R>
+        class Binary;
+
+        // Products are contracted with the sum or difference above them
+        template <typename E>
+        constexpr bool isProduct = false;
+        template <typename L, typename R>
+        constexpr bool isProduct<Binary<Mul, L, R>> = true;
+
+        // Scalar broadcast to every element
+        template <typename T>
+        class Scalar : public Expression<Scalar<T>>, public Node {
+
+            T t;
+
+            public:
+            using Value = T;
+            using Shape = void;
+
+            Scalar(T t) : t(t) {}
+            T operator[](size_t)const {
+                return t;
+            }
+            template <typename Q>
+            Q pack(size_t)const {
+                return Q::set(t);
+            }
+        };
+
+        template <typename Op, typename E>
+        class Unary : public Expression<Unary<Op, E>>, public Node {
+
+            Operand<E> e;
+
+            public:
+            using Value = typename E::Value;
+            using Shape = typename E::Shape;
+
+            Unary(const E& e) : e(e) {}
+            Value operator[](size_t i)const {
+                return Op::template apply<Value>(e[i]);
+            }
+            template <typename Q>
+            Q pack(size_t i)const {
+                return Op::apply(e.template pack<Q>(i));
+            }
+        };
+
+        template <typename Op, typename L, typename R>
+        class Binary : public Expression<Binary<Op, L, R>>, public Node {
+
+            static_assert(std::is_void_v<typename L::Shape> || std::is_void_v<typename R::Shape> || std::is_same_v<typename L::Shape, typename R::Shape>,
+                "elementwise operands must have the same shape");
+
+            public:
+            using Value = typename L::Value;
+            using Shape = expr::Shape<L, R>;
+
+            Operand<L> l;
+            Operand<R> r;
+
+            Binary(const L& l, const R& r) : l(l), r(r) {}
+            Value operator[](size_t i)const {
+                if constexpr (std::is_same_v<Op, Add> && isProduct<L>)
+                    return fma<Value>(l.l[i], l.r[i], r[i]);
+                else if constexpr (std::is_same_v<Op, Add> && isProduct<R>)
+                    return fma<Value>(r.l[i], r.r[i], l[i]);
+                else if constexpr (std::is_same_v<Op, Sub> && isProduct<L>)
+                    return fma<Value>(l.l[i], l.r[i], -r[i]);
+                else if constexpr (std::is_same_v<Op, Sub> && isProduct<R>)
+                    return fma<Value>(-r.l[i], r.r[i], l[i]);
+                else
+                    return Op::template apply<Value>(l[i], r[i]);
+            }
+            template <typename Q>
+            Q pack(size_t i)const {
+                if constexpr (std::is_same_v<Op, Add> && isProduct<L>)
+                    return fma(l.l.template pack<Q>(i), l.r.template pack<Q>(i), r.template pack<Q>(i));
+                else if constexpr (std::is_same_v<Op, Add> && isProduct<R>)
+                    return fma(r.l.template pack<Q>(i), r.r.template pack<Q>(i), l.template pack<Q>(i));
+                else if constexpr (std::is_same_v<Op, Sub> && isProduct<L>)
+                    return fma(l.l.template pack<Q>(i), l.r.template pack<Q>(i), -r.template pack<Q>(i));
+                else if constexpr (std::is_same_v<Op, Sub> && isProduct<R>)
+                    return fma(-r.l.template pack<Q>(i), r.r.template pack<Q>(i), l.template pack<Q>(i));
+                else
+                    return Op::apply(l.template pack<Q>(i), r.template pack<Q>(i));
+            }
+        };
+
+        template <typename Op, typename L, typename R>
+        auto binary(const L& l, const R& r) {
+            return Binary<Op, L, R>(l, r);
+        }
+        template <typename Op, typename L, typename K>
+        auto binaryScalar(const L& l, K k) {
+            using T = typename L::Value;
+            return Binary<Op, L, Scalar<T>>(l, Scalar<T>(T(k)));
+        }
+        template <typename Op, typename K, typename R>
+        auto scalarBinary(K k, const R& r) {
+            using T = typename R::Value;
+            return Binary<Op, Scalar<T>, R>(Scalar<T>(T(k)), r);
+        }
+    }
+
+    // Negation
+    template <IsExpression E>
+    auto operator-(const E& e) {
+        return expr::Unary<expr::Negate, E>(e);
+    }
+
+    // Operations between expressions
+    template <IsExpression L, IsExpression R>
+    auto operator+(const L& l, const R& r) {
+        return expr::binary<expr::Add>(l, r);
+    }
+    template <IsExpression L, IsExpression R>
+    auto operator-(const L& l, const R& r) {
+        return expr::binary<expr::Sub>(l, r);
+    }
+    template <IsExpression L, IsExpression R>
+    auto operator*(const L& l, const R& r) {
+        return expr::binary<expr::Mul>(l, r);
+    }
+    template <IsExpression L, IsExpression R>
+    auto operator/(const L& l, const R& r) {
+        return expr::binary<expr::Div>(l, r);
+    }
+
+    // Operations with scalars on either side
+    template <IsExpression L, typename K> requires std::is_arithmetic_v<K>
+    auto operator+(const L& l, const K k) {
+        return expr::binaryScalar<expr::Add>(l, k);
+    }
+    template <IsExpression L, typename K> requires std::is_arithmetic_v<K>
+    auto operator-(const L& l, const K k) {
+        return expr::binaryScalar<expr::Sub>(l, k);
+    }
+    template <IsExpression L, typename K> requires std::is_arithmetic_v<K>
+    auto operator*(const L& l, const K k) {
+        return expr::binaryScalar<expr::Mul>(l, k);
+    }
+    template <IsExpression L, typename K> requires std::is_arithmetic_v<K>
+    auto operator/(const L& l, const K k) {
+        return expr::binaryScalar<expr::Div>(l, k);
+    }
+    template <IsExpression L, typename K> requires std::is_arithmetic_v<K>
+    auto operator%(const L& l, const K k) {
+        return expr::binaryScalar<expr::Mod>(l, k);
+    }
+    template <typename K, IsExpression R> requires std::is_arithmetic_v<K>
+    auto operator+(const K k, const R& r) {
+        return expr::scalarBinary<expr::Add>(k, r);
+    }
+    template <typename K, IsExpression R> requires std::is_arithmetic_v<K>
+    auto operator-(const K k, const R& r) {
+        return expr::scalarBinary<expr::Sub>(k, r);
+    }
+    template <typename K, IsExpression R> requires std::is_arithmetic_v<K>
+    auto operator*(const K k, const R& r) {
+        return expr::scalarBinary<expr::Mul>(k, r);
+    }
+    template <typename K, IsExpression R> requires std::is_arithmetic_v<K>
+    auto operator/(const K k, const R& r) {
+        return expr::scalarBinary<expr::Div>(k, r);
+    }
+    template <typename K, IsExpression R> requires std::is_arithmetic_v<K>
+    auto operator%(const K k, const R& r) {
+        return expr::scalarBinary<expr::Mod>(k, r);
+    }
+}
+
+#endif
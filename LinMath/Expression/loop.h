@@ -0,0 +1,120 @@
+#ifndef LOOP_H
+#define LOOP_H
+
+#include <cstddef>
+#include <utility>
+
+#include "../Simd/dispatch.h"
+#include "../Simd/pack.h"
+
+namespace linmath {
+
+    // How the elementwise loops of VecN run
+    // Unrolled expands every index at compile time through an index_sequence, like the hand written Vec2 to Vec4
+    // Vectorized runs packs of simd::native, the widest tier of the consumer's flags, and finishes the tail with narrower ones
+    // Without a vector tier in the flags the packs are single values, the reductions still keep independent accumulators
+    // Plain is an ordinary runtime loop
+    enum class Loop { Plain, Unrolled, Vectorized };
+
+    // Loop policy of VecN<T, N>, up to 16 values are unrolled and longer float and double vectors are vectorized
+    // Specialize it to move the switch point for a type or a size, Vectorized needs float or double
+    template <typename T, size_t N>
+    struct LoopPolicy {
+        static constexpr Loop loop = N <= 16 ? Loop::Unrolled : (simd::vectorized<T> ? Loop::Vectorized : Loop::Plain);
+    };
+
+    namespace loop {
+
+        template <typename T, size_t N>
+        constexpr Loop policy = LoopPolicy<T, N>::loop;
+
+        // Full packs Q from Begin on, then the tail with narrower packs, all bounds known at compile time
+        template <typename Q, size_t Begin, size_t N, typename F>
+        inline void packs(F f) {
+            constexpr size_t end = Begin + (N - Begin) / Q::width * Q::width;
+            for (size_t i=Begin; i<end; i+=Q::width)
+                f(Q(), i);
+            if constexpr (end < N)
+                packs<typename Q::Half, end, N>(f);
+        }
+
+        // Calls f(i) for every index, for operations that have no pack form
+        template <typename T, size_t N, typename F>
+        inline void each(F f) {
+            if constexpr (policy<T, N> == Loop::Unrolled)
+                [&]<size_t... I>(std::index_sequence<I...>) {
+                    (f(I), ...);
+                }(std::make_index_sequence<N>());
+            else
+                for (size_t i=0; i<N; i++)
+                    f(i);
+        }
+
+        // True if f(i) holds for every index, stops at the first that does not
+        template <typename T, size_t N, typename F>
+        inline bool all(F f) {
+            if constexpr (policy<T, N> == Loop::Unrolled)
+                return [&]<size_t... I>(std::index_sequence<I...>) {
+                    return (f(I) && ...);
+                }(std::make_index_sequence<N>());
+            else {
+                for (size_t i=0; i<N; i++)
+                    if (!f(i))
+                        return false;
+                return true;
+            }
+        }
+
+        // Calls f(Q(), i) for every pack Q starting at index i, single values are simd::scalar::Pack
+        template <typename T, size_t N, typename F>
+        inline void sweep(F f) {
+            if constexpr (policy<T, N> == Loop::Vectorized) {
+                static_assert(simd::vectorized<T>, "only float and double vectors can be vectorized");
+                packs<simd::native::Pack<T>, 0, N>(f);
+            }
+            else
+                each<T, N>([&](size_t i) {
+                    f(simd::scalar::Pack<T>(), i);
+                });
+        }
+
+        // Folds f(acc, i) over every index, f returns the pack acc with the values at i added to it
+        // Vectorized keeps four accumulators to hide the latency of the adds and sums their lanes at the end
+        template <typename T, size_t N, typename F>
+        inline T reduce(F f) {
+            using S = simd::scalar::Pack<T>;
+            S total = S::zero();
+
+            if constexpr (policy<T, N> == Loop::Vectorized) {
+                static_assert(simd::vectorized<T>, "only float and double vectors can be vectorized");
+                using Q = simd::native::Pack<T>;
+                constexpr size_t W = Q::width;
+                constexpr size_t quads = N / (4*W) * 4*W;
+                constexpr size_t full = N / W * W;
+
+                Q acc[4] = {Q::zero(), Q::zero(), Q::zero(), Q::zero()};
+                for (size_t i=0; i<quads; i+=4*W)
+                    for (size_t k=0; k<4; k++)
+                        acc[k] = f(acc[k], i + k*W);
+                if constexpr (quads < full)
+                    for (size_t i=quads; i<full; i+=W)
+                        acc[0] = f(acc[0], i);
+
+                T lanes[W];
+                ((acc[0] + acc[1]) + (acc[2] + acc[3])).store(lanes);
+                for (size_t k=0; k<W; k++)
+                    total.v += lanes[k];
+                if constexpr (full < N)
+                    for (size_t i=full; i<N; i++)
+                        total = f(total, i);
+            }
+            else
+                each<T, N>([&](size_t i) {
+                    total = f(total, i);
+                });
+            return total.v;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef MATH_H
+#define MATH_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "../Simd/simd.h"
+
+namespace linmath {
+
+    // Precision of length and normalize, opted into per call as in vec.normalize<Precision::Fast>()
+    // Fast replaces the square root and the divisions with a reciprocal square root estimate and one Newton step
+    // For float that is within 2^-21 relative of the exact result, about 4 ulp, for double it is the exact
+    // reciprocal and only saves the divisions, in constant expressions the reciprocal is always the exact one
+    enum class Precision {
+        Exact,
+        Fast
+    };
+
+    namespace math {
+
+        // Square root, sine and cosine usable in constant expressions, so matricies built from them fold at compile time
+        // At run time they call the std ones, in a constant expression they are evaluated by series to within a few ulp
+        // Integers are promoted to double like the std ones do
+        template <typename T>
+        using Real = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+        template <typename T>
+        constexpr T pi = T(3.141592653589793238462643383279502884L);
+
+        namespace detail {
+
+            template <typename T>
+            constexpr bool finite(T t) {
+                return t == t && t - t == t - t;
+            }
+
+            // Newton from above the root decreases monotonically, so it stops at the first step that does not
+            // It runs in long double, where there is one, so the result rounds to the nearest T
+            template <typename T>
+            constexpr T sqrt(T t) {
+                if (!(t > 0) || !finite(t))
+                    return t == 0 || t > 0 ? t : std::numeric_limits<T>::quiet_NaN();
+                long double x = t;
+                long double r = x > 1 ? x : 1;
+                while (true) {
+                    long double next = (r + x/r) / 2;
+                    if (!(next < r))
+                        return T(r);
+                    r = next;
+                }
+            }
+
+            // Taylor series around 0 after reducing to [-pi, pi], cos when odd is 0 and sin when it is 1
+            template <typename T>
+            constexpr T series(T t, int odd) {
+                if (!finite(t))
+                    return std::numeric_limits<T>::quiet_NaN();
+                long double x = t;
+                long double turns = x / (2*pi<long double>);
+                long long k = static_cast<long long>(turns + (turns < 0 ? -0.5L : 0.5L));
+                x -= k * 2*pi<long double>;
+
+                long double term = odd ? x : 1;
+                long double sum = term;
+                for (int n=odd + 1; term != 0 && n < 64; n+=2) {
+                    term *= -x*x / (n*(n + 1));
+                    sum += term;
+                }
+                return T(sum);
+            }
+        }
+
+        template <typename T>
+        constexpr Real<T> sqrt(T t) {
+            if (std::is_constant_evaluated())
+                return detail::sqrt(Real<T>(t));
+            return std::sqrt(Real<T>(t));
+        }
+        // 1/sqrt(t), rsqrtss and one Newton step for Fast floats on x86
+        template <Precision p = Precision::Exact, typename T>
+        constexpr Real<T> rsqrt(T t) {
+        #if LINMATH_SSE2
+            if constexpr (p == Precision::Fast && std::is_same_v<T, float>)
+                if (!std::is_constant_evaluated()) {
+                    float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(t)));
+                    return 0.5f*y * (3.f - t*y*y);
+                }
+        #endif
+            return Real<T>(1) / sqrt(t);
+        }
+
+        template <typename T>
+        constexpr Real<T> sin(T t) {
+            if (std::is_constant_evaluated())
+                return detail::series(Real<T>(t), 1);
+            return std::sin(Real<T>(t));
+        }
+        template <typename T>
+        constexpr Real<T> cos(T t) {
+            if (std::is_constant_evaluated())
+                return detail::series(Real<T>(t), 0);
+            return std::cos(Real<T>(t));
+        }
+
+        // Sine and cosine of one angle, for builders that need both
+        // At run time the two std calls on the same argument are folded into a single sincos by gcc and clang
+        template <typename T>
+        struct SinCos {
+            T sin;
+            T cos;
+        };
+        template <typename T>
+        constexpr SinCos<Real<T>> sincos(T t) {
+            if (std::is_constant_evaluated())
+                return {detail::series(Real<T>(t), 1), detail::series(Real<T>(t), 0)};
+            return {std::sin(Real<T>(t)), std::cos(Real<T>(t))};
+        }
+
+        // Degrees to radians with pi/180 rounded once from long double
+        template <typename T>
+        constexpr Real<T> radians(T deg) {
+            return Real<T>(deg) * Real<T>(pi<long double> / 180);
+        }
+
+        // Argument reduction and polynomials of the batched sincos kernels, after Cephes sinf.c and sin.c
+        // x is reduced by the nearest multiple j of pi/2 split in five parts, the leading ones short enough that j times
+        // each and its subtraction are exact even next to a zero of sin or cos, then for z = r*r and |r| <= pi/4 the minimax polynomials lowest term first are
+        // sin r = r + r*z*(s[0] + z*s[1] + ...) and cos r = 1 - z/2 + z*z*(c[0] + z*c[1] + ...)
+        template <typename T>
+        struct SinCosSeries;
+
+        template <>
+        struct SinCosSeries<float> {
+            static constexpr float twoOverPi = 0.636619772367581343076f;
+            static constexpr std::array<float, 5> halfPi = {1.5703125f, 0.0004837512969970703f, 7.549533620476723e-08f, 2.5632829192545614e-12f, 6.123234262925839e-17f};
+            static constexpr std::array<float, 3> sin = {-1.6666654611e-1f, 8.3321608736e-3f, -1.9515295891e-4f};
+            static constexpr std::array<float, 3> cos = {4.166664568298827e-2f, -1.388731625493765e-3f, 2.443315711809948e-5f};
+        };
+        template <>
+        struct SinCosSeries<double> {
+            static constexpr double twoOverPi = 0.636619772367581343076;
+            static constexpr std::array<double, 5> halfPi = {1.570796251296997, 7.549789415861596e-08, 5.390302529957765e-15, 3.2820031633724233e-22, 3.7950107727212256e-29};
+            static constexpr std::array<double, 6> sin = {-1.66666666666666307295e-1, 8.33333333332211858878e-3, -1.98412698295895385996e-4,
+                                                          2.75573136213857245213e-6, -2.50507477628578072866e-8, 1.58962301576546568060e-10};
+            static constexpr std::array<double, 6> cos = {4.16666666666665929218e-2, -1.38888888888730564116e-3, 2.48015872888517045348e-5,
+                                                          -2.75573141792967388112e-7, 2.08757008419747316778e-9, -1.13585365213876817300e-11};
+        };
+
+        // Weights of slerp without trigonometry, after Eberly, "A Fast and Accurate Algorithm for Computing SLERP"
+        // sin(t*a)/sin(a) for x = cos(a) is t times the nested product 1 + b1*(1 + b2*(1 + ...)), bi = (u[i]*t*t - v[i])*(x - 1)
+        // with u[i] = 1/(i*(2i + 1)) and v[i] = i/(2i + 1), the last pair scaled by mu to make up for the cut off terms
+        // 16 terms keep float within 3e-8 and 40 keep double within 6e-16 for x and t in [0, 1]
+        template <typename T>
+        struct SlerpSeries {
+            static constexpr size_t terms = sizeof(T) <= sizeof(float) ? 16 : 40;
+            static constexpr long double mu = terms == 16 ? 1.91667479133959412L : 1.96359103704253584L;
+
+            static constexpr auto coefficients(bool isV) {
+                std::array<T, terms> c = {};
+                for (size_t i=1; i<=terms; i++) {
+                    long double m = i == terms ? mu : 1;
+                    c[i - 1] = T(isV ? m*i / (2*i + 1) : m / (i*(2*i + 1)));
+                }
+                return c;
+            }
+            static constexpr std::array<T, terms> u = coefficients(false);
+            static constexpr std::array<T, terms> v = coefficients(true);
+        };
+
+        template <typename T>
+        constexpr T slerpWeight(T x, T t) {
+            using S = SlerpSeries<T>;
+            T xm1 = x - 1;
+            T tt = t*t;
+            T c = 1;
+            for (size_t i=S::terms; i-- > 0;)
+                c = 1 + (S::u[i]*tt - S::v[i])*xm1*c;
+            return t*c;
+        }
+    }
+}
+
+#endif
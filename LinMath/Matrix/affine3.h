@@ -0,0 +1,255 @@
+#ifndef AFFINE3_H
+#define AFFINE3_H
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+#include "../Vector/vec3.h"
+#include "mat3.h"
+#include "mat4.h"
+#include "../Simd/affine3.h"
+
+namespace linmath {
+
+    // Mat4 whose last column is 0, 0, 0, 1, which is every matrix built from translation, rotation and scale
+    // Only the other 12 values are stored, row major: rows 0 to 2 are the linear part and row 3 the translation,
+    // so values[3*row + col] is mat[4*row + col] of the matching Mat4 and vectors multiply from the left
+    template <typename T>
+    class Affine3 {
+
+        protected:
+        T values[12];
+
+        public:
+
+        // Constructors
+        constexpr Affine3() {}
+        constexpr Affine3(T values[12]) {
+            for (uint8_t i=0; i<12; i++)
+                this->values[i] = values[i];
+        }
+        constexpr Affine3(const Mat3<T>& linear, const Vec3<T>& translation) {
+            for (uint8_t i=0; i<9; i++)
+                values[i] = linear[i];
+            values[9] = translation.x;
+            values[10] = translation.y;
+            values[11] = translation.z;
+        }
+
+        // Conversion with Mat4, the last column of mat is assumed to be 0, 0, 0, 1 and dropped
+        constexpr Affine3(const Mat4<T>& mat) {
+            for (uint8_t row=0; row<4; row++)
+                for (uint8_t col=0; col<3; col++)
+                    values[3*row + col] = mat[4*row + col];
+        }
+        constexpr operator Mat4<T>()const {
+            Mat4<T> mat = Mat4<T>();
+            for (uint8_t row=0; row<4; row++) {
+                for (uint8_t col=0; col<3; col++)
+                    mat[4*row + col] = values[3*row + col];
+                mat[4*row + 3] = row == 3 ? 1 : 0;
+            }
+            return mat;
+        }
+
+        // Parts
+        constexpr Mat3<T> linear()const {
+            Mat3<T> mat = Mat3<T>();
+            for (uint8_t i=0; i<9; i++)
+                mat[i] = values[i];
+            return mat;
+        }
+        constexpr Vec3<T> translation()const {
+            return Vec3<T>(values[9], values[10], values[11]);
+        }
+
+        // Matrix determinant, the one of the linear part
+        constexpr T det()const {
+            return determinant();
+        }
+        constexpr T determinant()const {
+            return  values[0]*( values[4]*values[8] - values[5]*values[7] )-
+                    values[1]*( values[3]*values[8] - values[5]*values[6] )+
+                    values[2]*( values[3]*values[7] - values[4]*values[6] );
+        }
+
+        // Matrix inverse, the linear part is inverted as a 3x3 and the translation becomes -t * inverse(linear)
+        constexpr void inverse() {
+            simd::scalar::affineInverse(values, values);
+        }
+        constexpr Affine3<T> inversed()const {
+            Affine3<T> mat = *this;
+            mat.inverse();
+            return mat;
+        }
+
+        // Inverse of a rotation with a translation, the linear part must be orthonormal so its inverse is its transpose
+        constexpr void inverseOrthonormal() {
+            simd::scalar::affineInverseOrthonormal(values, values);
+        }
+        constexpr Affine3<T> inversedOrthonormal()const {
+            Affine3<T> mat = *this;
+            mat.inverseOrthonormal();
+            return mat;
+        }
+
+        // Dot product, the same as the Mat4 product in 36 multiply-adds
+        constexpr Affine3<T> dot(const Affine3<T>& mat)const {
+            Affine3<T> dot = Affine3<T>();
+            simd::scalar::affineDot(values, mat.values, dot.values);
+            return dot;
+        }
+
+        // Transformation of row vectors, points get the translation and directions do not
+        constexpr Vec3<T> transformPoint(const Vec3<T>& vec)const {
+            return Vec3<T>( vec.x*values[0] + vec.y*values[3] + vec.z*values[6] + values[9],
+                            vec.x*values[1] + vec.y*values[4] + vec.z*values[7] + values[10],
+                            vec.x*values[2] + vec.y*values[5] + vec.z*values[8] + values[11]);
+        }
+        constexpr Vec3<T> transformDirection(const Vec3<T>& vec)const {
+            return Vec3<T>( vec.x*values[0] + vec.y*values[3] + vec.z*values[6],
+                            vec.x*values[1] + vec.y*values[4] + vec.z*values[7],
+                            vec.x*values[2] + vec.y*values[5] + vec.z*values[8]);
+        }
+
+        // Comparison between matricies
+        constexpr bool operator==(const Affine3<T>& mat)const {
+            for (uint8_t i=0; i<12; i++)
+                if (values[i] != mat[i]) return false;
+            return true;
+        }
+        constexpr bool operator!=(const Affine3<T>& mat)const {
+            return !(*this == mat);
+        }
+
+        // Array functionality
+        constexpr T& operator[](uint8_t i) {
+            return values[i];
+        }
+        constexpr const T& operator[](uint8_t i) const {
+            return values[i];
+        }
+
+        // Input and output
+        friend std::ostream& operator<<(std::ostream& output, const Affine3<T>& mat) {
+            for (uint8_t row=0; row<4; row++) {
+                output << mat[3*row] << " ";
+                output << mat[3*row + 1] << " ";
+                output << mat[3*row + 2] << " ";
+                output << (row == 3 ? 1 : 0) << (row < 3 ? "\n" : "");
+            }
+            return output;
+        }
+        friend std::istream& operator>>(std::istream& input, Affine3<T>& mat) {
+            for (uint8_t i=0; i<12; i++)
+                input >> mat[i];
+            return input;
+        }
+
+        // Predefined matricies
+        static constexpr Affine3<T> identity();
+
+        // Transformation matricies
+        static constexpr Affine3<T> translation(T tx, T ty, T tz);
+        static constexpr Affine3<T> rotationX(T ang);
+        static constexpr Affine3<T> rotationDegX(T ang);
+        static constexpr Affine3<T> rotationY(T ang);
+        static constexpr Affine3<T> rotationDegY(T ang);
+        static constexpr Affine3<T> rotationZ(T ang);
+        static constexpr Affine3<T> rotationDegZ(T ang);
+        static constexpr Affine3<T> scale(T sx, T sy, T sz);
+
+    };
+
+    // Predefined matricies
+    template <typename T>
+    constexpr Affine3<T> Affine3<T>::identity() {
+        return Affine3<T>(Mat4<T>::identity());
+    }
+
+    // Transformation matricies, the same as the Mat4 ones
+    template<typename T>
+    constexpr Affine3<T> Affine3<T>::translation(T tx, T ty, T tz) {
+        return Affine3<T>(Mat4<T>::translation(tx, ty, tz));
+    }
+    template<typename T>
+    constexpr Affine3<T> Affine3<T>::rotationX(T ang) {
+        return Affine3<T>(Mat4<T>::rotationX(ang));
+    }
+    template<typename T>
+    constexpr Affine3<T> Affine3<T>::rotationDegX(T ang) {
+        return Affine3<T>(Mat4<T>::rotationDegX(ang));
+    }
+    template<typename T>
+    constexpr Affine3<T> Affine3<T>::rotationY(T ang) {
+        return Affine3<T>(Mat4<T>::rotationY(ang));
+    }
+    template<typename T>
+    constexpr Affine3<T> Affine3<T>::rotationDegY(T ang) {
+        return Affine3<T>(Mat4<T>::rotationDegY(ang));
+    }
+    template<typename T>
+    constexpr Affine3<T> Affine3<T>::rotationZ(T ang) {
+        return Affine3<T>(Mat4<T>::rotationZ(ang));
+    }
+    template<typename T>
+    constexpr Affine3<T> Affine3<T>::rotationDegZ(T ang) {
+        return Affine3<T>(Mat4<T>::rotationDegZ(ang));
+    }
+    template<typename T>
+    constexpr Affine3<T> Affine3<T>::scale(T sx, T sy, T sz) {
+        return Affine3<T>(Mat4<T>::scale(sx, sy, sz));
+    }
+
+    // Vectorized kernels, constant expressions take the scalar ones
+    template <>
+    constexpr Affine3<float> Affine3<float>::dot(const Affine3<float>& mat)const {
+        Affine3<float> dot = Affine3<float>();
+        if (std::is_constant_evaluated())
+            simd::scalar::affineDot(values, mat.values, dot.values);
+        else
+            simd::affineDot(values, mat.values, dot.values);
+        return dot;
+    }
+    template <>
+    constexpr Affine3<double> Affine3<double>::dot(const Affine3<double>& mat)const {
+        Affine3<double> dot = Affine3<double>();
+        if (std::is_constant_evaluated())
+            simd::scalar::affineDot(values, mat.values, dot.values);
+        else
+            simd::affineDot(values, mat.values, dot.values);
+        return dot;
+    }
+
+    template <>
+    constexpr void Affine3<float>::inverse() {
+        if (std::is_constant_evaluated())
+            simd::scalar::affineInverse(values, values);
+        else
+            simd::affineInverse(values, values);
+    }
+    template <>
+    constexpr void Affine3<double>::inverse() {
+        if (std::is_constant_evaluated())
+            simd::scalar::affineInverse(values, values);
+        else
+            simd::affineInverse(values, values);
+    }
+    template <>
+    constexpr void Affine3<float>::inverseOrthonormal() {
+        if (std::is_constant_evaluated())
+            simd::scalar::affineInverseOrthonormal(values, values);
+        else
+            simd::affineInverseOrthonormal(values, values);
+    }
+    template <>
+    constexpr void Affine3<double>::inverseOrthonormal() {
+        if (std::is_constant_evaluated())
+            simd::scalar::affineInverseOrthonormal(values, values);
+        else
+            simd::affineInverseOrthonormal(values, values);
+    }
+}
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef CHOLESKY_H
+#define CHOLESKY_H
+
+#include <cmath>
+#include <cstddef>
+
+namespace linmath {
+
+    // Cholesky factorization of an N by N symmetric positive definite row major matrix, A = L*L^T
+    // Only the lower triangle of A is read, L is lower triangular with a positive diagonal and zeros above it
+    // A pivot that is not positive stops the factorization, positive() is false and the columns from it on stay 0
+    // Past choleskyBlock the factorization runs on square blocks, so the trailing update reuses a panel of L
+    // from cache instead of streaming every earlier column once per element
+    constexpr size_t choleskyBlock = 32;
+
+    template <typename T, size_t N>
+    class Cholesky {
+
+        protected:
+        T values[N*N];
+        bool definite = true;
+
+        // Unblocked factorization of the diagonal block from first to last, earlier columns are already subtracted
+        // Returns the column whose pivot is not positive, or last
+        size_t diagonal(size_t first, size_t last) {
+            for (size_t col=first; col<last; col++) {
+                T d = values[N*col + col];
+                for (size_t k=first; k<col; k++)
+                    d -= values[N*col + k]*values[N*col + k];
+                if (!(d > T(0)))
+                    return col;
+                T l = std::sqrt(d);
+                values[N*col + col] = l;
+                for (size_t row=col + 1; row<last; row++) {
+                    T s = values[N*row + col];
+                    for (size_t k=first; k<col; k++)
+                        s -= values[N*row + k]*values[N*col + k];
+                    values[N*row + col] = s / l;
+                }
+            }
+            return last;
+        }
+
+        // Factorization of the block from first to last, an indefinite matrix is cleared from its failing column on
+        bool factorize(size_t first, size_t last) {
+            size_t col = diagonal(first, last);
+            if (col == last)
+                return true;
+            definite = false;
+            clear(col);
+            return false;
+        }
+
+        // Zeros every column from col on
+        void clear(size_t col) {
+            for (size_t row=col; row<N; row++)
+                for (size_t i=col; i<=row; i++)
+                    values[N*row + i] = T(0);
+        }
+
+        public:
+
+        // Constructors, factorizes the N*N values of a row major matrix
+        Cholesky(const T* mat) {
+            for (size_t row=0; row<N; row++)
+                for (size_t col=0; col<N; col++)
+                    values[N*row + col] = col <= row ? mat[N*row + col] : T(0);
+
+            if constexpr (N == 3) {
+                T a = values[0];
+                if (!(a > T(0))) {
+                    definite = false;
+                    clear(0);
+                    return;
+                }
+                T l0 = std::sqrt(a);
+                T l3 = values[3] / l0;
+                T l6 = values[6] / l0;
+                T b = values[4] - l3*l3;
+                if (!(b > T(0))) {
+                    definite = false;
+                    values[0] = l0;
+                    values[3] = l3;
+                    values[6] = l6;
+                    clear(1);
+                    return;
+                }
+                T l4 = std::sqrt(b);
+                T l7 = (values[7] - l6*l3) / l4;
+                T c = values[8] - l6*l6 - l7*l7;
+                values[0] = l0;
+                values[3] = l3;
+                values[4] = l4;
+                values[6] = l6;
+                values[7] = l7;
+                definite = c > T(0);
+                values[8] = definite ? std::sqrt(c) : T(0);
+            }
+            else if constexpr (N <= choleskyBlock)
+                factorize(0, N);
+            else
+                for (size_t first=0; first<N; first+=choleskyBlock) {
+                    size_t last = first + choleskyBlock < N ? first + choleskyBlock : N;
+                    if (!factorize(first, last))
+                        return;
+
+                    // Panel below the block, every row solves against the block's L^T
+                    for (size_t row=last; row<N; row++)
+                        for (size_t col=first; col<last; col++) {
+                            T s = values[N*row + col];
+                            for (size_t k=first; k<col; k++)
+                                s -= values[N*row + k]*values[N*col + k];
+                            values[N*row + col] = s / values[N*col + col];
+                        }
+
+                    // Trailing lower triangle minus the panel times its transpose, a tile of rows at a time
+                    for (size_t rows=last; rows<N; rows+=choleskyBlock) {
+                        size_t rowsEnd = rows + choleskyBlock < N ? rows + choleskyBlock : N;
+                        for (size_t cols=last; cols<rowsEnd; cols+=choleskyBlock)
+                            for (size_t row=rows; row<rowsEnd; row++) {
+                                size_t colsEnd = cols + choleskyBlock < row + 1 ? cols + choleskyBlock : row + 1;
+                                for (size_t col=cols; col<colsEnd; col++) {
+                                    T s = T(0);
+                                    for (size_t k=first; k<last; k++)
+                                        s += values[N*row + k]*values[N*col + k];
+                                    values[N*row + col] -= s;
+                                }
+                            }
+                    }
+                }
+        }
+
+        // Positive definiteness, every pivot was positive
+        bool positive()const {
+            return definite;
+        }
+
+        // Matrix determinant, the squared product of the diagonal of L
+        T det()const {
+            return determinant();
+        }
+        T determinant()const {
+            T det = T(1);
+            for (size_t i=0; i<N; i++)
+                det *= values[N*i + i];
+            return det*det;
+        }
+
+        // Logarithm of the determinant, which does not overflow for large or badly scaled matricies
+        T logDeterminant()const {
+            T log = T(0);
+            for (size_t i=0; i<N; i++)
+                log += std::log(values[N*i + i]);
+            return log + log;
+        }
+
+        // Solution x of A*x = b by forward substitution with L and back substitution with L^T
+        // b and x hold N values and may be the same array
+        void solve(const T* b, T* x)const {
+            T y[N];
+            for (size_t row=0; row<N; row++) {
+                T s = b[row];
+                for (size_t i=0; i<row; i++)
+                    s -= values[N*row + i]*y[i];
+                y[row] = s / values[N*row + row];
+            }
+            for (size_t row=N; row-- > 0;) {
+                T s = y[row];
+                for (size_t i=row + 1; i<N; i++)
+                    s -= values[N*i + row]*y[i];
+                y[row] = s / values[N*row + row];
+            }
+            for (size_t row=0; row<N; row++)
+                x[row] = y[row];
+        }
+
+        // Array functionality, L in row major order
+        const T& operator[](size_t i)const {
+            return values[i];
+        }
+    };
+}
+
+#endif
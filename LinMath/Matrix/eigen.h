@@ -0,0 +1,436 @@
+#ifndef EIGEN_H
+#define EIGEN_H
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace linmath {
+
+    // Eigen decomposition of an N by N symmetric row major matrix, A = V^T*diag(values)*V
+    // Eigenvalues are in ascending order and eigenvector i, row i of V, has unit length, only the lower triangle of A is read
+    // 3x3 matricies use the closed form of Eberly's robust eigensolver, up to jacobiLimit the cyclic Jacobi method
+    // and past it Householder tridiagonalization with the implicit QL method
+    // The eigenvectors are kept as rows, so the QL rotations of two of them run over contiguous values
+    constexpr size_t jacobiLimit = 8;
+
+    template <typename T, size_t N>
+    class SymmetricEigen {
+
+        protected:
+        T eigenvalues[N];
+        T vectors[N*N];
+
+        static constexpr T epsilon = std::numeric_limits<T>::epsilon();
+
+        // Cross product of two rows
+        static void cross(const T* u, const T* v, T* r) {
+            r[0] = u[1]*v[2] - u[2]*v[1];
+            r[1] = u[2]*v[0] - u[0]*v[2];
+            r[2] = u[0]*v[1] - u[1]*v[0];
+        }
+
+        // Unit eigenvector of a simple eigenvalue e, the largest cross product of two rows of A - e*I
+        static void vector0(const T* a, T e, T* v) {
+            T rows[3][3] = {{a[0] - e, a[1], a[2]}, {a[1], a[4] - e, a[5]}, {a[2], a[5], a[8] - e}};
+            T crosses[3][3];
+            cross(rows[0], rows[1], crosses[0]);
+            cross(rows[0], rows[2], crosses[1]);
+            cross(rows[1], rows[2], crosses[2]);
+            size_t best = 0;
+            T largest = T(0);
+            for (size_t i=0; i<3; i++) {
+                T sq = crosses[i][0]*crosses[i][0] + crosses[i][1]*crosses[i][1] + crosses[i][2]*crosses[i][2];
+                if (sq > largest) {
+                    best = i;
+                    largest = sq;
+                }
+            }
+            T inv = T(1) / std::sqrt(largest);
+            for (size_t c=0; c<3; c++)
+                v[c] = crosses[best][c]*inv;
+        }
+
+        // Unit eigenvector of e orthogonal to the eigenvector w, from the 2x2 restriction of A - e*I to the complement of w
+        static void vector1(const T* a, const T* w, T e, T* v) {
+            T u[3], x[3];
+            if (std::abs(w[0]) > std::abs(w[1])) {
+                T inv = T(1) / std::sqrt(w[0]*w[0] + w[2]*w[2]);
+                u[0] = -w[2]*inv;
+                u[1] = T(0);
+                u[2] = w[0]*inv;
+            }
+            else {
+                T inv = T(1) / std::sqrt(w[1]*w[1] + w[2]*w[2]);
+                u[0] = T(0);
+                u[1] = w[2]*inv;
+                u[2] = -w[1]*inv;
+            }
+            cross(w, u, x);
+
+            T au[3], ax[3];
+            for (size_t r=0; r<3; r++) {
+                au[r] = a[3*r]*u[0] + a[3*r + 1]*u[1] + a[3*r + 2]*u[2];
+                ax[r] = a[3*r]*x[0] + a[3*r + 1]*x[1] + a[3*r + 2]*x[2];
+            }
+            T m00 = u[0]*au[0] + u[1]*au[1] + u[2]*au[2] - e;
+            T m01 = u[0]*ax[0] + u[1]*ax[1] + u[2]*ax[2];
+            T m11 = x[0]*ax[0] + x[1]*ax[1] + x[2]*ax[2] - e;
+
+            // The null vector of the 2x2 matrix in the u, x basis, normalized through its larger row
+            T p = m01, q = std::abs(m00) >= std::abs(m11) ? m00 : m11;
+            if (std::abs(p) == T(0) && std::abs(q) == T(0)) {
+                for (size_t c=0; c<3; c++)
+                    v[c] = u[c];
+                return;
+            }
+            T cu, cx;
+            if (std::abs(q) >= std::abs(p)) {
+                T r = p / q;
+                cx = T(1) / std::sqrt(T(1) + r*r);
+                cu = r*cx;
+            }
+            else {
+                T r = q / p;
+                cu = T(1) / std::sqrt(T(1) + r*r);
+                cx = r*cu;
+            }
+            if (std::abs(m00) >= std::abs(m11))
+                for (size_t c=0; c<3; c++)
+                    v[c] = cu*u[c] - cx*x[c];
+            else
+                for (size_t c=0; c<3; c++)
+                    v[c] = cx*u[c] - cu*x[c];
+        }
+
+        // Closed form, the eigenvalues from the trigonometric solution of the characteristic cubic of the
+        // shifted and scaled matrix and the eigenvectors from cross products, then the eigenvalues again from the vectors
+        // as Kopp's hybrid method does, a nearly repeated pair falls back to the iterative method
+        void closed(const T* mat) {
+            T a[9] = {mat[0], mat[3], mat[6], mat[3], mat[4], mat[7], mat[6], mat[7], mat[8]};
+            T scale = T(0);
+            for (size_t i=0; i<9; i++)
+                scale = std::abs(a[i]) > scale ? std::abs(a[i]) : scale;
+            T off = a[1]*a[1] + a[2]*a[2] + a[5]*a[5];
+            if (scale == T(0) || off == T(0)) {
+                for (size_t i=0; i<3; i++)
+                    eigenvalues[i] = a[4*i];
+                identity();
+                sort();
+                return;
+            }
+            for (size_t i=0; i<9; i++)
+                a[i] /= scale;
+            off /= scale*scale;
+
+            T shift = (a[0] + a[4] + a[8]) / T(3);
+            T b0 = a[0] - shift, b1 = a[4] - shift, b2 = a[8] - shift;
+            T p = std::sqrt((b0*b0 + b1*b1 + b2*b2 + T(2)*off) / T(6));
+            T c00 = b1*b2 - a[5]*a[5];
+            T c01 = a[1]*b2 - a[5]*a[2];
+            T c02 = a[1]*a[5] - b1*a[2];
+            T half = (b0*c00 - a[1]*c01 + a[2]*c02) / (T(2)*p*p*p);
+            half = half < T(-1) ? T(-1) : half > T(1) ? T(1) : half;
+
+            // Near a repeated pair the angle is off by about eps/sqrt(1 - |half|) and the pair's vectors with it,
+            // those matricies are left to Jacobi
+            if (T(1) - std::abs(half) < T(1e-4)) {
+                jacobi(mat);
+                return;
+            }
+            T angle = std::acos(half) / T(3);
+            T beta2 = T(2)*std::cos(angle);
+            T beta0 = T(2)*std::cos(angle + T(2.09439510239319549230842892218633526L));
+            T beta1 = -(beta0 + beta2);
+            T e[3] = {shift + p*beta0, shift + p*beta1, shift + p*beta2};
+
+            // The eigenvalue furthest from the other two is simple, its vector comes first
+            T* v = vectors;
+            if (half >= T(0)) {
+                vector0(a, e[2], v + 6);
+                vector1(a, v + 6, e[1], v + 3);
+                cross(v + 3, v + 6, v);
+            }
+            else {
+                vector0(a, e[0], v);
+                vector1(a, v, e[1], v + 3);
+                cross(v, v + 3, v + 6);
+            }
+
+            // The Rayleigh quotients of the vectors are more accurate than the roots of the cubic
+            for (size_t i=0; i<3; i++) {
+                const T* x = v + 3*i;
+                T r = T(0);
+                for (size_t row=0; row<3; row++)
+                    r += x[row]*(a[3*row]*x[0] + a[3*row + 1]*x[1] + a[3*row + 2]*x[2]);
+                eigenvalues[i] = r*scale;
+            }
+            sort();
+        }
+
+        // Cyclic Jacobi, every off diagonal value is rotated to 0 in turn until the sweep changes nothing
+        void jacobi(const T* mat) {
+            T a[N*N];
+            for (size_t row=0; row<N; row++)
+                for (size_t col=0; col<=row; col++)
+                    a[N*row + col] = a[N*col + row] = mat[N*row + col];
+            identity();
+
+            for (size_t sweep=0; sweep<64; sweep++) {
+                bool rotated = false;
+                for (size_t p=0; p<N; p++)
+                    for (size_t q=p + 1; q<N; q++) {
+                        T apq = a[N*p + q];
+                        T app = a[N*p + p], aqq = a[N*q + q];
+                        if (std::abs(apq) <= epsilon*T(0.5)*(std::abs(app) + std::abs(aqq))) {
+                            a[N*p + q] = a[N*q + p] = T(0);
+                            continue;
+                        }
+                        rotated = true;
+                        T d = aqq - app;
+                        T t = T(2)*apq / (std::abs(d) + std::sqrt(d*d + T(4)*apq*apq));
+                        t = d < T(0) ? -t : t;
+                        T c = T(1) / std::sqrt(t*t + T(1));
+                        T s = t*c;
+                        a[N*p + p] = app - t*apq;
+                        a[N*q + q] = aqq + t*apq;
+                        a[N*p + q] = a[N*q + p] = T(0);
+                        for (size_t r=0; r<N; r++) {
+                            if (r == p || r == q)
+                                continue;
+                            T arp = a[N*r + p], arq = a[N*r + q];
+                            a[N*r + p] = a[N*p + r] = c*arp - s*arq;
+                            a[N*r + q] = a[N*q + r] = s*arp + c*arq;
+                        }
+                        for (size_t k=0; k<N; k++) {
+                            T vp = vectors[N*p + k], vq = vectors[N*q + k];
+                            vectors[N*p + k] = c*vp - s*vq;
+                            vectors[N*q + k] = s*vp + c*vq;
+                        }
+                    }
+                if (!rotated)
+                    break;
+            }
+            for (size_t i=0; i<N; i++)
+                eigenvalues[i] = a[N*i + i];
+            sort();
+        }
+
+        // Householder tridiagonalization, diagonal d and subdiagonal e with e[i] below d[i], and the transform in V^T
+        void tridiagonalize(const T* mat, T* d, T* e) {
+            // The reduction works on the columns of V, written as vectors[N*col + row] so that they are rows in memory
+            auto v = [&](size_t row, size_t col) -> T& {
+                return vectors[N*col + row];
+            };
+            for (size_t row=0; row<N; row++)
+                for (size_t col=0; col<=row; col++)
+                    v(row, col) = v(col, row) = mat[N*row + col];
+
+            for (size_t j=0; j<N; j++)
+                d[j] = v(N - 1, j);
+            for (size_t i=N - 1; i>0; i--) {
+                T scale = T(0), h = T(0);
+                for (size_t k=0; k<i; k++)
+                    scale += std::abs(d[k]);
+                if (scale == T(0)) {
+                    e[i] = d[i - 1];
+                    for (size_t j=0; j<i; j++) {
+                        d[j] = v(i - 1, j);
+                        v(i, j) = T(0);
+                        v(j, i) = T(0);
+                    }
+                }
+                else {
+                    for (size_t k=0; k<i; k++) {
+                        d[k] /= scale;
+                        h += d[k]*d[k];
+                    }
+                    T f = d[i - 1];
+                    T g = std::sqrt(h);
+                    if (f > T(0))
+                        g = -g;
+                    e[i] = scale*g;
+                    h -= f*g;
+                    d[i - 1] = f - g;
+                    for (size_t j=0; j<i; j++)
+                        e[j] = T(0);
+                    for (size_t j=0; j<i; j++) {
+                        f = d[j];
+                        v(j, i) = f;
+                        g = e[j] + v(j, j)*f;
+                        for (size_t k=j + 1; k<i; k++) {
+                            g += v(k, j)*d[k];
+                            e[k] += v(k, j)*f;
+                        }
+                        e[j] = g;
+                    }
+                    f = T(0);
+                    for (size_t j=0; j<i; j++) {
+                        e[j] /= h;
+                        f += e[j]*d[j];
+                    }
+                    T hh = f / (h + h);
+                    for (size_t j=0; j<i; j++)
+                        e[j] -= hh*d[j];
+                    for (size_t j=0; j<i; j++) {
+                        f = d[j];
+                        g = e[j];
+                        for (size_t k=j; k<i; k++)
+                            v(k, j) -= f*e[k] + g*d[k];
+                        d[j] = v(i - 1, j);
+                        v(i, j) = T(0);
+                    }
+                }
+                d[i] = h;
+            }
+
+            // Accumulated transformations
+            for (size_t i=0; i<N - 1; i++) {
+                v(N - 1, i) = v(i, i);
+                v(i, i) = T(1);
+                T h = d[i + 1];
+                if (h != T(0)) {
+                    for (size_t k=0; k<=i; k++)
+                        d[k] = v(k, i + 1) / h;
+                    for (size_t j=0; j<=i; j++) {
+                        T g = T(0);
+                        for (size_t k=0; k<=i; k++)
+                            g += v(k, i + 1)*v(k, j);
+                        for (size_t k=0; k<=i; k++)
+                            v(k, j) -= g*d[k];
+                    }
+                }
+                for (size_t k=0; k<=i; k++)
+                    v(k, i + 1) = T(0);
+            }
+            for (size_t j=0; j<N; j++) {
+                d[j] = v(N - 1, j);
+                v(N - 1, j) = T(0);
+            }
+            v(N - 1, N - 1) = T(1);
+            e[0] = T(0);
+        }
+
+        // Implicit QL with Wilkinson shifts on the tridiagonal matrix, the rotations are applied to the rows of V
+        void ql(T* d, T* e) {
+            for (size_t i=1; i<N; i++)
+                e[i - 1] = e[i];
+            e[N - 1] = T(0);
+
+            T f = T(0), largest = T(0);
+            for (size_t l=0; l<N; l++) {
+                T size = std::abs(d[l]) + std::abs(e[l]);
+                largest = size > largest ? size : largest;
+                size_t m = l;
+                while (m < N - 1 && std::abs(e[m]) > epsilon*largest)
+                    m++;
+                if (m > l)
+                    for (size_t iter=0; iter<64 && std::abs(e[l]) > epsilon*largest; iter++) {
+                        T g = d[l];
+                        T p = (d[l + 1] - g) / (T(2)*e[l]);
+                        T r = std::hypot(p, T(1));
+                        if (p < T(0))
+                            r = -r;
+                        d[l] = e[l] / (p + r);
+                        d[l + 1] = e[l]*(p + r);
+                        T dl1 = d[l + 1];
+                        T h = g - d[l];
+                        for (size_t i=l + 2; i<N; i++)
+                            d[i] -= h;
+                        f += h;
+
+                        p = d[m];
+                        T c = T(1), c2 = T(1), c3 = T(1);
+                        T el1 = e[l + 1];
+                        T s = T(0), s2 = T(0);
+                        for (size_t i=m; i-- > l;) {
+                            c3 = c2;
+                            c2 = c;
+                            s2 = s;
+                            g = c*e[i];
+                            h = c*p;
+                            r = std::hypot(p, e[i]);
+                            e[i + 1] = s*r;
+                            s = e[i] / r;
+                            c = p / r;
+                            p = c*d[i] - s*g;
+                            d[i + 1] = h + s*(c*g + s*d[i]);
+                            T* vi = vectors + N*i;
+                            T* vj = vectors + N*(i + 1);
+                            for (size_t k=0; k<N; k++) {
+                                T t = vj[k];
+                                vj[k] = s*vi[k] + c*t;
+                                vi[k] = c*vi[k] - s*t;
+                            }
+                        }
+                        p = -s*s2*c3*el1*e[l] / dl1;
+                        e[l] = s*p;
+                        d[l] = c*p;
+                    }
+                d[l] += f;
+                e[l] = T(0);
+            }
+        }
+
+        // Ascending eigenvalues, the eigenvectors follow
+        void sort() {
+            for (size_t i=0; i<N; i++) {
+                size_t smallest = i;
+                for (size_t j=i + 1; j<N; j++)
+                    if (eigenvalues[j] < eigenvalues[smallest])
+                        smallest = j;
+                if (smallest == i)
+                    continue;
+                T t = eigenvalues[i];
+                eigenvalues[i] = eigenvalues[smallest];
+                eigenvalues[smallest] = t;
+                for (size_t k=0; k<N; k++) {
+                    t = vectors[N*i + k];
+                    vectors[N*i + k] = vectors[N*smallest + k];
+                    vectors[N*smallest + k] = t;
+                }
+            }
+        }
+
+        void identity() {
+            for (size_t i=0; i<N*N; i++)
+                vectors[i] = i % (N + 1) == 0 ? T(1) : T(0);
+        }
+
+        public:
+
+        // Constructors, decomposes the N*N values of a row major matrix
+        SymmetricEigen(const T* mat) {
+            if constexpr (N == 3)
+                closed(mat);
+            else if constexpr (N <= jacobiLimit)
+                jacobi(mat);
+            else {
+                T e[N];
+                tridiagonalize(mat, eigenvalues, e);
+                ql(eigenvalues, e);
+                sort();
+            }
+        }
+
+        // Eigenvalue i
+        T value(size_t i)const {
+            return eigenvalues[i];
+        }
+        const T* values()const {
+            return eigenvalues;
+        }
+
+        // Eigenvector i, N values
+        const T* vector(size_t i)const {
+            return vectors + N*i;
+        }
+
+        // Array functionality, V in row major order with an eigenvector per row
+        const T& operator[](size_t i)const {
+            return vectors[i];
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef GEMM_H
+#define GEMM_H
+
+#include <cstddef>
+
+#include "../Parallel/threadpool.h"
+#include "../Simd/aligned.h"
+#include "../Simd/dispatch.h"
+
+#define LINMATH_KERNELS "Kernels/gemm.h"
+#include "../Simd/foreach.h"
+
+namespace linmath {
+
+    // Row major matrix product C (n x m) = A (n x k) * B (k x m)
+    // lda, ldb and ldc are the row strides, so blocks of larger matricies can be multiplied in place
+    template <typename T>
+    void gemm(size_t n, size_t m, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc) {
+        simd::scalar::gemm(n, m, k, a, lda, b, ldb, c, ldc);
+    }
+
+    namespace simd {
+        template <typename T>
+        using GemmKernel = void (*)(size_t, size_t, size_t, const T*, size_t, const T*, size_t, T*, size_t);
+    }
+
+    inline void gemm(size_t n, size_t m, size_t k, const float* a, size_t lda, const float* b, size_t ldb, float* c, size_t ldc) {
+        using namespace simd;
+        static const GemmKernel<float> kernel = LINMATH_DISPATCH(GemmKernel<float>, gemm<float>);
+        kernel(n, m, k, a, lda, b, ldb, c, ldc);
+    }
+    inline void gemm(size_t n, size_t m, size_t k, const double* a, size_t lda, const double* b, size_t ldb, double* c, size_t ldc) {
+        using namespace simd;
+        static const GemmKernel<double> kernel = LINMATH_DISPATCH(GemmKernel<double>, gemm<double>);
+        kernel(n, m, k, a, lda, b, ldb, c, ldc);
+    }
+
+    // Matrix product split over a thread pool
+    // C is cut into a grid of tiles, at least four per thread, and every tile is an independent serial gemm
+    // Tiles keep at least 64 rows and 256 columns so each one still runs on full cache blocks
+    template <typename T>
+    void gemm(size_t n, size_t m, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, ThreadPool& pool) {
+        size_t threads = pool.size();
+        if (threads == 1 || n*m*k <= 128*128*128) {
+            gemm(n, m, k, a, lda, b, ldb, c, ldc);
+            return;
+        }
+
+        size_t tiles = 4*threads;
+        size_t rowTiles = (n + 63)/64;
+        if (rowTiles > tiles)
+            rowTiles = tiles;
+        size_t colTiles = (m + 255)/256;
+        if (colTiles > (tiles + rowTiles - 1)/rowTiles)
+            colTiles = (tiles + rowTiles - 1)/rowTiles;
+
+        size_t rows = (n + rowTiles - 1)/rowTiles;
+        size_t cols = (m + colTiles - 1)/colTiles;
+        rowTiles = (n + rows - 1)/rows;
+        colTiles = (m + cols - 1)/cols;
+
+        pool.parallelFor(rowTiles*colTiles, [&](size_t tile) {
+            size_t row = tile/colTiles*rows;
+            size_t col = tile%colTiles*cols;
+            size_t h = n - row < rows ? n - row : rows;
+            size_t w = m - col < cols ? m - col : cols;
+            gemm(h, w, k, a + row*lda, lda, b + col, ldb, c + row*ldc + col, ldc);
+        });
+    }
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef LU_H
+#define LU_H
+
+#include <cstddef>
+
+namespace linmath {
+
+    // LU factorization with partial pivoting of an N by N row major matrix, P*A = L*U
+    // L has a unit diagonal and is stored below the diagonal of U, row i of P*A is row pivot(i) of A
+    // Every column pivots on its largest value, a column whose values are all 0 marks the matrix singular
+    // and is left as it is, so det is 0 and solve divides by zero
+    template <typename T, size_t N>
+    class LU {
+
+        protected:
+        T values[N*N];
+        size_t rows[N];
+        bool odd = false;
+        bool zero = false;
+
+        static constexpr T magnitude(T t) {
+            return t < 0 ? -t : t;
+        }
+
+        public:
+
+        // Constructors, factorizes the N*N values of a row major matrix
+        constexpr LU(const T* mat) {
+            for (size_t i=0; i<N*N; i++)
+                values[i] = mat[i];
+            for (size_t row=0; row<N; row++)
+                rows[row] = row;
+
+            for (size_t col=0; col<N; col++) {
+                size_t pivot = col;
+                T largest = magnitude(values[N*col + col]);
+                for (size_t row=col + 1; row<N; row++)
+                    if (magnitude(values[N*row + col]) > largest) {
+                        pivot = row;
+                        largest = magnitude(values[N*row + col]);
+                    }
+                if (pivot != col) {
+                    for (size_t i=0; i<N; i++) {
+                        T t = values[N*col + i];
+                        values[N*col + i] = values[N*pivot + i];
+                        values[N*pivot + i] = t;
+                    }
+                    size_t r = rows[col];
+                    rows[col] = rows[pivot];
+                    rows[pivot] = r;
+                    odd = !odd;
+                }
+                if (largest == T(0)) {
+                    zero = true;
+                    continue;
+                }
+
+                T p = values[N*col + col];
+                for (size_t row=col + 1; row<N; row++) {
+                    T f = values[N*row + col] / p;
+                    values[N*row + col] = f;
+                    for (size_t i=col + 1; i<N; i++)
+                        values[N*row + i] -= f*values[N*col + i];
+                }
+            }
+        }
+
+        // Singularity, an exactly zero pivot
+        constexpr bool singular()const {
+            return zero;
+        }
+
+        // Matrix determinant, the product of the pivots with the sign of the row exchanges
+        constexpr T det()const {
+            return determinant();
+        }
+        constexpr T determinant()const {
+            if (zero)
+                return T(0);
+            T det = odd ? T(-1) : T(1);
+            for (size_t i=0; i<N; i++)
+                det *= values[N*i + i];
+            return det;
+        }
+
+        // Solution x of A*x = b by forward and back substitution, A is never inverted
+        // b and x hold N values and may be the same array
+        constexpr void solve(const T* b, T* x)const {
+            T y[N];
+            for (size_t row=0; row<N; row++) {
+                y[row] = b[rows[row]];
+                for (size_t i=0; i<row; i++)
+                    y[row] -= values[N*row + i]*y[i];
+            }
+            for (size_t row=N; row-- > 0;) {
+                for (size_t i=row + 1; i<N; i++)
+                    y[row] -= values[N*row + i]*y[i];
+                y[row] /= values[N*row + row];
+            }
+            for (size_t row=0; row<N; row++)
+                x[row] = y[row];
+        }
+
+        // Row of A that row i of P*A is
+        constexpr size_t pivot(size_t row)const {
+            return rows[row];
+        }
+
+        // Array functionality, L below the diagonal and U on and above it in row major order
+        constexpr const T& operator[](size_t i)const {
+            return values[i];
+        }
+    };
+}
+
+#endif
@@ -3,6 +3,11 @@
 
 #include <iostream>
 
+#include "cholesky.h"
+#include "eigen.h"
+#include "lu.h"
+#include "qr.h"
+
 namespace linmath {
 
     template <typename T>
@@ -14,56 +19,47 @@ namespace linmath {
         public:
 
         // Constructors
-        Mat2() {}
-        Mat2(T t) {
+        constexpr Mat2() {}
+        constexpr Mat2(T t) {
             this->values[0] = t;
             this->values[1] = t;
             this->values[2] = t;
             this->values[3] = t;
         }
-        Mat2(T values[4]) {
+        constexpr Mat2(T values[4]) {
             this->values[0] = values[0];
             this->values[1] = values[1];
             this->values[2] = values[2];
             this->values[3] = values[3];
         }
-        Mat2(T values[2][2]) {
+        constexpr Mat2(T values[2][2]) {
             this->values[0] = values[0][0];
             this->values[1] = values[0][1];
             this->values[2] = values[1][0];
             this->values[3] = values[1][1];
         }
 
-        // Variadic constructor
-        template <typename... Ts>
-        Mat2(T t, Ts... ts) {
-            auto n = 4;
-            *this = Mat2(&n, t, ts...);
-        }
-        template <typename... Ts>
-        Mat2(auto* n, T t, Ts... ts) : Mat2(n, ts...) {
-            *n = *n - 1;
-            values[*n] = t;
-        }
-        Mat2(auto*){}
+        // Variadic constructor, one value per element in row major order
+        template <typename... Ts> requires (sizeof...(Ts) + 1 == 4)
+        constexpr Mat2(T t, Ts... ts) : values{t, T(ts)...} {}
 
 
         // Matrix determinant
-        T det() {
+        constexpr T det() {
             return determinant();
         }
-        T determinant() {
+        constexpr T determinant() {
             return values[0]*values[3] - values[1]*values[2];
         }
 
         // Matrix transpozition
-        void transpoze() {
+        constexpr void transpoze() {
             T t;
             t = values[1];
             values[1] = values[2];
             values[2] = t;
         }
-        Mat2<T> transpozed() {
+        constexpr Mat2<T> transpozed() {
             Mat2<T> mat = *this;
             mat[1] = values[2];
             mat[2] = values[1];
@@ -71,7 +67,7 @@ namespace linmath {
         }
 
         // Matrix inverse
-        void inverse() {
+        constexpr void inverse() {
             T det = determinant();
 
             T t;
@@ -84,24 +80,30 @@ namespace linmath {
 
             *this /= det;
         }
-        Mat2<T> inversed() {
+        constexpr Mat2<T> inversed() {
             Mat2<T> mat = *this;
             mat.inverse();
             return mat;
         }
 
-        // TODO
-        // Matrix pivot
-        /*void pivot() {
+        // LU factorization with partial pivoting, for solving systems without forming the inverse
+        constexpr LU<T, 2> lu()const {
+            return LU<T, 2>(values);
+        }
 
-            values[2] = values[]
+        // Cholesky factorization of a symmetric positive definite matrix, QR factorization and symmetric eigen decomposition
+        Cholesky<T, 2> cholesky()const {
+            return Cholesky<T, 2>(values);
+        }
+        QR<T, 2, 2> qr()const {
+            return QR<T, 2, 2>(values);
+        }
+        SymmetricEigen<T, 2> eigen()const {
+            return SymmetricEigen<T, 2>(values);
         }
-        Mat2<T> pivoted() {
-            return Mat2<T>(1);
-        }*/
 
         // Dot product
-        Mat2<T> dot(const Mat2<T>& mat) {
+        constexpr Mat2<T> dot(const Mat2<T>& mat) {
             Mat2<T> dot = Mat2<T>();
             dot[0] = values[0]*mat[0] + values[1]*mat[2];
             dot[1] = values[0]*mat[1] + values[1]*mat[3];
@@ -111,7 +113,7 @@ namespace linmath {
         }
 
         // Negation
-        Mat2<T> operator-() {
+        constexpr Mat2<T> operator-() {
             Mat2<T> mat = Mat2<T>();
             mat[0] = -values[0];
             mat[1] = -values[1];
@@ -121,7 +123,7 @@ namespace linmath {
         }
 
         // Prefix increment and decrement
-        Mat2<T> operator++() {
+        constexpr Mat2<T> operator++() {
             Mat2<T> mat = Mat2<T>();
             mat[0] = ++values[0];
             mat[1] = ++values[1];
@@ -129,7 +131,7 @@ namespace linmath {
             mat[3] = ++values[3];
             return mat;
         }
-        Mat2<T> operator--() {
+        constexpr Mat2<T> operator--() {
             Mat2<T> mat = Mat2<T>();
             mat[0] = --values[0];
             mat[1] = --values[1];
@@ -139,7 +141,7 @@ namespace linmath {
         }
 
         // Postfix increment and decrement
-        Mat2<T> operator++(int) {
+        constexpr Mat2<T> operator++(int) {
             Mat2<T> mat = Mat2<T>();
             mat[0] = values[0]++;
             mat[1] = values[1]++;
@@ -147,7 +149,7 @@ namespace linmath {
             mat[3] = values[3]++;
             return mat;
         }
-        Mat2<T> operator--(int) {
+        constexpr Mat2<T> operator--(int) {
             Mat2<T> mat = Mat2<T>();
             mat[0] = values[0]--;
             mat[1] = values[1]--;
@@ -157,7 +159,7 @@ namespace linmath {
         }
 
         // Operations with scalars
-        Mat2<T> operator+(const T t) {
+        constexpr Mat2<T> operator+(const T t) {
             Mat2<T> mat = Mat2<T>();
             mat[0] = values[0] + t;
             mat[1] = values[1] + t;
@@ -165,7 +167,7 @@ namespace linmath {
             mat[3] = values[3] + t;
             return mat;
         }
-        Mat2<T> operator-(const T t) {
+        constexpr Mat2<T> operator-(const T t) {
             Mat2<T> mat = Mat2<T>();
             mat[0] = values[0] - t;
             mat[1] = values[1] - t;
@@ -173,7 +175,7 @@ namespace linmath {
             mat[3] = values[3] - t;
             return mat;
         }
-        Mat2<T> operator*(const T t) {
+        constexpr Mat2<T> operator*(const T t) {
             Mat2<T> mat = Mat2<T>();
             mat[0] = values[0] * t;
             mat[1] = values[1] * t;
@@ -181,7 +183,7 @@ namespace linmath {
             mat[3] = values[3] * t;
             return mat;
         }
-        Mat2<T> operator/(const T t) {
+        constexpr Mat2<T> operator/(const T t) {
             Mat2<T> mat = Mat2<T>();
             mat[0] = values[0] / t;
             mat[1] = values[1] / t;
@@ -197,31 +199,31 @@ namespace linmath {
             mat[3] = values[3] % t;
             return mat;
         }
-        void operator+=(const T t) {
+        constexpr void operator+=(const T t) {
             values[0] += t;
             values[1] += t;
             values[2] += t;
             values[3] += t;
         }
-        void operator-=(const T t) {
+        constexpr void operator-=(const T t) {
             values[0] -= t;
             values[1] -= t;
             values[2] -= t;
             values[3] -= t;
         }
-        void operator*=(const T t) {
+        constexpr void operator*=(const T t) {
             values[0] *= t;
             values[1] *= t;
             values[2] *= t;
             values[3] *= t;
         }
-        void operator/=(const T t) {
+        constexpr void operator/=(const T t) {
             values[0] /= t;
             values[1] /= t;
             values[2] /= t;
             values[3] /= t;
         }
-        void operator%=(const T t) {
+        constexpr void operator%=(const T t) {
             values[0] %= t;
             values[1] %= t;
             values[2] %= t;
@@ -229,7 +231,7 @@ namespace linmath {
         }
 
         // Operations with matricies
-        Mat2<T> operator+(const Mat2<T>& mat) {
+        constexpr Mat2<T> operator+(const Mat2<T>& mat) {
             Mat2<T> out = Mat2<T>();
             out[0] = values[0]+mat[0];
             out[1] = values[1]+mat[1];
@@ -237,7 +239,7 @@ namespace linmath {
             out[3] = values[3]+mat[3];
             return out;
         }
-        Mat2<T> operator-(const Mat2<T>& mat) {
+        constexpr Mat2<T> operator-(const Mat2<T>& mat) {
             Mat2<T> out = Mat2<T>();
             out[0] = values[0]-mat[0];
             out[1] = values[1]-mat[1];
@@ -245,7 +247,7 @@ namespace linmath {
             out[3] = values[3]-mat[3];
             return out;
         }
-        Mat2<T> operator*(const Mat2<T>& mat) {
+        constexpr Mat2<T> operator*(const Mat2<T>& mat) {
             Mat2<T> out = Mat2<T>();
             out[0] = values[0]*mat[0];
             out[1] = values[1]*mat[1];
@@ -253,7 +255,7 @@ namespace linmath {
             out[3] = values[3]*mat[3];
             return out;
         }
-        Mat2<T> operator/(const Mat2<T>& mat) {
+        constexpr Mat2<T> operator/(const Mat2<T>& mat) {
             Mat2<T> out = Mat2<T>();
             out[0] = values[0]/mat[0];
             out[1] = values[1]/mat[1];
@@ -261,25 +263,25 @@ namespace linmath {
             out[3] = values[3]/mat[3];
             return out;
         }
-        void operator+=(const Mat2<T>& mat) {
+        constexpr void operator+=(const Mat2<T>& mat) {
             values[0] += mat[0];
             values[1] += mat[1];
             values[2] += mat[2];
             values[3] += mat[3];
         }
-        void operator-=(const Mat2<T>& mat) {
+        constexpr void operator-=(const Mat2<T>& mat) {
             values[0] -= mat[0];
             values[1] -= mat[1];
             values[2] -= mat[2];
             values[3] -= mat[3];
         }
-        void operator*=(const Mat2<T>& mat) {
+        constexpr void operator*=(const Mat2<T>& mat) {
             values[0] *= mat[0];
             values[1] *= mat[1];
             values[2] *= mat[2];
             values[3] *= mat[3];
         }
-        void operator/=(const Mat2<T>& mat) {
+        constexpr void operator/=(const Mat2<T>& mat) {
             values[0] /= mat[0];
             values[1] /= mat[1];
             values[2] /= mat[2];
@@ -287,13 +289,13 @@ namespace linmath {
         }
 
         // Comparison between matricies
-        bool operator==(const Mat2<T>& mat) {
+        constexpr bool operator==(const Mat2<T>& mat) {
             return  values[0] == mat[0] && 
                     values[1] == mat[1] && 
                     values[2] == mat[2] && 
                     values[3] == mat[3];
         }
-        bool operator!=(const Mat2<T>& mat) {
+        constexpr bool operator!=(const Mat2<T>& mat) {
             return  values[0] != mat[0] || 
                     values[1] != mat[1] || 
                     values[2] != mat[2] || 
@@ -301,10 +303,10 @@ namespace linmath {
         }
 
         // Array functionality
-        T& operator[](uint8_t i) {
+        constexpr T& operator[](uint8_t i) {
             return values[i];
         }
-        const T& operator[](uint8_t i) const {
+        constexpr const T& operator[](uint8_t i) const {
             return values[i];
         }
 
@@ -323,51 +325,51 @@ namespace linmath {
         }
 
         // Predefined matricies
-        static Mat2<T> zero();
-        static Mat2<T> onei(uint8_t ind);
-        static Mat2<T> oner(uint8_t row);
-        static Mat2<T> onec(uint8_t col);
-        static Mat2<T> identity();
-        static Mat2<T> one();
+        static constexpr Mat2<T> zero();
+        static constexpr Mat2<T> onei(uint8_t ind);
+        static constexpr Mat2<T> oner(uint8_t row);
+        static constexpr Mat2<T> onec(uint8_t col);
+        static constexpr Mat2<T> identity();
+        static constexpr Mat2<T> one();
     };
 
     // Predefined matricies
     template <typename T>
-    Mat2<T> Mat2<T>::zero() {
+    constexpr Mat2<T> Mat2<T>::zero() {
         return Mat2<T>(.0);
     }
     template <typename T>
-    Mat2<T> Mat2<T>::onei(uint8_t ind) {
+    constexpr Mat2<T> Mat2<T>::onei(uint8_t ind) {
         Mat2<T> mat(.0);
         mat[ind] = 1;
         return mat;
     }
     template <typename T>
-    Mat2<T> Mat2<T>::oner(uint8_t row) {
+    constexpr Mat2<T> Mat2<T>::oner(uint8_t row) {
         Mat2<T> mat(.0);
         for (uint8_t col=0; col<2; col++)
             mat[2*row + col] = 1;
         return mat;
     }
     template <typename T>
-    Mat2<T> Mat2<T>::onec(uint8_t col) {
+    constexpr Mat2<T> Mat2<T>::onec(uint8_t col) {
         Mat2<T> mat(.0);
         for (uint8_t row=0; row<2; row++)
             mat[2*row + col] = 1;
         return mat;
     }
     template <typename T>
-    Mat2<T> Mat2<T>::identity() {
+    constexpr Mat2<T> Mat2<T>::identity() {
         return Mat2<T>(1, 0, 0, 1);
     }
     template <typename T>
-    Mat2<T> Mat2<T>::one() {
+    constexpr Mat2<T> Mat2<T>::one() {
         return Mat2<T>(1);
     }
 
     // Overload functions
     template <typename T, typename K>
-    Mat2<T> operator+(const Mat2<T> mat, const K k) {
+    constexpr Mat2<T> operator+(const Mat2<T> mat, const K k) {
         Mat2<T> out = Mat2<T>();
         out[0] = mat[0] + k;
         out[1] = mat[1] + k;
@@ -376,7 +378,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat2<T> operator-(const Mat2<T> mat, const K k) {
+    constexpr Mat2<T> operator-(const Mat2<T> mat, const K k) {
         Mat2<T> out = Mat2<T>();
         out[0] = mat[0] - k;
         out[1] = mat[1] - k;
@@ -385,7 +387,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat2<T> operator*(const Mat2<T> mat, const K k) {
+    constexpr Mat2<T> operator*(const Mat2<T> mat, const K k) {
         Mat2<T> out = Mat2<T>();
         out[0] = mat[0] * k;
         out[1] = mat[1] * k;
@@ -394,7 +396,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat2<T> operator/(const Mat2<T> mat, const K k) {
+    constexpr Mat2<T> operator/(const Mat2<T> mat, const K k) {
         Mat2<T> out = Mat2<T>();
         out[0] = mat[0] / k;
         out[1] = mat[1] / k;
@@ -403,7 +405,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat2<T> operator%(const Mat2<T> mat, const K k) {
+    constexpr Mat2<T> operator%(const Mat2<T> mat, const K k) {
         Mat2<T> out = Mat2<T>();
         out[0] = mat[0] % k;
         out[1] = mat[1] % k;
@@ -4,6 +4,13 @@
 #include <cmath>
 #include <iostream>
 
+#include "cholesky.h"
+#include "eigen.h"
+#include "lu.h"
+#include "qr.h"
+#include "svd.h"
+#include "../Math/math.h"
+
 namespace linmath {
 
     template <typename T>
@@ -15,8 +22,8 @@ namespace linmath {
         public:
 
         // Constructors
-        Mat3() {}
-        Mat3(T t) {
+        constexpr Mat3() {}
+        constexpr Mat3(T t) {
             this->values[0] = t;
             this->values[1] = t;
             this->values[2] = t;
@@ -27,7 +34,7 @@ namespace linmath {
             this->values[7] = t;
             this->values[8] = t;
         }
-        Mat3(T values[9]) {
+        constexpr Mat3(T values[9]) {
             this->values[0] = values[0];
             this->values[1] = values[1];
             this->values[2] = values[2];
@@ -38,7 +45,7 @@ namespace linmath {
             this->values[7] = values[7];
             this->values[8] = values[8];
         }
-        Mat3(T values[3][3]) {
+        constexpr Mat3(T values[3][3]) {
             this->values[0] = values[0][0];
             this->values[1] = values[0][1];
             this->values[2] = values[0][2];
@@ -50,32 +57,23 @@ namespace linmath {
             this->values[8] = values[2][2];
         }
 
-        // Variadic constructor
-        template <typename... Ts>
-        Mat3(T t, Ts... ts) {
-            auto n = 9;
-            *this = Mat3(&n, t, ts...);
-        }
-        template <typename... Ts>
-        Mat3(auto* n, T t, Ts... ts) : Mat3(n, ts...) {
-            *n = *n - 1;
-            values[*n] = t;
-        }
-        Mat3(auto*){}
+        // Variadic constructor, one value per element in row major order
+        template <typename... Ts> requires (sizeof...(Ts) + 1 == 9)
+        constexpr Mat3(T t, Ts... ts) : values{t, T(ts)...} {}
 
 
         // Matrix determinant
-        T det() {
+        constexpr T det() {
             return determinant();
         }
-        T determinant() {
+        constexpr T determinant() {
             return  values[0]*( values[4]*values[8] - values[5]*values[7] )-
                     values[1]*( values[3]*values[8] - values[5]*values[6] )+
                     values[2]*( values[3]*values[7] - values[4]*values[6] );
         }
 
         // Matrix transpozition
-        void transpoze() {
+        constexpr void transpoze() {
             T t;
 
             t = values[1];
@@ -90,7 +88,7 @@ namespace linmath {
             values[5] = values[7];
             values[7] = t;
         }
-        Mat3<T> transpozed() {
+        constexpr Mat3<T> transpozed() {
             Mat3<T> mat = *this;
             mat[1] = values[3];
             mat[3] = values[1];
@@ -104,7 +102,7 @@ namespace linmath {
         }
 
         // Matrix inverse
-        void inverse() {
+        constexpr void inverse() {
             T det = determinant();
 
             Mat3<T> mat = transpozed();
@@ -121,24 +119,38 @@ namespace linmath {
 
             *this /= det;
         }
-        Mat3<T> inversed() {
+        constexpr Mat3<T> inversed() {
             Mat3<T> mat = *this;
             mat.inverse();
             return mat;
         }
 
-        // TODO
-        // Matrix pivot
-        /*void pivot() {
+        // LU factorization with partial pivoting, for solving systems without forming the inverse
+        constexpr LU<T, 3> lu()const {
+            return LU<T, 3>(values);
+        }
 
-            values[2] = values[]
+        // Cholesky factorization of a symmetric positive definite matrix, QR factorization and symmetric eigen decomposition
+        Cholesky<T, 3> cholesky()const {
+            return Cholesky<T, 3>(values);
+        }
+        QR<T, 3, 3> qr()const {
+            return QR<T, 3, 3>(values);
+        }
+        SymmetricEigen<T, 3> eigen()const {
+            return SymmetricEigen<T, 3>(values);
+        }
+
+        // Singular value decomposition, and polar decomposition into the closest rotation and a stretch
+        SVD3<T> svd()const {
+            return SVD3<T>(values);
+        }
+        Polar3<T> polar()const {
+            return Polar3<T>(values);
         }
-        Mat3<T> pivoted() {
-            return Mat3<T>(1);
-        }*/
 
         // Dot product
-        Mat3<T> dot(const Mat3<T>& mat) {
+        constexpr Mat3<T> dot(const Mat3<T>& mat) {
             Mat3<T> dot = Mat3<T>();
             dot[0] = values[0]*mat[0] + values[1]*mat[3] + values[2]*mat[6];
             dot[1] = values[0]*mat[1] + values[1]*mat[4] + values[2]*mat[7];
@@ -153,7 +165,7 @@ namespace linmath {
         }
 
         // Negation
-        Mat3<T> operator-() {
+        constexpr Mat3<T> operator-() {
             Mat3<T> mat = Mat3<T>();
             mat[0] = -values[0];
             mat[1] = -values[1];
@@ -168,7 +180,7 @@ namespace linmath {
         }
 
         // Prefix increment and decrement
-        Mat3<T> operator++() {
+        constexpr Mat3<T> operator++() {
             Mat3<T> mat = Mat3<T>();
             mat[0] = ++values[0];
             mat[1] = ++values[1];
@@ -181,7 +193,7 @@ namespace linmath {
             mat[8] = ++values[8];
             return mat;
         }
-        Mat3<T> operator--() {
+        constexpr Mat3<T> operator--() {
             Mat3<T> mat = Mat3<T>();
             mat[0] = --values[0];
             mat[1] = --values[1];
@@ -196,7 +208,7 @@ namespace linmath {
         }
 
         // Postfix increment and decrement
-        Mat3<T> operator++(int) {
+        constexpr Mat3<T> operator++(int) {
             Mat3<T> mat = Mat3<T>();
             mat[0] = values[0]++;
             mat[1] = values[1]++;
@@ -209,7 +221,7 @@ namespace linmath {
             mat[8] = values[8]++;
             return mat;
         }
-        Mat3<T> operator--(int) {
+        constexpr Mat3<T> operator--(int) {
             Mat3<T> mat = Mat3<T>();
             mat[0] = values[0]--;
             mat[1] = values[1]--;
@@ -224,7 +236,7 @@ namespace linmath {
         }
 
         // Operations with scalars
-        Mat3<T> operator+(const T t) {
+        constexpr Mat3<T> operator+(const T t) {
             Mat3<T> mat = Mat3<T>();
             mat[0] = values[0] + t;
             mat[1] = values[1] + t;
@@ -237,7 +249,7 @@ namespace linmath {
             mat[8] = values[8] + t;
             return mat;
         }
-        Mat3<T> operator-(const T t) {
+        constexpr Mat3<T> operator-(const T t) {
             Mat3<T> mat = Mat3<T>();
             mat[0] = values[0] - t;
             mat[1] = values[1] - t;
@@ -250,7 +262,7 @@ namespace linmath {
             mat[8] = values[8] - t;
             return mat;
         }
-        Mat3<T> operator*(const T t) {
+        constexpr Mat3<T> operator*(const T t) {
             Mat3<T> mat = Mat3<T>();
             mat[0] = values[0] * t;
             mat[1] = values[1] * t;
@@ -263,7 +275,7 @@ namespace linmath {
             mat[8] = values[8] * t;
             return mat;
         }
-        Mat3<T> operator/(const T t) {
+        constexpr Mat3<T> operator/(const T t) {
             Mat3<T> mat = Mat3<T>();
             mat[0] = values[0] / t;
             mat[1] = values[1] / t;
@@ -289,7 +301,7 @@ namespace linmath {
             mat[8] = values[8] % t;
             return mat;
         }
-        void operator+=(const T t) {
+        constexpr void operator+=(const T t) {
             values[0] += t;
             values[1] += t;
             values[2] += t;
@@ -300,7 +312,7 @@ namespace linmath {
             values[7] += t;
             values[8] += t;
         }
-        void operator-=(const T t) {
+        constexpr void operator-=(const T t) {
             values[0] -= t;
             values[1] -= t;
             values[2] -= t;
@@ -311,7 +323,7 @@ namespace linmath {
             values[7] -= t;
             values[8] -= t;
         }
-        void operator*=(const T t) {
+        constexpr void operator*=(const T t) {
             values[0] *= t;
             values[1] *= t;
             values[2] *= t;
@@ -322,7 +334,7 @@ namespace linmath {
             values[7] *= t;
             values[8] *= t;
         }
-        void operator/=(const T t) {
+        constexpr void operator/=(const T t) {
             values[0] /= t;
             values[1] /= t;
             values[2] /= t;
@@ -333,7 +345,7 @@ namespace linmath {
             values[7] /= t;
             values[8] /= t;
         }
-        void operator%=(const T t) {
+        constexpr void operator%=(const T t) {
             values[0] %= t;
             values[1] %= t;
             values[2] %= t;
@@ -346,7 +358,7 @@ namespace linmath {
         }
 
         // Operations with matricies
-        Mat3<T> operator+(const Mat3<T>& mat) {
+        constexpr Mat3<T> operator+(const Mat3<T>& mat) {
             Mat3<T> out = Mat3<T>();
             out[0] = values[0]+mat[0];
             out[1] = values[1]+mat[1];
@@ -359,7 +371,7 @@ namespace linmath {
             out[8] = values[8]+mat[8];
             return out;
         }
-        Mat3<T> operator-(const Mat3<T>& mat) {
+        constexpr Mat3<T> operator-(const Mat3<T>& mat) {
             Mat3<T> out = Mat3<T>();
             out[0] = values[0]-mat[0];
             out[1] = values[1]-mat[1];
@@ -372,7 +384,7 @@ namespace linmath {
             out[8] = values[8]-mat[8];
             return out;
         }
-        Mat3<T> operator*(const Mat3<T>& mat) {
+        constexpr Mat3<T> operator*(const Mat3<T>& mat) {
             Mat3<T> out = Mat3<T>();
             out[0] = values[0]*mat[0];
             out[1] = values[1]*mat[1];
@@ -385,7 +397,7 @@ namespace linmath {
             out[8] = values[8]*mat[8];
             return out;
         }
-        Mat3<T> operator/(const Mat3<T>& mat) {
+        constexpr Mat3<T> operator/(const Mat3<T>& mat) {
             Mat3<T> out = Mat3<T>();
             out[0] = values[0]/mat[0];
             out[1] = values[1]/mat[1];
@@ -398,7 +410,7 @@ namespace linmath {
             out[8] = values[8]/mat[8];
             return out;
         }
-        void operator+=(const Mat3<T>& mat) {
+        constexpr void operator+=(const Mat3<T>& mat) {
             values[0] += mat[0];
             values[1] += mat[1];
             values[2] += mat[2];
@@ -409,7 +421,7 @@ namespace linmath {
             values[7] += mat[7];
             values[8] += mat[8];
         }
-        void operator-=(const Mat3<T>& mat) {
+        constexpr void operator-=(const Mat3<T>& mat) {
             values[0] -= mat[0];
             values[1] -= mat[1];
             values[2] -= mat[2];
@@ -420,7 +432,7 @@ namespace linmath {
             values[7] -= mat[7];
             values[8] -= mat[8];
         }
-        void operator*=(const Mat3<T>& mat) {
+        constexpr void operator*=(const Mat3<T>& mat) {
             values[0] *= mat[0];
             values[1] *= mat[1];
             values[2] *= mat[2];
@@ -431,7 +443,7 @@ namespace linmath {
             values[7] *= mat[7];
             values[8] *= mat[8];
         }
-        void operator/=(const Mat3<T>& mat) {
+        constexpr void operator/=(const Mat3<T>& mat) {
             values[0] /= mat[0];
             values[1] /= mat[1];
             values[2] /= mat[2];
@@ -444,7 +456,7 @@ namespace linmath {
         }
 
         // Comparison between matricies
-        bool operator==(const Mat3<T>& mat) {
+        constexpr bool operator==(const Mat3<T>& mat) {
             return  values[0] == mat[0] && 
                     values[1] == mat[1] && 
                     values[2] == mat[2] && 
@@ -455,7 +467,7 @@ namespace linmath {
                     values[7] == mat[7] && 
                     values[8] == mat[8];
         }
-        bool operator!=(const Mat3<T>& mat) {
+        constexpr bool operator!=(const Mat3<T>& mat) {
             return  values[0] != mat[0] || 
                     values[1] != mat[1] || 
                     values[2] != mat[2] || 
@@ -468,10 +480,10 @@ namespace linmath {
         }
 
         // Array functionality
-        T& operator[](uint8_t i) {
+        constexpr T& operator[](uint8_t i) {
             return values[i];
         }
-        const T& operator[](uint8_t i) const {
+        constexpr const T& operator[](uint8_t i) const {
             return values[i];
         }
 
@@ -495,75 +507,76 @@ namespace linmath {
         }
 
         // Predefined matricies
-        static Mat3<T> zero();
-        static Mat3<T> onei(uint8_t ind);
-        static Mat3<T> oner(uint8_t row);
-        static Mat3<T> onec(uint8_t col);
-        static Mat3<T> identity();
-        static Mat3<T> one();
+        static constexpr Mat3<T> zero();
+        static constexpr Mat3<T> onei(uint8_t ind);
+        static constexpr Mat3<T> oner(uint8_t row);
+        static constexpr Mat3<T> onec(uint8_t col);
+        static constexpr Mat3<T> identity();
+        static constexpr Mat3<T> one();
 
         // Transformation matricies
-        static Mat3<T> translation(T tx, T ty);
-        static Mat3<T> rotation(T ang);
-        static Mat3<T> rotationDeg(T ang);
-        static Mat3<T> scale(T sx, T sy);
+        static constexpr Mat3<T> translation(T tx, T ty);
+        static constexpr Mat3<T> rotation(T ang);
+        static constexpr Mat3<T> rotationDeg(T ang);
+        static constexpr Mat3<T> scale(T sx, T sy);
     };
 
     // Predefined matricies
     template <typename T>
-    Mat3<T> Mat3<T>::zero() {
+    constexpr Mat3<T> Mat3<T>::zero() {
         return Mat3<T>(.0);
     }
     template <typename T>
-    Mat3<T> Mat3<T>::onei(uint8_t ind) {
+    constexpr Mat3<T> Mat3<T>::onei(uint8_t ind) {
         Mat3<T> mat(.0);
         mat[ind] = 1;
         return mat;
     }
     template <typename T>
-    Mat3<T> Mat3<T>::oner(uint8_t row) {
+    constexpr Mat3<T> Mat3<T>::oner(uint8_t row) {
         Mat3<T> mat(.0);
         for (uint8_t col=0; col<3; col++)
             mat[3*row + col] = 1;
         return mat;
     }
     template <typename T>
-    Mat3<T> Mat3<T>::onec(uint8_t col) {
+    constexpr Mat3<T> Mat3<T>::onec(uint8_t col) {
         Mat3<T> mat(.0);
         for (uint8_t row=0; row<3; row++)
             mat[3*row + col] = 1;
         return mat;
     }
     template <typename T>
-    Mat3<T> Mat3<T>::identity() {
+    constexpr Mat3<T> Mat3<T>::identity() {
         return Mat3<T>(1, 0, 0, 0, 1, 0, 0, 0, 1);
     }
     template <typename T>
-    Mat3<T> Mat3<T>::one() {
+    constexpr Mat3<T> Mat3<T>::one() {
         return Mat3<T>(1);
     }
 
     // Transformation matricies
     template<typename T>
-    Mat3<T> Mat3<T>::translation(T tx, T ty) {
+    constexpr Mat3<T> Mat3<T>::translation(T tx, T ty) {
         return Mat3<T>(1, 0, 0, 0, 1, 0, tx, ty, 1);
     }
     template<typename T>
-    Mat3<T> Mat3<T>::rotation(T ang) {
-        return Mat3<T>(cos(ang), -sin(ang), 0, sin(ang), cos(ang), 0, 0, 0, 1);
+    constexpr Mat3<T> Mat3<T>::rotation(T ang) {
+        auto [s, c] = math::sincos(ang);
+        return Mat3<T>(c, -s, 0, s, c, 0, 0, 0, 1);
     }
     template<typename T>
-    Mat3<T> Mat3<T>::rotationDeg(T ang) {
-        return rotation(ang*3.14159265/180);
+    constexpr Mat3<T> Mat3<T>::rotationDeg(T ang) {
+        return rotation(math::radians(ang));
     }
     template<typename T>
-    Mat3<T> Mat3<T>::scale(T sx, T sy) {
+    constexpr Mat3<T> Mat3<T>::scale(T sx, T sy) {
         return Mat3<T>(sx, 0, 0, 0, sy, 0, 0, 0, 1);
     }
 
     // Overload functions
     template <typename T, typename K>
-    Mat3<T> operator+(const Mat3<T> mat, const K k) {
+    constexpr Mat3<T> operator+(const Mat3<T> mat, const K k) {
         Mat3<T> out = Mat3<T>();
         out[0] = mat[0] + k;
         out[1] = mat[1] + k;
@@ -577,7 +590,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat3<T> operator-(const Mat3<T> mat, const K k) {
+    constexpr Mat3<T> operator-(const Mat3<T> mat, const K k) {
         Mat3<T> out = Mat3<T>();
         out[0] = mat[0] - k;
         out[1] = mat[1] - k;
@@ -591,7 +604,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat3<T> operator*(const Mat3<T> mat, const K k) {
+    constexpr Mat3<T> operator*(const Mat3<T> mat, const K k) {
         Mat3<T> out = Mat3<T>();
         out[0] = mat[0] * k;
         out[1] = mat[1] * k;
@@ -605,7 +618,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat3<T> operator/(const Mat3<T> mat, const K k) {
+    constexpr Mat3<T> operator/(const Mat3<T> mat, const K k) {
         Mat3<T> out = Mat3<T>();
         out[0] = mat[0] / k;
         out[1] = mat[1] / k;
@@ -619,7 +632,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat3<T> operator%(const Mat3<T> mat, const K k) {
+    constexpr Mat3<T> operator%(const Mat3<T> mat, const K k) {
         Mat3<T> out = Mat3<T>();
         out[0] = mat[0] % k;
         out[1] = mat[1] % k;
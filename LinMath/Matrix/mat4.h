@@ -4,10 +4,20 @@
 #include <cmath>
 #include <iostream>
 
+#include "cholesky.h"
+#include "eigen.h"
+#include "lu.h"
+#include "qr.h"
+#include "svd.h"
+#include "../Math/math.h"
+#include "../Simd/aligned.h"
+#include "../Simd/mat4.h"
+
 namespace linmath {
 
+    // Aligned to a cache line, the 16 values of a Mat4<float> are exactly one and a Mat4<double> spans two
     template <typename T>
-    class Mat4 {
+    class alignas(simd::alignment<T, 16>) Mat4 {
 
         protected:
         T values[16];
@@ -15,8 +25,8 @@ namespace linmath {
         public:
 
         // Constructors
-        Mat4() {}
-        Mat4(T t) {
+        constexpr Mat4() {}
+        constexpr Mat4(T t) {
             this->values[0] = t;
             this->values[1] = t;
             this->values[2] = t;
@@ -34,7 +44,7 @@ namespace linmath {
             this->values[14] = t;
             this->values[15] = t;
         }
-        Mat4(T values[9]) {
+        constexpr Mat4(T values[9]) {
             this->values[0] = values[0];
             this->values[1] = values[1];
             this->values[2] = values[2];
@@ -52,7 +62,7 @@ namespace linmath {
             this->values[14] = values[14];
             this->values[15] = values[15];
         }
-        Mat4(T values[4][4]) {
+        constexpr Mat4(T values[4][4]) {
             this->values[0] = values[0][0];
             this->values[1] = values[0][1];
             this->values[2] = values[0][2];
@@ -71,53 +81,35 @@ namespace linmath {
             this->values[15] = values[3][3];
         }
 
-        // Variadic constructor
-        template <typename... Ts>
-        Mat4(T t, Ts... ts) {
-            auto n = 16;
-            *this = Mat4(&n, t, ts...);
-        }
-        template <typename... Ts>
-        Mat4(auto* n, T t, Ts... ts) : Mat4(n, ts...) {
-            *n = *n - 1;
-            values[*n] = t;
-        }
-        Mat4(auto*){}
+        // Variadic constructor, one value per element in row major order
+        template <typename... Ts> requires (sizeof...(Ts) + 1 == 16)
+        constexpr Mat4(T t, Ts... ts) : values{t, T(ts)...} {}
 
 
         // Matrix determinant
-        T det() {
+        constexpr T det() {
             return determinant();
         }
-        T determinant() {
-            return  values[0]* (values[5]*values[10]*values[15] -
-                                values[5]*values[11]*values[14] -
-                                values[9]*values[6]*values[15] +
-                                values[9]*values[7]*values[14] +
-                                values[13]*values[6]*values[11] -
-                                values[13]*values[7]*values[10]) +
-                    values[1]* (-values[4]*values[10]*values[15] +
-                                values[4]*values[11]*values[14] +
-                                values[8]*values[6]*values[15] -
-                                values[8]*values[7]*values[14] -
-                                values[12]*values[6]*values[11] +
-                                values[12]*values[7]*values[10]) +
-                    values[2]* (values[4]*values[9]*values[15] -
-                                values[4]*values[11]*values[13] -
-                                values[8]*values[5]*values[15] +
-                                values[8]*values[7]*values[13] +
-                                values[12]*values[5]*values[11] -
-                                values[12]*values[7]*values[9]) +
-                    values[3]* (-values[4]*values[9]*values[14] +
-                                values[4]*values[10]*values[13] +
-                                values[8]*values[5]*values[14] -
-                                values[8]*values[6]*values[13] -
-                                values[12]*values[5]*values[10] +
-                                values[12]*values[6]*values[9]);
+        constexpr T determinant() {
+            // Laplace expansion by the 2x2 minors of the top two rows and the complementary ones of the bottom two,
+            // each minor is computed once
+            T s0 = values[0]*values[5] - values[4]*values[1];
+            T s1 = values[0]*values[6] - values[4]*values[2];
+            T s2 = values[0]*values[7] - values[4]*values[3];
+            T s3 = values[1]*values[6] - values[5]*values[2];
+            T s4 = values[1]*values[7] - values[5]*values[3];
+            T s5 = values[2]*values[7] - values[6]*values[3];
+            T c5 = values[10]*values[15] - values[14]*values[11];
+            T c4 = values[9]*values[15] - values[13]*values[11];
+            T c3 = values[9]*values[14] - values[13]*values[10];
+            T c2 = values[8]*values[15] - values[12]*values[11];
+            T c1 = values[8]*values[14] - values[12]*values[10];
+            T c0 = values[8]*values[13] - values[12]*values[9];
+            return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
         }
 
         // Matrix transpozition
-        void transpoze() {
+        constexpr void transpoze() {
             T t;
 
             t = values[1];
@@ -144,7 +136,7 @@ namespace linmath {
             values[11] = values[14];
             values[14] = t;
         }
-        Mat4<T> transpozed() {
+        constexpr Mat4<T> transpozed() {
             Mat4<T> mat = *this;
             mat[1] = values[4];
             mat[4] = values[1];
@@ -167,143 +159,42 @@ namespace linmath {
         }
 
         // Matrix inverse
-        void inverse() {
-            Mat4<T> mat = *this;
-
-            values[0] = mat[5]  * mat[10] * mat[15] - 
-                 mat[5]  * mat[11] * mat[14] - 
-                 mat[9]  * mat[6]  * mat[15] + 
-                 mat[9]  * mat[7]  * mat[14] +
-                 mat[13] * mat[6]  * mat[11] - 
-                 mat[13] * mat[7]  * mat[10];
-    
-            values[4] = -mat[4]  * mat[10] * mat[15] + 
-                    mat[4]  * mat[11] * mat[14] + 
-                    mat[8]  * mat[6]  * mat[15] - 
-                    mat[8]  * mat[7]  * mat[14] - 
-                    mat[12] * mat[6]  * mat[11] + 
-                    mat[12] * mat[7]  * mat[10];
-        
-            values[8] = mat[4]  * mat[9] * mat[15] - 
-                    mat[4]  * mat[11] * mat[13] - 
-                    mat[8]  * mat[5] * mat[15] + 
-                    mat[8]  * mat[7] * mat[13] + 
-                    mat[12] * mat[5] * mat[11] - 
-                    mat[12] * mat[7] * mat[9];
-        
-            values[12] = -mat[4]  * mat[9] * mat[14] + 
-                    mat[4]  * mat[10] * mat[13] +
-                    mat[8]  * mat[5] * mat[14] - 
-                    mat[8]  * mat[6] * mat[13] - 
-                    mat[12] * mat[5] * mat[10] + 
-                    mat[12] * mat[6] * mat[9];
-        
-            values[1] = -mat[1]  * mat[10] * mat[15] + 
-                    mat[1]  * mat[11] * mat[14] + 
-                    mat[9]  * mat[2] * mat[15] - 
-                    mat[9]  * mat[3] * mat[14] - 
-                    mat[13] * mat[2] * mat[11] + 
-                    mat[13] * mat[3] * mat[10];
-        
-            values[5] = mat[0]  * mat[10] * mat[15] - 
-                    mat[0]  * mat[11] * mat[14] - 
-                    mat[8]  * mat[2] * mat[15] + 
-                    mat[8]  * mat[3] * mat[14] + 
-                    mat[12] * mat[2] * mat[11] - 
-                    mat[12] * mat[3] * mat[10];
-        
-            values[9] = -mat[0]  * mat[9] * mat[15] + 
-                    mat[0]  * mat[11] * mat[13] + 
-                    mat[8]  * mat[1] * mat[15] - 
-                    mat[8]  * mat[3] * mat[13] - 
-                    mat[12] * mat[1] * mat[11] + 
-                    mat[12] * mat[3] * mat[9];
-        
-            values[13] = mat[0]  * mat[9] * mat[14] - 
-                    mat[0]  * mat[10] * mat[13] - 
-                    mat[8]  * mat[1] * mat[14] + 
-                    mat[8]  * mat[2] * mat[13] + 
-                    mat[12] * mat[1] * mat[10] - 
-                    mat[12] * mat[2] * mat[9];
-        
-            values[2] = mat[1]  * mat[6] * mat[15] - 
-                    mat[1]  * mat[7] * mat[14] - 
-                    mat[5]  * mat[2] * mat[15] + 
-                    mat[5]  * mat[3] * mat[14] + 
-                    mat[13] * mat[2] * mat[7] - 
-                    mat[13] * mat[3] * mat[6];
-        
-            values[6] = -mat[0]  * mat[6] * mat[15] + 
-                    mat[0]  * mat[7] * mat[14] + 
-                    mat[4]  * mat[2] * mat[15] - 
-                    mat[4]  * mat[3] * mat[14] - 
-                    mat[12] * mat[2] * mat[7] + 
-                    mat[12] * mat[3] * mat[6];
-        
-            values[10] = mat[0]  * mat[5] * mat[15] - 
-                    mat[0]  * mat[7] * mat[13] - 
-                    mat[4]  * mat[1] * mat[15] + 
-                    mat[4]  * mat[3] * mat[13] + 
-                    mat[12] * mat[1] * mat[7] - 
-                    mat[12] * mat[3] * mat[5];
-        
-            values[14] = -mat[0]  * mat[5] * mat[14] + 
-                    mat[0]  * mat[6] * mat[13] + 
-                    mat[4]  * mat[1] * mat[14] - 
-                    mat[4]  * mat[2] * mat[13] - 
-                    mat[12] * mat[1] * mat[6] + 
-                    mat[12] * mat[2] * mat[5];
-        
-            values[3] = -mat[1] * mat[6] * mat[11] + 
-                    mat[1] * mat[7] * mat[10] + 
-                    mat[5] * mat[2] * mat[11] - 
-                    mat[5] * mat[3] * mat[10] - 
-                    mat[9] * mat[2] * mat[7] + 
-                    mat[9] * mat[3] * mat[6];
-        
-            values[7] = mat[0] * mat[6] * mat[11] - 
-                    mat[0] * mat[7] * mat[10] - 
-                    mat[4] * mat[2] * mat[11] + 
-                    mat[4] * mat[3] * mat[10] + 
-                    mat[8] * mat[2] * mat[7] - 
-                    mat[8] * mat[3] * mat[6];
-        
-            values[11] = -mat[0] * mat[5] * mat[11] + 
-                    mat[0] * mat[7] * mat[9] + 
-                    mat[4] * mat[1] * mat[11] - 
-                    mat[4] * mat[3] * mat[9] - 
-                    mat[8] * mat[1] * mat[7] + 
-                    mat[8] * mat[3] * mat[5];
-        
-            values[15] = mat[0] * mat[5] * mat[10] - 
-                    mat[0] * mat[6] * mat[9] - 
-                    mat[4] * mat[1] * mat[10] + 
-                    mat[4] * mat[2] * mat[9] + 
-                    mat[8] * mat[1] * mat[6] - 
-                    mat[8] * mat[2] * mat[5];
-        
-            T det = mat[0] * values[0] + mat[1] * values[4] + mat[2] * values[8] + mat[3] * values[12];
-        
-            *this /= det;
+        constexpr void inverse() {
+            simd::scalar::mat4Inverse(values, values);
         }
-        Mat4<T> inversed() {
+        constexpr Mat4<T> inversed() {
             Mat4<T> mat = *this;
             mat.inverse();
             return mat;
         }
 
-        // TODO
-        // Matrix pivot
-        /*void pivot() {
+        // LU factorization with partial pivoting, for solving systems without forming the inverse
+        constexpr LU<T, 4> lu()const {
+            return LU<T, 4>(values);
+        }
+
+        // Cholesky factorization of a symmetric positive definite matrix, QR factorization and symmetric eigen decomposition
+        Cholesky<T, 4> cholesky()const {
+            return Cholesky<T, 4>(values);
+        }
+        QR<T, 4, 4> qr()const {
+            return QR<T, 4, 4>(values);
+        }
+        SymmetricEigen<T, 4> eigen()const {
+            return SymmetricEigen<T, 4>(values);
+        }
 
-            values[2] = values[]
+        // Polar decomposition of the top left 3x3, the rotation and the scale and shear of a transform
+        // without its translation or projection
+        Polar3<T> polar()const {
+            T linear[9] = { values[0], values[1], values[2],
+                            values[4], values[5], values[6],
+                            values[8], values[9], values[10]};
+            return Polar3<T>(linear);
         }
-        Mat4<T> pivoted() {
-            return Mat4<T>(1);
-        }*/
 
         // Dot product
-        Mat4<T> dot(const Mat4<T>& mat) {
+        constexpr Mat4<T> dot(const Mat4<T>& mat) {
             Mat4<T> dot = Mat4<T>(1);
             dot[0] = mat[0]*values[0] + mat[4]*values[1] + mat[8]*values[2] + mat[12]*values[3];
             dot[1] = mat[1]*values[0] + mat[5]*values[1] + mat[9]*values[2] + mat[13]*values[3];
@@ -325,7 +216,7 @@ namespace linmath {
         }
 
         // Negation
-        Mat4<T> operator-() {
+        constexpr Mat4<T> operator-() {
             Mat4<T> mat = Mat4<T>();
             mat[0] = -values[0];
             mat[1] = -values[1];
@@ -347,7 +238,7 @@ namespace linmath {
         }
 
         // Prefix increment and decrement
-        Mat4<T> operator++() {
+        constexpr Mat4<T> operator++() {
             Mat4<T> mat = Mat4<T>();
             mat[0] = ++values[0];
             mat[1] = ++values[1];
@@ -367,7 +258,7 @@ namespace linmath {
             mat[15] = ++values[15];
             return mat;
         }
-        Mat4<T> operator--() {
+        constexpr Mat4<T> operator--() {
             Mat4<T> mat = Mat4<T>();
             mat[0] = --values[0];
             mat[1] = --values[1];
@@ -389,7 +280,7 @@ namespace linmath {
         }
 
         // Postfix increment and decrement
-        Mat4<T> operator++(int) {
+        constexpr Mat4<T> operator++(int) {
             Mat4<T> mat = Mat4<T>();
             mat[0] = values[0]++;
             mat[1] = values[1]++;
@@ -409,7 +300,7 @@ namespace linmath {
             mat[15] = values[15]++;
             return mat;
         }
-        Mat4<T> operator--(int) {
+        constexpr Mat4<T> operator--(int) {
             Mat4<T> mat = Mat4<T>();
             mat[0] = values[0]--;
             mat[1] = values[1]--;
@@ -431,7 +322,7 @@ namespace linmath {
         }
 
         // Operations with scalars
-        Mat4<T> operator+(const T t) {
+        constexpr Mat4<T> operator+(const T t) {
             Mat4<T> mat = Mat4<T>();
             mat[0] = values[0] + t;
             mat[1] = values[1] + t;
@@ -451,7 +342,7 @@ namespace linmath {
             mat[15] = values[15] + t;
             return mat;
         }
-        Mat4<T> operator-(const T t) {
+        constexpr Mat4<T> operator-(const T t) {
             Mat4<T> mat = Mat4<T>();
             mat[0] = values[0] - t;
             mat[1] = values[1] - t;
@@ -471,7 +362,7 @@ namespace linmath {
             mat[15] = values[15] - t;
             return mat;
         }
-        Mat4<T> operator*(const T t) {
+        constexpr Mat4<T> operator*(const T t) {
             Mat4<T> mat = Mat4<T>();
             mat[0] = values[0] * t;
             mat[1] = values[1] * t;
@@ -491,7 +382,7 @@ namespace linmath {
             mat[15] = values[15] * t;
             return mat;
         }
-        Mat4<T> operator/(const T t) {
+        constexpr Mat4<T> operator/(const T t) {
             Mat4<T> mat = Mat4<T>();
             mat[0] = values[0] / t;
             mat[1] = values[1] / t;
@@ -531,7 +422,7 @@ namespace linmath {
             mat[15] = values[15] % t;
             return mat;
         }
-        void operator+=(const T t) {
+        constexpr void operator+=(const T t) {
             values[0] += t;
             values[1] += t;
             values[2] += t;
@@ -549,7 +440,7 @@ namespace linmath {
             values[14] += t;
             values[15] += t;
         }
-        void operator-=(const T t) {
+        constexpr void operator-=(const T t) {
             values[0] -= t;
             values[1] -= t;
             values[2] -= t;
@@ -567,7 +458,7 @@ namespace linmath {
             values[14] -= t;
             values[15] -= t;
         }
-        void operator*=(const T t) {
+        constexpr void operator*=(const T t) {
             values[0] *= t;
             values[1] *= t;
             values[2] *= t;
@@ -585,7 +476,7 @@ namespace linmath {
             values[14] *= t;
             values[15] *= t;
         }
-        void operator/=(const T t) {
+        constexpr void operator/=(const T t) {
             values[0] /= t;
             values[1] /= t;
             values[2] /= t;
@@ -603,7 +494,7 @@ namespace linmath {
             values[14] /= t;
             values[15] /= t;
         }
-        void operator%=(const T t) {
+        constexpr void operator%=(const T t) {
             values[0] %= t;
             values[1] %= t;
             values[2] %= t;
@@ -623,7 +514,7 @@ namespace linmath {
         }
 
         // Operations with matricies
-        Mat4<T> operator+(const Mat4<T>& mat) {
+        constexpr Mat4<T> operator+(const Mat4<T>& mat) {
             Mat4<T> out = Mat4<T>();
             out[0] = values[0]+mat[0];
             out[1] = values[1]+mat[1];
@@ -643,7 +534,7 @@ namespace linmath {
             out[15] = values[15]+mat[15];
             return out;
         }
-        Mat4<T> operator-(const Mat4<T>& mat) {
+        constexpr Mat4<T> operator-(const Mat4<T>& mat) {
             Mat4<T> out = Mat4<T>();
             out[0] = values[0]-mat[0];
             out[1] = values[1]-mat[1];
@@ -663,7 +554,7 @@ namespace linmath {
             out[15] = values[15]-mat[15];
             return out;
         }
-        Mat4<T> operator*(const Mat4<T>& mat) {
+        constexpr Mat4<T> operator*(const Mat4<T>& mat) {
             Mat4<T> out = Mat4<T>();
             out[0] = values[0]*mat[0];
             out[1] = values[1]*mat[1];
@@ -683,7 +574,7 @@ namespace linmath {
             out[15] = values[15]*mat[15];
             return out;
         }
-        Mat4<T> operator/(const Mat4<T>& mat) {
+        constexpr Mat4<T> operator/(const Mat4<T>& mat) {
             Mat4<T> out = Mat4<T>();
             out[0] = values[0]/mat[0];
             out[1] = values[1]/mat[1];
@@ -703,7 +594,7 @@ namespace linmath {
             out[15] = values[15]/mat[15];
             return out;
         }
-        void operator+=(const Mat4<T>& mat) {
+        constexpr void operator+=(const Mat4<T>& mat) {
             values[0] += mat[0];
             values[1] += mat[1];
             values[2] += mat[2];
@@ -721,7 +612,7 @@ namespace linmath {
             values[14] += mat[14];
             values[15] += mat[15];
         }
-        void operator-=(const Mat4<T>& mat) {
+        constexpr void operator-=(const Mat4<T>& mat) {
             values[0] -= mat[0];
             values[1] -= mat[1];
             values[2] -= mat[2];
@@ -739,7 +630,7 @@ namespace linmath {
             values[14] -= mat[14];
             values[15] -= mat[15];
         }
-        void operator*=(const Mat4<T>& mat) {
+        constexpr void operator*=(const Mat4<T>& mat) {
             values[0] *= mat[0];
             values[1] *= mat[1];
             values[2] *= mat[2];
@@ -757,7 +648,7 @@ namespace linmath {
             values[14] *= mat[14];
             values[15] *= mat[15];
         }
-        void operator/=(const Mat4<T>& mat) {
+        constexpr void operator/=(const Mat4<T>& mat) {
             values[0] /= mat[0];
             values[1] /= mat[1];
             values[2] /= mat[2];
@@ -777,7 +668,7 @@ namespace linmath {
         }
 
         // Comparison between matricies
-        bool operator==(const Mat4<T>& mat) {
+        constexpr bool operator==(const Mat4<T>& mat) {
             return  values[0] == mat[0] && 
                     values[1] == mat[1] && 
                     values[2] == mat[2] && 
@@ -795,7 +686,7 @@ namespace linmath {
                     values[14] == mat[14] && 
                     values[15] == mat[15];
         }
-        bool operator!=(const Mat4<T>& mat) {
+        constexpr bool operator!=(const Mat4<T>& mat) {
             return  values[0] != mat[0] || 
                     values[1] != mat[1] || 
                     values[2] != mat[2] || 
@@ -815,10 +706,10 @@ namespace linmath {
         }
 
         // Array functionality
-        T& operator[](uint8_t i) {
+        constexpr T& operator[](uint8_t i) {
             return values[i];
         }
-        const T& operator[](uint8_t i) const {
+        constexpr const T& operator[](uint8_t i) const {
             return values[i];
         }
 
@@ -849,113 +740,151 @@ namespace linmath {
         }
 
         // Predefined matricies
-        static Mat4<T> zero();
-        static Mat4<T> onei(uint8_t ind);
-        static Mat4<T> oner(uint8_t row);
-        static Mat4<T> onec(uint8_t col);
-        static Mat4<T> identity();
-        static Mat4<T> one();
+        static constexpr Mat4<T> zero();
+        static constexpr Mat4<T> onei(uint8_t ind);
+        static constexpr Mat4<T> oner(uint8_t row);
+        static constexpr Mat4<T> onec(uint8_t col);
+        static constexpr Mat4<T> identity();
+        static constexpr Mat4<T> one();
 
         // Transformation matricies
-        static Mat4<T> translation(T tx, T ty, T tz);
-        static Mat4<T> rotationX(T ang);
-        static Mat4<T> rotationDegX(T ang);
-        static Mat4<T> rotationY(T ang);
-        static Mat4<T> rotationDegY(T ang);
-        static Mat4<T> rotationZ(T ang);
-        static Mat4<T> rotationDegZ(T ang);
-        static Mat4<T> scale(T sx, T sy, T sz);
+        static constexpr Mat4<T> translation(T tx, T ty, T tz);
+        static constexpr Mat4<T> rotationX(T ang);
+        static constexpr Mat4<T> rotationDegX(T ang);
+        static constexpr Mat4<T> rotationY(T ang);
+        static constexpr Mat4<T> rotationDegY(T ang);
+        static constexpr Mat4<T> rotationZ(T ang);
+        static constexpr Mat4<T> rotationDegZ(T ang);
+        static constexpr Mat4<T> scale(T sx, T sy, T sz);
     };
 
     // Predefined matricies
     template <typename T>
-    Mat4<T> Mat4<T>::zero() {
+    constexpr Mat4<T> Mat4<T>::zero() {
         return Mat4<T>(.0);
     }
     template <typename T>
-    Mat4<T> Mat4<T>::onei(uint8_t ind) {
+    constexpr Mat4<T> Mat4<T>::onei(uint8_t ind) {
         Mat4<T> mat(.0);
         mat[ind] = 1;
         return mat;
     }
     template <typename T>
-    Mat4<T> Mat4<T>::oner(uint8_t row) {
+    constexpr Mat4<T> Mat4<T>::oner(uint8_t row) {
         Mat4<T> mat(.0);
         for (uint8_t col=0; col<4; col++)
             mat[4*row + col] = 1;
         return mat;
     }
     template <typename T>
-    Mat4<T> Mat4<T>::onec(uint8_t col) {
+    constexpr Mat4<T> Mat4<T>::onec(uint8_t col) {
         Mat4<T> mat(.0);
         for (uint8_t row=0; row<4; row++)
             mat[4*row + col] = 1;
         return mat;
     }
     template <typename T>
-    Mat4<T> Mat4<T>::identity() {
+    constexpr Mat4<T> Mat4<T>::identity() {
         return Mat4<T>( 1, 0, 0, 0,
                         0, 1, 0, 0,
                         0, 0, 1, 0,
                         0, 0, 0, 1);
     }
     template <typename T>
-    Mat4<T> Mat4<T>::one() {
+    constexpr Mat4<T> Mat4<T>::one() {
         return Mat4<T>(1);
     }
 
     // Transformation matricies
     template<typename T>
-    Mat4<T> Mat4<T>::translation(T tx, T ty, T tz) {
+    constexpr Mat4<T> Mat4<T>::translation(T tx, T ty, T tz) {
         return Mat4<T>( 1, 0, 0, 0, 
                         0, 1, 0, 0, 
                         0, 0, 1, 0, 
                         tx, ty, tz, 1);
     }
     template<typename T>
-    Mat4<T> Mat4<T>::rotationX(T ang) {
+    constexpr Mat4<T> Mat4<T>::rotationX(T ang) {
+        auto [s, c] = math::sincos(ang);
         return Mat4<T>( 1, 0, 0, 0, 
-                        0, cos(ang), sin(ang), 0, 
-                        0, -sin(ang), cos(ang), 0, 
+                        0, c, s, 0, 
+                        0, -s, c, 0, 
                         0, 0, 0, 1);
     }
     template<typename T>
-    Mat4<T> Mat4<T>::rotationDegX(T ang) {
-        return rotationX(ang*3.14159265/180);
+    constexpr Mat4<T> Mat4<T>::rotationDegX(T ang) {
+        return rotationX(math::radians(ang));
     }
     template<typename T>
-    Mat4<T> Mat4<T>::rotationY(T ang) {
-        return Mat4<T>( cos(ang), 0, -sin(ang), 0, 
+    constexpr Mat4<T> Mat4<T>::rotationY(T ang) {
+        auto [s, c] = math::sincos(ang);
+        return Mat4<T>( c, 0, -s, 0, 
                         0, 1, 0, 0,
-                        sin(ang), 0, cos(ang), 0,
+                        s, 0, c, 0,
                         0, 0, 0, 1);
     }
     template<typename T>
-    Mat4<T> Mat4<T>::rotationDegY(T ang) {
-        return rotationY(ang*3.14159265/180);
+    constexpr Mat4<T> Mat4<T>::rotationDegY(T ang) {
+        return rotationY(math::radians(ang));
     }
     template<typename T>
-    Mat4<T> Mat4<T>::rotationZ(T ang) {
-        return Mat4<T>( cos(ang), sin(ang), 0, 0, 
-                        -sin(ang), cos(ang), 0, 0,
+    constexpr Mat4<T> Mat4<T>::rotationZ(T ang) {
+        auto [s, c] = math::sincos(ang);
+        return Mat4<T>( c, s, 0, 0, 
+                        -s, c, 0, 0,
                         0, 0, 1, 0,
                         0, 0, 0, 1);
     }
     template<typename T>
-    Mat4<T> Mat4<T>::rotationDegZ(T ang) {
-        return rotationZ(ang*3.14159265/180);
+    constexpr Mat4<T> Mat4<T>::rotationDegZ(T ang) {
+        return rotationZ(math::radians(ang));
     }
     template<typename T>
-    Mat4<T> Mat4<T>::scale(T sx, T sy, T sz) {
+    constexpr Mat4<T> Mat4<T>::scale(T sx, T sy, T sz) {
         return Mat4<T>( sx, 0, 0, 0, 
                         0, sy, 0, 0,
                         0, 0, sz, 0,
                         0, 0, 0, 1);
     }
 
+    // Vectorized kernels, constant expressions take the scalar ones
+    template <>
+    constexpr Mat4<float> Mat4<float>::dot(const Mat4<float>& mat) {
+        Mat4<float> dot = Mat4<float>();
+        if (std::is_constant_evaluated())
+            simd::scalar::mat4Dot(values, mat.values, dot.values);
+        else
+            simd::mat4Dot(values, mat.values, dot.values);
+        return dot;
+    }
+    template <>
+    constexpr Mat4<double> Mat4<double>::dot(const Mat4<double>& mat) {
+        Mat4<double> dot = Mat4<double>();
+        if (std::is_constant_evaluated())
+            simd::scalar::mat4Dot(values, mat.values, dot.values);
+        else
+            simd::mat4Dot(values, mat.values, dot.values);
+        return dot;
+    }
+
+    template <>
+    constexpr void Mat4<float>::inverse() {
+        if (std::is_constant_evaluated())
+            simd::scalar::mat4Inverse(values, values);
+        else
+            simd::mat4Inverse(values, values);
+    }
+    template <>
+    constexpr void Mat4<double>::inverse() {
+        if (std::is_constant_evaluated())
+            simd::scalar::mat4Inverse(values, values);
+        else
+            simd::mat4Inverse(values, values);
+    }
+
     // Overload functions
     template <typename T, typename K>
-    Mat4<T> operator+(const Mat4<T> mat, const K k) {
+    constexpr Mat4<T> operator+(const Mat4<T> mat, const K k) {
         Mat4<T> out = Mat4<T>();
         out[0] = mat[0] + k;
         out[1] = mat[1] + k;
@@ -976,7 +905,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat4<T> operator-(const Mat4<T> mat, const K k) {
+    constexpr Mat4<T> operator-(const Mat4<T> mat, const K k) {
         Mat4<T> out = Mat4<T>();
         out[0] = mat[0] - k;
         out[1] = mat[1] - k;
@@ -997,7 +926,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat4<T> operator*(const Mat4<T> mat, const K k) {
+    constexpr Mat4<T> operator*(const Mat4<T> mat, const K k) {
         Mat4<T> out = Mat4<T>();
         out[0] = mat[0] * k;
         out[1] = mat[1] * k;
@@ -1018,7 +947,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat4<T> operator/(const Mat4<T> mat, const K k) {
+    constexpr Mat4<T> operator/(const Mat4<T> mat, const K k) {
         Mat4<T> out = Mat4<T>();
         out[0] = mat[0] / k;
         out[1] = mat[1] / k;
@@ -1039,7 +968,7 @@ namespace linmath {
         return out;
     }
     template <typename T, typename K>
-    Mat4<T> operator%(const Mat4<T> mat, const K k) {
+    constexpr Mat4<T> operator%(const Mat4<T> mat, const K k) {
         Mat4<T> out = Mat4<T>();
         out[0] = mat[0] % k;
         out[1] = mat[1] % k;
@@ -0,0 +1,13 @@
+#ifndef MATN_H
+#define MATN_H
+
+#include "matNM.h"
+
+namespace linmath {
+
+    // Square matrix, det, inverse and transpoze are only available on this shape
+    template <typename T, size_t N>
+    using MatN = MatNM<T, N, N>;
+}
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef MATNM_H
+#define MATNM_H
+
+#include <cmath>
+#include <iostream>
+
+#include "cholesky.h"
+#include "eigen.h"
+#include "gemm.h"
+#include "lu.h"
+#include "qr.h"
+#include "../Expression/expression.h"
+
+namespace linmath {
+
+    // Elementwise arithmetic builds lazy expressions from Expression/expression.h, evaluated when assigned
+    template <typename T, size_t N, size_t M>
+    class MatNM : public Expression<MatNM<T, N, M>> {
+
+        protected:
+        T values[N*M];
+
+        public:
+        using Value = T;
+        using Shape = MatNM<T, N, M>;
+
+        // Constructors
+        MatNM() {}
+        MatNM(T t) {
+            for (size_t i=0; i<N*M; i++)
+                this->values[i] = t;
+        }
+        MatNM(T values[N*M]) {
+            for (size_t i=0; i<N*M; i++)
+                this->values[i] = values[i];
+        }
+        MatNM(T values[N][M]) {
+            for (size_t row=0; row<N; row++)
+                for (size_t col=0; col<M; col++)
+                    this->values[M*row + col] = values[row][col];
+        }
+
+        // Variadic constructor, one value per element in row major order
+        template <typename... Ts> requires (sizeof...(Ts) + 1 == N*M)
+        constexpr MatNM(T t, Ts... ts) : values{t, T(ts)...} {}
+
+        // Evaluation of an expression in one pass
+        template <typename E>
+        MatNM(const Expression<E>& expr) {
+            *this = expr;
+        }
+        template <typename E>
+        MatNM<T, N, M>& operator=(const Expression<E>& expr) {
+            static_assert(std::is_same_v<typename E::Shape, MatNM<T, N, M>>, "expression has a different shape");
+            const E& e = expr.self();
+            for (size_t i=0; i<N*M; i++)
+                values[i] = e[i];
+            return *this;
+        }
+
+
+        // Matrix determinant
+        T det() requires (N == M) {
+            return determinant();
+        }
+        T determinant() requires (N == M) {
+            return lu().determinant();
+        }
+
+        // Matrix transpozition
+        void transpoze() requires (N == M) {
+            T t;
+            for (size_t row=0; row<N; row++)
+                for (size_t col=row + 1; col<M; col++) {
+                    t = values[M*row + col];
+                    values[M*row + col] = values[M*col + row];
+                    values[M*col + row] = t;
+                }
+        }
+        MatNM<T, M, N> transpozed()const {
+            MatNM<T, M, N> mat = MatNM<T, M, N>();
+            for (size_t row=0; row<N; row++)
+                for (size_t col=0; col<M; col++)
+                    mat[N*col + row] = values[M*row + col];
+            return mat;
+        }
+
+        // Matrix inverse, Gauss-Jordan elimination with partial pivoting
+        void inverse() requires (N == M) {
+            MatNM<T, N, M> mat = *this;
+            *this = identity();
+
+            for (size_t col=0; col<N; col++) {
+                size_t pivot = col;
+                for (size_t row=col + 1; row<N; row++)
+                    if (std::abs(mat[M*row + col]) > std::abs(mat[M*pivot + col]))
+                        pivot = row;
+                if (pivot != col) {
+                    mat.swapRows(pivot, col);
+                    swapRows(pivot, col);
+                }
+
+                T p = mat[M*col + col];
+                for (size_t i=0; i<M; i++) {
+                    mat[M*col + i] /= p;
+                    values[M*col + i] /= p;
+                }
+                for (size_t row=0; row<N; row++) {
+                    T f = mat[M*row + col];
+                    if (row == col || f == T(0))
+                        continue;
+                    for (size_t i=0; i<M; i++) {
+                        mat[M*row + i] -= f*mat[M*col + i];
+                        values[M*row + i] -= f*values[M*col + i];
+                    }
+                }
+            }
+        }
+        MatNM<T, N, M> inversed() requires (N == M) {
+            MatNM<T, N, M> mat = *this;
+            mat.inverse();
+            return mat;
+        }
+
+        // LU factorization with partial pivoting, for solving systems without forming the inverse
+        LU<T, N> lu()const requires (N == M) {
+            return LU<T, N>(values);
+        }
+
+        // Cholesky factorization of a symmetric positive definite matrix and symmetric eigen decomposition
+        Cholesky<T, N> cholesky()const requires (N == M) {
+            return Cholesky<T, N>(values);
+        }
+        SymmetricEigen<T, N> eigen()const requires (N == M) {
+            return SymmetricEigen<T, N>(values);
+        }
+
+        // QR factorization, for least squares fits of an overdetermined system with at least as many rows as columns
+        QR<T, N, M> qr()const requires (N >= M) {
+            return QR<T, N, M>(values);
+        }
+
+        // Row exchange
+        void swapRows(size_t row1, size_t row2) {
+            T t;
+            for (size_t col=0; col<M; col++) {
+                t = values[M*row1 + col];
+                values[M*row1 + col] = values[M*row2 + col];
+                values[M*row2 + col] = t;
+            }
+        }
+
+        // Dot product
+        template <size_t K>
+        MatNM<T, N, K> dot(const MatNM<T, M, K>& mat) {
+            MatNM<T, N, K> dot = MatNM<T, N, K>();
+            gemm(N, K, M, values, M, &mat[0], K, &dot[0], K);
+            return dot;
+        }
+
+        // Prefix increment and decrement
+        MatNM<T, N, M> operator++() {
+            MatNM<T, N, M> mat = MatNM<T, N, M>();
+            for (size_t i=0; i<N*M; i++)
+                mat[i] = ++values[i];
+            return mat;
+        }
+        MatNM<T, N, M> operator--() {
+            MatNM<T, N, M> mat = MatNM<T, N, M>();
+            for (size_t i=0; i<N*M; i++)
+                mat[i] = --values[i];
+            return mat;
+        }
+
+        // Postfix increment and decrement
+        MatNM<T, N, M> operator++(int) {
+            MatNM<T, N, M> mat = MatNM<T, N, M>();
+            for (size_t i=0; i<N*M; i++)
+                mat[i] = values[i]++;
+            return mat;
+        }
+        MatNM<T, N, M> operator--(int) {
+            MatNM<T, N, M> mat = MatNM<T, N, M>();
+            for (size_t i=0; i<N*M; i++)
+                mat[i] = values[i]--;
+            return mat;
+        }
+
+        // Operations with scalars
+        void operator+=(const T t) {
+            for (size_t i=0; i<N*M; i++)
+                values[i] += t;
+        }
+        void operator-=(const T t) {
+            for (size_t i=0; i<N*M; i++)
+                values[i] -= t;
+        }
+        void operator*=(const T t) {
+            for (size_t i=0; i<N*M; i++)
+                values[i] *= t;
+        }
+        void operator/=(const T t) {
+            for (size_t i=0; i<N*M; i++)
+                values[i] /= t;
+        }
+        void operator%=(const T t) {
+            for (size_t i=0; i<N*M; i++)
+                values[i] %= t;
+        }
+
+        // Operations with matricies
+        template <typename E>
+        void operator+=(const Expression<E>& expr) {
+            const E& e = expr.self();
+            for (size_t i=0; i<N*M; i++)
+                values[i] += e[i];
+        }
+        template <typename E>
+        void operator-=(const Expression<E>& expr) {
+            const E& e = expr.self();
+            for (size_t i=0; i<N*M; i++)
+                values[i] -= e[i];
+        }
+        template <typename E>
+        void operator*=(const Expression<E>& expr) {
+            const E& e = expr.self();
+            for (size_t i=0; i<N*M; i++)
+                values[i] *= e[i];
+        }
+        template <typename E>
+        void operator/=(const Expression<E>& expr) {
+            const E& e = expr.self();
+            for (size_t i=0; i<N*M; i++)
+                values[i] /= e[i];
+        }
+
+        // Comparison between matricies
+        bool operator==(const MatNM<T, N, M>& mat) {
+            for (size_t i=0; i<N*M; i++)
+                if (values[i] != mat[i]) return false;
+            return true;
+        }
+        bool operator!=(const MatNM<T, N, M>& mat) {
+            for (size_t i=0; i<N*M; i++)
+                if (values[i] != mat[i]) return true;
+            return false;
+        }
+
+        // Array functionality
+        T& operator[](size_t i) {
+            return values[i];
+        }
+        const T& operator[](size_t i) const {
+            return values[i];
+        }
+
+        // Input and output
+        friend std::ostream& operator<<(std::ostream& output, const MatNM<T, N, M>& mat) { 
+            for (size_t row=0; row<N; row++) {
+                for (size_t col=0; col<M; col++)
+                    output << mat[M*row + col] << (col + 1 < M ? " " : "");
+                if (row + 1 < N)
+                    output << "\n";
+            }
+            return output;            
+        }
+        friend std::istream& operator>>(std::istream& input, MatNM<T, N, M>& mat) { 
+            for (size_t i=0; i<N*M; i++)
+                input >> mat[i];
+            return input;            
+        }
+
+        // Predefined matricies
+        static MatNM<T, N, M> zero();
+        static MatNM<T, N, M> onei(size_t ind);
+        static MatNM<T, N, M> oner(size_t row);
+        static MatNM<T, N, M> onec(size_t col);
+        static MatNM<T, N, M> identity() requires (N == M);
+        static MatNM<T, N, M> one();
+    };
+
+    // Predefined matricies
+    template <typename T, size_t N, size_t M>
+    MatNM<T, N, M> MatNM<T, N, M>::zero() {
+        return MatNM<T, N, M>(.0);
+    }
+    template <typename T, size_t N, size_t M>
+    MatNM<T, N, M> MatNM<T, N, M>::onei(size_t ind) {
+        MatNM<T, N, M> mat(.0);
+        mat[ind] = 1;
+        return mat;
+    }
+    template <typename T, size_t N, size_t M>
+    MatNM<T, N, M> MatNM<T, N, M>::oner(size_t row) {
+        MatNM<T, N, M> mat(.0);
+        for (size_t col=0; col<M; col++)
+            mat[M*row + col] = 1;
+        return mat;
+    }
+    template <typename T, size_t N, size_t M>
+    MatNM<T, N, M> MatNM<T, N, M>::onec(size_t col) {
+        MatNM<T, N, M> mat(.0);
+        for (size_t row=0; row<N; row++)
+            mat[M*row + col] = 1;
+        return mat;
+    }
+    template <typename T, size_t N, size_t M>
+    MatNM<T, N, M> MatNM<T, N, M>::identity() requires (N == M) {
+        MatNM<T, N, M> mat(.0);
+        for (size_t i=0; i<N; i++)
+            mat[M*i + i] = 1;
+        return mat;
+    }
+    template <typename T, size_t N, size_t M>
+    MatNM<T, N, M> MatNM<T, N, M>::one() {
+        return MatNM<T, N, M>(1);
+    }
+}
+
+#endif
@@ -0,0 +1,464 @@
+#ifndef MATX_H
+#define MATX_H
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#include "gemm.h"
+#include "../Parallel/threadpool.h"
+#include "../Simd/aligned.h"
+
+namespace linmath {
+
+    // Row major matrix with a shape chosen at runtime
+    // Values live on the heap, cache line aligned, and are moved rather than copied out of functions
+    template <typename T>
+    class MatX {
+
+        protected:
+        size_t n = 0;
+        size_t m = 0;
+        T* values = nullptr;
+
+        // Shapes are only known at runtime, so operands that do not fit throw rather than read past the values
+        void requireShape(const MatX<T>& mat)const {
+            if (n != mat.n || m != mat.m)
+                throw std::invalid_argument("MatX operands of different shapes");
+        }
+
+        public:
+
+        // Constructors
+        MatX() {}
+        MatX(size_t rows, size_t cols) : n(rows), m(cols), values(simd::alignedAlloc<T>(rows*cols)) {}
+        MatX(size_t rows, size_t cols, T t) : MatX(rows, cols) {
+            for (size_t i=0; i<n*m; i++)
+                this->values[i] = t;
+        }
+        MatX(size_t rows, size_t cols, const T* values) : MatX(rows, cols) {
+            for (size_t i=0; i<n*m; i++)
+                this->values[i] = values[i];
+        }
+
+        // Copy and move
+        MatX(const MatX<T>& mat) : MatX(mat.n, mat.m, mat.values) {}
+        MatX(MatX<T>&& mat) noexcept : n(mat.n), m(mat.m), values(mat.values) {
+            mat.n = 0;
+            mat.m = 0;
+            mat.values = nullptr;
+        }
+        MatX<T>& operator=(const MatX<T>& mat) {
+            if (this != &mat) {
+                if (n*m != mat.n*mat.m) {
+                    release();
+                    values = simd::alignedAlloc<T>(mat.n*mat.m);
+                }
+                n = mat.n;
+                m = mat.m;
+                for (size_t i=0; i<n*m; i++)
+                    values[i] = mat.values[i];
+            }
+            return *this;
+        }
+        MatX<T>& operator=(MatX<T>&& mat) noexcept {
+            std::swap(n, mat.n);
+            std::swap(m, mat.m);
+            std::swap(values, mat.values);
+            return *this;
+        }
+        ~MatX() {
+            release();
+        }
+
+
+        // Shape
+        size_t rows()const {
+            return n;
+        }
+        size_t cols()const {
+            return m;
+        }
+        size_t size()const {
+            return n*m;
+        }
+
+        // Matrix determinant
+        T det() {
+            return determinant();
+        }
+        T determinant() {
+            MatX<T> mat = *this;
+            T det = 1;
+
+            for (size_t col=0; col<n; col++) {
+                size_t pivot = col;
+                for (size_t row=col + 1; row<n; row++)
+                    if (std::abs(mat[m*row + col]) > std::abs(mat[m*pivot + col]))
+                        pivot = row;
+                if (mat[m*pivot + col] == T(0))
+                    return T(0);
+                if (pivot != col) {
+                    mat.swapRows(pivot, col);
+                    det = -det;
+                }
+
+                det *= mat[m*col + col];
+                for (size_t row=col + 1; row<n; row++) {
+                    T f = mat[m*row + col] / mat[m*col + col];
+                    for (size_t i=col + 1; i<m; i++)
+                        mat[m*row + i] -= f*mat[m*col + i];
+                }
+            }
+            return det;
+        }
+
+        // Matrix transpozition, a non square matrix swaps its shape
+        void transpoze() {
+            if (n != m) {
+                *this = transpozed();
+                return;
+            }
+            T t;
+            for (size_t row=0; row<n; row++)
+                for (size_t col=row + 1; col<m; col++) {
+                    t = values[m*row + col];
+                    values[m*row + col] = values[m*col + row];
+                    values[m*col + row] = t;
+                }
+        }
+        MatX<T> transpozed()const {
+            MatX<T> mat = MatX<T>(m, n);
+            for (size_t row=0; row<n; row++)
+                for (size_t col=0; col<m; col++)
+                    mat[n*col + row] = values[m*row + col];
+            return mat;
+        }
+
+        // Matrix inverse, Gauss-Jordan elimination with partial pivoting
+        void inverse() {
+            MatX<T> mat = *this;
+            *this = identity(n);
+
+            for (size_t col=0; col<n; col++) {
+                size_t pivot = col;
+                for (size_t row=col + 1; row<n; row++)
+                    if (std::abs(mat[m*row + col]) > std::abs(mat[m*pivot + col]))
+                        pivot = row;
+                if (pivot != col) {
+                    mat.swapRows(pivot, col);
+                    swapRows(pivot, col);
+                }
+
+                T p = mat[m*col + col];
+                for (size_t i=0; i<m; i++) {
+                    mat[m*col + i] /= p;
+                    values[m*col + i] /= p;
+                }
+                for (size_t row=0; row<n; row++) {
+                    T f = mat[m*row + col];
+                    if (row == col || f == T(0))
+                        continue;
+                    for (size_t i=0; i<m; i++) {
+                        mat[m*row + i] -= f*mat[m*col + i];
+                        values[m*row + i] -= f*values[m*col + i];
+                    }
+                }
+            }
+        }
+        MatX<T> inversed() {
+            MatX<T> mat = *this;
+            mat.inverse();
+            return mat;
+        }
+
+        // Row exchange
+        void swapRows(size_t row1, size_t row2) {
+            T t;
+            for (size_t col=0; col<m; col++) {
+                t = values[m*row1 + col];
+                values[m*row1 + col] = values[m*row2 + col];
+                values[m*row2 + col] = t;
+            }
+        }
+
+        // Dot product, split over the shared thread pool unless another is given
+        // mat needs as many rows as this matrix has columns, otherwise it throws std::invalid_argument
+        MatX<T> dot(const MatX<T>& mat) {
+            return dot(mat, ThreadPool::global());
+        }
+        MatX<T> dot(const MatX<T>& mat, ThreadPool& pool) {
+            if (mat.n != m)
+                throw std::invalid_argument("MatX dot product needs as many rows in mat as this matrix has columns");
+            MatX<T> dot = MatX<T>(n, mat.m);
+            gemm(n, mat.m, m, values, m, mat.values, mat.m, dot.values, mat.m, pool);
+            return dot;
+        }
+
+        // Negation
+        MatX<T> operator-() {
+            MatX<T> mat = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                mat[i] = -values[i];
+            return mat;
+        }
+
+        // Prefix increment and decrement
+        MatX<T> operator++() {
+            MatX<T> mat = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                mat[i] = ++values[i];
+            return mat;
+        }
+        MatX<T> operator--() {
+            MatX<T> mat = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                mat[i] = --values[i];
+            return mat;
+        }
+
+        // Postfix increment and decrement
+        MatX<T> operator++(int) {
+            MatX<T> mat = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                mat[i] = values[i]++;
+            return mat;
+        }
+        MatX<T> operator--(int) {
+            MatX<T> mat = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                mat[i] = values[i]--;
+            return mat;
+        }
+
+        // Operations with scalars
+        MatX<T> operator+(const T t) {
+            MatX<T> mat = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                mat[i] = values[i] + t;
+            return mat;
+        }
+        MatX<T> operator-(const T t) {
+            MatX<T> mat = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                mat[i] = values[i] - t;
+            return mat;
+        }
+        MatX<T> operator*(const T t) {
+            MatX<T> mat = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                mat[i] = values[i] * t;
+            return mat;
+        }
+        MatX<T> operator/(const T t) {
+            MatX<T> mat = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                mat[i] = values[i] / t;
+            return mat;
+        }
+        MatX<T> operator%(const T t) {
+            MatX<T> mat = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                mat[i] = values[i] % t;
+            return mat;
+        }
+        void operator+=(const T t) {
+            for (size_t i=0; i<n*m; i++)
+                values[i] += t;
+        }
+        void operator-=(const T t) {
+            for (size_t i=0; i<n*m; i++)
+                values[i] -= t;
+        }
+        void operator*=(const T t) {
+            for (size_t i=0; i<n*m; i++)
+                values[i] *= t;
+        }
+        void operator/=(const T t) {
+            for (size_t i=0; i<n*m; i++)
+                values[i] /= t;
+        }
+        void operator%=(const T t) {
+            for (size_t i=0; i<n*m; i++)
+                values[i] %= t;
+        }
+
+        // Operations with matricies of the same shape, others throw std::invalid_argument
+        MatX<T> operator+(const MatX<T>& mat) {
+            requireShape(mat);
+            MatX<T> out = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                out[i] = values[i] + mat[i];
+            return out;
+        }
+        MatX<T> operator-(const MatX<T>& mat) {
+            requireShape(mat);
+            MatX<T> out = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                out[i] = values[i] - mat[i];
+            return out;
+        }
+        MatX<T> operator*(const MatX<T>& mat) {
+            requireShape(mat);
+            MatX<T> out = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                out[i] = values[i] * mat[i];
+            return out;
+        }
+        MatX<T> operator/(const MatX<T>& mat) {
+            requireShape(mat);
+            MatX<T> out = MatX<T>(n, m);
+            for (size_t i=0; i<n*m; i++)
+                out[i] = values[i] / mat[i];
+            return out;
+        }
+        void operator+=(const MatX<T>& mat) {
+            requireShape(mat);
+            for (size_t i=0; i<n*m; i++)
+                values[i] += mat[i];
+        }
+        void operator-=(const MatX<T>& mat) {
+            requireShape(mat);
+            for (size_t i=0; i<n*m; i++)
+                values[i] -= mat[i];
+        }
+        void operator*=(const MatX<T>& mat) {
+            requireShape(mat);
+            for (size_t i=0; i<n*m; i++)
+                values[i] *= mat[i];
+        }
+        void operator/=(const MatX<T>& mat) {
+            requireShape(mat);
+            for (size_t i=0; i<n*m; i++)
+                values[i] /= mat[i];
+        }
+
+        // Comparison between matricies, different shapes are never equal
+        bool operator==(const MatX<T>& mat) {
+            if (n != mat.n || m != mat.m) return false;
+            for (size_t i=0; i<n*m; i++)
+                if (values[i] != mat[i]) return false;
+            return true;
+        }
+        bool operator!=(const MatX<T>& mat) {
+            return !(*this == mat);
+        }
+
+        // Array functionality
+        T& operator[](size_t i) {
+            return values[i];
+        }
+        const T& operator[](size_t i) const {
+            return values[i];
+        }
+
+        // Input and output
+        friend std::ostream& operator<<(std::ostream& output, const MatX<T>& mat) {
+            for (size_t row=0; row<mat.n; row++) {
+                for (size_t col=0; col<mat.m; col++)
+                    output << mat[mat.m*row + col] << (col + 1 < mat.m ? " " : "");
+                if (row + 1 < mat.n)
+                    output << "\n";
+            }
+            return output;
+        }
+        friend std::istream& operator>>(std::istream& input, MatX<T>& mat) {
+            for (size_t i=0; i<mat.n*mat.m; i++)
+                input >> mat[i];
+            return input;
+        }
+
+        // Predefined matricies
+        static MatX<T> zero(size_t rows, size_t cols);
+        static MatX<T> onei(size_t rows, size_t cols, size_t ind);
+        static MatX<T> oner(size_t rows, size_t cols, size_t row);
+        static MatX<T> onec(size_t rows, size_t cols, size_t col);
+        static MatX<T> identity(size_t size);
+        static MatX<T> one(size_t rows, size_t cols);
+
+        private:
+
+        void release() {
+            if (values)
+                simd::alignedFree(values);
+            values = nullptr;
+        }
+    };
+
+    // Predefined matricies
+    template <typename T>
+    MatX<T> MatX<T>::zero(size_t rows, size_t cols) {
+        return MatX<T>(rows, cols, T(0));
+    }
+    template <typename T>
+    MatX<T> MatX<T>::onei(size_t rows, size_t cols, size_t ind) {
+        MatX<T> mat(rows, cols, T(0));
+        mat[ind] = 1;
+        return mat;
+    }
+    template <typename T>
+    MatX<T> MatX<T>::oner(size_t rows, size_t cols, size_t row) {
+        MatX<T> mat(rows, cols, T(0));
+        for (size_t col=0; col<cols; col++)
+            mat[cols*row + col] = 1;
+        return mat;
+    }
+    template <typename T>
+    MatX<T> MatX<T>::onec(size_t rows, size_t cols, size_t col) {
+        MatX<T> mat(rows, cols, T(0));
+        for (size_t row=0; row<rows; row++)
+            mat[cols*row + col] = 1;
+        return mat;
+    }
+    template <typename T>
+    MatX<T> MatX<T>::identity(size_t size) {
+        MatX<T> mat(size, size, T(0));
+        for (size_t i=0; i<size; i++)
+            mat[size*i + i] = 1;
+        return mat;
+    }
+    template <typename T>
+    MatX<T> MatX<T>::one(size_t rows, size_t cols) {
+        return MatX<T>(rows, cols, T(1));
+    }
+
+    // Overload functions
+    template <typename T, typename K>
+    MatX<T> operator+(const MatX<T>& mat, const K k) {
+        MatX<T> out = MatX<T>(mat.rows(), mat.cols());
+        for (size_t i=0; i<mat.size(); i++)
+            out[i] = mat[i] + k;
+        return out;
+    }
+    template <typename T, typename K>
+    MatX<T> operator-(const MatX<T>& mat, const K k) {
+        MatX<T> out = MatX<T>(mat.rows(), mat.cols());
+        for (size_t i=0; i<mat.size(); i++)
+            out[i] = mat[i] - k;
+        return out;
+    }
+    template <typename T, typename K>
+    MatX<T> operator*(const MatX<T>& mat, const K k) {
+        MatX<T> out = MatX<T>(mat.rows(), mat.cols());
+        for (size_t i=0; i<mat.size(); i++)
+            out[i] = mat[i] * k;
+        return out;
+    }
+    template <typename T, typename K>
+    MatX<T> operator/(const MatX<T>& mat, const K k) {
+        MatX<T> out = MatX<T>(mat.rows(), mat.cols());
+        for (size_t i=0; i<mat.size(); i++)
+            out[i] = mat[i] / k;
+        return out;
+    }
+    template <typename T, typename K>
+    MatX<T> operator%(const MatX<T>& mat, const K k) {
+        MatX<T> out = MatX<T>(mat.rows(), mat.cols());
+        for (size_t i=0; i<mat.size(); i++)
+            out[i] = mat[i] % k;
+        return out;
+    }
+}
+
+#endif
@@ -0,0 +1,239 @@
+#ifndef QR_H
+#define QR_H
+
+#include <cmath>
+#include <cstddef>
+
+namespace linmath {
+
+    // Householder QR factorization of an N by M row major matrix with N >= M, A = Q*R
+    // Column j is reflected by H = I - tau*v*v^T with v[j] = 1, the rest of v is stored below the diagonal of R
+    // and Q = H0*H1*...*H(M-1), so Q is only formed on request
+    // Past qrBlock columns the reflectors of a panel are merged into I - V*T*V^T and applied to the trailing columns
+    // a tile at a time, every tile is read once per panel instead of once per reflector
+    constexpr size_t qrBlock = 32;
+
+    // The shape is checked in the body rather than by a requires clause, so MatNM can name QR<T, N, M> in the
+    // declaration of qr() for every shape and only wide matricies that call it fail
+    template <typename T, size_t N, size_t M>
+    class QR {
+        static_assert(N >= M, "QR needs at least as many rows as columns");
+
+        protected:
+        T values[N*M];
+        T taus[M];
+
+        // Reflector of column j over rows j to N, the column becomes beta on the diagonal and v below it
+        void reflector(size_t j) {
+            T alpha = values[M*j + j];
+            T norm = T(0);
+            for (size_t row=j + 1; row<N; row++)
+                norm += values[M*row + j]*values[M*row + j];
+            if (norm == T(0)) {
+                taus[j] = T(0);
+                return;
+            }
+            T beta = std::sqrt(alpha*alpha + norm);
+            if (alpha > T(0))
+                beta = -beta;
+            taus[j] = (beta - alpha) / beta;
+            T scale = T(1) / (alpha - beta);
+            for (size_t row=j + 1; row<N; row++)
+                values[M*row + j] *= scale;
+            values[M*j + j] = beta;
+        }
+
+        // Applies reflector j to the columns from first to last, w = v^T*A and A -= tau*v*w a row at a time
+        void reflect(size_t j, size_t first, size_t last) {
+            if (taus[j] == T(0) || first >= last)
+                return;
+            T w[qrBlock];
+            for (size_t cols=first; cols<last; cols+=qrBlock) {
+                size_t width = last - cols < qrBlock ? last - cols : qrBlock;
+                for (size_t col=0; col<width; col++)
+                    w[col] = values[M*j + cols + col];
+                for (size_t row=j + 1; row<N; row++) {
+                    T v = values[M*row + j];
+                    for (size_t col=0; col<width; col++)
+                        w[col] += v*values[M*row + cols + col];
+                }
+                for (size_t col=0; col<width; col++)
+                    w[col] *= taus[j];
+                for (size_t col=0; col<width; col++)
+                    values[M*j + cols + col] -= w[col];
+                for (size_t row=j + 1; row<N; row++) {
+                    T v = values[M*row + j];
+                    for (size_t col=0; col<width; col++)
+                        values[M*row + cols + col] -= v*w[col];
+                }
+            }
+        }
+
+        // Applies the panel of reflectors from first to last to the columns after it as I - V*T^T*V^T
+        void reflectPanel(size_t first, size_t last) {
+            size_t b = last - first;
+            auto v = [&](size_t row, size_t k) {
+                size_t j = first + k;
+                return row == j ? T(1) : row > j ? values[M*row + j] : T(0);
+            };
+
+            // T is upper triangular, column i is -tau_i * T * V^T * v_i over the columns before it
+            T t[qrBlock][qrBlock];
+            for (size_t i=0; i<b; i++) {
+                for (size_t k=0; k<i; k++) {
+                    T s = T(0);
+                    for (size_t row=first + i; row<N; row++)
+                        s += v(row, k)*v(row, i);
+                    t[k][i] = -taus[first + i]*s;
+                }
+                for (size_t k=0; k<i; k++) {
+                    T s = T(0);
+                    for (size_t l=k; l<i; l++)
+                        s += t[k][l]*t[l][i];
+                    t[k][i] = s;
+                }
+                t[i][i] = taus[first + i];
+            }
+
+            T w[qrBlock][qrBlock];
+            for (size_t cols=last; cols<M; cols+=qrBlock) {
+                size_t width = M - cols < qrBlock ? M - cols : qrBlock;
+                for (size_t k=0; k<b; k++)
+                    for (size_t col=0; col<width; col++)
+                        w[k][col] = T(0);
+                for (size_t row=first; row<N; row++)
+                    for (size_t k=0; k<b && first + k <= row; k++) {
+                        T vk = v(row, k);
+                        for (size_t col=0; col<width; col++)
+                            w[k][col] += vk*values[M*row + cols + col];
+                    }
+                for (size_t k=b; k-- > 0;)
+                    for (size_t col=0; col<width; col++) {
+                        T s = T(0);
+                        for (size_t l=0; l<=k; l++)
+                            s += t[l][k]*w[l][col];
+                        w[k][col] = s;
+                    }
+                for (size_t row=first; row<N; row++)
+                    for (size_t k=0; k<b && first + k <= row; k++) {
+                        T vk = v(row, k);
+                        for (size_t col=0; col<width; col++)
+                            values[M*row + cols + col] -= vk*w[k][col];
+                    }
+            }
+        }
+
+        public:
+
+        // Constructors, factorizes the N*M values of a row major matrix
+        QR(const T* mat) {
+            for (size_t i=0; i<N*M; i++)
+                values[i] = mat[i];
+
+            if constexpr (M <= qrBlock)
+                for (size_t j=0; j<M; j++) {
+                    reflector(j);
+                    reflect(j, j + 1, M);
+                }
+            else
+                for (size_t first=0; first<M; first+=qrBlock) {
+                    size_t last = first + qrBlock < M ? first + qrBlock : M;
+                    for (size_t j=first; j<last; j++) {
+                        reflector(j);
+                        reflect(j, j + 1, last);
+                    }
+                    reflectPanel(first, last);
+                }
+        }
+
+        // Full column rank, no zero on the diagonal of R
+        bool fullRank()const {
+            for (size_t j=0; j<M; j++)
+                if (values[M*j + j] == T(0))
+                    return false;
+            return true;
+        }
+
+        // Matrix determinant of a square A, the product of the diagonal of R with a sign per reflection
+        T det()const requires (N == M) {
+            return determinant();
+        }
+        T determinant()const requires (N == M) {
+            T det = T(1);
+            for (size_t j=0; j<M; j++)
+                det *= taus[j] == T(0) ? values[M*j + j] : -values[M*j + j];
+            return det;
+        }
+
+        // Q^T*b in place for N values of b
+        void applyQt(T* b)const {
+            for (size_t j=0; j<M; j++) {
+                if (taus[j] == T(0))
+                    continue;
+                T w = b[j];
+                for (size_t row=j + 1; row<N; row++)
+                    w += values[M*row + j]*b[row];
+                w *= taus[j];
+                b[j] -= w;
+                for (size_t row=j + 1; row<N; row++)
+                    b[row] -= values[M*row + j]*w;
+            }
+        }
+
+        // Least squares solution x of A*x = b, the exact solution for a square A
+        // b holds N values and x holds M, they may be the same array
+        void solve(const T* b, T* x)const {
+            T y[N];
+            for (size_t row=0; row<N; row++)
+                y[row] = b[row];
+            applyQt(y);
+            for (size_t row=M; row-- > 0;) {
+                T s = y[row];
+                for (size_t i=row + 1; i<M; i++)
+                    s -= values[M*row + i]*y[i];
+                y[row] = s / values[M*row + row];
+            }
+            for (size_t row=0; row<M; row++)
+                x[row] = y[row];
+        }
+
+        // Thin Q, N*M values with orthonormal columns, built by applying the reflectors to the first M columns of I
+        void q(T* out)const {
+            for (size_t row=0; row<N; row++)
+                for (size_t col=0; col<M; col++)
+                    out[M*row + col] = row == col ? T(1) : T(0);
+            for (size_t j=M; j-- > 0;) {
+                if (taus[j] == T(0))
+                    continue;
+                for (size_t col=j; col<M; col++) {
+                    T w = out[M*j + col];
+                    for (size_t row=j + 1; row<N; row++)
+                        w += values[M*row + j]*out[M*row + col];
+                    w *= taus[j];
+                    out[M*j + col] -= w;
+                    for (size_t row=j + 1; row<N; row++)
+                        out[M*row + col] -= values[M*row + j]*w;
+                }
+            }
+        }
+
+        // R, M*M values of the upper triangle with zeros below it
+        void r(T* out)const {
+            for (size_t row=0; row<M; row++)
+                for (size_t col=0; col<M; col++)
+                    out[M*row + col] = col >= row ? values[M*row + col] : T(0);
+        }
+
+        // Scale of reflector j, 0 when column j needed no reflection
+        T tau(size_t j)const {
+            return taus[j];
+        }
+
+        // Array functionality, R on and above the diagonal and the reflectors below it in row major order
+        const T& operator[](size_t i)const {
+            return values[i];
+        }
+    };
+}
+
+#endif
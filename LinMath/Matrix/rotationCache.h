@@ -0,0 +1,95 @@
+#ifndef ROTATIONCACHE_H
+#define ROTATIONCACHE_H
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "mat3.h"
+#include "mat4.h"
+#include "../Math/math.h"
+
+namespace linmath {
+
+    // Sines and cosines of a full turn split into steps equal angles, for workloads that rotate by the same
+    // discrete angles over and over, such as tile orientations or a dial with fixed detents
+    // An angle is quantized to its step once and every rotation after that is a table lookup without trigonometry
+    template <typename T>
+    class RotationCache {
+
+        protected:
+        std::vector<math::SinCos<T>> table;
+
+        // Rounds a position measured in steps to the nearest step and wraps it into [0, steps)
+        size_t nearest(long double at)const {
+            long double n = table.size();
+            long double k = std::floor(at + 0.5L);
+            return size_t(k - std::floor(k / n) * n) % table.size();
+        }
+
+        public:
+
+        // Constructors, step k is the angle 2*pi*k/steps evaluated in long double and rounded once,
+        // the quarter turns are exactly 0 and 1 when steps is a multiple of 4
+        RotationCache() {}
+        explicit RotationCache(size_t steps) : table(steps) {
+            constexpr T quarters[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+            for (size_t k=0; k<steps; k++) {
+                if (4*k % steps == 0)
+                    table[k] = {quarters[4*k / steps][0], quarters[4*k / steps][1]};
+                else {
+                    auto [s, c] = math::sincos(2*math::pi<long double> * k / steps);
+                    table[k] = {T(s), T(c)};
+                }
+            }
+        }
+
+        // Quantization, the nearest step to an angle in radians or degrees, wrapped into [0, steps)
+        size_t steps()const {
+            return table.size();
+        }
+        size_t step(T ang)const {
+            return nearest(ang / (2*math::pi<long double>) * table.size());
+        }
+        size_t stepDeg(T ang)const {
+            return nearest(ang / 360.L * table.size());
+        }
+        T angle(size_t step)const {
+            return T(2*math::pi<long double> * step / table.size());
+        }
+
+        // Cached values of a step
+        const math::SinCos<T>& sincos(size_t step)const {
+            return table[step];
+        }
+
+        // Rotation matricies of a step, the same as the builders for its angle
+        Mat3<T> rotation(size_t step)const {
+            auto [s, c] = table[step];
+            return Mat3<T>(c, -s, 0, s, c, 0, 0, 0, 1);
+        }
+        Mat4<T> rotationX(size_t step)const {
+            auto [s, c] = table[step];
+            return Mat4<T>( 1, 0, 0, 0,
+                            0, c, s, 0,
+                            0, -s, c, 0,
+                            0, 0, 0, 1);
+        }
+        Mat4<T> rotationY(size_t step)const {
+            auto [s, c] = table[step];
+            return Mat4<T>( c, 0, -s, 0,
+                            0, 1, 0, 0,
+                            s, 0, c, 0,
+                            0, 0, 0, 1);
+        }
+        Mat4<T> rotationZ(size_t step)const {
+            auto [s, c] = table[step];
+            return Mat4<T>( c, s, 0, 0,
+                            -s, c, 0, 0,
+                            0, 0, 1, 0,
+                            0, 0, 0, 1);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,529 @@
+#ifndef SPARSE_H
+#define SPARSE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "mat3.h"
+#include "matX.h"
+#include "../Parallel/threadpool.h"
+#include "../Simd/sparse.h"
+
+namespace linmath {
+
+    // Sparse matricies for meshes and constraint systems with millions of nonzeros
+    // CSR compresses by rows, CSC by columns and BSR3 by rows of 3x3 blocks, COO gathers entries in any order and
+    // builds any of them, indices are int32_t so a matrix has fewer than 2^31 rows and columns
+    // Products cut the rows into ranges of about sparseGrain nonzeros, so rows of uneven length still balance
+    constexpr size_t sparseGrain = 16384;
+
+    template <typename T>
+    class CSC;
+
+    namespace detail {
+
+        // First row whose nonzeros before it plus the rows before it reach work
+        inline size_t sparseRow(size_t rows, const size_t* offsets, size_t work) {
+            size_t lo = 0, hi = rows;
+            while (lo < hi) {
+                size_t mid = (lo + hi)/2;
+                if (offsets[mid] + mid < work)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo;
+        }
+
+        // Runs f(begin, end) over ranges of rows of about equal work, a row costs its nonzeros and one for its store
+        template <typename F>
+        void sparseRows(size_t rows, const size_t* offsets, ThreadPool& pool, F f) {
+            pool.parallelRange(offsets[rows] + rows, sparseGrain, [&](size_t begin, size_t end) {
+                f(sparseRow(rows, offsets, begin), sparseRow(rows, offsets, end));
+            });
+        }
+
+        // Entry of a line being built, the key orders the entries of a line
+        template <typename T>
+        struct SparseEntry {
+            size_t key;
+            T value;
+        };
+
+        // Entries grouped by line, every line sorted by key with the entries of equal keys summed
+        // One counting pass buckets the entries, then the lines sort and merge in parallel
+        // Line l starts at starts[l] and keeps lengths[l] entries
+        template <typename T, typename Line, typename Key>
+        std::vector<SparseEntry<T>> bucket(size_t lines, const std::vector<T>& values, Line line, Key key, ThreadPool& pool, std::vector<size_t>& starts, std::vector<size_t>& lengths) {
+            size_t count = values.size();
+            starts.assign(lines + 1, 0);
+            for (size_t e=0; e<count; e++)
+                starts[line(e) + 1]++;
+            for (size_t l=0; l<lines; l++)
+                starts[l + 1] += starts[l];
+
+            std::vector<SparseEntry<T>> entries(count);
+            std::vector<size_t> next(starts.begin(), starts.end() - 1);
+            for (size_t e=0; e<count; e++)
+                entries[next[line(e)]++] = {key(e), values[e]};
+
+            lengths.resize(lines);
+            sparseRows(lines, starts.data(), pool, [&](size_t begin, size_t end) {
+                for (size_t l=begin; l<end; l++) {
+                    SparseEntry<T>* first = entries.data() + starts[l];
+                    SparseEntry<T>* last = entries.data() + starts[l + 1];
+                    std::sort(first, last, [](const SparseEntry<T>& a, const SparseEntry<T>& b) {
+                        return a.key < b.key;
+                    });
+                    size_t length = 0;
+                    for (SparseEntry<T>* e=first; e<last; e++) {
+                        if (length > 0 && first[length - 1].key == e->key)
+                            first[length - 1].value += e->value;
+                        else
+                            first[length++] = *e;
+                    }
+                    lengths[l] = length;
+                }
+            });
+            return entries;
+        }
+
+        // Compressed arrays of bucketed entries, the key of an entry becomes its index
+        template <typename T>
+        void compress(size_t lines, const std::vector<SparseEntry<T>>& entries, const std::vector<size_t>& starts, const std::vector<size_t>& lengths,
+                      ThreadPool& pool, std::vector<size_t>& offsets, std::vector<int32_t>& indices, std::vector<T>& values) {
+            offsets.assign(lines + 1, 0);
+            for (size_t l=0; l<lines; l++)
+                offsets[l + 1] = offsets[l] + lengths[l];
+            indices.resize(offsets[lines]);
+            values.resize(offsets[lines]);
+            sparseRows(lines, offsets.data(), pool, [&](size_t begin, size_t end) {
+                for (size_t l=begin; l<end; l++)
+                    for (size_t i=0; i<lengths[l]; i++) {
+                        indices[offsets[l] + i] = int32_t(entries[starts[l] + i].key);
+                        values[offsets[l] + i] = entries[starts[l] + i].value;
+                    }
+            });
+        }
+
+        // The same matrix compressed along its other dimension, a counting pass over the indices
+        // The lines come out in order, so the indices of every new line stay sorted
+        template <typename T>
+        void transpose(size_t lines, size_t others, const std::vector<size_t>& offsets, const std::vector<int32_t>& indices, const std::vector<T>& values,
+                       std::vector<size_t>& outOffsets, std::vector<int32_t>& outIndices, std::vector<T>& outValues) {
+            outOffsets.assign(others + 1, 0);
+            for (int32_t index : indices)
+                outOffsets[size_t(index) + 1]++;
+            for (size_t o=0; o<others; o++)
+                outOffsets[o + 1] += outOffsets[o];
+            outIndices.resize(indices.size());
+            outValues.resize(values.size());
+            std::vector<size_t> next(outOffsets.begin(), outOffsets.end() - 1);
+            for (size_t l=0; l<lines; l++)
+                for (size_t k=offsets[l]; k<offsets[l + 1]; k++) {
+                    size_t at = next[indices[k]]++;
+                    outIndices[at] = int32_t(l);
+                    outValues[at] = values[k];
+                }
+        }
+
+        // y = A*x of the lines of A scattered into y, the lines of a CSR are rows and A^T*x is scattered the same way
+        template <typename T>
+        void scatter(size_t lines, size_t others, const std::vector<size_t>& offsets, const std::vector<int32_t>& indices, const std::vector<T>& values,
+                     const T* x, T* y) {
+            for (size_t o=0; o<others; o++)
+                y[o] = T(0);
+            for (size_t l=0; l<lines; l++)
+                for (size_t k=offsets[l]; k<offsets[l + 1]; k++)
+                    y[indices[k]] += values[k]*x[l];
+        }
+    }
+
+    // Compressed sparse rows, row r has the nonzeros from offset(r) to offset(r + 1) with columns in increasing order
+    template <typename T>
+    class CSR {
+
+        protected:
+        size_t n = 0;
+        size_t m = 0;
+        std::vector<size_t> offsets = std::vector<size_t>(1);
+        std::vector<int32_t> indices;
+        std::vector<T> values;
+
+        simd::SparseRows<T> arrays()const {
+            return {offsets.data(), indices.data(), values.data()};
+        }
+
+        public:
+
+        // Constructors, the arrays are taken over as they are, offsets holds rows + 1 values
+        CSR() {}
+        CSR(size_t rows, size_t cols, std::vector<size_t> offsets, std::vector<int32_t> indices, std::vector<T> values)
+            : n(rows), m(cols), offsets(std::move(offsets)), indices(std::move(indices)), values(std::move(values)) {}
+
+        // Shape
+        size_t rows()const {
+            return n;
+        }
+        size_t cols()const {
+            return m;
+        }
+        size_t nonzeros()const {
+            return values.size();
+        }
+
+        // Start of the nonzeros of a row and the column of a nonzero
+        size_t offset(size_t row)const {
+            return offsets[row];
+        }
+        size_t index(size_t k)const {
+            return size_t(indices[k]);
+        }
+
+        // Product y = A*x, x holds cols() values and y rows(), split over the shared thread pool unless another is given
+        // Every row is a SIMD dot product that gathers the entries of x it needs, x and y must not overlap
+        void dot(const T* x, T* y)const {
+            dot(x, y, ThreadPool::global());
+        }
+        void dot(const T* x, T* y, ThreadPool& pool)const {
+            simd::SparseRows<T> a = arrays();
+            detail::sparseRows(n, offsets.data(), pool, [&](size_t begin, size_t end) {
+                simd::spmv<T>(begin, end, a, x, y);
+            });
+        }
+
+        // Product A*X with a dense X of cols() rows
+        MatX<T> dot(const MatX<T>& x)const {
+            return dot(x, ThreadPool::global());
+        }
+        MatX<T> dot(const MatX<T>& x, ThreadPool& pool)const {
+            size_t k = x.cols();
+            MatX<T> y = MatX<T>(n, k);
+            if (k == 1) {
+                dot(&x[0], &y[0], pool);
+                return y;
+            }
+            simd::SparseRows<T> a = arrays();
+            detail::sparseRows(n, offsets.data(), pool, [&](size_t begin, size_t end) {
+                simd::spmm<T>(begin, end, a, &x[0], k, &y[0]);
+            });
+            return y;
+        }
+
+        // Product y = A^T*x, x holds rows() values and y cols()
+        // The rows scatter into y on the calling thread, csc() keeps the columns together so that A^T*x is parallel
+        void transposedDot(const T* x, T* y)const {
+            detail::scatter(n, m, offsets, indices, values, x, y);
+        }
+
+        // The same matrix compressed by columns
+        CSC<T> csc()const;
+
+        // Array functionality, the nonzero values in row order
+        T& operator[](size_t k) {
+            return values[k];
+        }
+        const T& operator[](size_t k)const {
+            return values[k];
+        }
+    };
+
+    // Compressed sparse columns, column c has the nonzeros from offset(c) to offset(c + 1) with rows in increasing order
+    // The arrays are those of the CSR of A^T, so A^T*x is the parallel product and A*x is a scatter
+    template <typename T>
+    class CSC {
+
+        protected:
+        size_t n = 0;
+        size_t m = 0;
+        std::vector<size_t> offsets = std::vector<size_t>(1);
+        std::vector<int32_t> indices;
+        std::vector<T> values;
+
+        public:
+
+        // Constructors, the arrays are taken over as they are, offsets holds cols + 1 values
+        CSC() {}
+        CSC(size_t rows, size_t cols, std::vector<size_t> offsets, std::vector<int32_t> indices, std::vector<T> values)
+            : n(rows), m(cols), offsets(std::move(offsets)), indices(std::move(indices)), values(std::move(values)) {}
+
+        // Shape
+        size_t rows()const {
+            return n;
+        }
+        size_t cols()const {
+            return m;
+        }
+        size_t nonzeros()const {
+            return values.size();
+        }
+
+        // Start of the nonzeros of a column and the row of a nonzero
+        size_t offset(size_t col)const {
+            return offsets[col];
+        }
+        size_t index(size_t k)const {
+            return size_t(indices[k]);
+        }
+
+        // Product y = A*x, x holds cols() values and y rows()
+        // The columns scatter into y on the calling thread, csr() keeps the rows together so that A*x is parallel
+        void dot(const T* x, T* y)const {
+            detail::scatter(m, n, offsets, indices, values, x, y);
+        }
+
+        // Product y = A^T*x, x holds rows() values and y cols(), split over the shared thread pool unless another is given
+        // x and y must not overlap
+        void transposedDot(const T* x, T* y)const {
+            transposedDot(x, y, ThreadPool::global());
+        }
+        void transposedDot(const T* x, T* y, ThreadPool& pool)const {
+            simd::SparseRows<T> a{offsets.data(), indices.data(), values.data()};
+            detail::sparseRows(m, offsets.data(), pool, [&](size_t begin, size_t end) {
+                simd::spmv<T>(begin, end, a, x, y);
+            });
+        }
+
+        // The same matrix compressed by rows
+        CSR<T> csr()const {
+            std::vector<size_t> rowOffsets;
+            std::vector<int32_t> cols;
+            std::vector<T> rowValues;
+            detail::transpose(m, n, offsets, indices, values, rowOffsets, cols, rowValues);
+            return CSR<T>(n, m, std::move(rowOffsets), std::move(cols), std::move(rowValues));
+        }
+
+        // Array functionality, the nonzero values in column order
+        T& operator[](size_t k) {
+            return values[k];
+        }
+        const T& operator[](size_t k)const {
+            return values[k];
+        }
+    };
+
+    template <typename T>
+    CSC<T> CSR<T>::csc()const {
+        std::vector<size_t> colOffsets;
+        std::vector<int32_t> rows;
+        std::vector<T> colValues;
+        detail::transpose(n, m, offsets, indices, values, colOffsets, rows, colValues);
+        return CSC<T>(n, m, std::move(colOffsets), std::move(rows), std::move(colValues));
+    }
+
+    // Block sparse rows of 3x3 blocks, block row r has the blocks from offset(r) to offset(r + 1) with block columns
+    // in increasing order, the nine values of block k are row major from 9*k
+    // One index per nine values and whole 3 component vectors of x per block suit the vector unknowns of meshes
+    template <typename T>
+    class BSR3 {
+
+        protected:
+        size_t n = 0;
+        size_t m = 0;
+        std::vector<size_t> offsets = std::vector<size_t>(1);
+        std::vector<int32_t> indices;
+        std::vector<T> values;
+
+        simd::SparseRows<T> arrays()const {
+            return {offsets.data(), indices.data(), values.data()};
+        }
+
+        public:
+
+        // Constructors, the arrays are taken over as they are, offsets holds blockRows + 1 values and values 9 per block
+        BSR3() {}
+        BSR3(size_t blockRows, size_t blockCols, std::vector<size_t> offsets, std::vector<int32_t> indices, std::vector<T> values)
+            : n(blockRows), m(blockCols), offsets(std::move(offsets)), indices(std::move(indices)), values(std::move(values)) {}
+
+        // Shape, in values and in blocks
+        size_t rows()const {
+            return 3*n;
+        }
+        size_t cols()const {
+            return 3*m;
+        }
+        size_t blockRows()const {
+            return n;
+        }
+        size_t blockCols()const {
+            return m;
+        }
+        size_t blocks()const {
+            return indices.size();
+        }
+
+        // Start of the blocks of a block row, the block column of a block and the block itself
+        size_t offset(size_t blockRow)const {
+            return offsets[blockRow];
+        }
+        size_t index(size_t k)const {
+            return size_t(indices[k]);
+        }
+        Mat3<T> block(size_t k)const {
+            const T* b = values.data() + 9*k;
+            return Mat3<T>(b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], b[8]);
+        }
+
+        // Product y = A*x, x holds cols() values and y rows(), split over the shared thread pool unless another is given
+        // x and y must not overlap
+        void dot(const T* x, T* y)const {
+            dot(x, y, ThreadPool::global());
+        }
+        void dot(const T* x, T* y, ThreadPool& pool)const {
+            simd::SparseRows<T> a = arrays();
+            detail::sparseRows(n, offsets.data(), pool, [&](size_t begin, size_t end) {
+                simd::bsr3mv<T>(begin, end, a, x, y);
+            });
+        }
+
+        // Product A*X with a dense X of cols() rows
+        MatX<T> dot(const MatX<T>& x)const {
+            return dot(x, ThreadPool::global());
+        }
+        MatX<T> dot(const MatX<T>& x, ThreadPool& pool)const {
+            size_t k = x.cols();
+            MatX<T> y = MatX<T>(3*n, k);
+            if (k == 1) {
+                dot(&x[0], &y[0], pool);
+                return y;
+            }
+            simd::SparseRows<T> a = arrays();
+            detail::sparseRows(n, offsets.data(), pool, [&](size_t begin, size_t end) {
+                simd::bsr3mm<T>(begin, end, a, &x[0], k, &y[0]);
+            });
+            return y;
+        }
+
+        // Array functionality, the block values in block order
+        T& operator[](size_t k) {
+            return values[k];
+        }
+        const T& operator[](size_t k)const {
+            return values[k];
+        }
+    };
+
+    // Coordinate list builder, entries are added in any order and entries at the same place are summed when built
+    // Building buckets the entries by row, or column for csc(), then sorts and merges the rows over a thread pool
+    template <typename T>
+    class COO {
+
+        protected:
+        size_t n = 0;
+        size_t m = 0;
+        std::vector<int32_t> rowIndices;
+        std::vector<int32_t> colIndices;
+        std::vector<T> values;
+
+        public:
+
+        // Constructors
+        COO() {}
+        COO(size_t rows, size_t cols) : n(rows), m(cols) {}
+
+        // Shape and the number of entries added so far
+        size_t rows()const {
+            return n;
+        }
+        size_t cols()const {
+            return m;
+        }
+        size_t entries()const {
+            return values.size();
+        }
+
+        // Room for count entries
+        void reserve(size_t count) {
+            rowIndices.reserve(count);
+            colIndices.reserve(count);
+            values.reserve(count);
+        }
+
+        // Adds value at (row, col)
+        void add(size_t row, size_t col, T value) {
+            rowIndices.push_back(int32_t(row));
+            colIndices.push_back(int32_t(col));
+            values.push_back(value);
+        }
+
+        // Adds the nine values of a 3x3 block whose top left is at (3*blockRow, 3*blockCol)
+        void addBlock(size_t blockRow, size_t blockCol, const Mat3<T>& block) {
+            for (size_t i=0; i<9; i++)
+                add(3*blockRow + i/3, 3*blockCol + i%3, block[i]);
+        }
+
+        // Compressed by rows, split over the shared thread pool unless another is given
+        CSR<T> csr()const {
+            return csr(ThreadPool::global());
+        }
+        CSR<T> csr(ThreadPool& pool)const {
+            std::vector<size_t> starts, lengths, offsets;
+            std::vector<int32_t> indices;
+            std::vector<T> out;
+            auto entries = detail::bucket(n, values, [&](size_t e) { return size_t(rowIndices[e]); },
+                                          [&](size_t e) { return size_t(colIndices[e]); }, pool, starts, lengths);
+            detail::compress(n, entries, starts, lengths, pool, offsets, indices, out);
+            return CSR<T>(n, m, std::move(offsets), std::move(indices), std::move(out));
+        }
+
+        // Compressed by columns
+        CSC<T> csc()const {
+            return csc(ThreadPool::global());
+        }
+        CSC<T> csc(ThreadPool& pool)const {
+            std::vector<size_t> starts, lengths, offsets;
+            std::vector<int32_t> indices;
+            std::vector<T> out;
+            auto entries = detail::bucket(m, values, [&](size_t e) { return size_t(colIndices[e]); },
+                                          [&](size_t e) { return size_t(rowIndices[e]); }, pool, starts, lengths);
+            detail::compress(m, entries, starts, lengths, pool, offsets, indices, out);
+            return CSC<T>(n, m, std::move(offsets), std::move(indices), std::move(out));
+        }
+
+        // Compressed by rows of 3x3 blocks, a shape that is not a multiple of 3 is padded with zeros to whole blocks
+        // Entries are keyed by 3*col + row%3, so the entries of a block are neighbours once a block row is sorted
+        BSR3<T> bsr3()const {
+            return bsr3(ThreadPool::global());
+        }
+        BSR3<T> bsr3(ThreadPool& pool)const {
+            size_t lines = (n + 2)/3;
+            std::vector<size_t> starts, lengths;
+            auto entries = detail::bucket(lines, values, [&](size_t e) { return size_t(rowIndices[e])/3; },
+                                          [&](size_t e) { return 3*size_t(colIndices[e]) + size_t(rowIndices[e])%3; }, pool, starts, lengths);
+
+            std::vector<size_t> offsets(lines + 1, 0);
+            detail::sparseRows(lines, starts.data(), pool, [&](size_t begin, size_t end) {
+                for (size_t l=begin; l<end; l++) {
+                    size_t count = 0;
+                    for (size_t i=0; i<lengths[l]; i++)
+                        if (i == 0 || entries[starts[l] + i].key/9 != entries[starts[l] + i - 1].key/9)
+                            count++;
+                    offsets[l + 1] = count;
+                }
+            });
+            for (size_t l=0; l<lines; l++)
+                offsets[l + 1] += offsets[l];
+
+            std::vector<int32_t> indices(offsets[lines]);
+            std::vector<T> blocks(9*offsets[lines], T(0));
+            detail::sparseRows(lines, offsets.data(), pool, [&](size_t begin, size_t end) {
+                for (size_t l=begin; l<end; l++) {
+                    size_t b = offsets[l];
+                    for (size_t i=0; i<lengths[l]; i++) {
+                        const detail::SparseEntry<T>& e = entries[starts[l] + i];
+                        if (i > 0 && e.key/9 != entries[starts[l] + i - 1].key/9)
+                            b++;
+                        indices[b] = int32_t(e.key/9);
+                        blocks[9*b + 3*(e.key%3) + e.key%9/3] = e.value;
+                    }
+                }
+            });
+            return BSR3<T>(lines, (m + 2)/3, std::move(offsets), std::move(indices), std::move(blocks));
+        }
+    };
+}
+
+#endif
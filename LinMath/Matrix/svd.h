@@ -0,0 +1,73 @@
+#ifndef SVD_H
+#define SVD_H
+
+#include <cstddef>
+
+#include "../Simd/svd.h"
+
+namespace linmath {
+
+    // Singular value decomposition of a 3x3 row major matrix, A = U*diag(sigma)*V^T
+    // U and V are rotations and the singular values descend, the last one is negative when det A is, so a reflection
+    // never turns up in U or V
+    // Runs the scalar tier of the batched kernel, so a matrix on its own and in a batch agree up to rounding
+    template <typename T>
+    class SVD3 {
+
+        protected:
+        T us[9];
+        T sigmas[3];
+        T vs[9];
+
+        public:
+
+        // Constructors, decomposes the 9 values of a row major matrix
+        SVD3(const T* mat) {
+            simd::scalar::svd3<T, 3>(0, 1, 1, mat, us, sigmas, 1, vs);
+        }
+
+        // Singular value i
+        T value(size_t i)const {
+            return sigmas[i];
+        }
+        const T* values()const {
+            return sigmas;
+        }
+
+        // U and V, 9 values each in row major order
+        const T* u()const {
+            return us;
+        }
+        const T* v()const {
+            return vs;
+        }
+    };
+
+    // Polar decomposition of a 3x3 row major matrix, A = R*P
+    // R = U*V^T is the rotation closest to A and P = V*diag(sigma)*V^T the stretch, symmetric and positive semidefinite
+    // unless det A is negative, in which case P keeps the reflection and R is still a rotation
+    template <typename T>
+    class Polar3 {
+
+        protected:
+        T rotations[9];
+        T stretches[9];
+
+        public:
+
+        // Constructors, decomposes the 9 values of a row major matrix
+        Polar3(const T* mat) {
+            simd::scalar::polar3<T, 3>(0, 1, 1, mat, rotations, stretches);
+        }
+
+        // R and P, 9 values each in row major order
+        const T* rotation()const {
+            return rotations;
+        }
+        const T* stretch()const {
+            return stretches;
+        }
+    };
+}
+
+#endif
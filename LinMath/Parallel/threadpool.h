@@ -0,0 +1,150 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace linmath {
+
+    // Fixed set of worker threads that run the tasks of one parallel loop at a time
+    // The calling thread works on the loop too, so a pool of size 1 has no workers
+    class ThreadPool {
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::mutex loop;
+
+        const std::function<void(size_t)>* task = nullptr;
+        size_t count = 0;
+        std::atomic<size_t> next{0};
+        size_t generation = 0;
+        size_t running = 0;
+        bool stop = false;
+
+        static bool& inside() {
+            static thread_local bool inside = false;
+            return inside;
+        }
+
+        // Takes tasks until the loop is exhausted
+        void drain() {
+            for (size_t i=next++; i<count; i=next++)
+                (*task)(i);
+        }
+
+        void work() {
+            inside() = true;
+            size_t seen = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                wake.wait(lock, [&]{ return stop || generation != seen; });
+                if (stop)
+                    return;
+                seen = generation;
+                lock.unlock();
+                drain();
+                lock.lock();
+                if (--running == 0)
+                    done.notify_one();
+            }
+        }
+
+        public:
+
+        // Constructors
+        ThreadPool() : ThreadPool(defaultSize()) {}
+        ThreadPool(size_t threads) {
+            for (size_t i=1; i<threads; i++)
+                workers.emplace_back([this]{ work(); });
+        }
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+            wake.notify_all();
+            for (std::thread& worker : workers)
+                worker.join();
+        }
+
+        // Number of threads a loop runs on, the caller included
+        size_t size()const {
+            return workers.size() + 1;
+        }
+
+        // Runs f(0) ... f(count - 1) and returns once all of them have finished
+        // Tasks are handed out one at a time, so uneven tasks balance themselves
+        // Loops started from inside a task, or while another thread's loop runs, run serially
+        template <typename F>
+        void parallelFor(size_t count, F f) {
+            std::unique_lock<std::mutex> exclusive(loop, std::defer_lock);
+            if (workers.empty() || count < 2 || inside() || !exclusive.try_lock()) {
+                for (size_t i=0; i<count; i++)
+                    f(i);
+                return;
+            }
+
+            std::function<void(size_t)> body = f;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                task = &body;
+                this->count = count;
+                next = 0;
+                running = workers.size();
+                generation++;
+            }
+            wake.notify_all();
+
+            inside() = true;
+            drain();
+            inside() = false;
+
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [&]{ return running == 0; });
+            task = nullptr;
+        }
+
+        // Runs f(begin, end) over [0, n) cut in a few ranges per thread of at least grain elements
+        template <typename F>
+        void parallelRange(size_t n, size_t grain, F f) {
+            size_t ranges = 4*size();
+            size_t length = (n + ranges - 1)/ranges;
+            if (length < grain)
+                length = grain;
+            if (length == 0)
+                length = 1;
+            parallelFor((n + length - 1)/length, [&](size_t range) {
+                size_t begin = range*length;
+                f(begin, n - begin < length ? n : begin + length);
+            });
+        }
+
+        // Shared pool sized by LINMATH_THREADS, or the hardware thread count
+        static ThreadPool& global() {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        static size_t defaultSize() {
+            if (const char* env = std::getenv("LINMATH_THREADS")) {
+                long threads = std::strtol(env, nullptr, 10);
+                if (threads > 0)
+                    return size_t(threads);
+            }
+            size_t threads = std::thread::hardware_concurrency();
+            return threads ? threads : 1;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef WORKSTEALING_H
+#define WORKSTEALING_H
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "threadpool.h"
+#include "../Simd/aligned.h"
+
+namespace linmath {
+
+    // Work stealing over tasks named by an index, for work that discovers more work as it runs
+    // Every thread of the pool owns a deque, takes its newest task first and when it runs dry
+    // steals the oldest task of another thread, which tends to be the largest one left
+    class WorkStealing {
+
+        struct alignas(simd::cacheLine) Deque {
+            std::mutex mutex;
+            std::deque<size_t> tasks;
+        };
+
+        std::unique_ptr<Deque[]> deques;
+        size_t count = 0;
+        std::atomic<size_t> pending{0};
+
+        bool take(size_t self, size_t& task) {
+            {
+                Deque& own = deques[self];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.tasks.empty()) {
+                    task = own.tasks.back();
+                    own.tasks.pop_back();
+                    return true;
+                }
+            }
+            for (size_t i=1; i<count; i++) {
+                Deque& victim = deques[(self + i) % count];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task = victim.tasks.front();
+                    victim.tasks.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        WorkStealing(size_t threads) : deques(new Deque[threads]), count(threads) {}
+
+        public:
+
+        // Handle a running task uses to hand new tasks to its own thread
+        class Worker {
+
+            WorkStealing& owner;
+            size_t self;
+
+            public:
+            Worker(WorkStealing& owner, size_t self) : owner(owner), self(self) {}
+
+            void push(size_t task) {
+                owner.pending++;
+                Deque& own = owner.deques[self];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                own.tasks.push_back(task);
+            }
+        };
+
+        // Runs f(task, worker) for every seed and every task pushed through worker, returns once all have finished
+        // Seeds are dealt round robin over the threads, a pool of size 1 or a nested call runs everything on the caller
+        template <typename F>
+        static void run(ThreadPool& pool, const size_t* seeds, size_t n, F f) {
+            if (n == 0)
+                return;
+            WorkStealing steal = WorkStealing(pool.size());
+            for (size_t i=0; i<n; i++)
+                steal.deques[i % steal.count].tasks.push_back(seeds[i]);
+            steal.pending = n;
+
+            // A thread that picks up a second slot finds the work done or steals it, so every slot ends once pending is 0
+            pool.parallelFor(steal.count, [&](size_t self) {
+                Worker worker = Worker(steal, self);
+                size_t task = 0;
+                while (steal.pending.load() != 0) {
+                    if (steal.take(self, task)) {
+                        f(task, worker);
+                        steal.pending--;
+                    }
+                    else
+                        std::this_thread::yield();
+                }
+            });
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef DUALQUAT_H
+#define DUALQUAT_H
+
+#include <iostream>
+#include <type_traits>
+
+#include "quat.h"
+#include "../Math/math.h"
+#include "../Vector/vec3.h"
+#include "../Matrix/mat4.h"
+
+namespace linmath {
+
+    // Rigid transform real + e*dual, a rotation quaternion and half the translation times it
+    // Stored as the 8 values of real then dual, the layout the skinning kernels read bone palettes in
+    // a*b transforms by b first and then by a, as Quat does, and blending then normalizing stays rigid
+    template <typename T>
+    class DualQuat {
+
+        public:
+        Quat<T> real;
+        Quat<T> dual;
+
+        // Constructors, the default is the identity transform
+        constexpr DualQuat() {
+            this->real = Quat<T>();
+            this->dual = Quat<T>(0, 0, 0, 0);
+        }
+        constexpr DualQuat(const Quat<T>& real, const Quat<T>& dual) {
+            this->real = real;
+            this->dual = dual;
+        }
+        // Rotation by rotation followed by a translation
+        constexpr DualQuat(const Quat<T>& rotation, const Vec3<T>& translation) {
+            this->real = rotation;
+            this->dual = Quat<T>(translation, 0) * rotation * T(0.5);
+        }
+
+        // Parts of the transform, the dual quaternion must be unit length
+        constexpr Quat<T> rotation()const {
+            return real;
+        }
+        constexpr Vec3<T> translation()const {
+            Quat<T> t = dual * real.conjugate() * T(2);
+            return Vec3<T>(t.x, t.y, t.z);
+        }
+
+        // Conversion with rigid matricies laid out like the Mat4 builders, rotation first and the translation in the last row
+        static constexpr DualQuat<T> fromMat4(const Mat4<T>& mat) {
+            return DualQuat<T>(Quat<T>::fromMat4(mat), Vec3<T>(mat[12], mat[13], mat[14]));
+        }
+        constexpr Mat4<T> mat4()const {
+            Mat4<T> mat = real.mat4();
+            Vec3<T> t = translation();
+            mat[12] = t.x;
+            mat[13] = t.y;
+            mat[14] = t.z;
+            return mat;
+        }
+
+        // Normalization divides both parts by the length of the real part
+        template <Precision p = Precision::Exact>
+        constexpr void normalize() {
+            if constexpr (p == Precision::Fast) {
+                T r = math::rsqrt<p>(real.lengthSquared());
+                real = real * r;
+                dual = dual * r;
+            }
+            else {
+                T len = real.length();
+                real = real / len;
+                dual = dual / len;
+            }
+        }
+        template <Precision p = Precision::Exact>
+        constexpr DualQuat<T> normalized()const {
+            DualQuat<T> dq = *this;
+            dq.template normalize<p>();
+            return dq;
+        }
+
+        // Inverse transform, the conjugate of both parts is the inverse of a unit dual quaternion
+        constexpr DualQuat<T> conjugate()const {
+            return DualQuat<T>(real.conjugate(), dual.conjugate());
+        }
+
+        // Transformation of a point and of a direction, which only rotates
+        constexpr Vec3<T> transform(const Vec3<T>& point)const {
+            return real.rotate(point) + translation();
+        }
+        constexpr Vec3<T> rotate(const Vec3<T>& vec)const {
+            return real.rotate(vec);
+        }
+
+        // Composition
+        constexpr DualQuat<T> operator*(const DualQuat<T>& dq)const {
+            return DualQuat<T>(real * dq.real, real * dq.dual + dual * dq.real);
+        }
+        constexpr void operator*=(const DualQuat<T>& dq) {
+            *this = *this * dq;
+        }
+
+        // Componentwise operations, for blending
+        constexpr DualQuat<T> operator-()const {
+            return DualQuat<T>(-real, -dual);
+        }
+        constexpr DualQuat<T> operator+(const DualQuat<T>& dq)const {
+            return DualQuat<T>(real + dq.real, dual + dq.dual);
+        }
+        constexpr DualQuat<T> operator-(const DualQuat<T>& dq)const {
+            return DualQuat<T>(real - dq.real, dual - dq.dual);
+        }
+        constexpr DualQuat<T> operator*(const T t)const {
+            return DualQuat<T>(real * t, dual * t);
+        }
+        constexpr DualQuat<T> operator/(const T t)const {
+            return DualQuat<T>(real / t, dual / t);
+        }
+
+        // Comparison between dual quaternions
+        constexpr bool operator==(const DualQuat<T>& dq)const {
+            return real == dq.real && dual == dq.dual;
+        }
+        constexpr bool operator!=(const DualQuat<T>& dq)const {
+            return !(*this == dq);
+        }
+
+        // Input and output
+        friend std::ostream& operator<<(std::ostream& output, const DualQuat<T>& dq) {
+            output << dq.real << " " << dq.dual;
+            return output;
+        }
+        friend std::istream& operator>>(std::istream& input, DualQuat<T>& dq) {
+            input >> dq.real >> dq.dual;
+            return input;
+        }
+
+        // Predefined transforms
+        static constexpr DualQuat<T> identity();
+    };
+
+    // Predefined transforms
+    template <typename T>
+    constexpr DualQuat<T> DualQuat<T>::identity() {
+        return DualQuat<T>();
+    }
+
+    // Overload functions
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr DualQuat<T> operator*(const K k, const DualQuat<T>& dq) {
+        return dq * T(k);
+    }
+}
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef QUAT_H
+#define QUAT_H
+
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+
+#include "../Math/math.h"
+#include "../Vector/vec3.h"
+#include "../Matrix/mat3.h"
+#include "../Matrix/mat4.h"
+#include "../Simd/aligned.h"
+
+namespace linmath {
+
+    // Rotation quaternion x*i + y*j + z*k + w, stored and constructed in that order like a Vec4
+    // Composition is 16 multiplies instead of the 64 of a Mat4 product and renormalizing keeps it a pure rotation
+    // a*b rotates by b first and then by a, the same order the matricies compose in as b.mat4().dot(a.mat4())
+    template <typename T>
+    class alignas(simd::alignment<T, 4>) Quat {
+
+        public:
+        T x;
+        T y;
+        T z;
+        T w;
+
+        // Constructors, the default is the identity rotation
+        constexpr Quat() {
+            this->x = 0;
+            this->y = 0;
+            this->z = 0;
+            this->w = 1;
+        }
+        constexpr Quat(T x, T y, T z, T w) {
+            this->x = x;
+            this->y = y;
+            this->z = z;
+            this->w = w;
+        }
+        constexpr Quat(const Vec3<T>& vec, T w) {
+            this->x = vec.x;
+            this->y = vec.y;
+            this->z = vec.z;
+            this->w = w;
+        }
+
+        // Conversion with rotation matricies laid out like the Mat4 builders, Quat<T>::rotationX(a).mat4() is Mat4<T>::rotationX(a)
+        // The matrix must be a pure rotation, the quaternion must be unit length
+        static constexpr Quat<T> fromMat3(const Mat3<T>& mat);
+        static constexpr Quat<T> fromMat4(const Mat4<T>& mat);
+        constexpr Mat3<T> mat3()const {
+            T xx = x*x, yy = y*y, zz = z*z;
+            T xy = x*y, xz = x*z, yz = y*z;
+            T wx = w*x, wy = w*y, wz = w*z;
+            return Mat3<T>( 1 - 2*(yy + zz), 2*(xy + wz), 2*(xz - wy),
+                            2*(xy - wz), 1 - 2*(xx + zz), 2*(yz + wx),
+                            2*(xz + wy), 2*(yz - wx), 1 - 2*(xx + yy));
+        }
+        constexpr Mat4<T> mat4()const {
+            Mat3<T> r = mat3();
+            return Mat4<T>( r[0], r[1], r[2], 0,
+                            r[3], r[4], r[5], 0,
+                            r[6], r[7], r[8], 0,
+                            0, 0, 0, 1);
+        }
+
+        // Directional normalization, Precision::Fast as for the vectors
+        constexpr T lengthSquared()const {
+            return x*x + y*y + z*z + w*w;
+        }
+        template <Precision p = Precision::Exact>
+        constexpr T length()const {
+            T sq = lengthSquared();
+            if constexpr (p == Precision::Fast)
+                return sq > 0 ? sq * math::rsqrt<p>(sq) : 0;
+            else
+                return math::sqrt(sq);
+        }
+        template <Precision p = Precision::Exact>
+        constexpr void normalize() {
+            if constexpr (p == Precision::Fast) {
+                T r = math::rsqrt<p>(lengthSquared());
+                x = x * r;
+                y = y * r;
+                z = z * r;
+                w = w * r;
+            }
+            else {
+                T len = length();
+                x = x / len;
+                y = y / len;
+                z = z / len;
+                w = w / len;
+            }
+        }
+        template <Precision p = Precision::Exact>
+        constexpr Quat<T> normalized()const {
+            Quat<T> quat = *this;
+            quat.template normalize<p>();
+            return quat;
+        }
+
+        // Dot product, the cosine of half the angle between two unit rotations
+        constexpr T dot(const Quat<T>& quat)const {
+            return x*quat.x + y*quat.y + z*quat.z + w*quat.w;
+        }
+
+        // Inverse rotation, the conjugate is the inverse of a unit quaternion
+        constexpr Quat<T> conjugate()const {
+            return Quat<T>(-x, -y, -z, w);
+        }
+        constexpr Quat<T> inverse()const {
+            T sq = lengthSquared();
+            return Quat<T>(-x / sq, -y / sq, -z / sq, w / sq);
+        }
+
+        // Rotation of a vector, v + 2w(u x v) + 2u x (u x v) for the vector part u
+        constexpr Vec3<T> rotate(const Vec3<T>& vec)const {
+            T tx = 2*(y*vec.z - z*vec.y);
+            T ty = 2*(z*vec.x - x*vec.z);
+            T tz = 2*(x*vec.y - y*vec.x);
+            return Vec3<T>( vec.x + w*tx + (y*tz - z*ty),
+                            vec.y + w*ty + (z*tx - x*tz),
+                            vec.z + w*tz + (x*ty - y*tx));
+        }
+
+        // Negation, the same rotation
+        constexpr Quat<T> operator-()const {
+            return Quat<T>(-x, -y, -z, -w);
+        }
+
+        // Composition
+        constexpr Quat<T> operator*(const Quat<T>& quat)const {
+            return Quat<T>( w*quat.x + x*quat.w + y*quat.z - z*quat.y,
+                            w*quat.y - x*quat.z + y*quat.w + z*quat.x,
+                            w*quat.z + x*quat.y - y*quat.x + z*quat.w,
+                            w*quat.w - x*quat.x - y*quat.y - z*quat.z);
+        }
+        constexpr void operator*=(const Quat<T>& quat) {
+            *this = *this * quat;
+        }
+
+        // Componentwise operations, for blending
+        constexpr Quat<T> operator+(const Quat<T>& quat)const {
+            return Quat<T>(x + quat.x, y + quat.y, z + quat.z, w + quat.w);
+        }
+        constexpr Quat<T> operator-(const Quat<T>& quat)const {
+            return Quat<T>(x - quat.x, y - quat.y, z - quat.z, w - quat.w);
+        }
+        constexpr Quat<T> operator*(const T t)const {
+            return Quat<T>(x * t, y * t, z * t, w * t);
+        }
+        constexpr Quat<T> operator/(const T t)const {
+            return Quat<T>(x / t, y / t, z / t, w / t);
+        }
+
+        // Comparison between quaternions, q and -q are the same rotation but compare unequal
+        constexpr bool operator==(const Quat<T>& quat)const {
+            return (x == quat.x && y == quat.y && z == quat.z && w == quat.w);
+        }
+        constexpr bool operator!=(const Quat<T>& quat)const {
+            return !(*this == quat);
+        }
+
+        // Input and output
+        friend std::ostream& operator<<(std::ostream& output, const Quat<T>& quat) {
+            output << quat.x << " " << quat.y << " " << quat.z << " " << quat.w;
+            return output;
+        }
+        friend std::istream& operator>>(std::istream& input, Quat<T>& quat) {
+            input >> quat.x >> quat.y >> quat.z >> quat.w;
+            return input;
+        }
+
+        // Predefined rotations, angles in radians and turning the same way as the Mat4 ones
+        static constexpr Quat<T> identity();
+        static constexpr Quat<T> axisAngle(const Vec3<T>& axis, T ang);
+        static constexpr Quat<T> rotationX(T ang);
+        static constexpr Quat<T> rotationY(T ang);
+        static constexpr Quat<T> rotationZ(T ang);
+    };
+
+    // Shepperd's method, the largest of w, x, y and z is found from the diagonal and divides the others
+    template <typename T>
+    constexpr Quat<T> Quat<T>::fromMat3(const Mat3<T>& mat) {
+        T trace = mat[0] + mat[4] + mat[8];
+        if (trace > 0) {
+            T s = 2*math::sqrt(trace + 1);
+            return Quat<T>((mat[5] - mat[7]) / s, (mat[6] - mat[2]) / s, (mat[1] - mat[3]) / s, s / 4);
+        }
+        if (mat[0] > mat[4] && mat[0] > mat[8]) {
+            T s = 2*math::sqrt(1 + mat[0] - mat[4] - mat[8]);
+            return Quat<T>(s / 4, (mat[1] + mat[3]) / s, (mat[2] + mat[6]) / s, (mat[5] - mat[7]) / s);
+        }
+        if (mat[4] > mat[8]) {
+            T s = 2*math::sqrt(1 + mat[4] - mat[0] - mat[8]);
+            return Quat<T>((mat[1] + mat[3]) / s, s / 4, (mat[5] + mat[7]) / s, (mat[6] - mat[2]) / s);
+        }
+        T s = 2*math::sqrt(1 + mat[8] - mat[0] - mat[4]);
+        return Quat<T>((mat[2] + mat[6]) / s, (mat[5] + mat[7]) / s, s / 4, (mat[1] - mat[3]) / s);
+    }
+    template <typename T>
+    constexpr Quat<T> Quat<T>::fromMat4(const Mat4<T>& mat) {
+        return fromMat3(Mat3<T>(mat[0], mat[1], mat[2],
+                                mat[4], mat[5], mat[6],
+                                mat[8], mat[9], mat[10]));
+    }
+
+    // Predefined rotations
+    template <typename T>
+    constexpr Quat<T> Quat<T>::identity() {
+        return Quat<T>(0, 0, 0, 1);
+    }
+    template <typename T>
+    constexpr Quat<T> Quat<T>::axisAngle(const Vec3<T>& axis, T ang) {
+        auto [s, c] = math::sincos(ang / 2);
+        return Quat<T>(axis.x * s, axis.y * s, axis.z * s, c);
+    }
+    template <typename T>
+    constexpr Quat<T> Quat<T>::rotationX(T ang) {
+        auto [s, c] = math::sincos(ang / 2);
+        return Quat<T>(s, 0, 0, c);
+    }
+    template <typename T>
+    constexpr Quat<T> Quat<T>::rotationY(T ang) {
+        auto [s, c] = math::sincos(ang / 2);
+        return Quat<T>(0, s, 0, c);
+    }
+    template <typename T>
+    constexpr Quat<T> Quat<T>::rotationZ(T ang) {
+        auto [s, c] = math::sincos(ang / 2);
+        return Quat<T>(0, 0, s, c);
+    }
+
+    // Overload functions
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Quat<T> operator*(const K k, const Quat<T>& quat) {
+        return quat * T(k);
+    }
+
+    // Interpolation along the shorter arc between unit quaternions, b is negated when the two are more than half a turn apart
+    // nlerp blends linearly and normalizes, which is cheaper but does not turn at a constant rate
+    // slerp turns at a constant rate, its weights come from math::slerpWeight so no trigonometry is evaluated
+    template <typename T>
+    constexpr Quat<T> nlerp(const Quat<T>& a, const Quat<T>& b, T t) {
+        Quat<T> end = a.dot(b) < 0 ? -b : b;
+        return (a*(1 - t) + end*t).normalized();
+    }
+    template <typename T>
+    constexpr Quat<T> slerp(const Quat<T>& a, const Quat<T>& b, T t) {
+        T cos = a.dot(b);
+        Quat<T> end = cos < 0 ? -b : b;
+        cos = cos < 0 ? -cos : cos;
+        return a*math::slerpWeight(cos, 1 - t) + end*math::slerpWeight(cos, t);
+    }
+}
+
+#endif
@@ -0,0 +1,141 @@
+// Structure of arrays kernels for one dispatch tier, expanded by Simd/foreach.h
+// Vectors are stored planar, component c of vector i is at a[c*stride + i]
+
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            // Elementwise operations with arrays
+            template <typename T>
+            void add(size_t n, const T* a, const T* b, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(a + i) + Q::load(b + i)).store(out + i);
+                });
+            }
+            template <typename T>
+            void sub(size_t n, const T* a, const T* b, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(a + i) - Q::load(b + i)).store(out + i);
+                });
+            }
+            template <typename T>
+            void mul(size_t n, const T* a, const T* b, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(a + i) * Q::load(b + i)).store(out + i);
+                });
+            }
+            template <typename T>
+            void div(size_t n, const T* a, const T* b, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(a + i) / Q::load(b + i)).store(out + i);
+                });
+            }
+            template <typename T>
+            void negate(size_t n, const T* a, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (-Q::load(a + i)).store(out + i);
+                });
+            }
+
+            // Elementwise operations with a scalar
+            template <typename T>
+            void addScalar(size_t n, const T* a, T t, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(a + i) + Q::set(t)).store(out + i);
+                });
+            }
+            template <typename T>
+            void subScalar(size_t n, const T* a, T t, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(a + i) - Q::set(t)).store(out + i);
+                });
+            }
+            template <typename T>
+            void mulScalar(size_t n, const T* a, T t, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(a + i) * Q::set(t)).store(out + i);
+                });
+            }
+            template <typename T>
+            void divScalar(size_t n, const T* a, T t, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(a + i) / Q::set(t)).store(out + i);
+                });
+            }
+
+            // Dot product of D component vectors
+            template <typename T, size_t D>
+            void dot(size_t n, const T* a, size_t sa, const T* b, size_t sb, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    Q acc = Q::load(a + i) * Q::load(b + i);
+                    for (size_t c=1; c<D; c++)
+                        acc = fma(Q::load(a + c*sa + i), Q::load(b + c*sb + i), acc);
+                    acc.store(out + i);
+                });
+            }
+
+            // Length of D component vectors, Fast is the squared length times its rsqrt with 0 kept at 0
+            template <typename T, size_t D, Precision p>
+            void length(size_t n, const T* a, size_t sa, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    Q acc = Q::load(a + i) * Q::load(a + i);
+                    for (size_t c=1; c<D; c++)
+                        acc = fma(Q::load(a + c*sa + i), Q::load(a + c*sa + i), acc);
+                    if constexpr (p == Precision::Fast)
+                        (acc * rsqrt(max(acc, Q::set(std::numeric_limits<T>::min())))).store(out + i);
+                    else
+                        sqrt(acc).store(out + i);
+                });
+            }
+
+            // D component vectors divided by their length, out may alias a
+            // Fast multiplies by the rsqrt of the squared length instead
+            template <typename T, size_t D, Precision p>
+            void normalize(size_t n, const T* a, size_t sa, T* out, size_t so) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    Q v[D];
+                    for (size_t c=0; c<D; c++)
+                        v[c] = Q::load(a + c*sa + i);
+                    Q acc = v[0] * v[0];
+                    for (size_t c=1; c<D; c++)
+                        acc = fma(v[c], v[c], acc);
+                    if constexpr (p == Precision::Fast) {
+                        Q r = rsqrt(acc);
+                        for (size_t c=0; c<D; c++)
+                            (v[c] * r).store(out + c*so + i);
+                    }
+                    else {
+                        Q len = sqrt(acc);
+                        for (size_t c=0; c<D; c++)
+                            (v[c] / len).store(out + c*so + i);
+                    }
+                });
+            }
+
+            // Cross product of 3 component vectors, out may alias a or b
+            template <typename T>
+            void cross(size_t n, const T* a, size_t sa, const T* b, size_t sb, T* out, size_t so) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    Q ax = Q::load(a + i), ay = Q::load(a + sa + i), az = Q::load(a + 2*sa + i);
+                    Q bx = Q::load(b + i), by = Q::load(b + sb + i), bz = Q::load(b + 2*sb + i);
+                    (ay*bz - az*by).store(out + i);
+                    (az*bx - ax*bz).store(out + so + i);
+                    (ax*by - ay*bx).store(out + 2*so + i);
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,141 @@
+// Batched decompositions of small symmetric matricies for one dispatch tier, expanded by Simd/foreach.h
+// Every lane factors its own matrix, the branches of the scalar decompositions become selects so that lanes that
+// fail or converge early never diverge, and the Jacobi method runs a fixed number of sweeps instead of testing
+
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            // Cholesky factors L, a lane whose pivot is not positive gets zero columns from it on and failed[i] = 1,
+            // as Cholesky<T, N> leaves them, the matricies are only read and l may alias a
+            template <typename T, size_t N>
+            void cholesky(size_t begin, size_t end, size_t lanes, const T* a, T* l, uint8_t* failed) {
+                sweep<Pack<T>>(begin, end, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    size_t at = i / lanes * N*N*lanes + i % lanes;
+
+                    Q m[N][N];
+                    LINMATH_UNROLL
+                    for (size_t row=0; row<N; row++)
+                        LINMATH_UNROLL
+                        for (size_t col=0; col<=row; col++)
+                            m[row][col] = Q::load(a + at + (N*row + col)*lanes);
+
+                    // alive stays 1 until the first pivot that is not positive
+                    Q alive = Q::set(T(1));
+                    LINMATH_UNROLL
+                    for (size_t col=0; col<N; col++) {
+                        Q d = m[col][col];
+                        LINMATH_UNROLL
+                        for (size_t k=0; k<col; k++)
+                            d = fma(-m[col][k], m[col][k], d);
+                        alive = select(d, Q::zero(), alive, Q::zero());
+                        Q root = sqrt(max(d, Q::zero())) * alive;
+                        Q inv = select(root, Q::zero(), Q::set(T(1)) / root, Q::zero());
+                        m[col][col] = root;
+                        LINMATH_UNROLL
+                        for (size_t row=col + 1; row<N; row++) {
+                            Q s = m[row][col];
+                            LINMATH_UNROLL
+                            for (size_t k=0; k<col; k++)
+                                s = fma(-m[row][k], m[col][k], s);
+                            m[row][col] = s * inv;
+                        }
+                    }
+
+                    LINMATH_UNROLL
+                    for (size_t row=0; row<N; row++)
+                        LINMATH_UNROLL
+                        for (size_t col=0; col<N; col++)
+                            (col <= row ? m[row][col] : Q::zero()).store(l + at + (N*row + col)*lanes);
+                    T flags[Q::width];
+                    alive.store(flags);
+                    for (size_t j=0; j<Q::width; j++)
+                        failed[i + j] = !(flags[j] > T(0));
+                });
+            }
+
+            // Cyclic Jacobi on a symmetric 3x3 matrix of packs, m ends diagonal and the rotations are applied to the rows of v
+            // Jacobi converges quadratically, 3 sweeps reach float precision and 4 double from any start, one more is margin
+            template <typename T, typename Q>
+            inline void jacobi3(Q (&m)[3][3], Q (&v)[3][3]) {
+                constexpr size_t sweeps = sizeof(T) > 4 ? 5 : 4;
+                constexpr size_t pairs[3][3] = {{0, 1, 2}, {0, 2, 1}, {1, 2, 0}};
+                Q one = Q::set(T(1));
+                for (size_t s=0; s<sweeps; s++)
+                    LINMATH_UNROLL
+                    for (size_t k=0; k<3; k++) {
+                        size_t p = pairs[k][0], r = pairs[k][1], o = pairs[k][2];
+                        Q apq = m[p][r];
+                        Q d = m[r][r] - m[p][p];
+                        Q den = mulsign(d, d) + sqrt(fma(d, d, Q::set(T(4)) * apq * apq));
+                        Q t = select(den, Q::zero(), mulsign(apq + apq, d) / den, Q::zero());
+                        Q c = one / sqrt(fma(t, t, one));
+                        Q sn = t * c;
+                        m[p][p] = fma(-t, apq, m[p][p]);
+                        m[r][r] = fma(t, apq, m[r][r]);
+                        m[p][r] = m[r][p] = Q::zero();
+                        Q aop = m[o][p], aoq = m[o][r];
+                        m[o][p] = m[p][o] = fma(c, aop, -(sn * aoq));
+                        m[o][r] = m[r][o] = fma(sn, aop, c * aoq);
+                        LINMATH_UNROLL
+                        for (size_t col=0; col<3; col++) {
+                            Q vp = v[p][col], vq = v[r][col];
+                            v[p][col] = fma(c, vp, -(sn * vq));
+                            v[r][col] = fma(sn, vp, c * vq);
+                        }
+                    }
+            }
+
+            // Eigen decompositions of symmetric 3x3 matricies by cyclic Jacobi, ascending eigenvalue r of matrix i at
+            // values[r*valueStride + i] and its unit eigenvector in row r of vectors, laid out as a
+            template <typename T>
+            void eigen3(size_t begin, size_t end, size_t lanes, const T* a, T* vectors, T* values, size_t valueStride) {
+                sweep<Pack<T>>(begin, end, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    size_t at = i / lanes * 9*lanes + i % lanes;
+                    Q one = Q::set(T(1));
+
+                    Q m[3][3], v[3][3];
+                    LINMATH_UNROLL
+                    for (size_t row=0; row<3; row++)
+                        LINMATH_UNROLL
+                        for (size_t col=0; col<=row; col++)
+                            m[row][col] = m[col][row] = Q::load(a + at + (3*row + col)*lanes);
+                    LINMATH_UNROLL
+                    for (size_t row=0; row<3; row++)
+                        LINMATH_UNROLL
+                        for (size_t col=0; col<3; col++)
+                            v[row][col] = row == col ? one : Q::zero();
+
+                    LINMATH_TIER::jacobi3<T>(m, v);
+
+                    // Ascending order by three compare and select exchanges
+                    Q e[3] = {m[0][0], m[1][1], m[2][2]};
+                    constexpr size_t order[3][2] = {{0, 1}, {1, 2}, {0, 1}};
+                    LINMATH_UNROLL
+                    for (size_t k=0; k<3; k++) {
+                        size_t x = order[k][0], y = order[k][1];
+                        Q ex = e[x], ey = e[y];
+                        e[x] = select(ex, ey, ey, ex);
+                        e[y] = select(ex, ey, ex, ey);
+                        LINMATH_UNROLL
+                        for (size_t col=0; col<3; col++) {
+                            Q vx = v[x][col], vy = v[y][col];
+                            v[x][col] = select(ex, ey, vy, vx);
+                            v[y][col] = select(ex, ey, vx, vy);
+                        }
+                    }
+
+                    LINMATH_UNROLL
+                    for (size_t row=0; row<3; row++) {
+                        e[row].store(values + row*valueStride + i);
+                        LINMATH_UNROLL
+                        for (size_t col=0; col<3; col++)
+                            v[row][col].store(vectors + at + (3*row + col)*lanes);
+                    }
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,168 @@
+// Cache blocked matrix product for one dispatch tier, expanded by Simd/foreach.h
+// C (n x m) = A (n x k) * B (k x m), all row major with leading dimensions lda, ldb, ldc
+// B is packed in kc x nc panels that stay in L2/L3, A in mc x kc blocks that stay in L2,
+// and an mr x nr register tile of C is accumulated by the micro kernel from L1
+
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            template <typename T>
+            struct Gemm {
+                using P = Pack<T>;
+
+                static constexpr size_t width = P::width;
+                static constexpr size_t vectors = width == 1 ? 4 : 2;
+                static constexpr size_t nr = vectors*width;
+                static constexpr size_t mr = width == 1 ? 4 : (P::registers >= 32 ? 12 : 6);
+                static constexpr size_t kc = 256;
+                static constexpr size_t mc = mr*(96/mr);
+                static constexpr size_t nc = nr*(4096/nr);
+
+                // Products below this many multiply-adds skip packing
+                static constexpr size_t direct = 32*32*32;
+
+                // Rows of A interleaved in mr tall slivers, zero padded at the bottom edge
+                static void packA(size_t rows, size_t depth, const T* a, size_t lda, T* out) {
+                    for (size_t i=0; i<rows; i+=mr) {
+                        size_t h = rows - i < mr ? rows - i : mr;
+                        for (size_t p=0; p<depth; p++) {
+                            for (size_t r=0; r<h; r++)
+                                out[r] = a[(i + r)*lda + p];
+                            for (size_t r=h; r<mr; r++)
+                                out[r] = T(0);
+                            out += mr;
+                        }
+                    }
+                }
+
+                // Columns of B interleaved in nr wide slivers, zero padded at the right edge
+                static void packB(size_t depth, size_t cols, const T* b, size_t ldb, T* out) {
+                    for (size_t j=0; j<cols; j+=nr) {
+                        size_t w = cols - j < nr ? cols - j : nr;
+                        for (size_t p=0; p<depth; p++) {
+                            const T* row = b + p*ldb + j;
+                            for (size_t c=0; c<w; c++)
+                                out[c] = row[c];
+                            for (size_t c=w; c<nr; c++)
+                                out[c] = T(0);
+                            out += nr;
+                        }
+                    }
+                }
+
+                // C tile (rows x cols, at most mr x nr) = or += packed A sliver * packed B sliver
+                static void micro(size_t depth, const T* a, const T* b, T* c, size_t ldc, size_t rows, size_t cols, bool accumulate) {
+                    P acc[mr][vectors];
+                    LINMATH_UNROLL
+                    for (size_t r=0; r<mr; r++)
+                        LINMATH_UNROLL
+                        for (size_t v=0; v<vectors; v++)
+                            acc[r][v] = P::zero();
+
+                    for (size_t p=0; p<depth; p++) {
+                        P bv[vectors];
+                        LINMATH_UNROLL
+                        for (size_t v=0; v<vectors; v++)
+                            bv[v] = P::load(b + v*width);
+                        LINMATH_UNROLL
+                        for (size_t r=0; r<mr; r++) {
+                            P av = P::set(a[r]);
+                            LINMATH_UNROLL
+                            for (size_t v=0; v<vectors; v++)
+                                acc[r][v] = fma(av, bv[v], acc[r][v]);
+                        }
+                        a += mr;
+                        b += nr;
+                    }
+
+                    if (rows == mr && cols == nr) {
+                        LINMATH_UNROLL
+                        for (size_t r=0; r<mr; r++)
+                            LINMATH_UNROLL
+                            for (size_t v=0; v<vectors; v++) {
+                                T* out = c + r*ldc + v*width;
+                                (accumulate ? acc[r][v] + P::load(out) : acc[r][v]).store(out);
+                            }
+                        return;
+                    }
+
+                    T tile[mr*nr];
+                    for (size_t r=0; r<mr; r++)
+                        for (size_t v=0; v<vectors; v++)
+                            acc[r][v].store(tile + r*nr + v*width);
+                    for (size_t r=0; r<rows; r++)
+                        for (size_t j=0; j<cols; j++)
+                            c[r*ldc + j] = accumulate ? c[r*ldc + j] + tile[r*nr + j] : tile[r*nr + j];
+                }
+
+                // Unpacked product for operands that fit in L1, four rows of C per pass
+                // Columns left over by one pack width are finished with the next narrower pack
+                template <typename Q>
+                static void small(size_t n, size_t m, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, size_t j) {
+                    const size_t blocked = n - n%4;
+                    for (; j + Q::width <= m; j+=Q::width) {
+                        for (size_t i=0; i<blocked; i+=4) {
+                            const T* a0 = a + i*lda;
+                            Q acc0 = Q::zero(), acc1 = Q::zero(), acc2 = Q::zero(), acc3 = Q::zero();
+                            for (size_t p=0; p<k; p++) {
+                                Q bv = Q::load(b + p*ldb + j);
+                                acc0 = fma(Q::set(a0[p]), bv, acc0);
+                                acc1 = fma(Q::set(a0[lda + p]), bv, acc1);
+                                acc2 = fma(Q::set(a0[2*lda + p]), bv, acc2);
+                                acc3 = fma(Q::set(a0[3*lda + p]), bv, acc3);
+                            }
+                            acc0.store(c + i*ldc + j);
+                            acc1.store(c + (i + 1)*ldc + j);
+                            acc2.store(c + (i + 2)*ldc + j);
+                            acc3.store(c + (i + 3)*ldc + j);
+                        }
+                        for (size_t i=blocked; i<n; i++) {
+                            Q acc = Q::zero();
+                            for (size_t p=0; p<k; p++)
+                                acc = fma(Q::set(a[i*lda + p]), Q::load(b + p*ldb + j), acc);
+                            acc.store(c + i*ldc + j);
+                        }
+                    }
+                    if constexpr (Q::width > 1)
+                        small<typename Q::Half>(n, m, k, a, lda, b, ldb, c, ldc, j);
+                }
+
+                static void run(size_t n, size_t m, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc) {
+                    if (n*m*k <= direct || k == 0) {
+                        small<P>(n, m, k, a, lda, b, ldb, c, ldc, 0);
+                        return;
+                    }
+
+                    static thread_local AlignedBuffer<T> bufferA;
+                    static thread_local AlignedBuffer<T> bufferB;
+                    T* packedA = bufferA.reserve(mc*kc);
+                    T* packedB = bufferB.reserve(kc*nc);
+
+                    for (size_t jc=0; jc<m; jc+=nc) {
+                        size_t cols = m - jc < nc ? m - jc : nc;
+                        for (size_t pc=0; pc<k; pc+=kc) {
+                            size_t depth = k - pc < kc ? k - pc : kc;
+                            packB(depth, cols, b + pc*ldb + jc, ldb, packedB);
+                            for (size_t ic=0; ic<n; ic+=mc) {
+                                size_t rows = n - ic < mc ? n - ic : mc;
+                                packA(rows, depth, a + ic*lda + pc, lda, packedA);
+                                for (size_t jr=0; jr<cols; jr+=nr)
+                                    for (size_t ir=0; ir<rows; ir+=mr)
+                                        micro(depth, packedA + ir*depth, packedB + jr*depth,
+                                              c + (ic + ir)*ldc + jc + jr, ldc,
+                                              rows - ir < mr ? rows - ir : mr,
+                                              cols - jr < nr ? cols - jr : nr, pc > 0);
+                            }
+                        }
+                    }
+                }
+            };
+
+            template <typename T>
+            inline void gemm(size_t n, size_t m, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc) {
+                Gemm<T>::run(n, m, k, a, lda, b, ldb, c, ldc);
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+// Batched 3x3 kernels for one dispatch tier, expanded by Simd/foreach.h
+// Interleaved kernels take blocks of lanes matricies where element k of matrix j is at block[k*lanes + j]
+// The cofactors of the first row give the determinant and the first column of the adjugate, a matrix whose
+// determinant is 0 or NaN is flagged singular and gets an all zero inverse instead of a division by zero
+
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            // Determinant and the nine cofactors, transposed into the adjugate
+            template <typename P>
+            inline P mat3Adjugate(const P* a, P* b) {
+                b[0] = fma(a[4], a[8], -(a[5] * a[7]));
+                b[3] = fma(a[5], a[6], -(a[3] * a[8]));
+                b[6] = fma(a[3], a[7], -(a[4] * a[6]));
+                b[1] = fma(a[2], a[7], -(a[1] * a[8]));
+                b[4] = fma(a[0], a[8], -(a[2] * a[6]));
+                b[7] = fma(a[1], a[6], -(a[0] * a[7]));
+                b[2] = fma(a[1], a[5], -(a[2] * a[4]));
+                b[5] = fma(a[2], a[3], -(a[0] * a[5]));
+                b[8] = fma(a[0], a[4], -(a[1] * a[3]));
+                return fma(a[2], b[6], fma(a[1], b[3], a[0] * b[0]));
+            }
+
+            // Inverses of n matricies over interleaved blocks, out may alias m and singular holds a flag per matrix
+            // lanes must be a multiple of the pack width, the zero padding lanes of the last block stay zero
+            template <typename T>
+            void mat3InverseInterleaved(size_t n, size_t lanes, const T* m, T* out, uint8_t* singular) {
+                using P = Pack<T>;
+                for (size_t first=0; first<n; first+=lanes, m+=9*lanes, out+=9*lanes)
+                    for (size_t j=0; j<lanes && first + j < n; j+=P::width) {
+                        P a[9], b[9];
+                        LINMATH_UNROLL
+                        for (size_t k=0; k<9; k++)
+                            a[k] = P::load(m + k*lanes + j);
+                        P det = LINMATH_TIER::mat3Adjugate(a, b);
+                        P size = mulsign(det, det);
+                        P inv = select(size, P::zero(), P::set(T(1)) / det, P::zero());
+                        LINMATH_UNROLL
+                        for (size_t k=0; k<9; k++)
+                            (b[k] * inv).store(out + k*lanes + j);
+
+                        T sizes[P::width];
+                        size.store(sizes);
+                        for (size_t l=0; l<P::width && first + j + l < n; l++)
+                            singular[first + j + l] = !(sizes[l] > T(0));
+                    }
+            }
+
+            // Determinants of n matricies over interleaved blocks, det holds one value per matrix
+            template <typename T>
+            void mat3DetInterleaved(size_t n, size_t lanes, const T* m, T* det) {
+                using P = Pack<T>;
+                for (size_t first=0; first<n; first+=lanes, m+=9*lanes)
+                    for (size_t j=0; j<lanes && first + j < n; j+=P::width) {
+                        P a[9];
+                        LINMATH_UNROLL
+                        for (size_t k=0; k<9; k++)
+                            a[k] = P::load(m + k*lanes + j);
+                        P d = fma(a[0], fma(a[4], a[8], -(a[5] * a[7])),
+                              fma(a[1], fma(a[5], a[6], -(a[3] * a[8])),
+                                  a[2] * fma(a[3], a[7], -(a[4] * a[6]))));
+                        if (first + j + P::width <= n)
+                            d.store(det + first + j);
+                        else {
+                            T dets[P::width];
+                            d.store(dets);
+                            for (size_t l=0; first + j + l < n; l++)
+                                det[first + j + l] = dets[l];
+                        }
+                    }
+            }
+        }
+    }
+}
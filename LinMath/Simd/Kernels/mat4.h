@@ -0,0 +1,143 @@
+// Batched 4x4 kernels for one dispatch tier, expanded by Simd/foreach.h
+// Array kernels take row major matricies one after another and run the single matrix kernel inline
+// Interleaved kernels take blocks of lanes matricies where element k of matrix j is at block[k*lanes + j],
+// so each instruction works on a full pack of matricies
+// Inverse and determinant share the six 2x2 minors of the top two rows and the six of the bottom two, a matrix whose
+// determinant is 0 or NaN is flagged singular and gets an all zero inverse instead of a division by zero
+// Like the single matrix kernels they are compiled without contraction, so products round as the scalar code does
+
+LINMATH_EXACT_BEGIN
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            // out[i] = a[i] * b[i], out may alias a or b
+            template <typename T>
+            void mat4DotArray(size_t n, const T* a, const T* b, T* out) {
+                for (size_t i=0; i<n; i++)
+                    mat4Dot(a + 16*i, b + 16*i, out + 16*i);
+            }
+
+            // out[i] = a[i] * b[i] over interleaved blocks, lanes must be a multiple of the pack width and out may alias a
+            template <typename T>
+            void mat4DotInterleaved(size_t blocks, size_t lanes, const T* a, const T* b, T* out) {
+                using P = Pack<T>;
+                for (size_t block=0; block<blocks*16*lanes; block+=16*lanes)
+                    for (size_t j=block; j<block + lanes; j+=P::width) {
+                        // One row of a stays in registers while the columns of b stream from L1
+                        for (size_t r=0; r<4; r++) {
+                            P a0 = P::load(a + (4*r)*lanes + j);
+                            P a1 = P::load(a + (4*r + 1)*lanes + j);
+                            P a2 = P::load(a + (4*r + 2)*lanes + j);
+                            P a3 = P::load(a + (4*r + 3)*lanes + j);
+                            P row[4];
+                            LINMATH_UNROLL
+                            for (size_t c=0; c<4; c++) {
+                                P dot = a0 * P::load(b + c*lanes + j);
+                                dot = fma(a1, P::load(b + (4 + c)*lanes + j), dot);
+                                dot = fma(a2, P::load(b + (8 + c)*lanes + j), dot);
+                                row[c] = fma(a3, P::load(b + (12 + c)*lanes + j), dot);
+                            }
+                            for (size_t c=0; c<4; c++)
+                                row[c].store(out + (4*r + c)*lanes + j);
+                        }
+                    }
+            }
+
+            // The 2x2 minors of rows 0 and 1 in s and of rows 2 and 3 in c, ordered so that
+            // det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0
+            template <typename P>
+            inline void mat4Minors(const P* a, P* s, P* c) {
+                s[0] = fma(a[0], a[5], -(a[4] * a[1]));
+                s[1] = fma(a[0], a[6], -(a[4] * a[2]));
+                s[2] = fma(a[0], a[7], -(a[4] * a[3]));
+                s[3] = fma(a[1], a[6], -(a[5] * a[2]));
+                s[4] = fma(a[1], a[7], -(a[5] * a[3]));
+                s[5] = fma(a[2], a[7], -(a[6] * a[3]));
+                c[0] = fma(a[8], a[13], -(a[12] * a[9]));
+                c[1] = fma(a[8], a[14], -(a[12] * a[10]));
+                c[2] = fma(a[8], a[15], -(a[12] * a[11]));
+                c[3] = fma(a[9], a[14], -(a[13] * a[10]));
+                c[4] = fma(a[9], a[15], -(a[13] * a[11]));
+                c[5] = fma(a[10], a[15], -(a[14] * a[11]));
+            }
+            template <typename P>
+            inline P mat4Det(const P* s, const P* c) {
+                P det = s[0] * c[5];
+                det = fma(-s[1], c[4], det);
+                det = fma(s[2], c[3], det);
+                det = fma(s[3], c[2], det);
+                det = fma(-s[4], c[1], det);
+                return fma(s[5], c[0], det);
+            }
+
+            // Inverses of n matricies over interleaved blocks, out may alias m and singular holds a flag per matrix
+            // lanes must be a multiple of the pack width, the zero padding lanes of the last block stay zero
+            template <typename T>
+            void mat4InverseInterleaved(size_t n, size_t lanes, const T* m, T* out, uint8_t* singular) {
+                using P = Pack<T>;
+                for (size_t first=0; first<n; first+=lanes, m+=16*lanes, out+=16*lanes)
+                    for (size_t j=0; j<lanes && first + j < n; j+=P::width) {
+                        P a[16], s[6], c[6];
+                        LINMATH_UNROLL
+                        for (size_t k=0; k<16; k++)
+                            a[k] = P::load(m + k*lanes + j);
+                        LINMATH_TIER::mat4Minors(a, s, c);
+                        P det = LINMATH_TIER::mat4Det(s, c);
+                        P size = mulsign(det, det);
+                        P inv = select(size, P::zero(), P::set(T(1)) / det, P::zero());
+
+                        P b[16];
+                        b[0] = fma(a[5], c[5], fma(-a[6], c[4], a[7] * c[3]));
+                        b[1] = fma(-a[1], c[5], fma(a[2], c[4], -(a[3] * c[3])));
+                        b[2] = fma(a[13], s[5], fma(-a[14], s[4], a[15] * s[3]));
+                        b[3] = fma(-a[9], s[5], fma(a[10], s[4], -(a[11] * s[3])));
+                        b[4] = fma(-a[4], c[5], fma(a[6], c[2], -(a[7] * c[1])));
+                        b[5] = fma(a[0], c[5], fma(-a[2], c[2], a[3] * c[1]));
+                        b[6] = fma(-a[12], s[5], fma(a[14], s[2], -(a[15] * s[1])));
+                        b[7] = fma(a[8], s[5], fma(-a[10], s[2], a[11] * s[1]));
+                        b[8] = fma(a[4], c[4], fma(-a[5], c[2], a[7] * c[0]));
+                        b[9] = fma(-a[0], c[4], fma(a[1], c[2], -(a[3] * c[0])));
+                        b[10] = fma(a[12], s[4], fma(-a[13], s[2], a[15] * s[0]));
+                        b[11] = fma(-a[8], s[4], fma(a[9], s[2], -(a[11] * s[0])));
+                        b[12] = fma(-a[4], c[3], fma(a[5], c[1], -(a[6] * c[0])));
+                        b[13] = fma(a[0], c[3], fma(-a[1], c[1], a[2] * c[0]));
+                        b[14] = fma(-a[12], s[3], fma(a[13], s[1], -(a[14] * s[0])));
+                        b[15] = fma(a[8], s[3], fma(-a[9], s[1], a[10] * s[0]));
+                        LINMATH_UNROLL
+                        for (size_t k=0; k<16; k++)
+                            (b[k] * inv).store(out + k*lanes + j);
+
+                        T sizes[P::width];
+                        size.store(sizes);
+                        for (size_t l=0; l<P::width && first + j + l < n; l++)
+                            singular[first + j + l] = !(sizes[l] > T(0));
+                    }
+            }
+
+            // Determinants of n matricies over interleaved blocks, det holds one value per matrix
+            template <typename T>
+            void mat4DetInterleaved(size_t n, size_t lanes, const T* m, T* det) {
+                using P = Pack<T>;
+                for (size_t first=0; first<n; first+=lanes, m+=16*lanes)
+                    for (size_t j=0; j<lanes && first + j < n; j+=P::width) {
+                        P a[16], s[6], c[6];
+                        LINMATH_UNROLL
+                        for (size_t k=0; k<16; k++)
+                            a[k] = P::load(m + k*lanes + j);
+                        LINMATH_TIER::mat4Minors(a, s, c);
+                        P d = LINMATH_TIER::mat4Det(s, c);
+                        if (first + j + P::width <= n)
+                            d.store(det + first + j);
+                        else {
+                            T dets[P::width];
+                            d.store(dets);
+                            for (size_t l=0; first + j + l < n; l++)
+                                det[first + j + l] = dets[l];
+                        }
+                    }
+            }
+        }
+    }
+}
+LINMATH_EXACT_END
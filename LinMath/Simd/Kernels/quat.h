@@ -0,0 +1,72 @@
+// Batched quaternion interpolation for one dispatch tier, expanded by Simd/foreach.h
+// Quaternions are interleaved x, y, z, w as Quat stores them and transposed to planar packs in registers
+
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            // Loads pair i of a and b with b negated where it is more than half a turn from a, cos gets |a.b|
+            template <typename T, typename Q>
+            inline void shorterArc(const T* a, const T* b, size_t i, Q* qa, Q* qb, Q& cos) {
+                Q::load4(a + 4*i, qa[0], qa[1], qa[2], qa[3]);
+                Q::load4(b + 4*i, qb[0], qb[1], qb[2], qb[3]);
+                Q d = qa[0] * qb[0];
+                for (size_t c=1; c<4; c++)
+                    d = fma(qa[c], qb[c], d);
+                for (size_t c=0; c<4; c++)
+                    qb[c] = mulsign(qb[c], d);
+                cos = mulsign(d, d);
+            }
+
+            // sin(t*angle)/sin(angle) as math::slerpWeight, one nested product per lane
+            template <typename T, typename Q>
+            inline Q slerpWeight(Q xm1, Q t) {
+                using S = math::SlerpSeries<T>;
+                Q one = Q::set(T(1));
+                Q tt = t * t;
+                Q c = one;
+                for (size_t i=S::terms; i-- > 0;)
+                    c = fma(fma(Q::set(S::u[i]), tt, Q::set(-S::v[i])) * xm1, c, one);
+                return t * c;
+            }
+
+            // out may alias a or b
+            template <typename T>
+            void nlerp(size_t n, const T* a, const T* b, const T* t, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    Q qa[4], qb[4], cos;
+                    LINMATH_TIER::shorterArc(a, b, i, qa, qb, cos);
+                    Q wb = Q::load(t + i);
+                    Q wa = Q::set(T(1)) - wb;
+
+                    Q r[4];
+                    for (size_t c=0; c<4; c++)
+                        r[c] = fma(qa[c], wa, qb[c] * wb);
+                    Q sq = r[0] * r[0];
+                    for (size_t c=1; c<4; c++)
+                        sq = fma(r[c], r[c], sq);
+                    Q len = sqrt(sq);
+                    Q::store4(out + 4*i, r[0] / len, r[1] / len, r[2] / len, r[3] / len);
+                });
+            }
+            template <typename T>
+            void slerp(size_t n, const T* a, const T* b, const T* t, T* out) {
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    Q qa[4], qb[4], cos;
+                    LINMATH_TIER::shorterArc(a, b, i, qa, qb, cos);
+                    Q xm1 = cos - Q::set(T(1));
+                    Q tb = Q::load(t + i);
+                    Q wb = LINMATH_TIER::slerpWeight<T>(xm1, tb);
+                    Q wa = LINMATH_TIER::slerpWeight<T>(xm1, Q::set(T(1)) - tb);
+
+                    Q r[4];
+                    for (size_t c=0; c<4; c++)
+                        r[c] = fma(qa[c], wa, qb[c] * wb);
+                    Q::store4(out + 4*i, r[0], r[1], r[2], r[3]);
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+// Batched sine and cosine for one dispatch tier, expanded by Simd/foreach.h
+// Every lane reduces its angle by the nearest multiple j of pi/2 as math::SinCosSeries describes, evaluates both
+// polynomials on the remainder and picks them by j mod 4, so no lane branches and both results cost one reduction
+// The quadrant is kept as exact 0 and 1 lane values, which select and negate by multiplying
+
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            // s and c may alias x but not each other
+            template <typename T>
+            void sincos(size_t n, const T* x, T* s, T* c) {
+                using S = math::SinCosSeries<T>;
+                constexpr size_t parts = S::halfPi.size();
+                constexpr size_t terms = S::sin.size();
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    Q one = Q::set(T(1));
+                    Q half = Q::set(T(0.5));
+
+                    Q v = Q::load(x + i);
+                    Q j = floor(fma(v, Q::set(S::twoOverPi), half));
+                    Q r = v;
+                    LINMATH_UNROLL
+                    for (size_t k=0; k<parts; k++)
+                        r = fma(j, Q::set(-S::halfPi[k]), r);
+                    Q z = r * r;
+
+                    Q ps = Q::set(S::sin.back());
+                    Q pc = Q::set(S::cos.back());
+                    for (size_t k=terms - 1; k-- > 0;) {
+                        ps = fma(ps, z, Q::set(S::sin[k]));
+                        pc = fma(pc, z, Q::set(S::cos[k]));
+                    }
+                    Q sinr = fma(r * z, ps, r);
+                    Q cosr = fma(z * z, pc, fma(z, Q::set(T(-0.5)), one));
+
+                    // Quadrant k = j mod 4, sin is sin r, cos r, -sin r, -cos r and cos is cos r, -sin r, -cos r, sin r
+                    Q k = j - floor(j * Q::set(T(0.25))) * Q::set(T(4));
+                    Q upper = floor(k * half);
+                    Q odd = k - (upper + upper);
+                    Q turn = floor((k + one) * half);
+                    Q flip = turn - floor(turn * half) * Q::set(T(2));
+                    Q sv = fma(odd, cosr, sinr * (one - odd));
+                    Q cv = fma(odd, sinr, cosr * (one - odd));
+                    (sv * (one - (upper + upper))).store(s + i);
+                    (cv * (one - (flip + flip))).store(c + i);
+                });
+            }
+        }
+    }
+}
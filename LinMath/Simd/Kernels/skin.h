@@ -0,0 +1,190 @@
+// Batched skinning for one dispatch tier, expanded by Simd/foreach.h
+// Each pack of vertices looks up its bones in the palette, blends them by weight and transforms with the blend
+// Linear blending sums the top three rows of the matricies, dual quaternion blending sums the dual quaternions
+// and normalizes, flipping each onto the same hemisphere as the sum so far
+
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            // Offsets of the bones of influence j for the vertices at i, stride values per bone
+            template <typename T, typename Q>
+            inline void skinOffsets(const Skin<T>& skin, size_t j, size_t i, size_t stride, int32_t* offset) {
+                const int32_t* bones = skin.bones + j*skin.influenceStride + i;
+                LINMATH_UNROLL
+                for (size_t l=0; l<Q::width; l++)
+                    offset[l] = bones[l] * int32_t(stride);
+            }
+
+            // The widest pack of at most 4 lanes, a row of a matrix or an equal part of it
+            template <typename Q, bool narrow = (Q::width <= 4)>
+            struct SkinRow {
+                using type = Q;
+            };
+            template <typename Q>
+            struct SkinRow<Q, false> {
+                using type = typename SkinRow<typename Q::Half>::type;
+            };
+
+            // Each vertex blends the top three rows of its bones a row at a time, without transposing every bone,
+            // and the blends are read back transposed by load4 so that the transform runs on planar packs
+            template <typename T, bool normals>
+            void skinLinearRange(size_t begin, size_t end, const Skin<T>& skin) {
+                sweep<Pack<T>>(begin, end, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    using R = typename SkinRow<Q>::type;
+                    constexpr size_t parts = 12 / R::width;
+
+                    T blend[3][4*Q::width];
+                    for (size_t l=0; l<Q::width; l++) {
+                        R acc[parts];
+                        LINMATH_UNROLL
+                        for (size_t k=0; k<parts; k++)
+                            acc[k] = R::zero();
+                        for (size_t j=0; j<skin.influences; j++) {
+                            size_t at = j*skin.influenceStride + i + l;
+                            const T* bone = skin.palette + 16*size_t(skin.bones[at]);
+                            R w = R::set(skin.weights[at]);
+                            LINMATH_UNROLL
+                            for (size_t k=0; k<parts; k++)
+                                acc[k] = fma(R::load(bone + k*R::width), w, acc[k]);
+                        }
+                        LINMATH_UNROLL
+                        for (size_t k=0; k<parts; k++)
+                            acc[k].store(blend[k*R::width / 4] + 4*l + k*R::width % 4);
+                    }
+                    Q m[12];
+                    LINMATH_UNROLL
+                    for (size_t row=0; row<3; row++)
+                        Q::load4(blend[row], m[4*row], m[4*row + 1], m[4*row + 2], m[4*row + 3]);
+
+                    Q v[3];
+                    LINMATH_UNROLL
+                    for (size_t c=0; c<3; c++)
+                        v[c] = Q::load(skin.positions + c*skin.positionStride + i);
+                    LINMATH_UNROLL
+                    for (size_t row=0; row<3; row++)
+                        fma(v[2], m[4*row + 2], fma(v[1], m[4*row + 1], fma(v[0], m[4*row], m[4*row + 3]))).store(skin.outPositions + row*skin.outPositionStride + i);
+
+                    // The blended rotation is no longer orthonormal, so the normal is renormalized
+                    if constexpr (normals) {
+                        LINMATH_UNROLL
+                        for (size_t c=0; c<3; c++)
+                            v[c] = Q::load(skin.normals + c*skin.normalStride + i);
+                        Q r[3];
+                        LINMATH_UNROLL
+                        for (size_t row=0; row<3; row++)
+                            r[row] = fma(v[2], m[4*row + 2], fma(v[1], m[4*row + 1], v[0] * m[4*row]));
+                        Q len = sqrt(fma(r[2], r[2], fma(r[1], r[1], r[0] * r[0])));
+                        LINMATH_UNROLL
+                        for (size_t c=0; c<3; c++)
+                            (r[c] / len).store(skin.outNormals + c*skin.outNormalStride + i);
+                    }
+                });
+            }
+
+            // u x v
+            template <typename Q>
+            inline void skinCross(const Q* u, const Q* v, Q* r) {
+                r[0] = fma(u[1], v[2], -(u[2] * v[1]));
+                r[1] = fma(u[2], v[0], -(u[0] * v[2]));
+                r[2] = fma(u[0], v[1], -(u[1] * v[0]));
+            }
+
+            // v rotated by the unit quaternion q, v + w*t + u x t for t = 2u x v and the vector part u
+            template <typename Q>
+            inline void skinRotate(const Q* q, const Q* v, Q* r) {
+                Q t[3], ut[3];
+                LINMATH_TIER::skinCross(q, v, t);
+                LINMATH_UNROLL
+                for (size_t c=0; c<3; c++)
+                    t[c] = t[c] + t[c];
+                LINMATH_TIER::skinCross(q, t, ut);
+                LINMATH_UNROLL
+                for (size_t c=0; c<3; c++)
+                    r[c] = fma(q[3], t[c], v[c] + ut[c]);
+            }
+
+            // The bones are transposed by gather4 as they are loaded, the sign of each weight needs the planar dot product
+            template <typename T, bool normals>
+            void skinDualQuatRange(size_t begin, size_t end, const Skin<T>& skin) {
+                sweep<Pack<T>>(begin, end, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    Q b[8];
+                    LINMATH_UNROLL
+                    for (size_t c=0; c<8; c++)
+                        b[c] = Q::zero();
+                    for (size_t j=0; j<skin.influences; j++) {
+                        int32_t offset[Q::width];
+                        LINMATH_TIER::skinOffsets<T, Q>(skin, j, i, 8, offset);
+                        Q w = Q::load(skin.weights + j*skin.influenceStride + i);
+                        Q d[8];
+                        Q::gather4(skin.palette, offset, d[0], d[1], d[2], d[3]);
+                        Q::gather4(skin.palette + 4, offset, d[4], d[5], d[6], d[7]);
+                        Q cos = b[0] * d[0];
+                        LINMATH_UNROLL
+                        for (size_t c=1; c<4; c++)
+                            cos = fma(b[c], d[c], cos);
+                        w = mulsign(w, cos);
+                        LINMATH_UNROLL
+                        for (size_t c=0; c<8; c++)
+                            b[c] = fma(d[c], w, b[c]);
+                    }
+
+                    Q sq = b[0] * b[0];
+                    LINMATH_UNROLL
+                    for (size_t c=1; c<4; c++)
+                        sq = fma(b[c], b[c], sq);
+                    Q inv = Q::set(T(1)) / sqrt(sq);
+                    LINMATH_UNROLL
+                    for (size_t c=0; c<8; c++)
+                        b[c] = b[c] * inv;
+
+                    // The translation is the vector part of 2*dual*conjugate(real), 2(rw*dv - dw*rv + rv x dv)
+                    Q t[3];
+                    LINMATH_TIER::skinCross(b, b + 4, t);
+                    LINMATH_UNROLL
+                    for (size_t c=0; c<3; c++) {
+                        t[c] = fma(b[3], b[4 + c], fma(-b[7], b[c], t[c]));
+                        t[c] = t[c] + t[c];
+                    }
+
+                    Q v[3], r[3];
+                    LINMATH_UNROLL
+                    for (size_t c=0; c<3; c++)
+                        v[c] = Q::load(skin.positions + c*skin.positionStride + i);
+                    LINMATH_TIER::skinRotate(b, v, r);
+                    LINMATH_UNROLL
+                    for (size_t c=0; c<3; c++)
+                        (r[c] + t[c]).store(skin.outPositions + c*skin.outPositionStride + i);
+
+                    if constexpr (normals) {
+                        LINMATH_UNROLL
+                        for (size_t c=0; c<3; c++)
+                            v[c] = Q::load(skin.normals + c*skin.normalStride + i);
+                        LINMATH_TIER::skinRotate(b, v, r);
+                        LINMATH_UNROLL
+                        for (size_t c=0; c<3; c++)
+                            r[c].store(skin.outNormals + c*skin.outNormalStride + i);
+                    }
+                });
+            }
+
+            // Outputs may alias the inputs
+            template <typename T>
+            void skinLinear(size_t begin, size_t end, const Skin<T>& skin) {
+                if (skin.normals)
+                    LINMATH_TIER::skinLinearRange<T, true>(begin, end, skin);
+                else
+                    LINMATH_TIER::skinLinearRange<T, false>(begin, end, skin);
+            }
+            template <typename T>
+            void skinDualQuat(size_t begin, size_t end, const Skin<T>& skin) {
+                if (skin.normals)
+                    LINMATH_TIER::skinDualQuatRange<T, true>(begin, end, skin);
+                else
+                    LINMATH_TIER::skinDualQuatRange<T, false>(begin, end, skin);
+            }
+        }
+    }
+}
@@ -0,0 +1,69 @@
+// Batched solves of small linear systems for one dispatch tier, expanded by Simd/foreach.h
+// Every lane eliminates its own system with partial pivoting, the pivot search is a run of compare and select
+// exchanges between the diagonal row and each row below it, so lanes that pick different pivots never branch
+
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            // The matricies are only read and x may alias b, a zero pivot leaves infinities or NaN in that lane
+            template <typename T, size_t N>
+            void solve(size_t begin, size_t end, const Systems<T>& systems) {
+                sweep<Pack<T>>(begin, end, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    const T* a = systems.a + i / systems.lanes * N*N*systems.lanes + i % systems.lanes;
+
+                    // The augmented matrix, b is column N
+                    Q m[N][N + 1];
+                    LINMATH_UNROLL
+                    for (size_t row=0; row<N; row++) {
+                        LINMATH_UNROLL
+                        for (size_t col=0; col<N; col++)
+                            m[row][col] = Q::load(a + (N*row + col)*systems.lanes);
+                        m[row][N] = Q::load(systems.b + row*systems.bStride + i);
+                    }
+
+                    Q inv[N];
+                    LINMATH_UNROLL
+                    for (size_t col=0; col<N; col++) {
+                        LINMATH_UNROLL
+                        for (size_t row=col + 1; row<N; row++) {
+                            Q below = mulsign(m[row][col], m[row][col]);
+                            Q pivot = mulsign(m[col][col], m[col][col]);
+                            LINMATH_UNROLL
+                            for (size_t k=col; k<=N; k++) {
+                                Q t = select(below, pivot, m[row][k], m[col][k]);
+                                m[row][k] = select(below, pivot, m[col][k], m[row][k]);
+                                m[col][k] = t;
+                            }
+                        }
+
+                        inv[col] = Q::set(T(1)) / m[col][col];
+                        LINMATH_UNROLL
+                        for (size_t row=col + 1; row<N; row++) {
+                            Q f = -(m[row][col] * inv[col]);
+                            LINMATH_UNROLL
+                            for (size_t k=col + 1; k<=N; k++)
+                                m[row][k] = fma(f, m[col][k], m[row][k]);
+                        }
+                    }
+
+                    // Back substitution from the last row up
+                    Q x[N];
+                    LINMATH_UNROLL
+                    for (size_t up=0; up<N; up++) {
+                        size_t row = N - 1 - up;
+                        Q s = m[row][N];
+                        LINMATH_UNROLL
+                        for (size_t k=row + 1; k<N; k++)
+                            s = fma(-m[row][k], x[k], s);
+                        x[row] = s * inv[row];
+                    }
+                    LINMATH_UNROLL
+                    for (size_t row=0; row<N; row++)
+                        x[row].store(systems.x + row*systems.xStride + i);
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+// Sparse matrix products for one dispatch tier, expanded by Simd/foreach.h
+// The values and indices of a row stream in a pack at a time and the entries of x they pick are gathered, rows are
+// independent so any range of them runs on one thread, and products with several columns scale rows of X a few packs at a time
+
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            // Dot product of n values with the entries of x at index, by full packs of Q and the rest by narrower packs
+            template <typename T, typename Q>
+            inline T sparseDot(const T* values, const int32_t* index, const T* x, size_t n) {
+                T s = T(0);
+                size_t k = 0;
+                if (n >= Q::width) {
+                    Q acc = Q::zero();
+                    for (; k + Q::width <= n; k+=Q::width)
+                        acc = fma(Q::load(values + k), Q::gather(x, index + k), acc);
+                    s = acc.sum();
+                }
+                if constexpr (Q::width > 1)
+                    if (k < n)
+                        s += LINMATH_TIER::sparseDot<T, typename Q::Half>(values + k, index + k, x, n - k);
+                return s;
+            }
+
+            // y[r] = row r of A times x, for the rows from begin to end
+            template <typename T>
+            void spmv(size_t begin, size_t end, const SparseRows<T>& a, const T* x, T* y) {
+                for (size_t row=begin; row<end; row++) {
+                    size_t first = a.offsets[row];
+                    y[row] = LINMATH_TIER::sparseDot<T, Pack<T>>(a.values + first, a.indices + first, x, a.offsets[row + 1] - first);
+                }
+            }
+
+            // P packs of columns of one row of Y = A*X from column j, the nonzeros of the row scale rows of X into P registers
+            template <typename T, typename Q, size_t P>
+            inline void spmmColumns(const SparseRows<T>& a, size_t row, const T* x, size_t k, T* y, size_t j) {
+                Q acc[P];
+                LINMATH_UNROLL
+                for (size_t p=0; p<P; p++)
+                    acc[p] = Q::zero();
+                for (size_t e=a.offsets[row]; e<a.offsets[row + 1]; e++) {
+                    Q v = Q::set(a.values[e]);
+                    const T* from = x + size_t(a.indices[e])*k + j;
+                    LINMATH_UNROLL
+                    for (size_t p=0; p<P; p++)
+                        acc[p] = fma(v, Q::load(from + p*Q::width), acc[p]);
+                }
+                LINMATH_UNROLL
+                for (size_t p=0; p<P; p++)
+                    acc[p].store(y + row*k + j + p*Q::width);
+            }
+
+            // Rows from begin to end of Y = A*X, X and Y row major with k columns
+            // Columns go four packs at a time so a row's nonzeros are walked once per four packs, the rest by one pack
+            template <typename T>
+            void spmm(size_t begin, size_t end, const SparseRows<T>& a, const T* x, size_t k, T* y) {
+                using Q = Pack<T>;
+                for (size_t row=begin; row<end; row++) {
+                    size_t j = 0;
+                    for (; j + 4*Q::width <= k; j+=4*Q::width)
+                        LINMATH_TIER::spmmColumns<T, Q, 4>(a, row, x, k, y, j);
+                    if (j + 2*Q::width <= k) {
+                        LINMATH_TIER::spmmColumns<T, Q, 2>(a, row, x, k, y, j);
+                        j += 2*Q::width;
+                    }
+                    sweep<Q>(j, k, [&](auto q, size_t i) {
+                        LINMATH_TIER::spmmColumns<T, decltype(q), 1>(a, row, x, k, y, i);
+                    });
+                }
+            }
+
+            // y[3r] to y[3r + 2] = block row r of A times x, for the block rows from begin to end
+            // A block is narrower than a pack, so its nine products are written out and the three sums stay in registers
+            template <typename T>
+            void bsr3mv(size_t begin, size_t end, const SparseRows<T>& a, const T* x, T* y) {
+                for (size_t row=begin; row<end; row++) {
+                    T y0 = T(0), y1 = T(0), y2 = T(0);
+                    for (size_t e=a.offsets[row]; e<a.offsets[row + 1]; e++) {
+                        const T* b = a.values + 9*e;
+                        const T* v = x + 3*size_t(a.indices[e]);
+                        y0 += b[0]*v[0] + b[1]*v[1] + b[2]*v[2];
+                        y1 += b[3]*v[0] + b[4]*v[1] + b[5]*v[2];
+                        y2 += b[6]*v[0] + b[7]*v[1] + b[8]*v[2];
+                    }
+                    y[3*row] = y0;
+                    y[3*row + 1] = y1;
+                    y[3*row + 2] = y2;
+                }
+            }
+
+            // Block rows from begin to end of Y = A*X, X and Y row major with k columns
+            // Every block scales three rows of X into the three rows of Y it covers, a pack of columns at a time
+            template <typename T>
+            void bsr3mm(size_t begin, size_t end, const SparseRows<T>& a, const T* x, size_t k, T* y) {
+                for (size_t row=begin; row<end; row++) {
+                    size_t first = a.offsets[row], last = a.offsets[row + 1];
+                    sweep<Pack<T>>(0, k, [&](auto q, size_t j) {
+                        using Q = decltype(q);
+                        Q y0 = Q::zero(), y1 = Q::zero(), y2 = Q::zero();
+                        for (size_t e=first; e<last; e++) {
+                            const T* b = a.values + 9*e;
+                            const T* v = x + 3*size_t(a.indices[e])*k + j;
+                            Q x0 = Q::load(v), x1 = Q::load(v + k), x2 = Q::load(v + 2*k);
+                            y0 = fma(Q::set(b[0]), x0, fma(Q::set(b[1]), x1, fma(Q::set(b[2]), x2, y0)));
+                            y1 = fma(Q::set(b[3]), x0, fma(Q::set(b[4]), x1, fma(Q::set(b[5]), x2, y1)));
+                            y2 = fma(Q::set(b[6]), x0, fma(Q::set(b[7]), x1, fma(Q::set(b[8]), x2, y2)));
+                        }
+                        y0.store(y + 3*row*k + j);
+                        y1.store(y + (3*row + 1)*k + j);
+                        y2.store(y + (3*row + 2)*k + j);
+                    });
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,170 @@
+// Batched 3x3 singular value and polar decompositions for one dispatch tier, expanded by Simd/foreach.h
+// Follows McAdams et al., Computing the SVD of 3x3 matrices with minimal branching: V diagonalizes A^T*A by Jacobi,
+// the columns of A*V are sorted by length with sign keeping exchanges and a Givens QR of them gives U and the
+// singular values, so V and U stay rotations and every step is a fixed sequence of selects
+// The Jacobi rotations are the exact ones of jacobi3 rather than the paper's approximate quaternions, so that
+// double converges as well as float
+
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            // Half angle Givens rotation (ch, sh) that zeros a2 against a1 and leaves a1 non negative
+            template <typename T, typename Q>
+            inline void svdGivens(Q a1, Q a2, Q& ch, Q& sh) {
+                constexpr T tiny = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+                Q rho = sqrt(fma(a1, a1, a2 * a2));
+                Q c = mulsign(a1, a1) + max(rho, Q::set(tiny));
+                Q s = select(rho, Q::set(tiny), a2, Q::zero());
+                ch = select(Q::zero(), a1, s, c);
+                sh = select(Q::zero(), a1, c, s);
+                Q w = Q::set(T(1)) / sqrt(fma(ch, ch, sh * sh));
+                ch = ch * w;
+                sh = sh * w;
+            }
+
+            // Rows p and q of b rotated by the Givens rotation of b[p][col] and b[q][col], and the transposed rotation
+            // applied to columns p and q of u
+            template <typename T, typename Q>
+            inline void svdQRStep(Q (&b)[3][3], Q (&u)[3][3], size_t p, size_t q, size_t col) {
+                Q ch, sh;
+                LINMATH_TIER::svdGivens<T>(b[p][col], b[q][col], ch, sh);
+                Q c = fma(ch, ch, -(sh * sh));
+                Q s = Q::set(T(2)) * ch * sh;
+                LINMATH_UNROLL
+                for (size_t k=0; k<3; k++) {
+                    Q bp = b[p][k], bq = b[q][k];
+                    b[p][k] = fma(c, bp, s * bq);
+                    b[q][k] = fma(c, bq, -(s * bp));
+                    Q up = u[k][p], uq = u[k][q];
+                    u[k][p] = fma(c, up, s * uq);
+                    u[k][q] = fma(c, uq, -(s * up));
+                }
+            }
+
+            // A = U*diag(sigma)*Vt^T with U and Vt rotations, sigma descending and only its last value negative when det A is
+            template <typename T, typename Q>
+            inline void svd3Pack(Q (&a)[3][3], Q (&u)[3][3], Q (&sigma)[3], Q (&vt)[3][3]) {
+                Q one = Q::set(T(1));
+
+                // Scaled to a largest value of 1, so A^T*A neither overflows nor underflows
+                Q size = Q::zero();
+                LINMATH_UNROLL
+                for (size_t k=0; k<9; k++)
+                    size = max(size, mulsign(a[k/3][k%3], a[k/3][k%3]));
+                Q inv = select(size, Q::zero(), one / size, Q::zero());
+                LINMATH_UNROLL
+                for (size_t k=0; k<9; k++)
+                    a[k/3][k%3] = a[k/3][k%3] * inv;
+
+                Q m[3][3];
+                LINMATH_UNROLL
+                for (size_t row=0; row<3; row++)
+                    LINMATH_UNROLL
+                    for (size_t col=row; col<3; col++)
+                        m[row][col] = m[col][row] = fma(a[0][row], a[0][col], fma(a[1][row], a[1][col], a[2][row] * a[2][col]));
+                LINMATH_UNROLL
+                for (size_t row=0; row<3; row++)
+                    LINMATH_UNROLL
+                    for (size_t col=0; col<3; col++) {
+                        vt[row][col] = row == col ? one : Q::zero();
+                        u[row][col] = vt[row][col];
+                    }
+                LINMATH_TIER::jacobi3<T>(m, vt);
+
+                Q b[3][3];
+                LINMATH_UNROLL
+                for (size_t row=0; row<3; row++)
+                    LINMATH_UNROLL
+                    for (size_t col=0; col<3; col++)
+                        b[row][col] = fma(a[row][0], vt[col][0], fma(a[row][1], vt[col][1], a[row][2] * vt[col][2]));
+
+                // Columns by descending length, the column moved down is negated so that V stays a rotation
+                Q rho[3];
+                LINMATH_UNROLL
+                for (size_t col=0; col<3; col++)
+                    rho[col] = fma(b[0][col], b[0][col], fma(b[1][col], b[1][col], b[2][col] * b[2][col]));
+                constexpr size_t order[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+                LINMATH_UNROLL
+                for (size_t k=0; k<3; k++) {
+                    size_t x = order[k][0], y = order[k][1];
+                    Q rx = rho[x], ry = rho[y];
+                    rho[x] = select(ry, rx, ry, rx);
+                    rho[y] = select(ry, rx, rx, ry);
+                    LINMATH_UNROLL
+                    for (size_t j=0; j<3; j++) {
+                        Q bx = b[j][x], by = b[j][y];
+                        b[j][x] = select(ry, rx, by, bx);
+                        b[j][y] = select(ry, rx, -bx, by);
+                        Q vx = vt[x][j], vy = vt[y][j];
+                        vt[x][j] = select(ry, rx, vy, vx);
+                        vt[y][j] = select(ry, rx, -vx, vy);
+                    }
+                }
+
+                LINMATH_TIER::svdQRStep<T>(b, u, 0, 1, 0);
+                LINMATH_TIER::svdQRStep<T>(b, u, 0, 2, 0);
+                LINMATH_TIER::svdQRStep<T>(b, u, 1, 2, 1);
+                LINMATH_UNROLL
+                for (size_t k=0; k<3; k++)
+                    sigma[k] = b[k][k] * size;
+            }
+
+            // Singular value decompositions A = U*diag(sigma)*V^T of the top left 3x3 of S by S matricies, laid out as
+            // in Systems, value r of matrix i at sigma[r*sigmaStride + i] and U and V in 3x3 blocks of the same lanes
+            template <typename T, size_t S>
+            void svd3(size_t begin, size_t end, size_t lanes, const T* a, T* u, T* sigma, size_t sigmaStride, T* v) {
+                sweep<Pack<T>>(begin, end, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    size_t from = i / lanes * S*S*lanes + i % lanes;
+                    size_t at = i / lanes * 9*lanes + i % lanes;
+
+                    Q m[3][3], us[3][3], s[3], vt[3][3];
+                    LINMATH_UNROLL
+                    for (size_t k=0; k<9; k++)
+                        m[k/3][k%3] = Q::load(a + from + (S*(k/3) + k%3)*lanes);
+                    LINMATH_TIER::svd3Pack<T>(m, us, s, vt);
+
+                    LINMATH_UNROLL
+                    for (size_t k=0; k<9; k++) {
+                        us[k/3][k%3].store(u + at + k*lanes);
+                        vt[k%3][k/3].store(v + at + k*lanes);
+                    }
+                    LINMATH_UNROLL
+                    for (size_t k=0; k<3; k++)
+                        s[k].store(sigma + k*sigmaStride + i);
+                });
+            }
+
+            // Polar decompositions A = R*P of the top left 3x3 of S by S matricies, R = U*V^T the closest rotation
+            // and P = V*diag(sigma)*V^T the stretch, which keeps the reflection of a negative determinant
+            // stretch may be null
+            template <typename T, size_t S>
+            void polar3(size_t begin, size_t end, size_t lanes, const T* a, T* rotation, T* stretch) {
+                sweep<Pack<T>>(begin, end, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    size_t from = i / lanes * S*S*lanes + i % lanes;
+                    size_t at = i / lanes * 9*lanes + i % lanes;
+
+                    Q m[3][3], u[3][3], s[3], vt[3][3];
+                    LINMATH_UNROLL
+                    for (size_t k=0; k<9; k++)
+                        m[k/3][k%3] = Q::load(a + from + (S*(k/3) + k%3)*lanes);
+                    LINMATH_TIER::svd3Pack<T>(m, u, s, vt);
+
+                    LINMATH_UNROLL
+                    for (size_t k=0; k<9; k++) {
+                        size_t row = k/3, col = k%3;
+                        fma(u[row][0], vt[0][col], fma(u[row][1], vt[1][col], u[row][2] * vt[2][col])).store(rotation + at + k*lanes);
+                    }
+                    if (stretch)
+                        LINMATH_UNROLL
+                        for (size_t k=0; k<9; k++) {
+                            size_t row = k/3, col = k%3;
+                            fma(vt[0][row] * s[0], vt[0][col], fma(vt[1][row] * s[1], vt[1][col], vt[2][row] * s[2] * vt[2][col])).store(stretch + at + k*lanes);
+                        }
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+// Batched 4x4 transforms for one dispatch tier, expanded by Simd/foreach.h
+// m is row major and applied to column vectors, row vectors copy its transpose instead, 3 component inputs have an implied w of 1
+// Planar vectors keep component c of vector i at v[c*stride + i], interleaved ones at v[D*i + c]
+
+namespace linmath {
+    namespace simd {
+        namespace LINMATH_TIER {
+
+            // Transforms one pack of vectors v into r
+            template <typename T, size_t D, Transform mode, typename Q>
+            inline void transformPack(const T* mat, const Q* v, Q* r) {
+                constexpr size_t rows = mode == Transform::Homogeneous || (D == 4 && mode == Transform::Full) ? 4 : 3;
+                for (size_t row=0; row<rows; row++) {
+                    Q acc = v[0] * Q::set(mat[4*row]);
+                    acc = fma(v[1], Q::set(mat[4*row + 1]), acc);
+                    acc = fma(v[2], Q::set(mat[4*row + 2]), acc);
+                    if constexpr (D == 4)
+                        acc = fma(v[3], Q::set(mat[4*row + 3]), acc);
+                    else
+                        acc = acc + Q::set(mat[4*row + 3]);
+                    r[row] = acc;
+                }
+
+                if constexpr (mode == Transform::Homogeneous) {
+                    for (size_t c=0; c<3; c++)
+                        r[c] = r[c] / r[3];
+                    r[3] = Q::set(T(1));
+                }
+                if constexpr (mode == Transform::Affine && D == 4)
+                    r[3] = v[3];
+            }
+
+            // A local copy cannot alias out, so the broadcasts are hoisted out of the loop
+            template <typename T, Convention order>
+            inline void transformMatrix(const T* m, T* mat) {
+                for (size_t i=0; i<16; i++)
+                    mat[i] = order == Convention::RowVectors ? m[4*(i%4) + i/4] : m[i];
+            }
+
+            template <typename T, size_t D, Transform mode, Convention order>
+            void transformPlanar(size_t n, const T* m, const T* in, size_t si, T* out, size_t so) {
+                T mat[16];
+                LINMATH_TIER::transformMatrix<T, order>(m, mat);
+
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    Q v[4], r[4];
+                    for (size_t c=0; c<D; c++)
+                        v[c] = Q::load(in + c*si + i);
+                    LINMATH_TIER::transformPack<T, D, mode>(mat, v, r);
+                    for (size_t c=0; c<D; c++)
+                        r[c].store(out + c*so + i);
+                });
+            }
+
+            // Interleaved vectors are transposed to planar packs in registers, out may alias in
+            template <typename T, size_t D, Transform mode, Convention order>
+            void transformInterleaved(size_t n, const T* m, const T* in, T* out) {
+                T mat[16];
+                LINMATH_TIER::transformMatrix<T, order>(m, mat);
+
+                sweep<Pack<T>>(0, n, [&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    Q v[4], r[4];
+                    if constexpr (D == 4) {
+                        Q::load4(in + 4*i, v[0], v[1], v[2], v[3]);
+                        LINMATH_TIER::transformPack<T, D, mode>(mat, v, r);
+                        Q::store4(out + 4*i, r[0], r[1], r[2], r[3]);
+                    }
+                    else {
+                        Q::load3(in + 3*i, v[0], v[1], v[2]);
+                        LINMATH_TIER::transformPack<T, D, mode>(mat, v, r);
+                        Q::store3(out + 3*i, r[0], r[1], r[2]);
+                    }
+                });
+            }
+        }
+    }
+}
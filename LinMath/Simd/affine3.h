@@ -0,0 +1,285 @@
+#ifndef SIMD_AFFINE3_H
+#define SIMD_AFFINE3_H
+
+#include "simd.h"
+#include "dispatch.h"
+#include "mat4.h"
+
+// Affine 4x4 kernels on the 12 stored values, rows 0 to 2 the linear part and row 3 the translation
+// affineDot:                 out = a * b
+// affineInverse:             out = inverse(m), the 3x3 inverse of the linear part and t' = -t * inverse(linear)
+// affineInverseOrthonormal:  the same with the transpose as inverse, for rotations with a translation
+// out may alias the inputs in all of them
+
+namespace linmath {
+    namespace simd {
+
+LINMATH_EXACT_BEGIN
+        namespace scalar {
+
+            template <typename T>
+            constexpr void affineDot(const T* a, const T* b, T* out) {
+                T dot[12];
+                for (int i=0; i<12; i+=3)
+                    for (int j=0; j<3; j++)
+                        dot[i + j] = a[i]*b[j] + a[i + 1]*b[3 + j] + a[i + 2]*b[6 + j];
+                for (int j=0; j<3; j++)
+                    dot[9 + j] += b[9 + j];
+                for (int i=0; i<12; i++)
+                    out[i] = dot[i];
+            }
+
+            template <typename T>
+            constexpr void affineTranslate(const T* inv, const T* m, T* out) {
+                T tx = m[9], ty = m[10], tz = m[11];
+                for (int i=0; i<9; i++)
+                    out[i] = inv[i];
+                for (int j=0; j<3; j++)
+                    out[9 + j] = -(tx*inv[j] + ty*inv[3 + j] + tz*inv[6 + j]);
+            }
+
+            template <typename T>
+            constexpr void affineInverse(const T* m, T* out) {
+                T inv[9];
+                inv[0] = m[4]*m[8] - m[5]*m[7];
+                inv[1] = m[2]*m[7] - m[1]*m[8];
+                inv[2] = m[1]*m[5] - m[2]*m[4];
+                inv[3] = m[5]*m[6] - m[3]*m[8];
+                inv[4] = m[0]*m[8] - m[2]*m[6];
+                inv[5] = m[2]*m[3] - m[0]*m[5];
+                inv[6] = m[3]*m[7] - m[4]*m[6];
+                inv[7] = m[1]*m[6] - m[0]*m[7];
+                inv[8] = m[0]*m[4] - m[1]*m[3];
+
+                T rdet = T(1) / (m[0]*inv[0] + m[1]*inv[3] + m[2]*inv[6]);
+                for (int i=0; i<9; i++)
+                    inv[i] *= rdet;
+                affineTranslate(inv, m, out);
+            }
+
+            template <typename T>
+            constexpr void affineInverseOrthonormal(const T* m, T* out) {
+                T inv[9];
+                for (int i=0; i<3; i++)
+                    for (int j=0; j<3; j++)
+                        inv[3*i + j] = m[3*j + i];
+                affineTranslate(inv, m, out);
+            }
+        }
+LINMATH_EXACT_END
+
+    #if LINMATH_X86
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_SSE42)
+LINMATH_EXACT_BEGIN
+        namespace sse42 {
+
+            // Rows of 3 floats in the low lanes, read and written as three full registers so the
+            // accesses line up with the ones of a Affine3 copy and store forwarding keeps working
+            inline void affineLoad(const float* m, __m128& r0, __m128& r1, __m128& r2, __m128& r3) {
+                __m128 l0 = _mm_loadu_ps(m);
+                __m128 l1 = _mm_loadu_ps(m + 4);
+                __m128 l2 = _mm_loadu_ps(m + 8);
+                r0 = l0;
+                r1 = _mm_castsi128_ps(_mm_alignr_epi8(_mm_castps_si128(l1), _mm_castps_si128(l0), 12));
+                r2 = _mm_castsi128_ps(_mm_alignr_epi8(_mm_castps_si128(l2), _mm_castps_si128(l1), 8));
+                r3 = swizzle<1, 2, 3, 0>(l2);
+            }
+            inline void affineStore(float* out, __m128 r0, __m128 r1, __m128 r2, __m128 r3) {
+                __m128 next = swizzle<0, 0, 0, 0>(r1);
+                _mm_storeu_ps(out, _mm_blend_ps(r0, next, 0x8));
+                _mm_storeu_ps(out + 4, shuffle<1, 2, 0, 1>(r1, r2));
+                _mm_storeu_ps(out + 8, shuffle<0, 2, 1, 2>(shuffle<2, 2, 0, 0>(r2, r3), r3));
+            }
+            inline __m128 cross(__m128 a, __m128 b) {
+                __m128 c = _mm_sub_ps(_mm_mul_ps(a, swizzle<1, 2, 0, 3>(b)), _mm_mul_ps(swizzle<1, 2, 0, 3>(a), b));
+                return swizzle<1, 2, 0, 3>(c);
+            }
+            // Rows of the inverse are the columns of the cofactor rows, the translation follows as -t * inverse
+            inline void affineTranslate(__m128 c0, __m128 c1, __m128 c2, __m128 t, float* out) {
+                __m128 c3 = _mm_setzero_ps();
+                _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+                __m128 r3 = _mm_mul_ps(swizzle<0, 0, 0, 0>(t), c0);
+                r3 = _mm_add_ps(r3, _mm_mul_ps(swizzle<1, 1, 1, 1>(t), c1));
+                r3 = _mm_add_ps(r3, _mm_mul_ps(swizzle<2, 2, 2, 2>(t), c2));
+                affineStore(out, c0, c1, c2, _mm_sub_ps(_mm_setzero_ps(), r3));
+            }
+
+            inline void affineDot(const float* a, const float* b, float* out) {
+                __m128 b0, b1, b2, b3;
+                affineLoad(b, b0, b1, b2, b3);
+                __m128 r[4];
+                for (int i=0; i<4; i++) {
+                    r[i] = _mm_mul_ps(_mm_set1_ps(a[3*i]), b0);
+                    r[i] = _mm_add_ps(r[i], _mm_mul_ps(_mm_set1_ps(a[3*i + 1]), b1));
+                    r[i] = _mm_add_ps(r[i], _mm_mul_ps(_mm_set1_ps(a[3*i + 2]), b2));
+                }
+                affineStore(out, r[0], r[1], r[2], _mm_add_ps(r[3], b3));
+            }
+            inline void affineDot(const double* a, const double* b, double* out) {
+                scalar::affineDot(a, b, out);
+            }
+
+            inline void affineInverse(const float* m, float* out) {
+                __m128 r0, r1, r2, t;
+                affineLoad(m, r0, r1, r2, t);
+                __m128 c0 = cross(r1, r2);
+                __m128 c1 = cross(r2, r0);
+                __m128 c2 = cross(r0, r1);
+                __m128 rdet = _mm_div_ps(_mm_set1_ps(1.f), _mm_dp_ps(r0, c0, 0x7F));
+                affineTranslate(_mm_mul_ps(c0, rdet), _mm_mul_ps(c1, rdet), _mm_mul_ps(c2, rdet), t, out);
+            }
+            inline void affineInverse(const double* m, double* out) {
+                scalar::affineInverse(m, out);
+            }
+
+            inline void affineInverseOrthonormal(const float* m, float* out) {
+                __m128 r0, r1, r2, t;
+                affineLoad(m, r0, r1, r2, t);
+                // The inverse is the transpose, so the rows go in where the cofactor rows would
+                affineTranslate(r0, r1, r2, t, out);
+            }
+            inline void affineInverseOrthonormal(const double* m, double* out) {
+                scalar::affineInverseOrthonormal(m, out);
+            }
+        }
+LINMATH_EXACT_END
+LINMATH_TARGET_END
+
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_AVX2)
+LINMATH_EXACT_BEGIN
+        namespace avx2 {
+
+            // The Mat4 broadcast kernels on rows widened to four lanes, lane 3 of every row is never stored and the
+            // translation is added to row 3 alone, so the products round as the scalar ones
+            // Values of a are broadcast one at a time, so a chain of products where each is the next left operand
+            // keeps store forwarding, and no load reads past the 12 values
+            inline void affineDot(const float* a, const float* b, float* out) {
+                __m256 b0 = _mm256_broadcast_ps((const __m128*)(b));
+                __m256 b1 = _mm256_broadcast_ps((const __m128*)(b + 3));
+                __m256 b2 = _mm256_broadcast_ps((const __m128*)(b + 6));
+                __m256 b3 = _mm256_permute_ps(_mm256_broadcast_ps((const __m128*)(b + 8)), _MM_SHUFFLE(3, 3, 2, 1));
+                __m256 r01 = _mm256_mul_ps(_mm256_blend_ps(_mm256_broadcast_ss(a), _mm256_broadcast_ss(a + 3), 0xF0), b0);
+                __m256 r23 = _mm256_mul_ps(_mm256_blend_ps(_mm256_broadcast_ss(a + 6), _mm256_broadcast_ss(a + 9), 0xF0), b0);
+                r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_blend_ps(_mm256_broadcast_ss(a + 1), _mm256_broadcast_ss(a + 4), 0xF0), b1));
+                r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_blend_ps(_mm256_broadcast_ss(a + 7), _mm256_broadcast_ss(a + 10), 0xF0), b1));
+                r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_blend_ps(_mm256_broadcast_ss(a + 2), _mm256_broadcast_ss(a + 5), 0xF0), b2));
+                r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_blend_ps(_mm256_broadcast_ss(a + 8), _mm256_broadcast_ss(a + 11), 0xF0), b2));
+                r23 = _mm256_blend_ps(r23, _mm256_add_ps(r23, b3), 0xF0);
+                __m256 low = _mm256_permutevar8x32_ps(r01, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 6, 6));
+                __m256 high = _mm256_permutevar8x32_ps(r23, _mm256_setr_epi32(2, 4, 5, 6, 6, 6, 0, 1));
+                _mm256_storeu_ps(out, _mm256_blend_ps(low, high, 0xC0));
+                _mm_storeu_ps(out + 8, _mm256_castps256_ps128(high));
+            }
+            inline void affineDot(const double* a, const double* b, double* out) {
+                __m256d b0 = _mm256_loadu_pd(b);
+                __m256d b1 = _mm256_loadu_pd(b + 3);
+                __m256d b2 = _mm256_loadu_pd(b + 6);
+                __m256d b3 = _mm256_permute4x64_pd(_mm256_loadu_pd(b + 8), 0xF9);
+                __m256d r[4];
+                for (int i=0; i<4; i++) {
+                    r[i] = _mm256_mul_pd(_mm256_broadcast_sd(a + 3*i), b0);
+                    r[i] = _mm256_add_pd(r[i], _mm256_mul_pd(_mm256_broadcast_sd(a + 3*i + 1), b1));
+                    r[i] = _mm256_add_pd(r[i], _mm256_mul_pd(_mm256_broadcast_sd(a + 3*i + 2), b2));
+                }
+                r[3] = _mm256_add_pd(r[3], b3);
+                _mm256_storeu_pd(out, _mm256_blend_pd(r[0], _mm256_permute4x64_pd(r[1], 0x00), 0x8));
+                _mm256_storeu_pd(out + 4, _mm256_blend_pd(_mm256_permute4x64_pd(r[1], 0x09), _mm256_permute4x64_pd(r[2], 0x40), 0xC));
+                _mm256_storeu_pd(out + 8, _mm256_blend_pd(_mm256_permute4x64_pd(r[2], 0x02), _mm256_permute4x64_pd(r[3], 0x90), 0xE));
+            }
+
+            // The sse4.2 kernels, rows of three floats fill no wider register
+            inline void affineInverse(const float* m, float* out) {
+                sse42::affineInverse(m, out);
+            }
+            inline void affineInverse(const double* m, double* out) {
+                scalar::affineInverse(m, out);
+            }
+            inline void affineInverseOrthonormal(const float* m, float* out) {
+                sse42::affineInverseOrthonormal(m, out);
+            }
+            inline void affineInverseOrthonormal(const double* m, double* out) {
+                scalar::affineInverseOrthonormal(m, out);
+            }
+        }
+LINMATH_EXACT_END
+LINMATH_TARGET_END
+
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_AVX512)
+LINMATH_EXACT_BEGIN
+        namespace avx512 {
+
+            // Single products of floats gain nothing from a wider register, doubles take rows 0 and 1 in one and rows
+            // 2 and 3 in the other as the Mat4 kernel does, with the same loads and stores as the avx2 kernels
+            // Zero masked forms avoid the undefined source operand gcc warns about
+            inline void affineDot(const float* a, const float* b, float* out) {
+                avx2::affineDot(a, b, out);
+            }
+            inline void affineDot(const double* a, const double* b, double* out) {
+                __m512d b0 = _mm512_maskz_broadcast_f64x4(0xFF, _mm256_loadu_pd(b));
+                __m512d b1 = _mm512_maskz_broadcast_f64x4(0xFF, _mm256_loadu_pd(b + 3));
+                __m512d b2 = _mm512_maskz_broadcast_f64x4(0xFF, _mm256_loadu_pd(b + 6));
+                __m512d b3 = _mm512_maskz_broadcast_f64x4(0xFF, _mm256_permute4x64_pd(_mm256_loadu_pd(b + 8), 0xF9));
+                __m512d r01 = _mm512_mul_pd(_mm512_mask_blend_pd(0xF0, _mm512_set1_pd(a[0]), _mm512_set1_pd(a[3])), b0);
+                __m512d r23 = _mm512_mul_pd(_mm512_mask_blend_pd(0xF0, _mm512_set1_pd(a[6]), _mm512_set1_pd(a[9])), b0);
+                r01 = _mm512_add_pd(r01, _mm512_mul_pd(_mm512_mask_blend_pd(0xF0, _mm512_set1_pd(a[1]), _mm512_set1_pd(a[4])), b1));
+                r23 = _mm512_add_pd(r23, _mm512_mul_pd(_mm512_mask_blend_pd(0xF0, _mm512_set1_pd(a[7]), _mm512_set1_pd(a[10])), b1));
+                r01 = _mm512_add_pd(r01, _mm512_mul_pd(_mm512_mask_blend_pd(0xF0, _mm512_set1_pd(a[2]), _mm512_set1_pd(a[5])), b2));
+                r23 = _mm512_add_pd(r23, _mm512_mul_pd(_mm512_mask_blend_pd(0xF0, _mm512_set1_pd(a[8]), _mm512_set1_pd(a[11])), b2));
+                r23 = _mm512_mask_add_pd(r23, 0xF0, r23, b3);
+                // Values 0 to 7 and 8 to 11, so every piece an Affine3 copy loads comes from one store
+                __m512d low = _mm512_maskz_permutex2var_pd(0xFF, r01, _mm512_setr_epi64(0, 1, 2, 4, 5, 6, 8, 9), r23);
+                __m512d high = _mm512_maskz_permutexvar_pd(0xFF, _mm512_setr_epi64(2, 4, 5, 6, 6, 6, 6, 6), r23);
+                _mm512_storeu_pd(out, low);
+                _mm256_storeu_pd(out + 8, _mm512_maskz_extractf64x4_pd(0xF, high, 0));
+            }
+            inline void affineInverse(const float* m, float* out) {
+                avx2::affineInverse(m, out);
+            }
+            inline void affineInverse(const double* m, double* out) {
+                avx2::affineInverse(m, out);
+            }
+            inline void affineInverseOrthonormal(const float* m, float* out) {
+                avx2::affineInverseOrthonormal(m, out);
+            }
+            inline void affineInverseOrthonormal(const double* m, double* out) {
+                avx2::affineInverseOrthonormal(m, out);
+            }
+        }
+LINMATH_EXACT_END
+LINMATH_TARGET_END
+    #endif
+
+        // Dispatched kernels
+        template <typename T>
+        using AffineBinary = void (*)(const T*, const T*, T*);
+        template <typename T>
+        using AffineUnary = void (*)(const T*, T*);
+
+        inline void affineDot(const float* a, const float* b, float* out) {
+            static const AffineBinary<float> kernel = LINMATH_DISPATCH(AffineBinary<float>, affineDot);
+            kernel(a, b, out);
+        }
+        inline void affineDot(const double* a, const double* b, double* out) {
+            static const AffineBinary<double> kernel = LINMATH_DISPATCH(AffineBinary<double>, affineDot);
+            kernel(a, b, out);
+        }
+        inline void affineInverse(const float* m, float* out) {
+            static const AffineUnary<float> kernel = LINMATH_DISPATCH(AffineUnary<float>, affineInverse);
+            kernel(m, out);
+        }
+        inline void affineInverse(const double* m, double* out) {
+            static const AffineUnary<double> kernel = LINMATH_DISPATCH(AffineUnary<double>, affineInverse);
+            kernel(m, out);
+        }
+        inline void affineInverseOrthonormal(const float* m, float* out) {
+            static const AffineUnary<float> kernel = LINMATH_DISPATCH(AffineUnary<float>, affineInverseOrthonormal);
+            kernel(m, out);
+        }
+        inline void affineInverseOrthonormal(const double* m, double* out) {
+            static const AffineUnary<double> kernel = LINMATH_DISPATCH(AffineUnary<double>, affineInverseOrthonormal);
+            kernel(m, out);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef ALIGNED_H
+#define ALIGNED_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace linmath {
+    namespace simd {
+
+        // Cache line alignment, also enough for the widest register
+        constexpr size_t cacheLine = 64;
+
+        // Alignment of n packed values, their size rounded up to a power of 2 and at most a cache line,
+        // so a Vec4<float> fills one 16 byte register and a Vec4<double> one 32 byte register
+        template <typename T, size_t n>
+        constexpr size_t alignment = [] {
+            size_t align = alignof(T);
+            while (align < n*sizeof(T) && align < cacheLine)
+                align *= 2;
+            return align;
+        }();
+
+        // Uninitialized cache line aligned storage for n values
+        template <typename T>
+        T* alignedAlloc(size_t n) {
+            return static_cast<T*>(::operator new(n*sizeof(T), std::align_val_t(cacheLine)));
+        }
+        template <typename T>
+        void alignedFree(T* values) {
+            ::operator delete(values, std::align_val_t(cacheLine));
+        }
+
+        // Allocator for std::vector and the other std containers, the storage starts on an align byte boundary
+        template <typename T, size_t align = cacheLine>
+        class AlignedAllocator {
+
+            static constexpr size_t boundary = align > alignof(T) ? align : alignof(T);
+
+            public:
+            using value_type = T;
+
+            template <typename U>
+            struct rebind {
+                using other = AlignedAllocator<U, align>;
+            };
+
+            AlignedAllocator() {}
+            template <typename U>
+            AlignedAllocator(const AlignedAllocator<U, align>&) {}
+
+            T* allocate(size_t n) {
+                return static_cast<T*>(::operator new(n*sizeof(T), std::align_val_t(boundary)));
+            }
+            void deallocate(T* values, size_t) {
+                ::operator delete(values, std::align_val_t(boundary));
+            }
+
+            template <typename U>
+            bool operator==(const AlignedAllocator<U, align>&)const {
+                return true;
+            }
+            template <typename U>
+            bool operator!=(const AlignedAllocator<U, align>&)const {
+                return false;
+            }
+        };
+
+        template <typename T, size_t align = cacheLine>
+        using AlignedVector = std::vector<T, AlignedAllocator<T, align>>;
+
+        // Grow only scratch storage for packed panels, kept per thread by the kernels
+        template <typename T>
+        class AlignedBuffer {
+
+            T* values = nullptr;
+            size_t size = 0;
+
+            public:
+
+            AlignedBuffer() {}
+            AlignedBuffer(const AlignedBuffer&) = delete;
+            AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+            ~AlignedBuffer() {
+                if (values)
+                    alignedFree(values);
+            }
+
+            T* reserve(size_t n) {
+                if (n > size) {
+                    if (values)
+                        alignedFree(values);
+                    values = alignedAlloc<T>(n);
+                    size = n;
+                }
+                return values;
+            }
+        };
+    }
+}
+
+#endif
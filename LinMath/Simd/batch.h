@@ -0,0 +1,152 @@
+#ifndef SIMD_BATCH_H
+#define SIMD_BATCH_H
+
+#include <cstddef>
+#include <limits>
+
+#include "dispatch.h"
+#include "../Math/math.h"
+
+#define LINMATH_KERNELS "Kernels/batch.h"
+#include "foreach.h"
+
+namespace linmath {
+    namespace simd {
+
+        // Dispatched kernels, float and double run the active tier and other types the scalar templates
+        template <typename T>
+        using BatchBinary = void (*)(size_t, const T*, const T*, T*);
+        template <typename T>
+        using BatchUnary = void (*)(size_t, const T*, T*);
+        template <typename T>
+        using BatchScalar = void (*)(size_t, const T*, T, T*);
+        template <typename T>
+        using BatchReduce = void (*)(size_t, const T*, size_t, const T*, size_t, T*);
+        template <typename T>
+        using BatchLength = void (*)(size_t, const T*, size_t, T*);
+        template <typename T>
+        using BatchMap = void (*)(size_t, const T*, size_t, T*, size_t);
+        template <typename T>
+        using BatchCross = void (*)(size_t, const T*, size_t, const T*, size_t, T*, size_t);
+
+        template <typename T>
+        inline void add(size_t n, const T* a, const T* b, T* out) {
+            if constexpr (vectorized<T>) {
+                static const BatchBinary<T> kernel = LINMATH_DISPATCH(BatchBinary<T>, add<T>);
+                kernel(n, a, b, out);
+            }
+            else
+                scalar::add<T>(n, a, b, out);
+        }
+        template <typename T>
+        inline void sub(size_t n, const T* a, const T* b, T* out) {
+            if constexpr (vectorized<T>) {
+                static const BatchBinary<T> kernel = LINMATH_DISPATCH(BatchBinary<T>, sub<T>);
+                kernel(n, a, b, out);
+            }
+            else
+                scalar::sub<T>(n, a, b, out);
+        }
+        template <typename T>
+        inline void mul(size_t n, const T* a, const T* b, T* out) {
+            if constexpr (vectorized<T>) {
+                static const BatchBinary<T> kernel = LINMATH_DISPATCH(BatchBinary<T>, mul<T>);
+                kernel(n, a, b, out);
+            }
+            else
+                scalar::mul<T>(n, a, b, out);
+        }
+        template <typename T>
+        inline void div(size_t n, const T* a, const T* b, T* out) {
+            if constexpr (vectorized<T>) {
+                static const BatchBinary<T> kernel = LINMATH_DISPATCH(BatchBinary<T>, div<T>);
+                kernel(n, a, b, out);
+            }
+            else
+                scalar::div<T>(n, a, b, out);
+        }
+        template <typename T>
+        inline void negate(size_t n, const T* a, T* out) {
+            if constexpr (vectorized<T>) {
+                static const BatchUnary<T> kernel = LINMATH_DISPATCH(BatchUnary<T>, negate<T>);
+                kernel(n, a, out);
+            }
+            else
+                scalar::negate<T>(n, a, out);
+        }
+        template <typename T>
+        inline void addScalar(size_t n, const T* a, T t, T* out) {
+            if constexpr (vectorized<T>) {
+                static const BatchScalar<T> kernel = LINMATH_DISPATCH(BatchScalar<T>, addScalar<T>);
+                kernel(n, a, t, out);
+            }
+            else
+                scalar::addScalar<T>(n, a, t, out);
+        }
+        template <typename T>
+        inline void subScalar(size_t n, const T* a, T t, T* out) {
+            if constexpr (vectorized<T>) {
+                static const BatchScalar<T> kernel = LINMATH_DISPATCH(BatchScalar<T>, subScalar<T>);
+                kernel(n, a, t, out);
+            }
+            else
+                scalar::subScalar<T>(n, a, t, out);
+        }
+        template <typename T>
+        inline void mulScalar(size_t n, const T* a, T t, T* out) {
+            if constexpr (vectorized<T>) {
+                static const BatchScalar<T> kernel = LINMATH_DISPATCH(BatchScalar<T>, mulScalar<T>);
+                kernel(n, a, t, out);
+            }
+            else
+                scalar::mulScalar<T>(n, a, t, out);
+        }
+        template <typename T>
+        inline void divScalar(size_t n, const T* a, T t, T* out) {
+            if constexpr (vectorized<T>) {
+                static const BatchScalar<T> kernel = LINMATH_DISPATCH(BatchScalar<T>, divScalar<T>);
+                kernel(n, a, t, out);
+            }
+            else
+                scalar::divScalar<T>(n, a, t, out);
+        }
+        template <typename T, size_t D>
+        inline void dot(size_t n, const T* a, size_t sa, const T* b, size_t sb, T* out) {
+            if constexpr (vectorized<T>) {
+                static const BatchReduce<T> kernel = LINMATH_DISPATCH(BatchReduce<T>, dot<T, D>);
+                kernel(n, a, sa, b, sb, out);
+            }
+            else
+                scalar::dot<T, D>(n, a, sa, b, sb, out);
+        }
+        template <typename T, size_t D, Precision p = Precision::Exact>
+        inline void length(size_t n, const T* a, size_t sa, T* out) {
+            if constexpr (vectorized<T>) {
+                static const BatchLength<T> kernel = LINMATH_DISPATCH(BatchLength<T>, length<T, D, p>);
+                kernel(n, a, sa, out);
+            }
+            else
+                scalar::length<T, D, p>(n, a, sa, out);
+        }
+        template <typename T, size_t D, Precision p = Precision::Exact>
+        inline void normalize(size_t n, const T* a, size_t sa, T* out, size_t so) {
+            if constexpr (vectorized<T>) {
+                static const BatchMap<T> kernel = LINMATH_DISPATCH(BatchMap<T>, normalize<T, D, p>);
+                kernel(n, a, sa, out, so);
+            }
+            else
+                scalar::normalize<T, D, p>(n, a, sa, out, so);
+        }
+        template <typename T>
+        inline void cross(size_t n, const T* a, size_t sa, const T* b, size_t sb, T* out, size_t so) {
+            if constexpr (vectorized<T>) {
+                static const BatchCross<T> kernel = LINMATH_DISPATCH(BatchCross<T>, cross<T>);
+                kernel(n, a, sa, b, sb, out, so);
+            }
+            else
+                scalar::cross<T>(n, a, sa, b, sb, out, so);
+        }
+    }
+}
+
+#endif
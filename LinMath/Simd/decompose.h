@@ -0,0 +1,44 @@
+#ifndef SIMD_DECOMPOSE_H
+#define SIMD_DECOMPOSE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dispatch.h"
+
+#define LINMATH_KERNELS "Kernels/decompose.h"
+#include "foreach.h"
+
+namespace linmath {
+    namespace simd {
+
+        // Dispatched kernels over the matricies from begin to end, float and double run the active tier and other types the scalar templates
+        // Element k of matrix i is at a[(i/lanes)*N*N*lanes + k*lanes + i%lanes] as in Systems, with several blocks
+        // begin must be a multiple of lanes
+        template <typename T>
+        using CholeskyRange = void (*)(size_t, size_t, size_t, const T*, T*, uint8_t*);
+        template <typename T>
+        using Eigen3Range = void (*)(size_t, size_t, size_t, const T*, T*, T*, size_t);
+
+        template <typename T, size_t N>
+        inline void cholesky(size_t begin, size_t end, size_t lanes, const T* a, T* l, uint8_t* failed) {
+            if constexpr (vectorized<T>) {
+                static const CholeskyRange<T> kernel = LINMATH_DISPATCH(CholeskyRange<T>, cholesky<T, N>);
+                kernel(begin, end, lanes, a, l, failed);
+            }
+            else
+                scalar::cholesky<T, N>(begin, end, lanes, a, l, failed);
+        }
+        template <typename T>
+        inline void eigen3(size_t begin, size_t end, size_t lanes, const T* a, T* vectors, T* values, size_t valueStride) {
+            if constexpr (vectorized<T>) {
+                static const Eigen3Range<T> kernel = LINMATH_DISPATCH(Eigen3Range<T>, eigen3<T>);
+                kernel(begin, end, lanes, a, vectors, values, valueStride);
+            }
+            else
+                scalar::eigen3<T>(begin, end, lanes, a, vectors, values, valueStride);
+        }
+    }
+}
+
+#endif
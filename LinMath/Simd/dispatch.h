@@ -0,0 +1,133 @@
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#include "simd.h"
+
+#if LINMATH_X86 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace linmath {
+    namespace simd {
+
+        // Instruction set tiers, from least to most capable
+        enum class Isa {
+            Scalar,
+            SSE42,
+            AVX2,
+            AVX512
+        };
+
+        inline const char* isaName(Isa isa) {
+            switch (isa) {
+            case Isa::SSE42:
+                return "sse4.2";
+            case Isa::AVX2:
+                return "avx2";
+            case Isa::AVX512:
+                return "avx512";
+            default:
+                return "scalar";
+            }
+        }
+
+        // Best tier supported by both the cpu and the operating system
+        inline Isa detectIsa() {
+        #if LINMATH_X86 && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+                __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512bw"))
+                return Isa::AVX512;
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+                return Isa::AVX2;
+            if (__builtin_cpu_supports("sse4.2"))
+                return Isa::SSE42;
+        #elif LINMATH_X86 && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            int ids = info[0];
+            __cpuid(info, 1);
+            bool sse42 = info[2] & (1 << 20);
+            bool fma = info[2] & (1 << 12);
+            bool osxsave = info[2] & (1 << 27);
+            unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+            bool ymm = (xcr0 & 0x06) == 0x06;
+            bool zmm = (xcr0 & 0xE6) == 0xE6;
+            int leaf7[4] = {0, 0, 0, 0};
+            if (ids >= 7)
+                __cpuidex(leaf7, 7, 0);
+            bool avx2 = leaf7[1] & (1 << 5);
+            bool avx512 = (leaf7[1] & (1 << 16)) && (leaf7[1] & (1 << 17)) && (leaf7[1] & (1 << 30)) && (leaf7[1] & (1u << 31));
+            if (zmm && avx512 && avx2 && fma)
+                return Isa::AVX512;
+            if (ymm && avx2 && fma)
+                return Isa::AVX2;
+            if (sse42)
+                return Isa::SSE42;
+        #endif
+            return Isa::Scalar;
+        }
+
+        // Parses a tier name as accepted by LINMATH_ISA
+        inline bool parseIsa(const char* name, Isa& isa) {
+            if (!strcmp(name, "scalar"))
+                isa = Isa::Scalar;
+            else if (!strcmp(name, "sse4.2") || !strcmp(name, "sse42"))
+                isa = Isa::SSE42;
+            else if (!strcmp(name, "avx2"))
+                isa = Isa::AVX2;
+            else if (!strcmp(name, "avx512"))
+                isa = Isa::AVX512;
+            else
+                return false;
+            return true;
+        }
+
+        // Tier used by every dispatched kernel, probed once per process
+        // Setting LINMATH_ISA=scalar|sse4.2|avx2|avx512 lowers it, tiers above the detected one are ignored
+        inline Isa activeIsa() {
+            static const Isa isa = [] {
+                Isa detected = detectIsa();
+                Isa requested;
+                const char* env = std::getenv("LINMATH_ISA");
+                if (env && parseIsa(env, requested) && requested < detected)
+                    return requested;
+                return detected;
+            }();
+            return isa;
+        }
+
+        // Types with vectorized kernels, others run the scalar templates
+        template <typename T>
+        constexpr bool vectorized = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+        // Kernel matching the active tier
+        template <typename Fn>
+        Fn dispatch(Fn scalar, Fn sse42, Fn avx2, Fn avx512) {
+            switch (activeIsa()) {
+            case Isa::SSE42:
+                return sse42;
+            case Isa::AVX2:
+                return avx2;
+            case Isa::AVX512:
+                return avx512;
+            default:
+                return scalar;
+            }
+        }
+    }
+}
+
+// Resolves a kernel of type Fn from the scalar, sse42, avx2 and avx512 namespaces in scope
+// The kernel name may be a template id with several arguments, Fn may not contain commas
+#if LINMATH_X86
+#define LINMATH_DISPATCH(Fn, ...) ::linmath::simd::dispatch<Fn>(&scalar::__VA_ARGS__, &sse42::__VA_ARGS__, &avx2::__VA_ARGS__, &avx512::__VA_ARGS__)
+#else
+#define LINMATH_DISPATCH(Fn, ...) ::linmath::simd::dispatch<Fn>(&scalar::__VA_ARGS__, &scalar::__VA_ARGS__, &scalar::__VA_ARGS__, &scalar::__VA_ARGS__)
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+// Expands the kernel header named by LINMATH_KERNELS once per dispatch tier
+// The kernel header has no include guard and writes its code inside
+// namespace linmath::simd::LINMATH_TIER, where Pack<T> is that tier's register type
+// Paths in LINMATH_KERNELS are relative to this directory
+
+#include "simd.h"
+#include "pack.h"
+
+#define LINMATH_TIER scalar
+#include LINMATH_KERNELS
+#undef LINMATH_TIER
+
+#if LINMATH_X86
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_SSE42)
+#define LINMATH_TIER sse42
+#include LINMATH_KERNELS
+#undef LINMATH_TIER
+LINMATH_TARGET_END
+
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_AVX2)
+#define LINMATH_TIER avx2
+#include LINMATH_KERNELS
+#undef LINMATH_TIER
+LINMATH_TARGET_END
+
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_AVX512)
+#define LINMATH_TIER avx512
+#include LINMATH_KERNELS
+#undef LINMATH_TIER
+LINMATH_TARGET_END
+#endif
+
+#undef LINMATH_KERNELS
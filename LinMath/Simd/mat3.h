@@ -0,0 +1,42 @@
+#ifndef SIMD_MAT3_H
+#define SIMD_MAT3_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dispatch.h"
+
+#define LINMATH_KERNELS "Kernels/mat3.h"
+#include "foreach.h"
+
+namespace linmath {
+    namespace simd {
+
+        // Dispatched batch kernels, float and double run the active tier and other types the scalar templates
+        template <typename T>
+        using Mat3InverseBatch = void (*)(size_t, size_t, const T*, T*, uint8_t*);
+        template <typename T>
+        using Mat3DetBatch = void (*)(size_t, size_t, const T*, T*);
+
+        template <typename T>
+        inline void mat3InverseInterleaved(size_t n, size_t lanes, const T* m, T* out, uint8_t* singular) {
+            if constexpr (vectorized<T>) {
+                static const Mat3InverseBatch<T> kernel = LINMATH_DISPATCH(Mat3InverseBatch<T>, mat3InverseInterleaved<T>);
+                kernel(n, lanes, m, out, singular);
+            }
+            else
+                scalar::mat3InverseInterleaved<T>(n, lanes, m, out, singular);
+        }
+        template <typename T>
+        inline void mat3DetInterleaved(size_t n, size_t lanes, const T* m, T* det) {
+            if constexpr (vectorized<T>) {
+                static const Mat3DetBatch<T> kernel = LINMATH_DISPATCH(Mat3DetBatch<T>, mat3DetInterleaved<T>);
+                kernel(n, lanes, m, det);
+            }
+            else
+                scalar::mat3DetInterleaved<T>(n, lanes, m, det);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,655 @@
+#ifndef SIMD_MAT4_H
+#define SIMD_MAT4_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "simd.h"
+#include "dispatch.h"
+
+// Row major 4x4 kernels on raw pointers, one implementation per dispatch tier
+// mat4Dot:     out = a * b, out may alias a or b
+// mat4Inverse: out = inverse(m), out may alias m
+// mat4Vec:     out = m * v
+// vecMat4:     out = v * m
+// Batched kernels over arrays of matricies are in Kernels/mat4.h
+// Products accumulate in the same order as the scalar code and round the same, the block inverse only agrees to rounding
+
+namespace linmath {
+    namespace simd {
+
+LINMATH_EXACT_BEGIN
+        namespace scalar {
+
+            template <typename T>
+            constexpr void mat4Dot(const T* a, const T* b, T* out) {
+                T dot[16];
+                for (int i=0; i<16; i+=4)
+                    for (int j=0; j<4; j++)
+                        dot[i + j] = a[i]*b[j] + a[i + 1]*b[4 + j] + a[i + 2]*b[8 + j] + a[i + 3]*b[12 + j];
+                for (int i=0; i<16; i++)
+                    out[i] = dot[i];
+            }
+
+            template <typename T>
+            constexpr void mat4Inverse(const T* m, T* out) {
+                T mat[16];
+                for (int i=0; i<16; i++)
+                    mat[i] = m[i];
+
+                out[0] = mat[5]  * mat[10] * mat[15] - 
+                     mat[5]  * mat[11] * mat[14] - 
+                     mat[9]  * mat[6]  * mat[15] + 
+                     mat[9]  * mat[7]  * mat[14] +
+                     mat[13] * mat[6]  * mat[11] - 
+                     mat[13] * mat[7]  * mat[10];
+    
+                out[4] = -mat[4]  * mat[10] * mat[15] + 
+                        mat[4]  * mat[11] * mat[14] + 
+                        mat[8]  * mat[6]  * mat[15] - 
+                        mat[8]  * mat[7]  * mat[14] - 
+                        mat[12] * mat[6]  * mat[11] + 
+                        mat[12] * mat[7]  * mat[10];
+        
+                out[8] = mat[4]  * mat[9] * mat[15] - 
+                        mat[4]  * mat[11] * mat[13] - 
+                        mat[8]  * mat[5] * mat[15] + 
+                        mat[8]  * mat[7] * mat[13] + 
+                        mat[12] * mat[5] * mat[11] - 
+                        mat[12] * mat[7] * mat[9];
+        
+                out[12] = -mat[4]  * mat[9] * mat[14] + 
+                        mat[4]  * mat[10] * mat[13] +
+                        mat[8]  * mat[5] * mat[14] - 
+                        mat[8]  * mat[6] * mat[13] - 
+                        mat[12] * mat[5] * mat[10] + 
+                        mat[12] * mat[6] * mat[9];
+        
+                out[1] = -mat[1]  * mat[10] * mat[15] + 
+                        mat[1]  * mat[11] * mat[14] + 
+                        mat[9]  * mat[2] * mat[15] - 
+                        mat[9]  * mat[3] * mat[14] - 
+                        mat[13] * mat[2] * mat[11] + 
+                        mat[13] * mat[3] * mat[10];
+        
+                out[5] = mat[0]  * mat[10] * mat[15] - 
+                        mat[0]  * mat[11] * mat[14] - 
+                        mat[8]  * mat[2] * mat[15] + 
+                        mat[8]  * mat[3] * mat[14] + 
+                        mat[12] * mat[2] * mat[11] - 
+                        mat[12] * mat[3] * mat[10];
+        
+                out[9] = -mat[0]  * mat[9] * mat[15] + 
+                        mat[0]  * mat[11] * mat[13] + 
+                        mat[8]  * mat[1] * mat[15] - 
+                        mat[8]  * mat[3] * mat[13] - 
+                        mat[12] * mat[1] * mat[11] + 
+                        mat[12] * mat[3] * mat[9];
+        
+                out[13] = mat[0]  * mat[9] * mat[14] - 
+                        mat[0]  * mat[10] * mat[13] - 
+                        mat[8]  * mat[1] * mat[14] + 
+                        mat[8]  * mat[2] * mat[13] + 
+                        mat[12] * mat[1] * mat[10] - 
+                        mat[12] * mat[2] * mat[9];
+        
+                out[2] = mat[1]  * mat[6] * mat[15] - 
+                        mat[1]  * mat[7] * mat[14] - 
+                        mat[5]  * mat[2] * mat[15] + 
+                        mat[5]  * mat[3] * mat[14] + 
+                        mat[13] * mat[2] * mat[7] - 
+                        mat[13] * mat[3] * mat[6];
+        
+                out[6] = -mat[0]  * mat[6] * mat[15] + 
+                        mat[0]  * mat[7] * mat[14] + 
+                        mat[4]  * mat[2] * mat[15] - 
+                        mat[4]  * mat[3] * mat[14] - 
+                        mat[12] * mat[2] * mat[7] + 
+                        mat[12] * mat[3] * mat[6];
+        
+                out[10] = mat[0]  * mat[5] * mat[15] - 
+                        mat[0]  * mat[7] * mat[13] - 
+                        mat[4]  * mat[1] * mat[15] + 
+                        mat[4]  * mat[3] * mat[13] + 
+                        mat[12] * mat[1] * mat[7] - 
+                        mat[12] * mat[3] * mat[5];
+        
+                out[14] = -mat[0]  * mat[5] * mat[14] + 
+                        mat[0]  * mat[6] * mat[13] + 
+                        mat[4]  * mat[1] * mat[14] - 
+                        mat[4]  * mat[2] * mat[13] - 
+                        mat[12] * mat[1] * mat[6] + 
+                        mat[12] * mat[2] * mat[5];
+        
+                out[3] = -mat[1] * mat[6] * mat[11] + 
+                        mat[1] * mat[7] * mat[10] + 
+                        mat[5] * mat[2] * mat[11] - 
+                        mat[5] * mat[3] * mat[10] - 
+                        mat[9] * mat[2] * mat[7] + 
+                        mat[9] * mat[3] * mat[6];
+        
+                out[7] = mat[0] * mat[6] * mat[11] - 
+                        mat[0] * mat[7] * mat[10] - 
+                        mat[4] * mat[2] * mat[11] + 
+                        mat[4] * mat[3] * mat[10] + 
+                        mat[8] * mat[2] * mat[7] - 
+                        mat[8] * mat[3] * mat[6];
+        
+                out[11] = -mat[0] * mat[5] * mat[11] + 
+                        mat[0] * mat[7] * mat[9] + 
+                        mat[4] * mat[1] * mat[11] - 
+                        mat[4] * mat[3] * mat[9] - 
+                        mat[8] * mat[1] * mat[7] + 
+                        mat[8] * mat[3] * mat[5];
+        
+                out[15] = mat[0] * mat[5] * mat[10] - 
+                        mat[0] * mat[6] * mat[9] - 
+                        mat[4] * mat[1] * mat[10] + 
+                        mat[4] * mat[2] * mat[9] + 
+                        mat[8] * mat[1] * mat[6] - 
+                        mat[8] * mat[2] * mat[5];
+        
+                T det = mat[0] * out[0] + mat[1] * out[4] + mat[2] * out[8] + mat[3] * out[12];
+
+                for (int i=0; i<16; i++)
+                    out[i] /= det;
+            }
+
+            template <typename T>
+            constexpr void mat4Vec(const T* m, const T* v, T* out) {
+                T x = v[0], y = v[1], z = v[2], w = v[3];
+                out[0] = x*m[0] + y*m[1] + z*m[2] + w*m[3];
+                out[1] = x*m[4] + y*m[5] + z*m[6] + w*m[7];
+                out[2] = x*m[8] + y*m[9] + z*m[10] + w*m[11];
+                out[3] = x*m[12] + y*m[13] + z*m[14] + w*m[15];
+            }
+
+            template <typename T>
+            constexpr void vecMat4(const T* v, const T* m, T* out) {
+                T x = v[0], y = v[1], z = v[2], w = v[3];
+                out[0] = x*m[0] + y*m[4] + z*m[8] + w*m[12];
+                out[1] = x*m[1] + y*m[5] + z*m[9] + w*m[13];
+                out[2] = x*m[2] + y*m[6] + z*m[10] + w*m[14];
+                out[3] = x*m[3] + y*m[7] + z*m[11] + w*m[15];
+            }
+        }
+LINMATH_EXACT_END
+
+    #if LINMATH_X86
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_SSE42)
+LINMATH_EXACT_BEGIN
+        namespace sse42 {
+
+            template <int X, int Y, int Z, int W>
+            inline __m128 shuffle(__m128 a, __m128 b) {
+                return _mm_shuffle_ps(a, b, X | (Y << 2) | (Z << 4) | (W << 6));
+            }
+            template <int X, int Y, int Z, int W>
+            inline __m128 swizzle(__m128 v) {
+                return shuffle<X, Y, Z, W>(v, v);
+            }
+
+            // 2x2 row major blocks packed in one register, a*b, adj(a)*b and a*adj(b)
+            inline __m128 mat2Mul(__m128 a, __m128 b) {
+                return _mm_add_ps(_mm_mul_ps(a, swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+            }
+            inline __m128 mat2AdjMul(__m128 a, __m128 b) {
+                return _mm_sub_ps(_mm_mul_ps(swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+            }
+            inline __m128 mat2MulAdj(__m128 a, __m128 b) {
+                return _mm_sub_ps(_mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+            }
+
+            inline void mat4Dot(const float* a, const float* b, float* out) {
+                __m128 b0 = _mm_loadu_ps(b);
+                __m128 b1 = _mm_loadu_ps(b + 4);
+                __m128 b2 = _mm_loadu_ps(b + 8);
+                __m128 b3 = _mm_loadu_ps(b + 12);
+                __m128 r0 = _mm_mul_ps(_mm_set1_ps(a[0]), b0);
+                __m128 r1 = _mm_mul_ps(_mm_set1_ps(a[4]), b0);
+                __m128 r2 = _mm_mul_ps(_mm_set1_ps(a[8]), b0);
+                __m128 r3 = _mm_mul_ps(_mm_set1_ps(a[12]), b0);
+                r0 = _mm_add_ps(r0, _mm_mul_ps(_mm_set1_ps(a[1]), b1));
+                r1 = _mm_add_ps(r1, _mm_mul_ps(_mm_set1_ps(a[5]), b1));
+                r2 = _mm_add_ps(r2, _mm_mul_ps(_mm_set1_ps(a[9]), b1));
+                r3 = _mm_add_ps(r3, _mm_mul_ps(_mm_set1_ps(a[13]), b1));
+                r0 = _mm_add_ps(r0, _mm_mul_ps(_mm_set1_ps(a[2]), b2));
+                r1 = _mm_add_ps(r1, _mm_mul_ps(_mm_set1_ps(a[6]), b2));
+                r2 = _mm_add_ps(r2, _mm_mul_ps(_mm_set1_ps(a[10]), b2));
+                r3 = _mm_add_ps(r3, _mm_mul_ps(_mm_set1_ps(a[14]), b2));
+                r0 = _mm_add_ps(r0, _mm_mul_ps(_mm_set1_ps(a[3]), b3));
+                r1 = _mm_add_ps(r1, _mm_mul_ps(_mm_set1_ps(a[7]), b3));
+                r2 = _mm_add_ps(r2, _mm_mul_ps(_mm_set1_ps(a[11]), b3));
+                r3 = _mm_add_ps(r3, _mm_mul_ps(_mm_set1_ps(a[15]), b3));
+                _mm_storeu_ps(out, r0);
+                _mm_storeu_ps(out + 4, r1);
+                _mm_storeu_ps(out + 8, r2);
+                _mm_storeu_ps(out + 12, r3);
+            }
+            inline void mat4Dot(const double* a, const double* b, double* out) {
+                // b is held in registers and each row of a is read before its row of out is written
+                __m128d b0l = _mm_loadu_pd(b), b0h = _mm_loadu_pd(b + 2);
+                __m128d b1l = _mm_loadu_pd(b + 4), b1h = _mm_loadu_pd(b + 6);
+                __m128d b2l = _mm_loadu_pd(b + 8), b2h = _mm_loadu_pd(b + 10);
+                __m128d b3l = _mm_loadu_pd(b + 12), b3h = _mm_loadu_pd(b + 14);
+                for (int i=0; i<16; i+=4) {
+                    __m128d a0 = _mm_set1_pd(a[i]);
+                    __m128d a1 = _mm_set1_pd(a[i + 1]);
+                    __m128d a2 = _mm_set1_pd(a[i + 2]);
+                    __m128d a3 = _mm_set1_pd(a[i + 3]);
+                    __m128d lo = _mm_mul_pd(a0, b0l);
+                    __m128d hi = _mm_mul_pd(a0, b0h);
+                    lo = _mm_add_pd(lo, _mm_mul_pd(a1, b1l));
+                    hi = _mm_add_pd(hi, _mm_mul_pd(a1, b1h));
+                    lo = _mm_add_pd(lo, _mm_mul_pd(a2, b2l));
+                    hi = _mm_add_pd(hi, _mm_mul_pd(a2, b2h));
+                    lo = _mm_add_pd(lo, _mm_mul_pd(a3, b3l));
+                    hi = _mm_add_pd(hi, _mm_mul_pd(a3, b3h));
+                    _mm_storeu_pd(out + i, lo);
+                    _mm_storeu_pd(out + i + 2, hi);
+                }
+            }
+
+            // Block inverse on the four 2x2 sub-matrices, sharing their determinants and adjugate products
+            inline void mat4Inverse(const float* m, float* out) {
+                __m128 r0 = _mm_loadu_ps(m);
+                __m128 r1 = _mm_loadu_ps(m + 4);
+                __m128 r2 = _mm_loadu_ps(m + 8);
+                __m128 r3 = _mm_loadu_ps(m + 12);
+
+                __m128 a = _mm_movelh_ps(r0, r1);
+                __m128 b = _mm_movehl_ps(r1, r0);
+                __m128 c = _mm_movelh_ps(r2, r3);
+                __m128 d = _mm_movehl_ps(r3, r2);
+
+                __m128 detSub = _mm_sub_ps(_mm_mul_ps(shuffle<0, 2, 0, 2>(r0, r2), shuffle<1, 3, 1, 3>(r1, r3)),
+                                           _mm_mul_ps(shuffle<1, 3, 1, 3>(r0, r2), shuffle<0, 2, 0, 2>(r1, r3)));
+                __m128 detA = swizzle<0, 0, 0, 0>(detSub);
+                __m128 detB = swizzle<1, 1, 1, 1>(detSub);
+                __m128 detC = swizzle<2, 2, 2, 2>(detSub);
+                __m128 detD = swizzle<3, 3, 3, 3>(detSub);
+
+                __m128 dc = mat2AdjMul(d, c);
+                __m128 ab = mat2AdjMul(a, b);
+                __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2Mul(b, dc));
+                __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2Mul(c, ab));
+                __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2MulAdj(d, ab));
+                __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2MulAdj(a, dc));
+
+                __m128 tr = _mm_mul_ps(ab, swizzle<0, 2, 1, 3>(dc));
+                tr = _mm_hadd_ps(tr, tr);
+                tr = _mm_hadd_ps(tr, tr);
+                __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+                __m128 rdet = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+
+                x = _mm_mul_ps(x, rdet);
+                y = _mm_mul_ps(y, rdet);
+                z = _mm_mul_ps(z, rdet);
+                w = _mm_mul_ps(w, rdet);
+
+                _mm_storeu_ps(out, shuffle<3, 1, 3, 1>(x, y));
+                _mm_storeu_ps(out + 4, shuffle<2, 0, 2, 0>(x, y));
+                _mm_storeu_ps(out + 8, shuffle<3, 1, 3, 1>(z, w));
+                _mm_storeu_ps(out + 12, shuffle<2, 0, 2, 0>(z, w));
+            }
+            inline void mat4Inverse(const double* m, double* out) {
+                scalar::mat4Inverse(m, out);
+            }
+
+            inline void mat4Vec(const float* m, const float* v, float* out) {
+                __m128 c0 = _mm_loadu_ps(m);
+                __m128 c1 = _mm_loadu_ps(m + 4);
+                __m128 c2 = _mm_loadu_ps(m + 8);
+                __m128 c3 = _mm_loadu_ps(m + 12);
+                _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+                __m128 r = _mm_mul_ps(_mm_set1_ps(v[0]), c0);
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v[1]), c1));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v[2]), c2));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v[3]), c3));
+                _mm_storeu_ps(out, r);
+            }
+            inline void mat4Vec(const double* m, const double* v, double* out) {
+                __m128d x = _mm_set1_pd(v[0]);
+                __m128d y = _mm_set1_pd(v[1]);
+                __m128d z = _mm_set1_pd(v[2]);
+                __m128d w = _mm_set1_pd(v[3]);
+                for (int i=0; i<4; i+=2) {
+                    __m128d lo0 = _mm_loadu_pd(m + 4*i);
+                    __m128d hi0 = _mm_loadu_pd(m + 4*i + 2);
+                    __m128d lo1 = _mm_loadu_pd(m + 4*i + 4);
+                    __m128d hi1 = _mm_loadu_pd(m + 4*i + 6);
+                    __m128d r = _mm_mul_pd(x, _mm_unpacklo_pd(lo0, lo1));
+                    r = _mm_add_pd(r, _mm_mul_pd(y, _mm_unpackhi_pd(lo0, lo1)));
+                    r = _mm_add_pd(r, _mm_mul_pd(z, _mm_unpacklo_pd(hi0, hi1)));
+                    r = _mm_add_pd(r, _mm_mul_pd(w, _mm_unpackhi_pd(hi0, hi1)));
+                    _mm_storeu_pd(out + i, r);
+                }
+            }
+
+            inline void vecMat4(const float* v, const float* m, float* out) {
+                __m128 r = _mm_mul_ps(_mm_set1_ps(v[0]), _mm_loadu_ps(m));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v[1]), _mm_loadu_ps(m + 4)));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v[2]), _mm_loadu_ps(m + 8)));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v[3]), _mm_loadu_ps(m + 12)));
+                _mm_storeu_ps(out, r);
+            }
+            inline void vecMat4(const double* v, const double* m, double* out) {
+                __m128d x = _mm_set1_pd(v[0]);
+                __m128d y = _mm_set1_pd(v[1]);
+                __m128d z = _mm_set1_pd(v[2]);
+                __m128d w = _mm_set1_pd(v[3]);
+                for (int j=0; j<4; j+=2) {
+                    __m128d r = _mm_mul_pd(x, _mm_loadu_pd(m + j));
+                    r = _mm_add_pd(r, _mm_mul_pd(y, _mm_loadu_pd(m + 4 + j)));
+                    r = _mm_add_pd(r, _mm_mul_pd(z, _mm_loadu_pd(m + 8 + j)));
+                    r = _mm_add_pd(r, _mm_mul_pd(w, _mm_loadu_pd(m + 12 + j)));
+                    _mm_storeu_pd(out + j, r);
+                }
+            }
+        }
+LINMATH_EXACT_END
+LINMATH_TARGET_END
+
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_AVX2)
+LINMATH_EXACT_BEGIN
+        namespace avx2 {
+
+            template <int X, int Y, int Z, int W>
+            inline __m256d swizzle(__m256d v) {
+                return _mm256_permute4x64_pd(v, X | (Y << 2) | (Z << 4) | (W << 6));
+            }
+            template <int X, int Y, int Z, int W>
+            inline __m256d shuffle(__m256d a, __m256d b) {
+                return _mm256_blend_pd((swizzle<X, Y, X, Y>(a)), (swizzle<Z, W, Z, W>(b)), 0xC);
+            }
+
+            inline __m256d mat2Mul(__m256d a, __m256d b) {
+                return _mm256_add_pd(_mm256_mul_pd(a, swizzle<0, 3, 0, 3>(b)), _mm256_mul_pd(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+            }
+            inline __m256d mat2AdjMul(__m256d a, __m256d b) {
+                return _mm256_sub_pd(_mm256_mul_pd(swizzle<3, 3, 0, 0>(a), b), _mm256_mul_pd(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+            }
+            inline __m256d mat2MulAdj(__m256d a, __m256d b) {
+                return _mm256_sub_pd(_mm256_mul_pd(a, swizzle<3, 0, 3, 0>(b)), _mm256_mul_pd(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+            }
+
+            inline void mat4Dot(const float* a, const float* b, float* out) {
+                __m256 b0 = _mm256_broadcast_ps((const __m128*)(b));
+                __m256 b1 = _mm256_broadcast_ps((const __m128*)(b + 4));
+                __m256 b2 = _mm256_broadcast_ps((const __m128*)(b + 8));
+                __m256 b3 = _mm256_broadcast_ps((const __m128*)(b + 12));
+                __m256 rows01 = _mm256_loadu_ps(a);
+                __m256 rows23 = _mm256_loadu_ps(a + 8);
+                __m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(rows01, rows01, 0x00), b0);
+                __m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(rows23, rows23, 0x00), b0);
+                r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(rows01, rows01, 0x55), b1));
+                r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(rows23, rows23, 0x55), b1));
+                r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(rows01, rows01, 0xAA), b2));
+                r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(rows23, rows23, 0xAA), b2));
+                r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(rows01, rows01, 0xFF), b3));
+                r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(rows23, rows23, 0xFF), b3));
+                _mm256_storeu_ps(out, r01);
+                _mm256_storeu_ps(out + 8, r23);
+            }
+            inline void mat4Dot(const double* a, const double* b, double* out) {
+                __m256d b0 = _mm256_loadu_pd(b);
+                __m256d b1 = _mm256_loadu_pd(b + 4);
+                __m256d b2 = _mm256_loadu_pd(b + 8);
+                __m256d b3 = _mm256_loadu_pd(b + 12);
+                __m256d r0 = _mm256_mul_pd(_mm256_broadcast_sd(a), b0);
+                __m256d r1 = _mm256_mul_pd(_mm256_broadcast_sd(a + 4), b0);
+                __m256d r2 = _mm256_mul_pd(_mm256_broadcast_sd(a + 8), b0);
+                __m256d r3 = _mm256_mul_pd(_mm256_broadcast_sd(a + 12), b0);
+                r0 = _mm256_add_pd(r0, _mm256_mul_pd(_mm256_broadcast_sd(a + 1), b1));
+                r1 = _mm256_add_pd(r1, _mm256_mul_pd(_mm256_broadcast_sd(a + 5), b1));
+                r2 = _mm256_add_pd(r2, _mm256_mul_pd(_mm256_broadcast_sd(a + 9), b1));
+                r3 = _mm256_add_pd(r3, _mm256_mul_pd(_mm256_broadcast_sd(a + 13), b1));
+                r0 = _mm256_add_pd(r0, _mm256_mul_pd(_mm256_broadcast_sd(a + 2), b2));
+                r1 = _mm256_add_pd(r1, _mm256_mul_pd(_mm256_broadcast_sd(a + 6), b2));
+                r2 = _mm256_add_pd(r2, _mm256_mul_pd(_mm256_broadcast_sd(a + 10), b2));
+                r3 = _mm256_add_pd(r3, _mm256_mul_pd(_mm256_broadcast_sd(a + 14), b2));
+                r0 = _mm256_add_pd(r0, _mm256_mul_pd(_mm256_broadcast_sd(a + 3), b3));
+                r1 = _mm256_add_pd(r1, _mm256_mul_pd(_mm256_broadcast_sd(a + 7), b3));
+                r2 = _mm256_add_pd(r2, _mm256_mul_pd(_mm256_broadcast_sd(a + 11), b3));
+                r3 = _mm256_add_pd(r3, _mm256_mul_pd(_mm256_broadcast_sd(a + 15), b3));
+                _mm256_storeu_pd(out, r0);
+                _mm256_storeu_pd(out + 4, r1);
+                _mm256_storeu_pd(out + 8, r2);
+                _mm256_storeu_pd(out + 12, r3);
+            }
+
+            inline void mat4Inverse(const float* m, float* out) {
+                sse42::mat4Inverse(m, out);
+            }
+            inline void mat4Inverse(const double* m, double* out) {
+                __m256d r0 = _mm256_loadu_pd(m);
+                __m256d r1 = _mm256_loadu_pd(m + 4);
+                __m256d r2 = _mm256_loadu_pd(m + 8);
+                __m256d r3 = _mm256_loadu_pd(m + 12);
+
+                __m256d a = _mm256_permute2f128_pd(r0, r1, 0x20);
+                __m256d b = _mm256_permute2f128_pd(r0, r1, 0x31);
+                __m256d c = _mm256_permute2f128_pd(r2, r3, 0x20);
+                __m256d d = _mm256_permute2f128_pd(r2, r3, 0x31);
+
+                __m256d detSub = _mm256_sub_pd(_mm256_mul_pd(shuffle<0, 2, 0, 2>(r0, r2), shuffle<1, 3, 1, 3>(r1, r3)),
+                                               _mm256_mul_pd(shuffle<1, 3, 1, 3>(r0, r2), shuffle<0, 2, 0, 2>(r1, r3)));
+                __m256d detA = swizzle<0, 0, 0, 0>(detSub);
+                __m256d detB = swizzle<1, 1, 1, 1>(detSub);
+                __m256d detC = swizzle<2, 2, 2, 2>(detSub);
+                __m256d detD = swizzle<3, 3, 3, 3>(detSub);
+
+                __m256d dc = mat2AdjMul(d, c);
+                __m256d ab = mat2AdjMul(a, b);
+                __m256d x = _mm256_sub_pd(_mm256_mul_pd(detD, a), mat2Mul(b, dc));
+                __m256d w = _mm256_sub_pd(_mm256_mul_pd(detA, d), mat2Mul(c, ab));
+                __m256d y = _mm256_sub_pd(_mm256_mul_pd(detB, c), mat2MulAdj(d, ab));
+                __m256d z = _mm256_sub_pd(_mm256_mul_pd(detC, b), mat2MulAdj(a, dc));
+
+                __m256d tr = _mm256_mul_pd(ab, swizzle<0, 2, 1, 3>(dc));
+                tr = _mm256_add_pd(tr, swizzle<1, 0, 3, 2>(tr));
+                tr = _mm256_add_pd(tr, swizzle<2, 3, 0, 1>(tr));
+                __m256d det = _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(detA, detD), _mm256_mul_pd(detB, detC)), tr);
+                __m256d rdet = _mm256_div_pd(_mm256_setr_pd(1., -1., -1., 1.), det);
+
+                x = _mm256_mul_pd(x, rdet);
+                y = _mm256_mul_pd(y, rdet);
+                z = _mm256_mul_pd(z, rdet);
+                w = _mm256_mul_pd(w, rdet);
+
+                _mm256_storeu_pd(out, shuffle<3, 1, 3, 1>(x, y));
+                _mm256_storeu_pd(out + 4, shuffle<2, 0, 2, 0>(x, y));
+                _mm256_storeu_pd(out + 8, shuffle<3, 1, 3, 1>(z, w));
+                _mm256_storeu_pd(out + 12, shuffle<2, 0, 2, 0>(z, w));
+            }
+
+            inline void mat4Vec(const float* m, const float* v, float* out) {
+                sse42::mat4Vec(m, v, out);
+            }
+            inline void mat4Vec(const double* m, const double* v, double* out) {
+                __m256d r0 = _mm256_loadu_pd(m);
+                __m256d r1 = _mm256_loadu_pd(m + 4);
+                __m256d r2 = _mm256_loadu_pd(m + 8);
+                __m256d r3 = _mm256_loadu_pd(m + 12);
+                __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+                __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+                __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+                __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+                __m256d r = _mm256_mul_pd(_mm256_broadcast_sd(v), _mm256_permute2f128_pd(t0, t2, 0x20));
+                r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_broadcast_sd(v + 1), _mm256_permute2f128_pd(t1, t3, 0x20)));
+                r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_broadcast_sd(v + 2), _mm256_permute2f128_pd(t0, t2, 0x31)));
+                r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_broadcast_sd(v + 3), _mm256_permute2f128_pd(t1, t3, 0x31)));
+                _mm256_storeu_pd(out, r);
+            }
+
+            inline void vecMat4(const float* v, const float* m, float* out) {
+                sse42::vecMat4(v, m, out);
+            }
+            inline void vecMat4(const double* v, const double* m, double* out) {
+                __m256d r = _mm256_mul_pd(_mm256_broadcast_sd(v), _mm256_loadu_pd(m));
+                r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_broadcast_sd(v + 1), _mm256_loadu_pd(m + 4)));
+                r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_broadcast_sd(v + 2), _mm256_loadu_pd(m + 8)));
+                r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_broadcast_sd(v + 3), _mm256_loadu_pd(m + 12)));
+                _mm256_storeu_pd(out, r);
+            }
+        }
+LINMATH_EXACT_END
+LINMATH_TARGET_END
+
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_AVX512)
+LINMATH_EXACT_BEGIN
+        namespace avx512 {
+
+            // Zero masked forms avoid the undefined source operand gcc warns about
+            inline void mat4Dot(const float* a, const float* b, float* out) {
+                __m512 rows = _mm512_loadu_ps(a);
+                __m512 b0 = _mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(b));
+                __m512 b1 = _mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(b + 4));
+                __m512 b2 = _mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(b + 8));
+                __m512 b3 = _mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(b + 12));
+                __m512 r = _mm512_mul_ps(_mm512_maskz_permute_ps(0xFFFF, rows, 0x00), b0);
+                r = _mm512_add_ps(r, _mm512_mul_ps(_mm512_maskz_permute_ps(0xFFFF, rows, 0x55), b1));
+                r = _mm512_add_ps(r, _mm512_mul_ps(_mm512_maskz_permute_ps(0xFFFF, rows, 0xAA), b2));
+                r = _mm512_add_ps(r, _mm512_mul_ps(_mm512_maskz_permute_ps(0xFFFF, rows, 0xFF), b3));
+                _mm512_storeu_ps(out, r);
+            }
+            inline void mat4Dot(const double* a, const double* b, double* out) {
+                __m512d rows01 = _mm512_loadu_pd(a);
+                __m512d rows23 = _mm512_loadu_pd(a + 8);
+                __m512d b0 = _mm512_maskz_broadcast_f64x4(0xFF, _mm256_loadu_pd(b));
+                __m512d b1 = _mm512_maskz_broadcast_f64x4(0xFF, _mm256_loadu_pd(b + 4));
+                __m512d b2 = _mm512_maskz_broadcast_f64x4(0xFF, _mm256_loadu_pd(b + 8));
+                __m512d b3 = _mm512_maskz_broadcast_f64x4(0xFF, _mm256_loadu_pd(b + 12));
+                __m512d r01 = _mm512_mul_pd(_mm512_maskz_permutex_pd(0xFF, rows01, 0x00), b0);
+                __m512d r23 = _mm512_mul_pd(_mm512_maskz_permutex_pd(0xFF, rows23, 0x00), b0);
+                r01 = _mm512_add_pd(r01, _mm512_mul_pd(_mm512_maskz_permutex_pd(0xFF, rows01, 0x55), b1));
+                r23 = _mm512_add_pd(r23, _mm512_mul_pd(_mm512_maskz_permutex_pd(0xFF, rows23, 0x55), b1));
+                r01 = _mm512_add_pd(r01, _mm512_mul_pd(_mm512_maskz_permutex_pd(0xFF, rows01, 0xAA), b2));
+                r23 = _mm512_add_pd(r23, _mm512_mul_pd(_mm512_maskz_permutex_pd(0xFF, rows23, 0xAA), b2));
+                r01 = _mm512_add_pd(r01, _mm512_mul_pd(_mm512_maskz_permutex_pd(0xFF, rows01, 0xFF), b3));
+                r23 = _mm512_add_pd(r23, _mm512_mul_pd(_mm512_maskz_permutex_pd(0xFF, rows23, 0xFF), b3));
+                _mm512_storeu_pd(out, r01);
+                _mm512_storeu_pd(out + 8, r23);
+            }
+
+            // Single matrix kernels gain nothing from wider registers
+            inline void mat4Inverse(const float* m, float* out) {
+                avx2::mat4Inverse(m, out);
+            }
+            inline void mat4Inverse(const double* m, double* out) {
+                avx2::mat4Inverse(m, out);
+            }
+            inline void mat4Vec(const float* m, const float* v, float* out) {
+                avx2::mat4Vec(m, v, out);
+            }
+            inline void mat4Vec(const double* m, const double* v, double* out) {
+                avx2::mat4Vec(m, v, out);
+            }
+            inline void vecMat4(const float* v, const float* m, float* out) {
+                avx2::vecMat4(v, m, out);
+            }
+            inline void vecMat4(const double* v, const double* m, double* out) {
+                avx2::vecMat4(v, m, out);
+            }
+        }
+LINMATH_EXACT_END
+LINMATH_TARGET_END
+    #endif
+
+        // Dispatched kernels
+        template <typename T>
+        using Mat4Binary = void (*)(const T*, const T*, T*);
+        template <typename T>
+        using Mat4Unary = void (*)(const T*, T*);
+
+        inline void mat4Dot(const float* a, const float* b, float* out) {
+            static const Mat4Binary<float> kernel = LINMATH_DISPATCH(Mat4Binary<float>, mat4Dot);
+            kernel(a, b, out);
+        }
+        inline void mat4Dot(const double* a, const double* b, double* out) {
+            static const Mat4Binary<double> kernel = LINMATH_DISPATCH(Mat4Binary<double>, mat4Dot);
+            kernel(a, b, out);
+        }
+        inline void mat4Inverse(const float* m, float* out) {
+            static const Mat4Unary<float> kernel = LINMATH_DISPATCH(Mat4Unary<float>, mat4Inverse);
+            kernel(m, out);
+        }
+        inline void mat4Inverse(const double* m, double* out) {
+            static const Mat4Unary<double> kernel = LINMATH_DISPATCH(Mat4Unary<double>, mat4Inverse);
+            kernel(m, out);
+        }
+        inline void mat4Vec(const float* m, const float* v, float* out) {
+            static const Mat4Binary<float> kernel = LINMATH_DISPATCH(Mat4Binary<float>, mat4Vec);
+            kernel(m, v, out);
+        }
+        inline void mat4Vec(const double* m, const double* v, double* out) {
+            static const Mat4Binary<double> kernel = LINMATH_DISPATCH(Mat4Binary<double>, mat4Vec);
+            kernel(m, v, out);
+        }
+        inline void vecMat4(const float* v, const float* m, float* out) {
+            static const Mat4Binary<float> kernel = LINMATH_DISPATCH(Mat4Binary<float>, vecMat4);
+            kernel(v, m, out);
+        }
+        inline void vecMat4(const double* v, const double* m, double* out) {
+            static const Mat4Binary<double> kernel = LINMATH_DISPATCH(Mat4Binary<double>, vecMat4);
+            kernel(v, m, out);
+        }
+    }
+}
+
+#define LINMATH_KERNELS "Kernels/mat4.h"
+#include "foreach.h"
+
+namespace linmath {
+    namespace simd {
+
+        // Dispatched batch kernels, float and double run the active tier and other types the scalar templates
+        template <typename T>
+        using Mat4Array = void (*)(size_t, const T*, const T*, T*);
+        template <typename T>
+        using Mat4Interleaved = void (*)(size_t, size_t, const T*, const T*, T*);
+        template <typename T>
+        using Mat4InverseBatch = void (*)(size_t, size_t, const T*, T*, uint8_t*);
+        template <typename T>
+        using Mat4DetBatch = void (*)(size_t, size_t, const T*, T*);
+
+        template <typename T>
+        inline void mat4DotArray(size_t n, const T* a, const T* b, T* out) {
+            if constexpr (vectorized<T>) {
+                static const Mat4Array<T> kernel = LINMATH_DISPATCH(Mat4Array<T>, mat4DotArray<T>);
+                kernel(n, a, b, out);
+            }
+            else
+                scalar::mat4DotArray<T>(n, a, b, out);
+        }
+        template <typename T>
+        inline void mat4DotInterleaved(size_t blocks, size_t lanes, const T* a, const T* b, T* out) {
+            if constexpr (vectorized<T>) {
+                static const Mat4Interleaved<T> kernel = LINMATH_DISPATCH(Mat4Interleaved<T>, mat4DotInterleaved<T>);
+                kernel(blocks, lanes, a, b, out);
+            }
+            else
+                scalar::mat4DotInterleaved<T>(blocks, lanes, a, b, out);
+        }
+        template <typename T>
+        inline void mat4InverseInterleaved(size_t n, size_t lanes, const T* m, T* out, uint8_t* singular) {
+            if constexpr (vectorized<T>) {
+                static const Mat4InverseBatch<T> kernel = LINMATH_DISPATCH(Mat4InverseBatch<T>, mat4InverseInterleaved<T>);
+                kernel(n, lanes, m, out, singular);
+            }
+            else
+                scalar::mat4InverseInterleaved<T>(n, lanes, m, out, singular);
+        }
+        template <typename T>
+        inline void mat4DetInterleaved(size_t n, size_t lanes, const T* m, T* det) {
+            if constexpr (vectorized<T>) {
+                static const Mat4DetBatch<T> kernel = LINMATH_DISPATCH(Mat4DetBatch<T>, mat4DetInterleaved<T>);
+                kernel(n, lanes, m, det);
+            }
+            else
+                scalar::mat4DetInterleaved<T>(n, lanes, m, det);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,879 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "simd.h"
+
+// Pack<T> is one register of T lanes per dispatch tier, the common vocabulary of the batch kernels
+// width is the lane count, registers the size of the register file and Half the next narrower
+// pack, down to the one lane scalar pack that finishes loop tails
+// load3/load4 and store3/store4 transpose width interleaved 3 or 4 component vectors to and from planar packs
+// rsqrt is 1/sqrt, for float the hardware estimate refined by one Newton step and for double the exact quotient
+// gather4(p, index, ...) is load4 with vector k at p + index[k], for tables looked up by a different index in every lane
+// gather(p, index) loads lane k from p[index[k]], the scattered entries a sparse row picks out of a dense vector
+// sum() adds the lanes together, to finish a dot product accumulated a pack at a time
+// select(a, b, x, y) is x in the lanes where a > b and y in the others, for picking without branching per lane
+// floor rounds every lane down to an integer value, for splitting arguments into whole periods and a remainder
+// mulsign(a, s) is a with its sign flipped in the lanes where s is negative, a*sign(s) by one bitwise operation
+// Every tier keeps the same interface so kernels are written once and expanded per tier
+
+namespace linmath {
+    namespace simd {
+
+        namespace scalar {
+
+            template <typename T>
+            struct Pack {
+                static constexpr size_t width = 1;
+                static constexpr size_t registers = 16;
+                using Half = Pack;
+                T v;
+
+                static Pack load(const T* p) {
+                    return {*p};
+                }
+                static Pack set(T t) {
+                    return {t};
+                }
+                static Pack zero() {
+                    return {T(0)};
+                }
+                void store(T* p) const {
+                    *p = v;
+                }
+                static Pack gather(const T* p, const int32_t* index) {
+                    return {p[index[0]]};
+                }
+                T sum() const {
+                    return v;
+                }
+
+                // Interleaved 3 and 4 component vectors, width of them starting at p
+                static void load3(const T* p, Pack& x, Pack& y, Pack& z) {
+                    x.v = p[0];
+                    y.v = p[1];
+                    z.v = p[2];
+                }
+                static void load4(const T* p, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    x.v = p[0];
+                    y.v = p[1];
+                    z.v = p[2];
+                    w.v = p[3];
+                }
+                static void gather4(const T* p, const int32_t* index, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    load4(p + index[0], x, y, z, w);
+                }
+                static void store3(T* p, Pack x, Pack y, Pack z) {
+                    p[0] = x.v;
+                    p[1] = y.v;
+                    p[2] = z.v;
+                }
+                static void store4(T* p, Pack x, Pack y, Pack z, Pack w) {
+                    p[0] = x.v;
+                    p[1] = y.v;
+                    p[2] = z.v;
+                    p[3] = w.v;
+                }
+
+                Pack operator+(Pack b) const {
+                    return {v + b.v};
+                }
+                Pack operator-(Pack b) const {
+                    return {v - b.v};
+                }
+                Pack operator*(Pack b) const {
+                    return {v * b.v};
+                }
+                Pack operator/(Pack b) const {
+                    return {v / b.v};
+                }
+                Pack operator-() const {
+                    return {-v};
+                }
+            };
+
+            // a*b + c
+            template <typename T>
+            inline Pack<T> fma(Pack<T> a, Pack<T> b, Pack<T> c) {
+                return {a.v*b.v + c.v};
+            }
+            template <typename T>
+            inline Pack<T> sqrt(Pack<T> a) {
+                return {std::sqrt(a.v)};
+            }
+            template <typename T>
+            inline Pack<T> rsqrt(Pack<T> a) {
+                return {T(1) / std::sqrt(a.v)};
+            }
+            template <typename T>
+            inline Pack<T> max(Pack<T> a, Pack<T> b) {
+                return {a.v > b.v ? a.v : b.v};
+            }
+            template <typename T>
+            inline Pack<T> select(Pack<T> a, Pack<T> b, Pack<T> x, Pack<T> y) {
+                return {a.v > b.v ? x.v : y.v};
+            }
+            template <typename T>
+            inline Pack<T> floor(Pack<T> a) {
+                return {std::floor(a.v)};
+            }
+            template <typename T>
+            inline Pack<T> mulsign(Pack<T> a, Pack<T> s) {
+                return {std::signbit(s.v) ? -a.v : a.v};
+            }
+
+            // Calls f(Q(), i) for every full pack from i to n, then finishes the tail with narrower packs
+            template <typename Q, typename F>
+            inline void sweep(size_t i, size_t n, F f) {
+                for (; i + Q::width <= n; i+=Q::width)
+                    f(Q(), i);
+                if constexpr (Q::width > 1)
+                    sweep<typename Q::Half>(i, n, f);
+            }
+        }
+
+    #if LINMATH_X86
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_SSE42)
+        namespace sse42 {
+
+            template <typename T>
+            struct Pack;
+
+            template <>
+            struct Pack<float> {
+                static constexpr size_t width = 4;
+                static constexpr size_t registers = 16;
+                using Half = scalar::Pack<float>;
+                __m128 v;
+
+                static Pack load(const float* p) {
+                    return {_mm_loadu_ps(p)};
+                }
+                static Pack set(float t) {
+                    return {_mm_set1_ps(t)};
+                }
+                static Pack zero() {
+                    return {_mm_setzero_ps()};
+                }
+                void store(float* p) const {
+                    _mm_storeu_ps(p, v);
+                }
+                static Pack gather(const float* p, const int32_t* index) {
+                    return {_mm_set_ps(p[index[3]], p[index[2]], p[index[1]], p[index[0]])};
+                }
+                float sum() const {
+                    __m128 h = _mm_add_ps(v, _mm_movehl_ps(v, v));
+                    return _mm_cvtss_f32(_mm_add_ss(h, _mm_movehdup_ps(h)));
+                }
+
+                // Interleaved 3 and 4 component vectors, width of them starting at p
+                static void load3(const float* p, Pack& x, Pack& y, Pack& z) {
+                    __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);
+                    __m128 tx = _mm_blend_ps(_mm_blend_ps(a, b, 0x4), c, 0x2);
+                    __m128 ty = _mm_blend_ps(_mm_blend_ps(a, b, 0x9), c, 0x4);
+                    __m128 tz = _mm_blend_ps(_mm_blend_ps(a, b, 0x2), c, 0x9);
+                    x.v = _mm_shuffle_ps(tx, tx, _MM_SHUFFLE(1, 2, 3, 0));
+                    y.v = _mm_shuffle_ps(ty, ty, _MM_SHUFFLE(2, 3, 0, 1));
+                    z.v = _mm_shuffle_ps(tz, tz, _MM_SHUFFLE(3, 0, 1, 2));
+                }
+                static void load4(const float* p, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8), d = _mm_loadu_ps(p + 12);
+                    _MM_TRANSPOSE4_PS(a, b, c, d);
+                    x.v = a;
+                    y.v = b;
+                    z.v = c;
+                    w.v = d;
+                }
+                static void gather4(const float* p, const int32_t* index, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    __m128 a = _mm_loadu_ps(p + index[0]), b = _mm_loadu_ps(p + index[1]), c = _mm_loadu_ps(p + index[2]), d = _mm_loadu_ps(p + index[3]);
+                    _MM_TRANSPOSE4_PS(a, b, c, d);
+                    x.v = a;
+                    y.v = b;
+                    z.v = c;
+                    w.v = d;
+                }
+                static void store3(float* p, Pack x, Pack y, Pack z) {
+                    __m128 tx = _mm_shuffle_ps(x.v, x.v, _MM_SHUFFLE(1, 2, 3, 0));
+                    __m128 ty = _mm_shuffle_ps(y.v, y.v, _MM_SHUFFLE(2, 3, 0, 1));
+                    __m128 tz = _mm_shuffle_ps(z.v, z.v, _MM_SHUFFLE(3, 0, 1, 2));
+                    _mm_storeu_ps(p, _mm_blend_ps(_mm_blend_ps(tx, ty, 0x2), tz, 0x4));
+                    _mm_storeu_ps(p + 4, _mm_blend_ps(_mm_blend_ps(ty, tz, 0x2), tx, 0x4));
+                    _mm_storeu_ps(p + 8, _mm_blend_ps(_mm_blend_ps(tz, tx, 0x2), ty, 0x4));
+                }
+                static void store4(float* p, Pack x, Pack y, Pack z, Pack w) {
+                    _MM_TRANSPOSE4_PS(x.v, y.v, z.v, w.v);
+                    _mm_storeu_ps(p, x.v);
+                    _mm_storeu_ps(p + 4, y.v);
+                    _mm_storeu_ps(p + 8, z.v);
+                    _mm_storeu_ps(p + 12, w.v);
+                }
+
+                Pack operator+(Pack b) const {
+                    return {_mm_add_ps(v, b.v)};
+                }
+                Pack operator-(Pack b) const {
+                    return {_mm_sub_ps(v, b.v)};
+                }
+                Pack operator*(Pack b) const {
+                    return {_mm_mul_ps(v, b.v)};
+                }
+                Pack operator/(Pack b) const {
+                    return {_mm_div_ps(v, b.v)};
+                }
+                Pack operator-() const {
+                    return {_mm_xor_ps(v, _mm_set1_ps(-0.f))};
+                }
+            };
+
+            template <>
+            struct Pack<double> {
+                static constexpr size_t width = 2;
+                static constexpr size_t registers = 16;
+                using Half = scalar::Pack<double>;
+                __m128d v;
+
+                static Pack load(const double* p) {
+                    return {_mm_loadu_pd(p)};
+                }
+                static Pack set(double t) {
+                    return {_mm_set1_pd(t)};
+                }
+                static Pack zero() {
+                    return {_mm_setzero_pd()};
+                }
+                void store(double* p) const {
+                    _mm_storeu_pd(p, v);
+                }
+                static Pack gather(const double* p, const int32_t* index) {
+                    return {_mm_set_pd(p[index[1]], p[index[0]])};
+                }
+                double sum() const {
+                    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+                }
+
+                // Interleaved 3 and 4 component vectors, width of them starting at p
+                static void load3(const double* p, Pack& x, Pack& y, Pack& z) {
+                    __m128d a = _mm_loadu_pd(p), b = _mm_loadu_pd(p + 2), c = _mm_loadu_pd(p + 4);
+                    x.v = _mm_blend_pd(a, b, 0x2);
+                    y.v = _mm_shuffle_pd(a, c, 0x1);
+                    z.v = _mm_blend_pd(b, c, 0x2);
+                }
+                static void load4(const double* p, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    __m128d a = _mm_loadu_pd(p), b = _mm_loadu_pd(p + 2), c = _mm_loadu_pd(p + 4), d = _mm_loadu_pd(p + 6);
+                    x.v = _mm_unpacklo_pd(a, c);
+                    y.v = _mm_unpackhi_pd(a, c);
+                    z.v = _mm_unpacklo_pd(b, d);
+                    w.v = _mm_unpackhi_pd(b, d);
+                }
+                static void gather4(const double* p, const int32_t* index, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    const double* p0 = p + index[0];
+                    const double* p1 = p + index[1];
+                    __m128d a = _mm_loadu_pd(p0), b = _mm_loadu_pd(p0 + 2), c = _mm_loadu_pd(p1), d = _mm_loadu_pd(p1 + 2);
+                    x.v = _mm_unpacklo_pd(a, c);
+                    y.v = _mm_unpackhi_pd(a, c);
+                    z.v = _mm_unpacklo_pd(b, d);
+                    w.v = _mm_unpackhi_pd(b, d);
+                }
+                static void store3(double* p, Pack x, Pack y, Pack z) {
+                    _mm_storeu_pd(p, _mm_unpacklo_pd(x.v, y.v));
+                    _mm_storeu_pd(p + 2, _mm_blend_pd(z.v, x.v, 0x2));
+                    _mm_storeu_pd(p + 4, _mm_unpackhi_pd(y.v, z.v));
+                }
+                static void store4(double* p, Pack x, Pack y, Pack z, Pack w) {
+                    _mm_storeu_pd(p, _mm_unpacklo_pd(x.v, y.v));
+                    _mm_storeu_pd(p + 2, _mm_unpacklo_pd(z.v, w.v));
+                    _mm_storeu_pd(p + 4, _mm_unpackhi_pd(x.v, y.v));
+                    _mm_storeu_pd(p + 6, _mm_unpackhi_pd(z.v, w.v));
+                }
+
+                Pack operator+(Pack b) const {
+                    return {_mm_add_pd(v, b.v)};
+                }
+                Pack operator-(Pack b) const {
+                    return {_mm_sub_pd(v, b.v)};
+                }
+                Pack operator*(Pack b) const {
+                    return {_mm_mul_pd(v, b.v)};
+                }
+                Pack operator/(Pack b) const {
+                    return {_mm_div_pd(v, b.v)};
+                }
+                Pack operator-() const {
+                    return {_mm_xor_pd(v, _mm_set1_pd(-0.))};
+                }
+            };
+
+            inline Pack<float> fma(Pack<float> a, Pack<float> b, Pack<float> c) {
+                return {_mm_add_ps(_mm_mul_ps(a.v, b.v), c.v)};
+            }
+            inline Pack<double> fma(Pack<double> a, Pack<double> b, Pack<double> c) {
+                return {_mm_add_pd(_mm_mul_pd(a.v, b.v), c.v)};
+            }
+            inline Pack<float> sqrt(Pack<float> a) {
+                return {_mm_sqrt_ps(a.v)};
+            }
+            inline Pack<double> sqrt(Pack<double> a) {
+                return {_mm_sqrt_pd(a.v)};
+            }
+            // The 12 bit estimate refined by one Newton step, y' = y*(1.5 - 0.5*a*y*y)
+            inline Pack<float> rsqrt(Pack<float> a) {
+                __m128 y = _mm_rsqrt_ps(a.v);
+                __m128 ayy = _mm_mul_ps(_mm_mul_ps(a.v, y), y);
+                return {_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), y), _mm_sub_ps(_mm_set1_ps(3.f), ayy))};
+            }
+            inline Pack<double> rsqrt(Pack<double> a) {
+                return {_mm_div_pd(_mm_set1_pd(1.), _mm_sqrt_pd(a.v))};
+            }
+            inline Pack<float> max(Pack<float> a, Pack<float> b) {
+                return {_mm_max_ps(a.v, b.v)};
+            }
+            inline Pack<double> max(Pack<double> a, Pack<double> b) {
+                return {_mm_max_pd(a.v, b.v)};
+            }
+            inline Pack<float> select(Pack<float> a, Pack<float> b, Pack<float> x, Pack<float> y) {
+                return {_mm_blendv_ps(y.v, x.v, _mm_cmpgt_ps(a.v, b.v))};
+            }
+            inline Pack<double> select(Pack<double> a, Pack<double> b, Pack<double> x, Pack<double> y) {
+                return {_mm_blendv_pd(y.v, x.v, _mm_cmpgt_pd(a.v, b.v))};
+            }
+            inline Pack<float> floor(Pack<float> a) {
+                return {_mm_floor_ps(a.v)};
+            }
+            inline Pack<double> floor(Pack<double> a) {
+                return {_mm_floor_pd(a.v)};
+            }
+            inline Pack<float> mulsign(Pack<float> a, Pack<float> s) {
+                return {_mm_xor_ps(a.v, _mm_and_ps(s.v, _mm_set1_ps(-0.f)))};
+            }
+            inline Pack<double> mulsign(Pack<double> a, Pack<double> s) {
+                return {_mm_xor_pd(a.v, _mm_and_pd(s.v, _mm_set1_pd(-0.)))};
+            }
+
+            // Calls f(Q(), i) for every full pack from i to n, then finishes the tail with narrower packs
+            template <typename Q, typename F>
+            inline void sweep(size_t i, size_t n, F f) {
+                for (; i + Q::width <= n; i+=Q::width)
+                    f(Q(), i);
+                if constexpr (Q::width > 1)
+                    sweep<typename Q::Half>(i, n, f);
+            }
+        }
+LINMATH_TARGET_END
+
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_AVX2)
+        namespace avx2 {
+
+            template <typename T>
+            struct Pack;
+
+            template <>
+            struct Pack<float> {
+                static constexpr size_t width = 8;
+                static constexpr size_t registers = 16;
+                using Half = sse42::Pack<float>;
+                __m256 v;
+
+                static Pack load(const float* p) {
+                    return {_mm256_loadu_ps(p)};
+                }
+                static Pack set(float t) {
+                    return {_mm256_set1_ps(t)};
+                }
+                static Pack zero() {
+                    return {_mm256_setzero_ps()};
+                }
+                void store(float* p) const {
+                    _mm256_storeu_ps(p, v);
+                }
+                // Masked forms with a zero source avoid the undefined source operand gcc warns about
+                static Pack gather(const float* p, const int32_t* index) {
+                    __m256i at = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index));
+                    return {_mm256_mask_i32gather_ps(_mm256_setzero_ps(), p, at, _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4)};
+                }
+                float sum() const {
+                    return Half{_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1))}.sum();
+                }
+
+                // Interleaved 3 and 4 component vectors, width of them starting at p
+                // The low lane holds the first four vectors and the high lane the next four
+                static __m256 lanes(const float* lo, const float* hi) {
+                    return _mm256_set_m128(_mm_loadu_ps(hi), _mm_loadu_ps(lo));
+                }
+                static void lanes(float* lo, float* hi, __m256 v) {
+                    _mm_storeu_ps(lo, _mm256_castps256_ps128(v));
+                    _mm_storeu_ps(hi, _mm256_extractf128_ps(v, 1));
+                }
+                static void load3(const float* p, Pack& x, Pack& y, Pack& z) {
+                    __m256 a = lanes(p, p + 12), b = lanes(p + 4, p + 16), c = lanes(p + 8, p + 20);
+                    __m256 tx = _mm256_blend_ps(_mm256_blend_ps(a, b, 0x44), c, 0x22);
+                    __m256 ty = _mm256_blend_ps(_mm256_blend_ps(a, b, 0x99), c, 0x44);
+                    __m256 tz = _mm256_blend_ps(_mm256_blend_ps(a, b, 0x22), c, 0x99);
+                    x.v = _mm256_permute_ps(tx, _MM_SHUFFLE(1, 2, 3, 0));
+                    y.v = _mm256_permute_ps(ty, _MM_SHUFFLE(2, 3, 0, 1));
+                    z.v = _mm256_permute_ps(tz, _MM_SHUFFLE(3, 0, 1, 2));
+                }
+                static void load4(const float* p, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    __m256 a = lanes(p, p + 16), b = lanes(p + 4, p + 20), c = lanes(p + 8, p + 24), d = lanes(p + 12, p + 28);
+                    __m256 t0 = _mm256_unpacklo_ps(a, b), t1 = _mm256_unpacklo_ps(c, d);
+                    __m256 t2 = _mm256_unpackhi_ps(a, b), t3 = _mm256_unpackhi_ps(c, d);
+                    x.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+                    y.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+                    z.v = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+                    w.v = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+                }
+                static void gather4(const float* p, const int32_t* index, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    __m256 a = lanes(p + index[0], p + index[4]), b = lanes(p + index[1], p + index[5]);
+                    __m256 c = lanes(p + index[2], p + index[6]), d = lanes(p + index[3], p + index[7]);
+                    __m256 t0 = _mm256_unpacklo_ps(a, b), t1 = _mm256_unpacklo_ps(c, d);
+                    __m256 t2 = _mm256_unpackhi_ps(a, b), t3 = _mm256_unpackhi_ps(c, d);
+                    x.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+                    y.v = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+                    z.v = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+                    w.v = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+                }
+                static void store3(float* p, Pack x, Pack y, Pack z) {
+                    __m256 tx = _mm256_permute_ps(x.v, _MM_SHUFFLE(1, 2, 3, 0));
+                    __m256 ty = _mm256_permute_ps(y.v, _MM_SHUFFLE(2, 3, 0, 1));
+                    __m256 tz = _mm256_permute_ps(z.v, _MM_SHUFFLE(3, 0, 1, 2));
+                    lanes(p, p + 12, _mm256_blend_ps(_mm256_blend_ps(tx, ty, 0x22), tz, 0x44));
+                    lanes(p + 4, p + 16, _mm256_blend_ps(_mm256_blend_ps(ty, tz, 0x22), tx, 0x44));
+                    lanes(p + 8, p + 20, _mm256_blend_ps(_mm256_blend_ps(tz, tx, 0x22), ty, 0x44));
+                }
+                static void store4(float* p, Pack x, Pack y, Pack z, Pack w) {
+                    __m256 t0 = _mm256_unpacklo_ps(x.v, y.v), t1 = _mm256_unpacklo_ps(z.v, w.v);
+                    __m256 t2 = _mm256_unpackhi_ps(x.v, y.v), t3 = _mm256_unpackhi_ps(z.v, w.v);
+                    lanes(p, p + 16, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)));
+                    lanes(p + 4, p + 20, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2)));
+                    lanes(p + 8, p + 24, _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+                    lanes(p + 12, p + 28, _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+                }
+
+                Pack operator+(Pack b) const {
+                    return {_mm256_add_ps(v, b.v)};
+                }
+                Pack operator-(Pack b) const {
+                    return {_mm256_sub_ps(v, b.v)};
+                }
+                Pack operator*(Pack b) const {
+                    return {_mm256_mul_ps(v, b.v)};
+                }
+                Pack operator/(Pack b) const {
+                    return {_mm256_div_ps(v, b.v)};
+                }
+                Pack operator-() const {
+                    return {_mm256_xor_ps(v, _mm256_set1_ps(-0.f))};
+                }
+            };
+
+            template <>
+            struct Pack<double> {
+                static constexpr size_t width = 4;
+                static constexpr size_t registers = 16;
+                using Half = sse42::Pack<double>;
+                __m256d v;
+
+                static Pack load(const double* p) {
+                    return {_mm256_loadu_pd(p)};
+                }
+                static Pack set(double t) {
+                    return {_mm256_set1_pd(t)};
+                }
+                static Pack zero() {
+                    return {_mm256_setzero_pd()};
+                }
+                void store(double* p) const {
+                    _mm256_storeu_pd(p, v);
+                }
+                static Pack gather(const double* p, const int32_t* index) {
+                    __m128i at = _mm_loadu_si128(reinterpret_cast<const __m128i*>(index));
+                    return {_mm256_mask_i32gather_pd(_mm256_setzero_pd(), p, at, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8)};
+                }
+                double sum() const {
+                    return Half{_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1))}.sum();
+                }
+
+                // Interleaved 3 and 4 component vectors, width of them starting at p
+                static __m256d lanes(const double* lo, const double* hi) {
+                    return _mm256_set_m128d(_mm_loadu_pd(hi), _mm_loadu_pd(lo));
+                }
+                static void lanes(double* lo, double* hi, __m256d v) {
+                    _mm_storeu_pd(lo, _mm256_castpd256_pd128(v));
+                    _mm_storeu_pd(hi, _mm256_extractf128_pd(v, 1));
+                }
+                static void load3(const double* p, Pack& x, Pack& y, Pack& z) {
+                    __m256d a = lanes(p, p + 6), b = lanes(p + 2, p + 8), c = lanes(p + 4, p + 10);
+                    x.v = _mm256_blend_pd(a, b, 0xA);
+                    y.v = _mm256_shuffle_pd(a, c, 0x5);
+                    z.v = _mm256_blend_pd(b, c, 0xA);
+                }
+                static void load4(const double* p, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    __m256d a = _mm256_loadu_pd(p), b = _mm256_loadu_pd(p + 4), c = _mm256_loadu_pd(p + 8), d = _mm256_loadu_pd(p + 12);
+                    __m256d t0 = _mm256_unpacklo_pd(a, b), t1 = _mm256_unpackhi_pd(a, b);
+                    __m256d t2 = _mm256_unpacklo_pd(c, d), t3 = _mm256_unpackhi_pd(c, d);
+                    x.v = _mm256_permute2f128_pd(t0, t2, 0x20);
+                    y.v = _mm256_permute2f128_pd(t1, t3, 0x20);
+                    z.v = _mm256_permute2f128_pd(t0, t2, 0x31);
+                    w.v = _mm256_permute2f128_pd(t1, t3, 0x31);
+                }
+                static void gather4(const double* p, const int32_t* index, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    __m256d a = _mm256_loadu_pd(p + index[0]), b = _mm256_loadu_pd(p + index[1]);
+                    __m256d c = _mm256_loadu_pd(p + index[2]), d = _mm256_loadu_pd(p + index[3]);
+                    __m256d t0 = _mm256_unpacklo_pd(a, b), t1 = _mm256_unpackhi_pd(a, b);
+                    __m256d t2 = _mm256_unpacklo_pd(c, d), t3 = _mm256_unpackhi_pd(c, d);
+                    x.v = _mm256_permute2f128_pd(t0, t2, 0x20);
+                    y.v = _mm256_permute2f128_pd(t1, t3, 0x20);
+                    z.v = _mm256_permute2f128_pd(t0, t2, 0x31);
+                    w.v = _mm256_permute2f128_pd(t1, t3, 0x31);
+                }
+                static void store3(double* p, Pack x, Pack y, Pack z) {
+                    lanes(p, p + 6, _mm256_unpacklo_pd(x.v, y.v));
+                    lanes(p + 2, p + 8, _mm256_blend_pd(z.v, x.v, 0xA));
+                    lanes(p + 4, p + 10, _mm256_unpackhi_pd(y.v, z.v));
+                }
+                static void store4(double* p, Pack x, Pack y, Pack z, Pack w) {
+                    __m256d t0 = _mm256_permute2f128_pd(x.v, z.v, 0x20), t2 = _mm256_permute2f128_pd(x.v, z.v, 0x31);
+                    __m256d t1 = _mm256_permute2f128_pd(y.v, w.v, 0x20), t3 = _mm256_permute2f128_pd(y.v, w.v, 0x31);
+                    _mm256_storeu_pd(p, _mm256_unpacklo_pd(t0, t1));
+                    _mm256_storeu_pd(p + 4, _mm256_unpackhi_pd(t0, t1));
+                    _mm256_storeu_pd(p + 8, _mm256_unpacklo_pd(t2, t3));
+                    _mm256_storeu_pd(p + 12, _mm256_unpackhi_pd(t2, t3));
+                }
+
+                Pack operator+(Pack b) const {
+                    return {_mm256_add_pd(v, b.v)};
+                }
+                Pack operator-(Pack b) const {
+                    return {_mm256_sub_pd(v, b.v)};
+                }
+                Pack operator*(Pack b) const {
+                    return {_mm256_mul_pd(v, b.v)};
+                }
+                Pack operator/(Pack b) const {
+                    return {_mm256_div_pd(v, b.v)};
+                }
+                Pack operator-() const {
+                    return {_mm256_xor_pd(v, _mm256_set1_pd(-0.))};
+                }
+            };
+
+            inline Pack<float> fma(Pack<float> a, Pack<float> b, Pack<float> c) {
+                return {_mm256_fmadd_ps(a.v, b.v, c.v)};
+            }
+            inline Pack<double> fma(Pack<double> a, Pack<double> b, Pack<double> c) {
+                return {_mm256_fmadd_pd(a.v, b.v, c.v)};
+            }
+            inline Pack<float> sqrt(Pack<float> a) {
+                return {_mm256_sqrt_ps(a.v)};
+            }
+            inline Pack<double> sqrt(Pack<double> a) {
+                return {_mm256_sqrt_pd(a.v)};
+            }
+            inline Pack<float> rsqrt(Pack<float> a) {
+                __m256 y = _mm256_rsqrt_ps(a.v);
+                __m256 ayy = _mm256_mul_ps(_mm256_mul_ps(a.v, y), y);
+                return {_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), y), _mm256_sub_ps(_mm256_set1_ps(3.f), ayy))};
+            }
+            inline Pack<double> rsqrt(Pack<double> a) {
+                return {_mm256_div_pd(_mm256_set1_pd(1.), _mm256_sqrt_pd(a.v))};
+            }
+            inline Pack<float> max(Pack<float> a, Pack<float> b) {
+                return {_mm256_max_ps(a.v, b.v)};
+            }
+            inline Pack<double> max(Pack<double> a, Pack<double> b) {
+                return {_mm256_max_pd(a.v, b.v)};
+            }
+            inline Pack<float> select(Pack<float> a, Pack<float> b, Pack<float> x, Pack<float> y) {
+                return {_mm256_blendv_ps(y.v, x.v, _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ))};
+            }
+            inline Pack<double> select(Pack<double> a, Pack<double> b, Pack<double> x, Pack<double> y) {
+                return {_mm256_blendv_pd(y.v, x.v, _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ))};
+            }
+            inline Pack<float> floor(Pack<float> a) {
+                return {_mm256_floor_ps(a.v)};
+            }
+            inline Pack<double> floor(Pack<double> a) {
+                return {_mm256_floor_pd(a.v)};
+            }
+            inline Pack<float> mulsign(Pack<float> a, Pack<float> s) {
+                return {_mm256_xor_ps(a.v, _mm256_and_ps(s.v, _mm256_set1_ps(-0.f)))};
+            }
+            inline Pack<double> mulsign(Pack<double> a, Pack<double> s) {
+                return {_mm256_xor_pd(a.v, _mm256_and_pd(s.v, _mm256_set1_pd(-0.)))};
+            }
+
+            // Calls f(Q(), i) for every full pack from i to n, then finishes the tail with narrower packs
+            template <typename Q, typename F>
+            inline void sweep(size_t i, size_t n, F f) {
+                for (; i + Q::width <= n; i+=Q::width)
+                    f(Q(), i);
+                if constexpr (Q::width > 1)
+                    sweep<typename Q::Half>(i, n, f);
+            }
+        }
+LINMATH_TARGET_END
+
+LINMATH_TARGET_BEGIN(LINMATH_TARGET_AVX512)
+        namespace avx512 {
+
+            template <typename T>
+            struct Pack;
+
+            template <>
+            struct Pack<float> {
+                static constexpr size_t width = 16;
+                static constexpr size_t registers = 32;
+                using Half = avx2::Pack<float>;
+                __m512 v;
+
+                static Pack load(const float* p) {
+                    return {_mm512_loadu_ps(p)};
+                }
+                static Pack set(float t) {
+                    return {_mm512_set1_ps(t)};
+                }
+                static Pack zero() {
+                    return {_mm512_setzero_ps()};
+                }
+                void store(float* p) const {
+                    _mm512_storeu_ps(p, v);
+                }
+                static Pack gather(const float* p, const int32_t* index) {
+                    return {_mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, _mm512_loadu_si512(index), p, 4)};
+                }
+                float sum() const {
+                    return (low() + high()).sum();
+                }
+
+                // Interleaved 3 and 4 component vectors, width of them starting at p
+                // Each half is interleaved by the avx2 pack and the halves are joined
+                // Zero masked forms avoid the undefined source operand gcc warns about
+                static Pack join(Half lo, Half hi) {
+                    __m512 v = _mm512_maskz_insertf32x8(0xFFFF, _mm512_setzero_ps(), lo.v, 0);
+                    return {_mm512_maskz_insertf32x8(0xFFFF, v, hi.v, 1)};
+                }
+                Half low() const {
+                    return {_mm512_maskz_extractf32x8_ps(0xFF, v, 0)};
+                }
+                Half high() const {
+                    return {_mm512_maskz_extractf32x8_ps(0xFF, v, 1)};
+                }
+                static void load3(const float* p, Pack& x, Pack& y, Pack& z) {
+                    Half lo[3], hi[3];
+                    Half::load3(p, lo[0], lo[1], lo[2]);
+                    Half::load3(p + 24, hi[0], hi[1], hi[2]);
+                    x = join(lo[0], hi[0]);
+                    y = join(lo[1], hi[1]);
+                    z = join(lo[2], hi[2]);
+                }
+                static void load4(const float* p, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    Half lo[4], hi[4];
+                    Half::load4(p, lo[0], lo[1], lo[2], lo[3]);
+                    Half::load4(p + 32, hi[0], hi[1], hi[2], hi[3]);
+                    x = join(lo[0], hi[0]);
+                    y = join(lo[1], hi[1]);
+                    z = join(lo[2], hi[2]);
+                    w = join(lo[3], hi[3]);
+                }
+                static void gather4(const float* p, const int32_t* index, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    Half lo[4], hi[4];
+                    Half::gather4(p, index, lo[0], lo[1], lo[2], lo[3]);
+                    Half::gather4(p, index + Half::width, hi[0], hi[1], hi[2], hi[3]);
+                    x = join(lo[0], hi[0]);
+                    y = join(lo[1], hi[1]);
+                    z = join(lo[2], hi[2]);
+                    w = join(lo[3], hi[3]);
+                }
+                static void store3(float* p, Pack x, Pack y, Pack z) {
+                    Half::store3(p, x.low(), y.low(), z.low());
+                    Half::store3(p + 24, x.high(), y.high(), z.high());
+                }
+                static void store4(float* p, Pack x, Pack y, Pack z, Pack w) {
+                    Half::store4(p, x.low(), y.low(), z.low(), w.low());
+                    Half::store4(p + 32, x.high(), y.high(), z.high(), w.high());
+                }
+
+                Pack operator+(Pack b) const {
+                    return {_mm512_add_ps(v, b.v)};
+                }
+                Pack operator-(Pack b) const {
+                    return {_mm512_sub_ps(v, b.v)};
+                }
+                Pack operator*(Pack b) const {
+                    return {_mm512_mul_ps(v, b.v)};
+                }
+                Pack operator/(Pack b) const {
+                    return {_mm512_div_ps(v, b.v)};
+                }
+                Pack operator-() const {
+                    return {_mm512_sub_ps(_mm512_setzero_ps(), v)};
+                }
+            };
+
+            template <>
+            struct Pack<double> {
+                static constexpr size_t width = 8;
+                static constexpr size_t registers = 32;
+                using Half = avx2::Pack<double>;
+                __m512d v;
+
+                static Pack load(const double* p) {
+                    return {_mm512_loadu_pd(p)};
+                }
+                static Pack set(double t) {
+                    return {_mm512_set1_pd(t)};
+                }
+                static Pack zero() {
+                    return {_mm512_setzero_pd()};
+                }
+                void store(double* p) const {
+                    _mm512_storeu_pd(p, v);
+                }
+                static Pack gather(const double* p, const int32_t* index) {
+                    return {_mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index)), p, 8)};
+                }
+                double sum() const {
+                    return (low() + high()).sum();
+                }
+
+                // Interleaved 3 and 4 component vectors, width of them starting at p
+                // Each half is interleaved by the avx2 pack and the halves are joined
+                // Zero masked forms avoid the undefined source operand gcc warns about
+                static Pack join(Half lo, Half hi) {
+                    __m512d v = _mm512_maskz_insertf64x4(0xFF, _mm512_setzero_pd(), lo.v, 0);
+                    return {_mm512_maskz_insertf64x4(0xFF, v, hi.v, 1)};
+                }
+                Half low() const {
+                    return {_mm512_maskz_extractf64x4_pd(0xF, v, 0)};
+                }
+                Half high() const {
+                    return {_mm512_maskz_extractf64x4_pd(0xF, v, 1)};
+                }
+                static void load3(const double* p, Pack& x, Pack& y, Pack& z) {
+                    Half lo[3], hi[3];
+                    Half::load3(p, lo[0], lo[1], lo[2]);
+                    Half::load3(p + 12, hi[0], hi[1], hi[2]);
+                    x = join(lo[0], hi[0]);
+                    y = join(lo[1], hi[1]);
+                    z = join(lo[2], hi[2]);
+                }
+                static void load4(const double* p, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    Half lo[4], hi[4];
+                    Half::load4(p, lo[0], lo[1], lo[2], lo[3]);
+                    Half::load4(p + 16, hi[0], hi[1], hi[2], hi[3]);
+                    x = join(lo[0], hi[0]);
+                    y = join(lo[1], hi[1]);
+                    z = join(lo[2], hi[2]);
+                    w = join(lo[3], hi[3]);
+                }
+                static void gather4(const double* p, const int32_t* index, Pack& x, Pack& y, Pack& z, Pack& w) {
+                    Half lo[4], hi[4];
+                    Half::gather4(p, index, lo[0], lo[1], lo[2], lo[3]);
+                    Half::gather4(p, index + Half::width, hi[0], hi[1], hi[2], hi[3]);
+                    x = join(lo[0], hi[0]);
+                    y = join(lo[1], hi[1]);
+                    z = join(lo[2], hi[2]);
+                    w = join(lo[3], hi[3]);
+                }
+                static void store3(double* p, Pack x, Pack y, Pack z) {
+                    Half::store3(p, x.low(), y.low(), z.low());
+                    Half::store3(p + 12, x.high(), y.high(), z.high());
+                }
+                static void store4(double* p, Pack x, Pack y, Pack z, Pack w) {
+                    Half::store4(p, x.low(), y.low(), z.low(), w.low());
+                    Half::store4(p + 16, x.high(), y.high(), z.high(), w.high());
+                }
+
+                Pack operator+(Pack b) const {
+                    return {_mm512_add_pd(v, b.v)};
+                }
+                Pack operator-(Pack b) const {
+                    return {_mm512_sub_pd(v, b.v)};
+                }
+                Pack operator*(Pack b) const {
+                    return {_mm512_mul_pd(v, b.v)};
+                }
+                Pack operator/(Pack b) const {
+                    return {_mm512_div_pd(v, b.v)};
+                }
+                Pack operator-() const {
+                    return {_mm512_sub_pd(_mm512_setzero_pd(), v)};
+                }
+            };
+
+            inline Pack<float> fma(Pack<float> a, Pack<float> b, Pack<float> c) {
+                return {_mm512_fmadd_ps(a.v, b.v, c.v)};
+            }
+            inline Pack<double> fma(Pack<double> a, Pack<double> b, Pack<double> c) {
+                return {_mm512_fmadd_pd(a.v, b.v, c.v)};
+            }
+            // Zero masked forms avoid the undefined source operand gcc warns about
+            inline Pack<float> sqrt(Pack<float> a) {
+                return {_mm512_maskz_sqrt_ps(0xFFFF, a.v)};
+            }
+            inline Pack<double> sqrt(Pack<double> a) {
+                return {_mm512_maskz_sqrt_pd(0xFF, a.v)};
+            }
+            // The 14 bit estimate refined by one Newton step
+            inline Pack<float> rsqrt(Pack<float> a) {
+                __m512 y = _mm512_maskz_rsqrt14_ps(0xFFFF, a.v);
+                __m512 ayy = _mm512_mul_ps(_mm512_mul_ps(a.v, y), y);
+                return {_mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f), y), _mm512_sub_ps(_mm512_set1_ps(3.f), ayy))};
+            }
+            inline Pack<double> rsqrt(Pack<double> a) {
+                return {_mm512_div_pd(_mm512_set1_pd(1.), _mm512_maskz_sqrt_pd(0xFF, a.v))};
+            }
+            inline Pack<float> max(Pack<float> a, Pack<float> b) {
+                return {_mm512_maskz_max_ps(0xFFFF, a.v, b.v)};
+            }
+            inline Pack<double> max(Pack<double> a, Pack<double> b) {
+                return {_mm512_maskz_max_pd(0xFF, a.v, b.v)};
+            }
+            inline Pack<float> select(Pack<float> a, Pack<float> b, Pack<float> x, Pack<float> y) {
+                return {_mm512_mask_blend_ps(_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ), y.v, x.v)};
+            }
+            inline Pack<double> select(Pack<double> a, Pack<double> b, Pack<double> x, Pack<double> y) {
+                return {_mm512_mask_blend_pd(_mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ), y.v, x.v)};
+            }
+            inline Pack<float> floor(Pack<float> a) {
+                return {_mm512_maskz_roundscale_ps(0xFFFF, a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)};
+            }
+            inline Pack<double> floor(Pack<double> a) {
+                return {_mm512_maskz_roundscale_pd(0xFF, a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)};
+            }
+            inline Pack<float> mulsign(Pack<float> a, Pack<float> s) {
+                return {_mm512_xor_ps(a.v, _mm512_and_ps(s.v, _mm512_set1_ps(-0.f)))};
+            }
+            inline Pack<double> mulsign(Pack<double> a, Pack<double> s) {
+                return {_mm512_xor_pd(a.v, _mm512_and_pd(s.v, _mm512_set1_pd(-0.)))};
+            }
+
+            // Calls f(Q(), i) for every full pack from i to n, then finishes the tail with narrower packs
+            template <typename Q, typename F>
+            inline void sweep(size_t i, size_t n, F f) {
+                for (; i + Q::width <= n; i+=Q::width)
+                    f(Q(), i);
+                if constexpr (Q::width > 1)
+                    sweep<typename Q::Half>(i, n, f);
+            }
+        }
+LINMATH_TARGET_END
+    #endif
+
+        // The widest tier the consumer's own compiler flags enable, for loops that are inlined into the caller
+        // instead of dispatched, scalar unless the build targets SSE4.2 or better
+    #if LINMATH_X86 && defined(__AVX512F__) && defined(__AVX512VL__) && defined(__AVX512DQ__) && defined(__AVX512BW__)
+        namespace native = avx512;
+    #elif LINMATH_X86 && defined(__AVX2__) && defined(__FMA__)
+        namespace native = avx2;
+    #elif LINMATH_X86 && defined(__SSE4_2__)
+        namespace native = sse42;
+    #else
+        namespace native = scalar;
+    #endif
+    }
+}
+
+#endif
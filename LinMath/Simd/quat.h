@@ -0,0 +1,40 @@
+#ifndef SIMD_QUAT_H
+#define SIMD_QUAT_H
+
+#include <cstddef>
+
+#include "dispatch.h"
+#include "../Math/math.h"
+
+#define LINMATH_KERNELS "Kernels/quat.h"
+#include "foreach.h"
+
+namespace linmath {
+    namespace simd {
+
+        // Dispatched kernels, float and double run the active tier and other types the scalar templates
+        template <typename T>
+        using QuatBlend = void (*)(size_t, const T*, const T*, const T*, T*);
+
+        template <typename T>
+        inline void nlerp(size_t n, const T* a, const T* b, const T* t, T* out) {
+            if constexpr (vectorized<T>) {
+                static const QuatBlend<T> kernel = LINMATH_DISPATCH(QuatBlend<T>, nlerp<T>);
+                kernel(n, a, b, t, out);
+            }
+            else
+                scalar::nlerp<T>(n, a, b, t, out);
+        }
+        template <typename T>
+        inline void slerp(size_t n, const T* a, const T* b, const T* t, T* out) {
+            if constexpr (vectorized<T>) {
+                static const QuatBlend<T> kernel = LINMATH_DISPATCH(QuatBlend<T>, slerp<T>);
+                kernel(n, a, b, t, out);
+            }
+            else
+                scalar::slerp<T>(n, a, b, t, out);
+        }
+    }
+}
+
+#endif
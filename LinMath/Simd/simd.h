@@ -0,0 +1,71 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define LINMATH_X86 1
+#include <immintrin.h>
+#else
+#define LINMATH_X86 0
+#endif
+
+// Instruction sets enabled by the consumer's compiler flags
+#if LINMATH_X86 && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define LINMATH_SSE2 1
+#else
+#define LINMATH_SSE2 0
+#endif
+
+#if LINMATH_X86 && defined(__AVX__)
+#define LINMATH_AVX 1
+#else
+#define LINMATH_AVX 0
+#endif
+
+// Fused multiply-add in the consumer's own target, used by code outside the dispatched kernels
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA) || defined(FP_FAST_FMA)
+#define LINMATH_FMA 1
+#else
+#define LINMATH_FMA 0
+#endif
+
+// Target strings of the runtime dispatched tiers
+#define LINMATH_TARGET_SSE42 "sse4.2"
+#define LINMATH_TARGET_AVX2 "avx2,fma"
+#define LINMATH_TARGET_AVX512 "avx512f,avx512vl,avx512dq,avx512bw,avx2,fma"
+
+// Turns contraction off for the enclosed functions, so a separate multiply and add round on their own whatever
+// the consumer's flags are, the scalar references and the tiers below agree and only an explicit fma fuses
+#if defined(__clang__)
+#define LINMATH_EXACT_BEGIN _Pragma("float_control(push)") _Pragma("clang fp contract(off)")
+#define LINMATH_EXACT_END _Pragma("float_control(pop)")
+#elif defined(__GNUC__)
+#define LINMATH_EXACT_BEGIN _Pragma("GCC push_options") _Pragma("GCC optimize(\"fp-contract=off\")")
+#define LINMATH_EXACT_END _Pragma("GCC pop_options")
+#else
+#define LINMATH_EXACT_BEGIN
+#define LINMATH_EXACT_END
+#endif
+
+// Compiles the enclosed functions for a tier regardless of the consumer's flags
+// The Mat4 kernels add LINMATH_EXACT inside, the packs stay without it, gcc does not inline a function whose
+// optimize options differ from its caller's and VecN runs the native packs in the consumer's own code
+#define LINMATH_STRINGIFY(x) #x
+#if LINMATH_X86 && defined(__clang__)
+#define LINMATH_TARGET_BEGIN(isa) _Pragma(LINMATH_STRINGIFY(clang attribute push(__attribute__((target(isa))), apply_to = function)))
+#define LINMATH_TARGET_END _Pragma("clang attribute pop")
+#elif LINMATH_X86 && defined(__GNUC__)
+#define LINMATH_TARGET_BEGIN(isa) _Pragma("GCC push_options") _Pragma(LINMATH_STRINGIFY(GCC target(isa)))
+#define LINMATH_TARGET_END _Pragma("GCC pop_options")
+#else
+#define LINMATH_TARGET_BEGIN(isa)
+#define LINMATH_TARGET_END
+#endif
+
+// Requests full unrolling of the following fixed trip count loop
+#if defined(__clang__) || defined(__GNUC__)
+#define LINMATH_UNROLL _Pragma("GCC unroll 16")
+#else
+#define LINMATH_UNROLL
+#endif
+
+#endif
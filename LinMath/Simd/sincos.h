@@ -0,0 +1,37 @@
+#ifndef SIMD_SINCOS_H
+#define SIMD_SINCOS_H
+
+#include <cstddef>
+
+#include "dispatch.h"
+#include "../Math/math.h"
+
+#define LINMATH_KERNELS "Kernels/sincos.h"
+#include "foreach.h"
+
+namespace linmath {
+    namespace simd {
+
+        // Dispatched sine and cosine of n values, float and double run the active tier and other types math::sincos
+        // Results are within 2 ulp of the correctly rounded ones for |x| below 8192 for float and 2^30 for double,
+        // next to the zeros too, past that j outgrows the short parts of pi/2 and the remainder loses bits
+        template <typename T>
+        using SinCosKernel = void (*)(size_t, const T*, T*, T*);
+
+        template <typename T>
+        inline void sincos(size_t n, const T* x, T* s, T* c) {
+            if constexpr (vectorized<T>) {
+                static const SinCosKernel<T> kernel = LINMATH_DISPATCH(SinCosKernel<T>, sincos<T>);
+                kernel(n, x, s, c);
+            }
+            else
+                for (size_t i=0; i<n; i++) {
+                    auto [sin, cos] = math::sincos(x[i]);
+                    s[i] = sin;
+                    c[i] = cos;
+                }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SIMD_SKIN_H
+#define SIMD_SKIN_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dispatch.h"
+
+namespace linmath {
+    namespace simd {
+
+        // The arrays of one skinning call
+        // palette holds a bone every stride values, a column vector Mat4 for linear blending or the 8 values of a DualQuat
+        // Influence j of vertex i is bone bones[j*influenceStride + i] with weight weights[j*influenceStride + i]
+        // Positions and normals are planar with component c of vertex i at [c*stride + i], normals are skipped when null
+        template <typename T>
+        struct Skin {
+            const T* palette;
+            size_t influences;
+            const int32_t* bones;
+            const T* weights;
+            size_t influenceStride;
+            const T* positions;
+            size_t positionStride;
+            T* outPositions;
+            size_t outPositionStride;
+            const T* normals = nullptr;
+            size_t normalStride = 0;
+            T* outNormals = nullptr;
+            size_t outNormalStride = 0;
+        };
+    }
+}
+
+#define LINMATH_KERNELS "Kernels/skin.h"
+#include "foreach.h"
+
+namespace linmath {
+    namespace simd {
+
+        // Dispatched kernels over the vertices from begin to end, float and double run the active tier and other types the scalar templates
+        template <typename T>
+        using SkinRange = void (*)(size_t, size_t, const Skin<T>&);
+
+        template <typename T>
+        inline void skinLinear(size_t begin, size_t end, const Skin<T>& skin) {
+            if constexpr (vectorized<T>) {
+                static const SkinRange<T> kernel = LINMATH_DISPATCH(SkinRange<T>, skinLinear<T>);
+                kernel(begin, end, skin);
+            }
+            else
+                scalar::skinLinear<T>(begin, end, skin);
+        }
+        template <typename T>
+        inline void skinDualQuat(size_t begin, size_t end, const Skin<T>& skin) {
+            if constexpr (vectorized<T>) {
+                static const SkinRange<T> kernel = LINMATH_DISPATCH(SkinRange<T>, skinDualQuat<T>);
+                kernel(begin, end, skin);
+            }
+            else
+                scalar::skinDualQuat<T>(begin, end, skin);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef SIMD_SOLVE_H
+#define SIMD_SOLVE_H
+
+#include <cstddef>
+
+#include "dispatch.h"
+
+namespace linmath {
+    namespace simd {
+
+        // The arrays of one batched solve of N by N systems a*x = b, row major matricies in blocks of lanes systems
+        // Element k of matrix i is at a[(i/lanes)*N*N*lanes + k*lanes + i%lanes], as in Mat4Batch, a single block with
+        // lanes at least the count is planar with element k of every matrix lanes values apart
+        // Component r of the right hand side and of the solution of system i are at b[r*bStride + i] and x[r*xStride + i]
+        template <typename T>
+        struct Systems {
+            const T* a;
+            size_t lanes;
+            const T* b;
+            size_t bStride;
+            T* x;
+            size_t xStride;
+        };
+    }
+}
+
+#define LINMATH_KERNELS "Kernels/solve.h"
+#include "foreach.h"
+
+namespace linmath {
+    namespace simd {
+
+        // Dispatched kernels over the systems from begin to end, float and double run the active tier and other types the scalar templates
+        // With several blocks begin must be a multiple of lanes, so that no pack crosses into the next block
+        template <typename T>
+        using SolveRange = void (*)(size_t, size_t, const Systems<T>&);
+
+        template <typename T, size_t N>
+        inline void solve(size_t begin, size_t end, const Systems<T>& systems) {
+            if constexpr (vectorized<T>) {
+                static const SolveRange<T> kernel = LINMATH_DISPATCH(SolveRange<T>, solve<T, N>);
+                kernel(begin, end, systems);
+            }
+            else
+                scalar::solve<T, N>(begin, end, systems);
+        }
+    }
+}
+
+#endif
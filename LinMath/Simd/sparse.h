@@ -0,0 +1,76 @@
+#ifndef SIMD_SPARSE_H
+#define SIMD_SPARSE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dispatch.h"
+
+namespace linmath {
+    namespace simd {
+
+        // The arrays of a compressed sparse matrix, row r has the nonzeros from offsets[r] to offsets[r + 1] with their
+        // column in indices and their value in values, a matrix compressed by columns passes them as rows of its transpose
+        // With 3x3 blocks the indices are block columns and every block has nine row major values
+        template <typename T>
+        struct SparseRows {
+            const size_t* offsets;
+            const int32_t* indices;
+            const T* values;
+        };
+    }
+}
+
+#define LINMATH_KERNELS "Kernels/sparse.h"
+#include "foreach.h"
+
+namespace linmath {
+    namespace simd {
+
+        // Dispatched kernels over the rows from begin to end, float and double run the active tier and other types the scalar templates
+        // x and y must not overlap
+        template <typename T>
+        using SpmvRange = void (*)(size_t, size_t, const SparseRows<T>&, const T*, T*);
+        template <typename T>
+        using SpmmRange = void (*)(size_t, size_t, const SparseRows<T>&, const T*, size_t, T*);
+
+        template <typename T>
+        inline void spmv(size_t begin, size_t end, const SparseRows<T>& a, const T* x, T* y) {
+            if constexpr (vectorized<T>) {
+                static const SpmvRange<T> kernel = LINMATH_DISPATCH(SpmvRange<T>, spmv<T>);
+                kernel(begin, end, a, x, y);
+            }
+            else
+                scalar::spmv<T>(begin, end, a, x, y);
+        }
+        template <typename T>
+        inline void spmm(size_t begin, size_t end, const SparseRows<T>& a, const T* x, size_t k, T* y) {
+            if constexpr (vectorized<T>) {
+                static const SpmmRange<T> kernel = LINMATH_DISPATCH(SpmmRange<T>, spmm<T>);
+                kernel(begin, end, a, x, k, y);
+            }
+            else
+                scalar::spmm<T>(begin, end, a, x, k, y);
+        }
+        template <typename T>
+        inline void bsr3mv(size_t begin, size_t end, const SparseRows<T>& a, const T* x, T* y) {
+            if constexpr (vectorized<T>) {
+                static const SpmvRange<T> kernel = LINMATH_DISPATCH(SpmvRange<T>, bsr3mv<T>);
+                kernel(begin, end, a, x, y);
+            }
+            else
+                scalar::bsr3mv<T>(begin, end, a, x, y);
+        }
+        template <typename T>
+        inline void bsr3mm(size_t begin, size_t end, const SparseRows<T>& a, const T* x, size_t k, T* y) {
+            if constexpr (vectorized<T>) {
+                static const SpmmRange<T> kernel = LINMATH_DISPATCH(SpmmRange<T>, bsr3mm<T>);
+                kernel(begin, end, a, x, k, y);
+            }
+            else
+                scalar::bsr3mm<T>(begin, end, a, x, k, y);
+        }
+    }
+}
+
+#endif
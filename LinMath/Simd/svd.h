@@ -0,0 +1,44 @@
+#ifndef SIMD_SVD_H
+#define SIMD_SVD_H
+
+#include <cstddef>
+#include <limits>
+
+#include "decompose.h"
+#include "dispatch.h"
+
+#define LINMATH_KERNELS "Kernels/svd.h"
+#include "foreach.h"
+
+namespace linmath {
+    namespace simd {
+
+        // Dispatched kernels over the matricies from begin to end, float and double run the active tier and other types the scalar templates
+        // S is 3 for Mat3 blocks and 4 to read the top left 3x3 of Mat4 blocks, the results are 3x3 blocks of the same lanes
+        template <typename T>
+        using Svd3Range = void (*)(size_t, size_t, size_t, const T*, T*, T*, size_t, T*);
+        template <typename T>
+        using Polar3Range = void (*)(size_t, size_t, size_t, const T*, T*, T*);
+
+        template <typename T, size_t S>
+        inline void svd3(size_t begin, size_t end, size_t lanes, const T* a, T* u, T* sigma, size_t sigmaStride, T* v) {
+            if constexpr (vectorized<T>) {
+                static const Svd3Range<T> kernel = LINMATH_DISPATCH(Svd3Range<T>, svd3<T, S>);
+                kernel(begin, end, lanes, a, u, sigma, sigmaStride, v);
+            }
+            else
+                scalar::svd3<T, S>(begin, end, lanes, a, u, sigma, sigmaStride, v);
+        }
+        template <typename T, size_t S>
+        inline void polar3(size_t begin, size_t end, size_t lanes, const T* a, T* rotation, T* stretch) {
+            if constexpr (vectorized<T>) {
+                static const Polar3Range<T> kernel = LINMATH_DISPATCH(Polar3Range<T>, polar3<T, S>);
+                kernel(begin, end, lanes, a, rotation, stretch);
+            }
+            else
+                scalar::polar3<T, S>(begin, end, lanes, a, rotation, stretch);
+        }
+    }
+}
+
+#endif
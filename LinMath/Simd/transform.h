@@ -0,0 +1,65 @@
+#ifndef SIMD_TRANSFORM_H
+#define SIMD_TRANSFORM_H
+
+#include <cstddef>
+
+#include "dispatch.h"
+
+namespace linmath {
+
+    // Side of a Mat4 the vectors it transforms go on
+    // ColumnVectors: out = m * v as mat4x4vec, the translation in the last column
+    // RowVectors:    out = v * m as vec4x4mat, the translation in the bottom row as the Mat4 builders and Affine3 put it
+    enum class Convention {
+        ColumnVectors,
+        RowVectors
+    };
+
+    namespace simd {
+
+        // Full:        out = m * v
+        // Homogeneous: out = m * v divided by its w, a 4 component out gets w = 1
+        // Affine:      only the top three rows of m, a 4 component out keeps the input w
+        // Written for column vectors, row vectors use the transpose of m, so Affine drops its last column instead
+        enum class Transform {
+            Full,
+            Homogeneous,
+            Affine
+        };
+    }
+}
+
+#define LINMATH_KERNELS "Kernels/transform.h"
+#include "foreach.h"
+
+namespace linmath {
+    namespace simd {
+
+        // Dispatched kernels, float and double run the active tier and other types the scalar templates
+        template <typename T>
+        using TransformPlanar = void (*)(size_t, const T*, const T*, size_t, T*, size_t);
+        template <typename T>
+        using TransformInterleaved = void (*)(size_t, const T*, const T*, T*);
+
+        template <typename T, size_t D, Transform mode, Convention order = Convention::ColumnVectors>
+        inline void transformPlanar(size_t n, const T* m, const T* in, size_t si, T* out, size_t so) {
+            if constexpr (vectorized<T>) {
+                static const TransformPlanar<T> kernel = LINMATH_DISPATCH(TransformPlanar<T>, transformPlanar<T, D, mode, order>);
+                kernel(n, m, in, si, out, so);
+            }
+            else
+                scalar::transformPlanar<T, D, mode, order>(n, m, in, si, out, so);
+        }
+        template <typename T, size_t D, Transform mode, Convention order = Convention::ColumnVectors>
+        inline void transformInterleaved(size_t n, const T* m, const T* in, T* out) {
+            if constexpr (vectorized<T>) {
+                static const TransformInterleaved<T> kernel = LINMATH_DISPATCH(TransformInterleaved<T>, transformInterleaved<T, D, mode, order>);
+                kernel(n, m, in, out);
+            }
+            else
+                scalar::transformInterleaved<T, D, mode, order>(n, m, in, out);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef SIMD_VEC4_H
+#define SIMD_VEC4_H
+
+#include <type_traits>
+
+#include "simd.h"
+
+// Lanes4<T> holds the 4 values of a Vec4<T> in registers, one __m128 for float and one __m256d or two __m128d for double
+// A Vec4 operation is only a few instructions, too short to pay for a call through the runtime dispatch,
+// so these use the instruction sets of the consumer's own compiler flags and are inlined into the Vec4 members
+// load and store take 4 values aligned to their size, which Vec4 is
+
+namespace linmath {
+    namespace simd {
+
+        template <typename T>
+        struct Lanes4;
+
+        template <typename T>
+        constexpr bool hasLanes4 = LINMATH_SSE2 && (std::is_same_v<T, float> || std::is_same_v<T, double>);
+
+    #if LINMATH_SSE2
+        template <>
+        struct Lanes4<float> {
+            __m128 v;
+
+            static Lanes4 load(const float* p) {
+                return {_mm_load_ps(p)};
+            }
+            static Lanes4 set(float t) {
+                return {_mm_set1_ps(t)};
+            }
+            void store(float* p) const {
+                _mm_store_ps(p, v);
+            }
+
+            Lanes4 operator+(Lanes4 b) const {
+                return {_mm_add_ps(v, b.v)};
+            }
+            Lanes4 operator-(Lanes4 b) const {
+                return {_mm_sub_ps(v, b.v)};
+            }
+            Lanes4 operator*(Lanes4 b) const {
+                return {_mm_mul_ps(v, b.v)};
+            }
+            Lanes4 operator/(Lanes4 b) const {
+                return {_mm_div_ps(v, b.v)};
+            }
+            Lanes4 operator-() const {
+                return {_mm_xor_ps(v, _mm_set1_ps(-0.f))};
+            }
+
+            // Sum of the 4 lanes in every lane, two shuffles and two adds
+            Lanes4 sum() const {
+                __m128 s = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+                return {_mm_add_ps(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 3, 2)))};
+            }
+            Lanes4 sqrt() const {
+                return {_mm_sqrt_ps(v)};
+            }
+            // The 12 bit estimate refined by one Newton step
+            Lanes4 rsqrt() const {
+                __m128 y = _mm_rsqrt_ps(v);
+                __m128 vyy = _mm_mul_ps(_mm_mul_ps(v, y), y);
+                return {_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), y), _mm_sub_ps(_mm_set1_ps(3.f), vyy))};
+            }
+            float first() const {
+                return _mm_cvtss_f32(v);
+            }
+            bool operator==(Lanes4 b) const {
+                return _mm_movemask_ps(_mm_cmpeq_ps(v, b.v)) == 0xF;
+            }
+        };
+
+    #if LINMATH_AVX
+        template <>
+        struct Lanes4<double> {
+            __m256d v;
+
+            static Lanes4 load(const double* p) {
+                return {_mm256_load_pd(p)};
+            }
+            static Lanes4 set(double t) {
+                return {_mm256_set1_pd(t)};
+            }
+            void store(double* p) const {
+                _mm256_store_pd(p, v);
+            }
+
+            Lanes4 operator+(Lanes4 b) const {
+                return {_mm256_add_pd(v, b.v)};
+            }
+            Lanes4 operator-(Lanes4 b) const {
+                return {_mm256_sub_pd(v, b.v)};
+            }
+            Lanes4 operator*(Lanes4 b) const {
+                return {_mm256_mul_pd(v, b.v)};
+            }
+            Lanes4 operator/(Lanes4 b) const {
+                return {_mm256_div_pd(v, b.v)};
+            }
+            Lanes4 operator-() const {
+                return {_mm256_xor_pd(v, _mm256_set1_pd(-0.))};
+            }
+
+            // Sum of the 4 lanes in every lane, a lane swap within and one across the halves
+            Lanes4 sum() const {
+                __m256d s = _mm256_add_pd(v, _mm256_permute_pd(v, 0x5));
+                return {_mm256_add_pd(s, _mm256_permute2f128_pd(s, s, 0x01))};
+            }
+            Lanes4 sqrt() const {
+                return {_mm256_sqrt_pd(v)};
+            }
+            Lanes4 rsqrt() const {
+                return {_mm256_div_pd(_mm256_set1_pd(1.), _mm256_sqrt_pd(v))};
+            }
+            double first() const {
+                return _mm256_cvtsd_f64(v);
+            }
+            bool operator==(Lanes4 b) const {
+                return _mm256_movemask_pd(_mm256_cmp_pd(v, b.v, _CMP_EQ_OQ)) == 0xF;
+            }
+        };
+    #else
+        template <>
+        struct Lanes4<double> {
+            __m128d lo;
+            __m128d hi;
+
+            static Lanes4 load(const double* p) {
+                return {_mm_load_pd(p), _mm_load_pd(p + 2)};
+            }
+            static Lanes4 set(double t) {
+                return {_mm_set1_pd(t), _mm_set1_pd(t)};
+            }
+            void store(double* p) const {
+                _mm_store_pd(p, lo);
+                _mm_store_pd(p + 2, hi);
+            }
+
+            Lanes4 operator+(Lanes4 b) const {
+                return {_mm_add_pd(lo, b.lo), _mm_add_pd(hi, b.hi)};
+            }
+            Lanes4 operator-(Lanes4 b) const {
+                return {_mm_sub_pd(lo, b.lo), _mm_sub_pd(hi, b.hi)};
+            }
+            Lanes4 operator*(Lanes4 b) const {
+                return {_mm_mul_pd(lo, b.lo), _mm_mul_pd(hi, b.hi)};
+            }
+            Lanes4 operator/(Lanes4 b) const {
+                return {_mm_div_pd(lo, b.lo), _mm_div_pd(hi, b.hi)};
+            }
+            Lanes4 operator-() const {
+                __m128d sign = _mm_set1_pd(-0.);
+                return {_mm_xor_pd(lo, sign), _mm_xor_pd(hi, sign)};
+            }
+
+            // Sum of the 4 lanes in every lane
+            Lanes4 sum() const {
+                __m128d s = _mm_add_pd(lo, hi);
+                s = _mm_add_pd(s, _mm_shuffle_pd(s, s, 0x1));
+                return {s, s};
+            }
+            Lanes4 sqrt() const {
+                return {_mm_sqrt_pd(lo), _mm_sqrt_pd(hi)};
+            }
+            Lanes4 rsqrt() const {
+                __m128d one = _mm_set1_pd(1.);
+                return {_mm_div_pd(one, _mm_sqrt_pd(lo)), _mm_div_pd(one, _mm_sqrt_pd(hi))};
+            }
+            double first() const {
+                return _mm_cvtsd_f64(lo);
+            }
+            bool operator==(Lanes4 b) const {
+                return (_mm_movemask_pd(_mm_cmpeq_pd(lo, b.lo)) & _mm_movemask_pd(_mm_cmpeq_pd(hi, b.hi))) == 0x3;
+            }
+        };
+    #endif
+    #endif
+    }
+}
+
+#endif
@@ -3,6 +3,9 @@
 
 #include <cmath>
 #include <iostream>
+#include <type_traits>
+
+#include "../Math/math.h"
 
 namespace linmath {
 
@@ -14,64 +17,84 @@ namespace linmath {
         T y;
 
         // Constructors
-        Vec2() {
+        constexpr Vec2() {
             this->x = 0;
             this->y = 0;
         }
-        Vec2(T x, T y) {
+        constexpr Vec2(T x, T y) {
             this->x = x;
             this->y = y;
         }
 
-        // Directional normalization
-        T length()const {
-            return sqrt(pow(x, 2) + pow(y, 2));
+        // Squared length, the comparisons use it to skip the square root
+        constexpr T lengthSquared()const {
+            return x*x + y*y;
         }
-        void normalize() {
-            T len = length();
-            x = x / len;
-            y = y / len;
+
+        // Directional normalization, Precision::Fast swaps the square root and divisions for an rsqrt estimate
+        template <Precision p = Precision::Exact>
+        constexpr T length()const {
+            T sq = lengthSquared();
+            if constexpr (p == Precision::Fast)
+                return sq > 0 ? sq * math::rsqrt<p>(sq) : 0;
+            else
+                return math::sqrt(sq);
+        }
+        template <Precision p = Precision::Exact>
+        constexpr void normalize() {
+            if constexpr (p == Precision::Fast) {
+                T r = math::rsqrt<p>(lengthSquared());
+                x = x * r;
+                y = y * r;
+            }
+            else {
+                T len = length();
+                x = x / len;
+                y = y / len;
+            }
         }
-        Vec2<T> normalized() {
-            T len = length();
-            return Vec2(x / len, y / len);
+        template <Precision p = Precision::Exact>
+        constexpr Vec2<T> normalized() {
+            Vec2<T> vec = *this;
+            vec.template normalize<p>();
+            return vec;
         }
 
         // Sum of all values
-        T sum()const {
+        constexpr T sum()const {
             return x + y;
         }
 
         // Dot product
-        T dot(const Vec2<T>& vec) {
+        constexpr T dot(const Vec2<T>& vec) {
             return x*vec.x + y*vec.y;
         }
 
         // Negation
-        Vec2<T> operator-() {
+        constexpr Vec2<T> operator-() {
             return Vec2<T>(-x, -y);
         }
 
         // Prefix increment and decrement
-        Vec2<T> operator++() {
+        constexpr Vec2<T> operator++() {
             x++;
             y++;
             return Vec2<T>(x, y);
         }
-        Vec2<T> operator--() {
+        constexpr Vec2<T> operator--() {
             x--;
             y--;
             return Vec2<T>(x, y);
         }
 
         // Postfix increment and decrement
-        Vec2<T> operator++(int) {
+        constexpr Vec2<T> operator++(int) {
             Vec2<T> vec(x, y);
             x++;
             y++;
             return vec;
         }
-        Vec2<T> operator--(int) {
+        constexpr Vec2<T> operator--(int) {
             Vec2<T> vec(x, y);
             x--;
             y--;
@@ -79,94 +102,94 @@ namespace linmath {
         }
 
         // Operations with scalars
-        Vec2<T> operator+(const T t) {
+        constexpr Vec2<T> operator+(const T t) {
             return Vec2<T>(x + t, y + t);
         }
-        Vec2<T> operator-(const T t) {
+        constexpr Vec2<T> operator-(const T t) {
             return Vec2<T>(x - t, y - t);
         }
-        Vec2<T> operator*(const T t) {
+        constexpr Vec2<T> operator*(const T t) {
             return Vec2<T>(x * t, y * t);
         }
-        Vec2<T> operator/(const T t) {
+        constexpr Vec2<T> operator/(const T t) {
             return Vec2<T>(x / t, y / t);
         }
-        Vec2<T> operator%(const T t) {
+        constexpr Vec2<T> operator%(const T t) {
             return Vec2<T>(x % t, y % t);
         }
-        void operator+=(const T t) {
+        constexpr void operator+=(const T t) {
             x += t;
             y += t;
         }
-        void operator-=(const T t) {
+        constexpr void operator-=(const T t) {
             x -= t;
             y -= t;
         }
-        void operator*=(const T t) {
+        constexpr void operator*=(const T t) {
             x *= t;
             y *= t;
         }
-        void operator/=(const T t) {
+        constexpr void operator/=(const T t) {
             x /= t;
             y /= t;
         }
-        void operator%=(const T t) {
+        constexpr void operator%=(const T t) {
             x %= t;
             y %= t;
         }
 
         // Operations with vectors
-        Vec2<T> operator+(const Vec2<T>& vec) {
+        constexpr Vec2<T> operator+(const Vec2<T>& vec) {
             return Vec2<T>(x + vec.x, y + vec.y);
         }
-        Vec2<T> operator-(const Vec2<T>& vec) {
+        constexpr Vec2<T> operator-(const Vec2<T>& vec) {
             return Vec2<T>(x - vec.x, y - vec.y);
         }
-        Vec2<T> operator*(const Vec2<T>& vec) {
+        constexpr Vec2<T> operator*(const Vec2<T>& vec) {
             return Vec2<T>(x * vec.x, y * vec.y);
         }
-        Vec2<T> operator/(const Vec2<T>& vec) {
+        constexpr Vec2<T> operator/(const Vec2<T>& vec) {
             return Vec2<T>(x / vec.x, y / vec.y);
         }
-        void operator+=(const Vec2<T>& vec) {
+        constexpr void operator+=(const Vec2<T>& vec) {
             x += vec.x;
             y += vec.y;
         }
-        void operator-=(const Vec2<T>& vec) {
+        constexpr void operator-=(const Vec2<T>& vec) {
             x -= vec.x;
             y -= vec.y;
         }
-        void operator*=(const Vec2<T>& vec) {
+        constexpr void operator*=(const Vec2<T>& vec) {
             x *= vec.x;
             y *= vec.y;
         }
-        void operator/=(const Vec2<T>& vec) {
+        constexpr void operator/=(const Vec2<T>& vec) {
             x /= vec.x;
             y /= vec.y;
         }
 
         // Comparison between vectors
-        bool operator<(const Vec2<T>& vec) {
-            return length() < vec.length();
+        constexpr bool operator<(const Vec2<T>& vec)const {
+            return lengthSquared() < vec.lengthSquared();
         }
-        bool operator>(const Vec2<T>& vec) {
-            return length() > vec.length();
+        constexpr bool operator>(const Vec2<T>& vec)const {
+            return lengthSquared() > vec.lengthSquared();
         }
-        bool operator<=(const Vec2<T>& vec) {
-            return length() <= vec.length();
+        constexpr bool operator<=(const Vec2<T>& vec)const {
+            return lengthSquared() <= vec.lengthSquared();
         }
-        bool operator>=(const Vec2<T>& vec) {
-            return length() >= vec.length();
+        constexpr bool operator>=(const Vec2<T>& vec)const {
+            return lengthSquared() >= vec.lengthSquared();
         }
-        bool operator==(const Vec2<T>& vec) {
+        constexpr bool operator==(const Vec2<T>& vec)const {
             return (x == vec.x && y == vec.y);
         }
-        bool operator!=(const Vec2<T>& vec) {
+        constexpr bool operator!=(const Vec2<T>& vec)const {
             return (x != vec.x || y != vec.y);
         }
 
         // Array functionality
-        T& operator[](int i) {
+        constexpr T& operator[](int i) {
 
             switch (i) {
             case 0:
@@ -189,49 +212,49 @@ namespace linmath {
         }
 
         // Predefined vectors
-        static Vec2<T> zero();
-        static Vec2<T> onex();
-        static Vec2<T> oney();
-        static Vec2<T> one();
+        static constexpr Vec2<T> zero();
+        static constexpr Vec2<T> onex();
+        static constexpr Vec2<T> oney();
+        static constexpr Vec2<T> one();
     };
 
     // Predefined vectors
     template <typename T>
-    Vec2<T> Vec2<T>::zero() {
+    constexpr Vec2<T> Vec2<T>::zero() {
         return Vec2<T>(0, 0);
     }
     template <typename T>
-    Vec2<T> Vec2<T>::onex() {
+    constexpr Vec2<T> Vec2<T>::onex() {
         return Vec2<T>(1, 0);
     }
     template <typename T>
-    Vec2<T> Vec2<T>::oney() {
+    constexpr Vec2<T> Vec2<T>::oney() {
         return Vec2<T>(0, 1);
     }
     template <typename T>
-    Vec2<T> Vec2<T>::one() {
+    constexpr Vec2<T> Vec2<T>::one() {
         return Vec2<T>(1, 1);
     }
 
     // Overload functions
-    template <typename T, typename K>
-    Vec2<T> operator+(const K k, const Vec2<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec2<T> operator+(const K k, const Vec2<T>& vec) {
         return Vec2<T>(vec.x + k, vec.y + k);
     }
-    template <typename T, typename K>
-    Vec2<T> operator-(const K k, const Vec2<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec2<T> operator-(const K k, const Vec2<T>& vec) {
         return Vec2<T>(vec.x - k, vec.y - k);
     }
-    template <typename T, typename K>
-    Vec2<T> operator*(const K k, const Vec2<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec2<T> operator*(const K k, const Vec2<T>& vec) {
         return Vec2<T>(vec.x * k, vec.y * k);
     }
-    template <typename T, typename K>
-    Vec2<T> operator/(const K k, const Vec2<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec2<T> operator/(const K k, const Vec2<T>& vec) {
         return Vec2<T>(vec.x / k, vec.y / k);
     }
-    template <typename T, typename K>
-    Vec2<T> operator%(const K k, const Vec2<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec2<T> operator%(const K k, const Vec2<T>& vec) {
         return Vec2<T>(vec.x % k, vec.y % k);
     }
 }
@@ -3,6 +3,9 @@
 
 #include <cmath>
 #include <iostream>
+#include <type_traits>
+
+#include "../Math/math.h"
 
 namespace linmath {
 
@@ -15,60 +18,81 @@ namespace linmath {
         T z;
 
         // Constructors
-        Vec3() {
+        constexpr Vec3() {
             this->x = 0;
             this->y = 0;
             this->z = 0;
         }
-        Vec3(T x, T y, T z) {
+        constexpr Vec3(T x, T y, T z) {
             this->x = x;
             this->y = y;
             this->z = z;
         }
 
-        // Directional normalization
-        T length()const {
-            return sqrt(pow(x, 2) + pow(y, 2) + pow(z, 2));
+        // Squared length, the comparisons use it to skip the square root
+        constexpr T lengthSquared()const {
+            return x*x + y*y + z*z;
         }
-        void normalize() {
-            T len = length();
-            x = x / len;
-            y = y / len;
-            z = z / len;
+
+        // Directional normalization, Precision::Fast swaps the square root and divisions for an rsqrt estimate
+        template <Precision p = Precision::Exact>
+        constexpr T length()const {
+            T sq = lengthSquared();
+            if constexpr (p == Precision::Fast)
+                return sq > 0 ? sq * math::rsqrt<p>(sq) : 0;
+            else
+                return math::sqrt(sq);
+        }
+        template <Precision p = Precision::Exact>
+        constexpr void normalize() {
+            if constexpr (p == Precision::Fast) {
+                T r = math::rsqrt<p>(lengthSquared());
+                x = x * r;
+                y = y * r;
+                z = z * r;
+            }
+            else {
+                T len = length();
+                x = x / len;
+                y = y / len;
+                z = z / len;
+            }
         }
-        Vec3<T> normalized() {
-            T len = length();
-            return Vec3(x / len, y / len, z / len);
+        template <Precision p = Precision::Exact>
+        constexpr Vec3<T> normalized() {
+            Vec3<T> vec = *this;
+            vec.template normalize<p>();
+            return vec;
         }
 
         // Sum of all values
-        T sum()const {
+        constexpr T sum()const {
             return x + y + z;
         }
 
         // Dot product
-        T dot(const Vec3<T>& vec) {
+        constexpr T dot(const Vec3<T>& vec) {
             return x*vec.x + y*vec.y + z*vec.z;
         }
 
         // Cross product
-        Vec3<T> cross(const Vec3<T>& vec) {
+        constexpr Vec3<T> cross(const Vec3<T>& vec) {
             return Vec3(y*vec.z - z*vec.y, z*vec.x - x*vec.z, x*vec.y - y*vec.x);
         }
 
         // Negation
-        Vec3<T> operator-() {
+        constexpr Vec3<T> operator-() {
             return Vec3<T>(-x, -y, -z);
         }
 
         // Prefix increment and decrement
-        Vec3<T> operator++() {
+        constexpr Vec3<T> operator++() {
             x++;
             y++;
             z++;
             return Vec3<T>(x, y, z);
         }
-        Vec3<T> operator--() {
+        constexpr Vec3<T> operator--() {
             x--;
             y--;
             z--;
@@ -76,14 +100,14 @@ namespace linmath {
         }
 
         // Postfix increment and decrement
-        Vec3<T> operator++(int) {
+        constexpr Vec3<T> operator++(int) {
             Vec3<T> vec(x, y, z);
             x++;
             y++;
             z++;
             return vec;
         }
-        Vec3<T> operator--(int) {
+        constexpr Vec3<T> operator--(int) {
             Vec3<T> vec(x, y, z);
             x--;
             y--;
@@ -92,103 +116,103 @@ namespace linmath {
         }
 
         // Operations with scalars
-        Vec3<T> operator+(const T t) {
+        constexpr Vec3<T> operator+(const T t) {
             return Vec3<T>(x + t, y + t, z + t);
         }
-        Vec3<T> operator-(const T t) {
+        constexpr Vec3<T> operator-(const T t) {
             return Vec3<T>(x - t, y - t, z - t);
         }
-        Vec3<T> operator*(const T t) {
+        constexpr Vec3<T> operator*(const T t) {
             return Vec3<T>(x * t, y * t, z * t);
         }
-        Vec3<T> operator/(const T t) {
+        constexpr Vec3<T> operator/(const T t) {
             return Vec3<T>(x / t, y / t, z / t);
         }
-        Vec3<T> operator%(const T t) {
+        constexpr Vec3<T> operator%(const T t) {
             return Vec3<T>(x % t, y % t, z % t);
         }
-        void operator+=(const T t) {
+        constexpr void operator+=(const T t) {
             x += t;
             y += t;
             z += t;
         }
-        void operator-=(const T t) {
+        constexpr void operator-=(const T t) {
             x -= t;
             y -= t;
             z -= t;
         }
-        void operator*=(const T t) {
+        constexpr void operator*=(const T t) {
             x *= t;
             y *= t;
             z *= t;
         }
-        void operator/=(const T t) {
+        constexpr void operator/=(const T t) {
             x /= t;
             y /= t;
             z /= t;
         }
-        void operator%=(const T t) {
+        constexpr void operator%=(const T t) {
             x %= t;
             y %= t;
             z %= t;
         }
 
         // Operations with vectors
-        Vec3<T> operator+(const Vec3<T>& vec) {
+        constexpr Vec3<T> operator+(const Vec3<T>& vec) {
             return Vec3<T>(x + vec.x, y + vec.y, z + vec.z);
         }
-        Vec3<T> operator-(const Vec3<T>& vec) {
+        constexpr Vec3<T> operator-(const Vec3<T>& vec) {
             return Vec3<T>(x - vec.x, y - vec.y, z - vec.z);
         }
-        Vec3<T> operator*(const Vec3<T>& vec) {
+        constexpr Vec3<T> operator*(const Vec3<T>& vec) {
             return Vec3<T>(x * vec.x, y * vec.y, z * vec.z);
         }
-        Vec3<T> operator/(const Vec3<T>& vec) {
+        constexpr Vec3<T> operator/(const Vec3<T>& vec) {
             return Vec3<T>(x / vec.x, y / vec.y, z / vec.z);
         }
-        void operator+=(const Vec3<T>& vec) {
+        constexpr void operator+=(const Vec3<T>& vec) {
             x += vec.x;
             y += vec.y;
             z += vec.z;
         }
-        void operator-=(const Vec3<T>& vec) {
+        constexpr void operator-=(const Vec3<T>& vec) {
             x -= vec.x;
             y -= vec.y;
             z -= vec.z;
         }
-        void operator*=(const Vec3<T>& vec) {
+        constexpr void operator*=(const Vec3<T>& vec) {
             x *= vec.x;
             y *= vec.y;
             z *= vec.z;
         }
-        void operator/=(const Vec3<T>& vec) {
+        constexpr void operator/=(const Vec3<T>& vec) {
             x /= vec.x;
             y /= vec.y;
             z /= vec.z;
         }
 
         // Comparison between vectors
-        bool operator<(const Vec3<T>& vec) {
-            return length() < vec.length();
+        constexpr bool operator<(const Vec3<T>& vec)const {
+            return lengthSquared() < vec.lengthSquared();
         }
-        bool operator>(const Vec3<T>& vec) {
-            return length() > vec.length();
+        constexpr bool operator>(const Vec3<T>& vec)const {
+            return lengthSquared() > vec.lengthSquared();
         }
-        bool operator<=(const Vec3<T>& vec) {
-            return length() <= vec.length();
+        constexpr bool operator<=(const Vec3<T>& vec)const {
+            return lengthSquared() <= vec.lengthSquared();
         }
-        bool operator>=(const Vec3<T>& vec) {
-            return length() >= vec.length();
+        constexpr bool operator>=(const Vec3<T>& vec)const {
+            return lengthSquared() >= vec.lengthSquared();
         }
-        bool operator==(const Vec3<T>& vec) {
+        constexpr bool operator==(const Vec3<T>& vec)const {
             return (x == vec.x && y == vec.y && z == vec.z);
         }
-        bool operator!=(const Vec3<T>& vec) {
+        constexpr bool operator!=(const Vec3<T>& vec)const {
             return (x != vec.x || y != vec.y || z != vec.z);
         }
 
         // Array functionality
-        T& operator[](int i) {
+        constexpr T& operator[](int i) {
 
             switch (i) {
             case 0:
@@ -213,54 +237,54 @@ namespace linmath {
         }
 
         // Predefined vectors
-        static Vec3<T> zero();
-        static Vec3<T> onex();
-        static Vec3<T> oney();
-        static Vec3<T> onez();
-        static Vec3<T> one();
+        static constexpr Vec3<T> zero();
+        static constexpr Vec3<T> onex();
+        static constexpr Vec3<T> oney();
+        static constexpr Vec3<T> onez();
+        static constexpr Vec3<T> one();
     };
 
     // Predefined vectors
     template <typename T>
-    Vec3<T> Vec3<T>::zero() {
+    constexpr Vec3<T> Vec3<T>::zero() {
         return Vec3<T>(0, 0, 0);
     }
     template <typename T>
-    Vec3<T> Vec3<T>::onex() {
+    constexpr Vec3<T> Vec3<T>::onex() {
         return Vec3<T>(1, 0, 0);
     }
     template <typename T>
-    Vec3<T> Vec3<T>::oney() {
+    constexpr Vec3<T> Vec3<T>::oney() {
         return Vec3<T>(0, 1, 0);
     }
     template <typename T>
-    Vec3<T> Vec3<T>::onez() {
+    constexpr Vec3<T> Vec3<T>::onez() {
         return Vec3<T>(0, 0, 1);
     }
     template <typename T>
-    Vec3<T> Vec3<T>::one() {
+    constexpr Vec3<T> Vec3<T>::one() {
         return Vec3<T>(1, 1, 1);
     }
 
     // Overload functions
-    template <typename T, typename K>
-    Vec3<T> operator+(const K k, const Vec3<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec3<T> operator+(const K k, const Vec3<T>& vec) {
         return Vec3<T>(vec.x + k, vec.y + k, vec.z + k);
     }
-    template <typename T, typename K>
-    Vec3<T> operator-(const K k, const Vec3<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec3<T> operator-(const K k, const Vec3<T>& vec) {
         return Vec3<T>(vec.x - k, vec.y - k, vec.z - k);
     }
-    template <typename T, typename K>
-    Vec3<T> operator*(const K k, const Vec3<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec3<T> operator*(const K k, const Vec3<T>& vec) {
         return Vec3<T>(vec.x * k, vec.y * k, vec.z * k);
     }
-    template <typename T, typename K>
-    Vec3<T> operator/(const K k, const Vec3<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec3<T> operator/(const K k, const Vec3<T>& vec) {
         return Vec3<T>(vec.x / k, vec.y / k, vec.z / k);
     }
-    template <typename T, typename K>
-    Vec3<T> operator%(const K k, const Vec3<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec3<T> operator%(const K k, const Vec3<T>& vec) {
         return Vec3<T>(vec.x % k, vec.y % k, vec.z % k);
     }
 }
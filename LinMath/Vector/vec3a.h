@@ -0,0 +1,25 @@
+#ifndef VEC3A_H
+#define VEC3A_H
+
+#include "vec3.h"
+#include "../Simd/aligned.h"
+
+namespace linmath {
+
+    // Vec3 padded to 4 values and aligned like a Vec4, so arrays of them never straddle a cache line
+    // and every vector can be read with one aligned load, the padding is kept at 0
+    // It has the whole Vec3 interface, results of the Vec3 operators convert back implicitly
+    template <typename T>
+    class alignas(simd::alignment<T, 4>) Vec3A : public Vec3<T> {
+
+        public:
+        T pad = 0;
+
+        // Constructors
+        constexpr Vec3A() : Vec3<T>() {}
+        constexpr Vec3A(T x, T y, T z) : Vec3<T>(x, y, z) {}
+        constexpr Vec3A(const Vec3<T>& vec) : Vec3<T>(vec) {}
+    };
+}
+
+#endif
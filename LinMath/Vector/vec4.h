@@ -3,11 +3,18 @@
 
 #include <cmath>
 #include <iostream>
+#include <type_traits>
+
+#include "../Math/math.h"
+#include "../Simd/aligned.h"
+#include "../Simd/vec4.h"
 
 namespace linmath {
 
+    // Aligned to its size, so it can be read with aligned loads and never straddles a cache line
+    // The float and double arithmetic runs on the 4 values as one register, see Simd/vec4.h
     template <typename T>
-    class Vec4 {
+    class alignas(simd::alignment<T, 4>) Vec4 {
 
         public:
         T x;
@@ -15,192 +22,235 @@ namespace linmath {
         T z;
         T w;
 
+        protected:
+
+        // The 4 values in registers, float and double members run on them outside constant expressions
+        using Lanes = simd::Lanes4<T>;
+        Lanes lanes()const {
+            return Lanes::load(&x);
+        }
+        Vec4(Lanes lanes) {
+            lanes.store(&x);
+        }
+
+        public:
+
         // Constructors
-        Vec4() {
+        constexpr Vec4() {
             this->x = 0;
             this->y = 0;
             this->z = 0;
             this->w = 0;
         }
-        Vec4(T x, T y, T z, T w) {
+        constexpr Vec4(T x, T y, T z, T w) {
             this->x = x;
             this->y = y;
             this->z = z;
             this->w = w;
         }
 
-        // Directional normalization
-        T length()const {
-            return sqrt(pow(x, 2) + pow(y, 2) + pow(z, 2) + pow(w, 2));
+        // Squared length, the comparisons use it to skip the square root
+        constexpr T lengthSquared()const {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return (lanes()*lanes()).sum().first();
+            return x*x + y*y + z*z + w*w;
         }
-        void normalize() {
+
+        // Directional normalization, Precision::Fast swaps the square root and divisions for an rsqrt estimate
+        template <Precision p = Precision::Exact>
+        constexpr T length()const {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated()) {
+                    Lanes sq = (lanes()*lanes()).sum();
+                    if constexpr (p == Precision::Fast)
+                        return sq.first() > 0 ? (sq * sq.rsqrt()).first() : 0;
+                    else
+                        return sq.sqrt().first();
+                }
+            T sq = lengthSquared();
+            if constexpr (p == Precision::Fast)
+                return sq > 0 ? sq * math::rsqrt<p>(sq) : 0;
+            else
+                return math::sqrt(sq);
+        }
+        template <Precision p = Precision::Exact>
+        constexpr void normalize() {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated()) {
+                    Lanes sq = (lanes()*lanes()).sum();
+                    if constexpr (p == Precision::Fast)
+                        (lanes() * sq.rsqrt()).store(&x);
+                    else
+                        (lanes() / sq.sqrt()).store(&x);
+                    return;
+                }
             T len = length();
             x = x / len;
             y = y / len;
             z = z / len;
             w = w / len;
         }
-        Vec4<T> normalized() {
-            T len = length();
-            return Vec4(x / len, y / len, z / len, w / len);
+        template <Precision p = Precision::Exact>
+        constexpr Vec4<T> normalized() {
+            Vec4<T> vec = *this;
+            vec.template normalize<p>();
+            return vec;
         }
 
         // Sum of all values
-        T sum()const {
+        constexpr T sum()const {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return lanes().sum().first();
             return x + y + z + w;
         }
 
         // Dot product
-        T dot(const Vec4<T>& vec) {
+        constexpr T dot(const Vec4<T>& vec) {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return (lanes()*vec.lanes()).sum().first();
             return x*vec.x + y*vec.y + z*vec.z + w*vec.w;
         }
 
         // Negation
-        Vec4<T> operator-() {
+        constexpr Vec4<T> operator-() {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return Vec4<T>(-lanes());
             return Vec4<T>(-x, -y, -z, -w);
         }
 
         // Prefix increment and decrement
-        Vec4<T> operator++() {
-            x++;
-            y++;
-            z++;
-            w++;
-            return Vec4<T>(x, y, z);
-        }
-        Vec4<T> operator--() {
-            x--;
-            y--;
-            z--;
-            w--;
-            return Vec4<T>(x, y, z);
+        constexpr Vec4<T> operator++() {
+            *this += T(1);
+            return *this;
+        }
+        constexpr Vec4<T> operator--() {
+            *this -= T(1);
+            return *this;
         }
 
         // Postfix increment and decrement
-        Vec4<T> operator++(int) {
-            Vec4<T> vec(x, y, z, w);
-            x++;
-            y++;
-            z++;
-            w++;
+        constexpr Vec4<T> operator++(int) {
+            Vec4<T> vec = *this;
+            *this += T(1);
             return vec;
         }
-        Vec4<T> operator--(int) {
-            Vec4<T> vec(x, y, z, w);
-            x--;
-            y--;
-            z--;
-            w--;
+        constexpr Vec4<T> operator--(int) {
+            Vec4<T> vec = *this;
+            *this -= T(1);
             return vec;
         }
 
         // Operations with scalars
-        Vec4<T> operator+(const T t) {
+        constexpr Vec4<T> operator+(const T t) {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return Vec4<T>(lanes() + Lanes::set(t));
             return Vec4<T>(x + t, y + t, z + t, w + t);
         }
-        Vec4<T> operator-(const T t) {
+        constexpr Vec4<T> operator-(const T t) {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return Vec4<T>(lanes() - Lanes::set(t));
             return Vec4<T>(x - t, y - t, z - t, w - t);
         }
-        Vec4<T> operator*(const T t) {
+        constexpr Vec4<T> operator*(const T t) {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return Vec4<T>(lanes() * Lanes::set(t));
             return Vec4<T>(x * t, y * t, z * t, w * t);
         }
-        Vec4<T> operator/(const T t) {
+        constexpr Vec4<T> operator/(const T t) {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return Vec4<T>(lanes() / Lanes::set(t));
             return Vec4<T>(x / t, y / t, z / t, w / t);
         }
-        Vec4<T> operator%(const T t) {
+        constexpr Vec4<T> operator%(const T t) {
             return Vec4<T>(x % t, y % t, z % t, w % t);
         }
-        Vec4<T> operator+=(const T t) {
-            x += t;
-            y += t;
-            z += t;
-            w += t;
-        }
-        Vec4<T> operator-=(const T t) {
-            x -= t;
-            y -= t;
-            z -= t;
-            w -= t;
-        }
-        Vec4<T> operator*=(const T t) {
-            x *= t;
-            y *= t;
-            z *= t;
-            w *= t;
-        }
-        Vec4<T> operator/=(const T t) {
-            x /= t;
-            y /= t;
-            z /= t;
-            w /= t;
-        }
-        Vec4<T> operator%=(const T t) {
-            x %= t;
-            y %= t;
-            z %= t;
-            w %= t;
+        constexpr void operator+=(const T t) {
+            *this = *this + t;
+        }
+        constexpr void operator-=(const T t) {
+            *this = *this - t;
+        }
+        constexpr void operator*=(const T t) {
+            *this = *this * t;
+        }
+        constexpr void operator/=(const T t) {
+            *this = *this / t;
+        }
+        constexpr void operator%=(const T t) {
+            *this = *this % t;
         }
 
         // Operations with vectors
-        Vec4<T> operator+(const Vec4<T>& vec) {
+        constexpr Vec4<T> operator+(const Vec4<T>& vec) {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return Vec4<T>(lanes() + vec.lanes());
             return Vec4<T>(x + vec.x, y + vec.y, z + vec.z, w + vec.w);
         }
-        Vec4<T> operator-(const Vec4<T>& vec) {
+        constexpr Vec4<T> operator-(const Vec4<T>& vec) {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return Vec4<T>(lanes() - vec.lanes());
             return Vec4<T>(x - vec.x, y - vec.y, z - vec.z, w - vec.w);
         }
-        Vec4<T> operator*(const Vec4<T>& vec) {
+        constexpr Vec4<T> operator*(const Vec4<T>& vec) {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return Vec4<T>(lanes() * vec.lanes());
             return Vec4<T>(x * vec.x, y * vec.y, z * vec.z, w * vec.w);
         }
-        Vec4<T> operator/(const Vec4<T>& vec) {
+        constexpr Vec4<T> operator/(const Vec4<T>& vec) {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return Vec4<T>(lanes() / vec.lanes());
             return Vec4<T>(x / vec.x, y / vec.y, z / vec.z, w / vec.w);
         }
-        void operator+=(const Vec4<T>& vec) {
-            x += vec.x;
-            y += vec.y;
-            z += vec.z;
-            w += vec.w;
-        }
-        void operator-=(const Vec4<T>& vec) {
-            x -= vec.x;
-            y -= vec.y;
-            z -= vec.z;
-            w -= vec.w;
-        }
-        void operator*=(const Vec4<T>& vec) {
-            x *= vec.x;
-            y *= vec.y;
-            z *= vec.z;
-            w *= vec.w;
-        }
-        void operator/=(const Vec4<T>& vec) {
-            x /= vec.x;
-            y /= vec.y;
-            z /= vec.z;
-            w /= vec.w;
+        constexpr void operator+=(const Vec4<T>& vec) {
+            *this = *this + vec;
+        }
+        constexpr void operator-=(const Vec4<T>& vec) {
+            *this = *this - vec;
+        }
+        constexpr void operator*=(const Vec4<T>& vec) {
+            *this = *this * vec;
+        }
+        constexpr void operator/=(const Vec4<T>& vec) {
+            *this = *this / vec;
         }
 
         // Comparison between vectors
-        bool operator<(const Vec4<T>& vec) {
-            return length() < vec.length();
+        constexpr bool operator<(const Vec4<T>& vec)const {
+            return lengthSquared() < vec.lengthSquared();
         }
-        bool operator>(const Vec4<T>& vec) {
-            return length() > vec.length();
+        constexpr bool operator>(const Vec4<T>& vec)const {
+            return lengthSquared() > vec.lengthSquared();
         }
-        bool operator<=(const Vec4<T>& vec) {
-            return length() <= vec.length();
+        constexpr bool operator<=(const Vec4<T>& vec)const {
+            return lengthSquared() <= vec.lengthSquared();
         }
-        bool operator>=(const Vec4<T>& vec) {
-            return length() >= vec.length();
+        constexpr bool operator>=(const Vec4<T>& vec)const {
+            return lengthSquared() >= vec.lengthSquared();
         }
-        bool operator==(const Vec4<T>& vec) {
+        constexpr bool operator==(const Vec4<T>& vec)const {
+            if constexpr (simd::hasLanes4<T>)
+                if (!std::is_constant_evaluated())
+                    return lanes() == vec.lanes();
             return (x == vec.x && y == vec.y && z == vec.z && w == vec.w);
         }
-        bool operator!=(const Vec4<T>& vec) {
-            return (x != vec.x || y != vec.y || z != vec.z || w != vec.w);
+        constexpr bool operator!=(const Vec4<T>& vec)const {
+            return !(*this == vec);
         }
 
         // Array functionality
-        T& operator[](int i) {
+        constexpr T& operator[](int i) {
 
             switch (i) {
             case 0:
@@ -227,59 +277,59 @@ namespace linmath {
         }
 
         // Predefined vectors
-        static Vec4<T> zero();
-        static Vec4<T> onex();
-        static Vec4<T> oney();
-        static Vec4<T> onez();
-        static Vec4<T> onew();
-        static Vec4<T> one();
+        static constexpr Vec4<T> zero();
+        static constexpr Vec4<T> onex();
+        static constexpr Vec4<T> oney();
+        static constexpr Vec4<T> onez();
+        static constexpr Vec4<T> onew();
+        static constexpr Vec4<T> one();
     };
 
     // Predefined vectors
     template <typename T>
-    Vec4<T> Vec4<T>::zero() {
+    constexpr Vec4<T> Vec4<T>::zero() {
         return Vec4<T>(0, 0, 0, 0);
     }
     template <typename T>
-    Vec4<T> Vec4<T>::onex() {
+    constexpr Vec4<T> Vec4<T>::onex() {
         return Vec4<T>(1, 0, 0, 0);
     }
     template <typename T>
-    Vec4<T> Vec4<T>::oney() {
+    constexpr Vec4<T> Vec4<T>::oney() {
         return Vec4<T>(0, 1, 0, 0);
     }
     template <typename T>
-    Vec4<T> Vec4<T>::onez() {
+    constexpr Vec4<T> Vec4<T>::onez() {
         return Vec4<T>(0, 0, 1, 0);
     }
     template <typename T>
-    Vec4<T> Vec4<T>::onew() {
+    constexpr Vec4<T> Vec4<T>::onew() {
         return Vec4<T>(0, 0, 0, 1);
     }
     template <typename T>
-    Vec4<T> Vec4<T>::one() {
+    constexpr Vec4<T> Vec4<T>::one() {
         return Vec4<T>(1, 1, 1, 1);
     }
 
     // Overload functions
-    template <typename T, typename K>
-    Vec4<T> operator+(const K k, const Vec4<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec4<T> operator+(const K k, const Vec4<T>& vec) {
         return Vec4<T>(vec.x + k, vec.y + k, vec.z + k, vec.w + k);
     }
-    template <typename T, typename K>
-    Vec4<T> operator-(const K k, const Vec4<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec4<T> operator-(const K k, const Vec4<T>& vec) {
         return Vec4<T>(vec.x - k, vec.y - k, vec.z - k, vec.w - k);
     }
-    template <typename T, typename K>
-    Vec4<T> operator*(const K k, const Vec4<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec4<T> operator*(const K k, const Vec4<T>& vec) {
         return Vec4<T>(vec.x * k, vec.y * k, vec.z * k, vec.w * k);
     }
-    template <typename T, typename K>
-    Vec4<T> operator/(const K k, const Vec4<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec4<T> operator/(const K k, const Vec4<T>& vec) {
         return Vec4<T>(vec.x / k, vec.y / k, vec.z / k, vec.w / k);
     }
-    template <typename T, typename K>
-    Vec4<T> operator%(const K k, const Vec4<T>& vec) {
+    template <typename T, typename K> requires std::is_arithmetic_v<K>
+    constexpr Vec4<T> operator%(const K k, const Vec4<T>& vec) {
         return Vec4<T>(vec.x % k, vec.y % k, vec.z % k, vec.w % k);
     }
 }
@@ -4,228 +4,255 @@
 #include <cmath>
 #include <iostream>
 
+#include "../Expression/expression.h"
+#include "../Expression/loop.h"
+#include "../Math/math.h"
+
 namespace linmath {
 
+    // Arithmetic operators build lazy expressions from Expression/expression.h, evaluated when assigned
+    // Loops are unrolled or vectorized as LoopPolicy<T, N> from Expression/loop.h chooses
     template <typename T, size_t N>
-    class VecN {
+    class VecN : public Expression<VecN<T, N>> {
 
         protected:
         T values[N];
 
         public:
+        using Value = T;
+        using Shape = VecN<T, N>;
 
         // Constructors
         VecN() {}
         VecN(T t) {
-            for (size_t i=0; i<N; i++)
-                this->values[i] = t;
+            loop::sweep<T, N>([&](auto q, size_t i) {
+                using Q = decltype(q);
+                Q::set(t).store(this->values + i);
+            });
         }
         VecN(T values[N]) {
-            for (size_t i=0; i<N; i++)
-                this->values[i] = values[i];
+            loop::sweep<T, N>([&](auto q, size_t i) {
+                using Q = decltype(q);
+                Q::load(values + i).store(this->values + i);
+            });
         }
 
-        // Variadic constructor
-        template <typename... Ts>
-        VecN(T t, Ts... ts) {
-            auto n = N;
-            *this = VecN(&n, t, ts...);
-        }
-        template <typename... Ts>
-        VecN(auto* n, T t, Ts... ts) : VecN(n, ts...) {
-            *n = *n - 1;
-            this->values[*n] = t;
-        }
-        VecN(auto*){}
+        // Variadic constructor, one value per element
+        template <typename... Ts> requires (sizeof...(Ts) + 1 == N)
+        constexpr VecN(T t, Ts... ts) : values{t, T(ts)...} {}
+
+        // Evaluation of an expression in one pass
+        template <typename E>
+        VecN(const Expression<E>& expr) {
+            *this = expr;
+        }
+        template <typename E>
+        VecN<T, N>& operator=(const Expression<E>& expr) {
+            static_assert(std::is_same_v<typename E::Shape, VecN<T, N>>, "expression has a different shape");
+            const E& e = expr.self();
+            if constexpr (loop::policy<T, N> == Loop::Vectorized)
+                loop::sweep<T, N>([&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    e.template pack<Q>(i).store(values + i);
+                });
+            else
+                loop::each<T, N>([&](size_t i) {
+                    values[i] = e[i];
+                });
+            return *this;
+        }
+
+        // Elements from i on as one pack, see Expression/expression.h
+        template <typename Q>
+        Q pack(size_t i)const {
+            return Q::load(values + i);
+        }
+
+        // Squared length, the comparisons use it to skip the square root
+        T lengthSquared()const {
+            return loop::reduce<T, N>([&](auto acc, size_t i) {
+                using Q = decltype(acc);
+                return fma(Q::load(values + i), Q::load(values + i), acc);
+            });
+        }
 
-        // Directional normalization
+        // Directional normalization, Precision::Fast swaps the square root and divisions for an rsqrt estimate
+        template <Precision p = Precision::Exact>
         T length()const {
-            T len = 0;
-            for (size_t i=0; i<N; i++)
-                len += pow(values[i], 2);
-            return sqrt(len);
+            T sq = lengthSquared();
+            if constexpr (p == Precision::Fast)
+                return sq > 0 ? sq * math::rsqrt<p>(sq) : 0;
+            else
+                return math::sqrt(sq);
         }
+        template <Precision p = Precision::Exact>
         void normalize() {
-            T len = length();
-            for (size_t i=0; i<N; i++)
-                values[i] /= len;
+            if constexpr (p == Precision::Fast) {
+                *this *= math::rsqrt<p>(lengthSquared());
+                return;
+            }
+            *this /= length();
         }
+        template <Precision p = Precision::Exact>
         VecN<T, N> normalized() {
-            T len = length();
-            VecN<T, N> vec = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
-                vec[i] = values[i] / len;
+            VecN<T, N> vec = *this;
+            vec.template normalize<p>();
             return vec;
         }
 
         // Sum of all values
         T sum()const {
-            T sum = 0;
-            for (size_t i=0; i<N; i++)
-                sum += values[i];
-            return sum;
+            return loop::reduce<T, N>([&](auto acc, size_t i) {
+                using Q = decltype(acc);
+                return acc + Q::load(values + i);
+            });
         }
 
         // Dot product
         T dot(const VecN<T, N>& vec) {
-            T dot = 0;
-            for (size_t i=0; i<N; i++)
-                dot += values[i]*vec[i];
-            return dot;
-        }
-
-        // Negation
-        VecN<T, N> operator-() {
-            VecN<T, N> vec = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
-                vec[i] = -values[i];
-            return vec;
+            return loop::reduce<T, N>([&](auto acc, size_t i) {
+                using Q = decltype(acc);
+                return fma(Q::load(values + i), Q::load(vec.values + i), acc);
+            });
         }
 
         // Prefix increment and decrement
         VecN<T, N> operator++() {
             VecN<T, N> vec = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
+            loop::each<T, N>([&](size_t i) {
                 vec[i] = ++values[i];
+            });
             return vec;
         }
         VecN<T, N> operator--() {
             VecN<T, N> vec = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
+            loop::each<T, N>([&](size_t i) {
                 vec[i] = --values[i];
+            });
             return vec;
         }
 
         // Postfix increment and decrement
         VecN<T, N> operator++(int) {
             VecN<T, N> vec = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
+            loop::each<T, N>([&](size_t i) {
                 vec[i] = values[i]++;
+            });
             return vec;
         }
         VecN<T, N> operator--(int) {
             VecN<T, N> vec = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
+            loop::each<T, N>([&](size_t i) {
                 vec[i] = values[i]--;
+            });
             return vec;
         }
 
         // Operations with scalars
-        VecN<T, N> operator+(const T t) {
-            VecN<T, N> vec = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
-                vec[i] = values[i] + t;
-            return vec;
-        }
-        VecN<T, N> operator-(const T t) {
-            VecN<T, N> vec = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
-                vec[i] = values[i] - t;
-            return vec;
-        }
-        VecN<T, N> operator*(const T t) {
-            VecN<T, N> vec = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
-                vec[i] = values[i] * t;
-            return vec;
-        }
-        VecN<T, N> operator/(const T t) {
-            VecN<T, N> vec = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
-                vec[i] = values[i] / t;
-            return vec;
-        }
-        VecN<T, N> operator%(const T t) {
-            VecN<T, N> vec = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
-                vec[i] = values[i] % t;
-            return vec;
-        }
         void operator+=(const T t) {
-            for (size_t i=0; i<N; i++)
-                values[i] += t;
+            loop::sweep<T, N>([&](auto q, size_t i) {
+                using Q = decltype(q);
+                (Q::load(values + i) + Q::set(t)).store(values + i);
+            });
         }
         void operator-=(const T t) {
-            for (size_t i=0; i<N; i++)
-                values[i] -= t;
+            loop::sweep<T, N>([&](auto q, size_t i) {
+                using Q = decltype(q);
+                (Q::load(values + i) - Q::set(t)).store(values + i);
+            });
         }
         void operator*=(const T t) {
-            for (size_t i=0; i<N; i++)
-                values[i] *= t;
+            loop::sweep<T, N>([&](auto q, size_t i) {
+                using Q = decltype(q);
+                (Q::load(values + i) * Q::set(t)).store(values + i);
+            });
         }
         void operator/=(const T t) {
-            for (size_t i=0; i<N; i++)
-                values[i] /= t;
+            loop::sweep<T, N>([&](auto q, size_t i) {
+                using Q = decltype(q);
+                (Q::load(values + i) / Q::set(t)).store(values + i);
+            });
         }
         void operator%=(const T t) {
-            for (size_t i=0; i<N; i++)
+            loop::each<T, N>([&](size_t i) {
                 values[i] %= t;
+            });
         }
 
         // Operations with vectors
-        VecN<T, N> operator+(const VecN<T, N>& vec) {
-            VecN<T, N> out = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
-                out[i] = values[i] + vec[i];
-            return out;
-        }
-        VecN<T, N> operator-(const VecN<T, N>& vec) {
-            VecN<T, N> out = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
-                out[i] = values[i] - vec[i];
-            return out;
-        }
-        VecN<T, N> operator*(const VecN<T, N>& vec) {
-            VecN<T, N> out = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
-                out[i] = values[i] * vec[i];
-            return out;
-        }
-        VecN<T, N> operator/(const VecN<T, N>& vec) {
-            VecN<T, N> out = VecN<T, N>();
-            for (size_t i=0; i<N; i++)
-                out[i] = values[i] / vec[i];
-            return out;
-        }
-        void operator+=(const VecN<T, N>& vec) {
-            for (size_t i=0; i<N; i++)
-                values[i] += vec[i];
-        }
-        void operator-=(const VecN<T, N>& vec) {
-            for (size_t i=0; i<N; i++)
-                values[i] -= vec[i];
-        }
-        void operator*=(const VecN<T, N>& vec) {
-            for (size_t i=0; i<N; i++)
-                values[i] *= vec[i];
-        }
-        void operator/=(const VecN<T, N>& vec) {
-            for (size_t i=0; i<N; i++)
-                values[i] /= vec[i];
+        template <typename E>
+        void operator+=(const Expression<E>& expr) {
+            const E& e = expr.self();
+            if constexpr (loop::policy<T, N> == Loop::Vectorized)
+                loop::sweep<T, N>([&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(values + i) + e.template pack<Q>(i)).store(values + i);
+                });
+            else
+                loop::each<T, N>([&](size_t i) {
+                    values[i] += e[i];
+                });
+        }
+        template <typename E>
+        void operator-=(const Expression<E>& expr) {
+            const E& e = expr.self();
+            if constexpr (loop::policy<T, N> == Loop::Vectorized)
+                loop::sweep<T, N>([&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(values + i) - e.template pack<Q>(i)).store(values + i);
+                });
+            else
+                loop::each<T, N>([&](size_t i) {
+                    values[i] -= e[i];
+                });
+        }
+        template <typename E>
+        void operator*=(const Expression<E>& expr) {
+            const E& e = expr.self();
+            if constexpr (loop::policy<T, N> == Loop::Vectorized)
+                loop::sweep<T, N>([&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(values + i) * e.template pack<Q>(i)).store(values + i);
+                });
+            else
+                loop::each<T, N>([&](size_t i) {
+                    values[i] *= e[i];
+                });
+        }
+        template <typename E>
+        void operator/=(const Expression<E>& expr) {
+            const E& e = expr.self();
+            if constexpr (loop::policy<T, N> == Loop::Vectorized)
+                loop::sweep<T, N>([&](auto q, size_t i) {
+                    using Q = decltype(q);
+                    (Q::load(values + i) / e.template pack<Q>(i)).store(values + i);
+                });
+            else
+                loop::each<T, N>([&](size_t i) {
+                    values[i] /= e[i];
+                });
         }
 
         // Comparison between vectors
-        bool operator<(const VecN<T, N>& vec) {
-            return length() < vec.length();
+        bool operator<(const VecN<T, N>& vec)const {
+            return lengthSquared() < vec.lengthSquared();
         }
-        bool operator>(const VecN<T, N>& vec) {
-            return length() > vec.length();
+        bool operator>(const VecN<T, N>& vec)const {
+            return lengthSquared() > vec.lengthSquared();
         }
-        bool operator<=(const VecN<T, N>& vec) {
-            return length() <= vec.length();
+        bool operator<=(const VecN<T, N>& vec)const {
+            return lengthSquared() <= vec.lengthSquared();
         }
-        bool operator>=(const VecN<T, N>& vec) {
-            return length() >= vec.length();
+        bool operator>=(const VecN<T, N>& vec)const {
+            return lengthSquared() >= vec.lengthSquared();
         }
-        bool operator==(const VecN<T, N>& vec) {
-            for (size_t i=0; i<N; i++)
-                if (values[i] != vec[i]) return false;
-            return true;
+        bool operator==(const VecN<T, N>& vec)const {
+            return loop::all<T, N>([&](size_t i) {
+                return values[i] == vec[i];
+            });
         }
-        bool operator!=(const VecN<T, N>& vec) {
-            for (size_t i=0; i<N; i++)
-                if (values[i] != vec[i]) return true;
-            return false;
+        bool operator!=(const VecN<T, N>& vec)const {
+            return !(*this == vec);
         }
 
         // Array functionality
@@ -269,43 +296,6 @@ namespace linmath {
     VecN<T, N> VecN<T, N>::one() {
         return VecN<T, N>(1);
     }
-
-    // Overload functions
-    template <typename T, typename K, size_t N>
-    VecN<T, N> operator+(const K k, const VecN<T, N>& vec) {
-        VecN<T, N> out = VecN<T, N>();
-        for (size_t i=0; i<N; i++)
-            out[i] = vec[i] + k;
-        return out;
-    }
-    template <typename T, typename K, size_t N>
-    VecN<T, N> operator-(const K k, const VecN<T, N>& vec) {
-        VecN<T, N> out = VecN<T, N>();
-        for (size_t i=0; i<N; i++)
-            out[i]  = vec[i] - k;
-        return out;
-    }
-    template <typename T, typename K, size_t N>
-    VecN<T, N> operator*(const K k, const VecN<T, N>& vec) {
-        VecN<T, N> out = VecN<T, N>();
-        for (size_t i=0; i<N; i++)
-            out[i]  = vec[i] * k;
-        return out;
-    }
-    template <typename T, typename K, size_t N>
-    VecN<T, N> operator/(const K k, const VecN<T, N>& vec) {
-        VecN<T, N> out = VecN<T, N>();
-        for (size_t i=0; i<N; i++)
-            out[i]  = vec[i] / k;
-        return out;
-    }
-    template <typename T, typename K, size_t N>
-    VecN<T, N> operator%(const K k, const VecN<T, N>& vec) {
-        VecN<T, N> out = VecN<T, N>();
-        for (size_t i=0; i<N; i++)
-            out[i]  = vec[i] % k;
-        return out;
-    }
 }
 
 #endif
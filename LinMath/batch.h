@@ -0,0 +1,16 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "Batch/vec3Batch.h"
+#include "Batch/vec4Batch.h"
+#include "Batch/transform.h"
+#include "Batch/mat3Batch.h"
+#include "Batch/mat4Batch.h"
+#include "Batch/transformTree.h"
+#include "Batch/magnitude.h"
+#include "Batch/rotation.h"
+#include "Batch/skinning.h"
+#include "Batch/solve.h"
+#include "Batch/decompose.h"
+
+#endif
@@ -3,12 +3,14 @@
 
 #include "vector.h"
 #include "matrix.h"
+#include "quaternion.h"
+#include "batch.h"
 
 namespace linmath {
 
     // Conversions between vector and matricies
     template<typename T>
-    Mat2<T> vec2matr(const Vec2<T>& vec1, const Vec2<T>& vec2) {
+    constexpr Mat2<T> vec2matr(const Vec2<T>& vec1, const Vec2<T>& vec2) {
         Mat2<T> mat = Mat2<T>();
         mat[0] = vec1.x;
         mat[1] = vec1.y;
@@ -17,7 +19,7 @@ namespace linmath {
         return mat;
     }
     template<typename T>
-    Mat3<T> vec3matr(const Vec3<T>& vec1, const Vec3<T>& vec2, const Vec3<T>& vec3) {
+    constexpr Mat3<T> vec3matr(const Vec3<T>& vec1, const Vec3<T>& vec2, const Vec3<T>& vec3) {
         Mat3<T> mat = Mat3<T>();
         mat[0] = vec1.x;
         mat[1] = vec1.y;
@@ -31,8 +33,8 @@ namespace linmath {
         return mat;
     }
     template<typename T>
-    Mat4<T> vec4matr(const Vec4<T>& vec1, const Vec4<T>& vec2, const Vec4<T>& vec3, const Vec4<T>& vec4) {
-        Mat3<T> mat = Mat3<T>();
+    constexpr Mat4<T> vec4matr(const Vec4<T>& vec1, const Vec4<T>& vec2, const Vec4<T>& vec3, const Vec4<T>& vec4) {
+        Mat4<T> mat = Mat4<T>();
         mat[0] = vec1.x;
         mat[1] = vec1.y;
         mat[2] = vec1.z;
@@ -53,7 +55,7 @@ namespace linmath {
     }
 
     template<typename T>
-    Mat2<T> vec2matc(const Vec2<T>& vec1, const Vec2<T>& vec2) {
+    constexpr Mat2<T> vec2matc(const Vec2<T>& vec1, const Vec2<T>& vec2) {
         Mat2<T> mat = Mat2<T>();
         mat[0] = vec1.x;
         mat[1] = vec2.x;
@@ -62,7 +64,7 @@ namespace linmath {
         return mat;
     }
     template<typename T>
-    Mat3<T> vec3matc(const Vec3<T>& vec1, const Vec3<T>& vec2, const Vec3<T>& vec3) {
+    constexpr Mat3<T> vec3matc(const Vec3<T>& vec1, const Vec3<T>& vec2, const Vec3<T>& vec3) {
         Mat3<T> mat = Mat3<T>();
         mat[0] = vec1.x;
         mat[1] = vec2.x;
@@ -76,8 +78,8 @@ namespace linmath {
         return mat;
     }
     template<typename T>
-    Mat4<T> vec4matc(const Vec4<T>& vec1, const Vec4<T>& vec2, const Vec4<T>& vec3, const Vec4<T>& vec4) {
-        Mat3<T> mat = Mat3<T>();
+    constexpr Mat4<T> vec4matc(const Vec4<T>& vec1, const Vec4<T>& vec2, const Vec4<T>& vec3, const Vec4<T>& vec4) {
+        Mat4<T> mat = Mat4<T>();
         mat[0] = vec1.x;
         mat[1] = vec2.x;
         mat[2] = vec3.x;
@@ -98,86 +100,143 @@ namespace linmath {
     }
 
     template<typename T>
-    Vec2<T> matr2vec(const Mat2<T>& mat, int row) {
+    constexpr Vec2<T> matr2vec(const Mat2<T>& mat, int row) {
         Vec2<T> vec = Vec2<T>();
         for (int col=0; col<2; col++)
-            vec[col] = mat.values[2*row + col];
+            vec[col] = mat[2*row + col];
         return vec;
     }
     template<typename T>
-    Vec3<T> matr3vec(const Mat3<T>& mat, int row) {
+    constexpr Vec3<T> matr3vec(const Mat3<T>& mat, int row) {
         Vec3<T> vec = Vec3<T>();
         for (int col=0; col<3; col++)
-            vec[col] = mat.values[3*row + col];
+            vec[col] = mat[3*row + col];
         return vec;
     }
     template<typename T>
-    Vec4<T> matr4vec(const Mat4<T>& mat, int row) {
+    constexpr Vec4<T> matr4vec(const Mat4<T>& mat, int row) {
         Vec4<T> vec = Vec4<T>();
         for (int col=0; col<4; col++)
-            vec[col] = mat.values[4*row + col];
+            vec[col] = mat[4*row + col];
         return vec;
     }
     
     template<typename T>
-    Vec2<T> matc2vec(const Mat2<T>& mat, int col) {
+    constexpr Vec2<T> matc2vec(const Mat2<T>& mat, int col) {
         Vec2<T> vec = Vec2<T>();
         for (int row=0; row<2; row++)
-            vec[row] = mat.values[2*row + col];
+            vec[row] = mat[2*row + col];
         return vec;
     }
     template<typename T>
-    Vec3<T> matc3vec(const Mat3<T>& mat, int col) {
+    constexpr Vec3<T> matc3vec(const Mat3<T>& mat, int col) {
         Vec3<T> vec = Vec3<T>();
         for (int row=0; row<3; row++)
-            vec[row] = mat.values[3*row + col];
+            vec[row] = mat[3*row + col];
         return vec;
     }
     template<typename T>
-    Vec4<T> matc4vec(const Mat4<T>& mat, int col) {
+    constexpr Vec4<T> matc4vec(const Mat4<T>& mat, int col) {
         Vec4<T> vec = Vec4<T>();
         for (int row=0; row<4; row++)
-            vec[row] = mat.values[4*row + col];
+            vec[row] = mat[4*row + col];
         return vec;
     }
 
     // Vector and matrix multiplication
     template<typename T>
-    Vec2<T> vec2x2mat(const Vec2<T>& vec, const Mat2<T>& mat) {
-        return Vec2<T>( vec.x*mat.values[0] + vec.y*mat.values[2], 
-                        vec.x*mat.values[1] + vec.y*mat.values[3]);
+    constexpr Vec2<T> vec2x2mat(const Vec2<T>& vec, const Mat2<T>& mat) {
+        return Vec2<T>( vec.x*mat[0] + vec.y*mat[2], 
+                        vec.x*mat[1] + vec.y*mat[3]);
+    }
+    template<typename T>
+    constexpr Vec3<T> vec3x3mat(const Vec3<T>& vec, const Mat3<T>& mat) {
+        return Vec3<T>( vec.x*mat[0] + vec.y*mat[3] + vec.z*mat[6], 
+                        vec.x*mat[1] + vec.y*mat[4] + vec.z*mat[7],
+                        vec.x*mat[2] + vec.y*mat[5] + vec.z*mat[8]);
+    }
+    template<typename T>
+    constexpr Vec4<T> vec4x4mat(const Vec4<T>& vec, const Mat4<T>& mat) {
+        return Vec4<T>( vec.x*mat[0] + vec.y*mat[4] + vec.z*mat[8] + vec.w*mat[12], 
+                        vec.x*mat[1] + vec.y*mat[5] + vec.z*mat[9] + vec.w*mat[13],
+                        vec.x*mat[2] + vec.y*mat[6] + vec.z*mat[10] + vec.w*mat[14],
+                        vec.x*mat[3] + vec.y*mat[7] + vec.z*mat[11] + vec.w*mat[15]);
+    }
+
+    constexpr Vec4<float> vec4x4mat(const Vec4<float>& vec, const Mat4<float>& mat) {
+        if (std::is_constant_evaluated())
+            return vec4x4mat<float>(vec, mat);
+        Vec4<float> out = Vec4<float>();
+        simd::vecMat4(&vec.x, &mat[0], &out.x);
+        return out;
+    }
+    constexpr Vec4<double> vec4x4mat(const Vec4<double>& vec, const Mat4<double>& mat) {
+        if (std::is_constant_evaluated())
+            return vec4x4mat<double>(vec, mat);
+        Vec4<double> out = Vec4<double>();
+        simd::vecMat4(&vec.x, &mat[0], &out.x);
+        return out;
+    }
+
+    template<typename T>
+    constexpr Vec2<T> mat2x2vec(const Mat2<T>& mat, const Vec2<T>& vec) {
+        return Vec2<T>( vec.x*mat[0] + vec.y*mat[1], 
+                        vec.x*mat[2] + vec.y*mat[3]);
     }
     template<typename T>
-    Vec3<T> vec3x3mat(const Vec3<T>& vec, const Mat3<T>& mat) {
-        return Vec3<T>( vec.x*mat.values[0] + vec.y*mat.values[3] + vec.z*mat.values[6], 
-                        vec.x*mat.values[1] + vec.y*mat.values[4] + vec.z*mat.values[7],
-                        vec.x*mat.values[2] + vec.y*mat.values[5] + vec.z*mat.values[8]);
+    constexpr Vec3<T> mat3x3vec(const Mat3<T>& mat, const Vec3<T>& vec) {
+        return Vec3<T>( vec.x*mat[0] + vec.y*mat[1] + vec.z*mat[2], 
+                        vec.x*mat[3] + vec.y*mat[4] + vec.z*mat[5],
+                        vec.x*mat[6] + vec.y*mat[7] + vec.z*mat[8]);
     }
     template<typename T>
-    Vec4<T> vec4x4mat(const Vec4<T>& vec, const Mat4<T>& mat) {
-        return Vec4<T>( vec.x*mat.values[0] + vec.y*mat.values[4] + vec.z*mat.values[8] + vec.w*mat.values[12], 
-                        vec.x*mat.values[1] + vec.y*mat.values[5] + vec.z*mat.values[9] + vec.w*mat.values[13],
-                        vec.x*mat.values[2] + vec.y*mat.values[6] + vec.z*mat.values[10] + vec.w*mat.values[14],
-                        vec.x*mat.values[3] + vec.y*mat.values[7] + vec.z*mat.values[11] + vec.w*mat.values[15]);
+    constexpr Vec4<T> mat4x4vec(const Mat4<T>& mat, const Vec4<T>& vec) {
+        return Vec4<T>( vec.x*mat[0] + vec.y*mat[1] + vec.z*mat[2] + vec.w*mat[3], 
+                        vec.x*mat[4] + vec.y*mat[5] + vec.z*mat[6] + vec.w*mat[7],
+                        vec.x*mat[8] + vec.y*mat[9] + vec.z*mat[10] + vec.w*mat[11],
+                        vec.x*mat[12] + vec.y*mat[13] + vec.z*mat[14] + vec.w*mat[15]);
+    }
+    constexpr Vec4<float> mat4x4vec(const Mat4<float>& mat, const Vec4<float>& vec) {
+        if (std::is_constant_evaluated())
+            return mat4x4vec<float>(mat, vec);
+        Vec4<float> out = Vec4<float>();
+        simd::mat4Vec(&mat[0], &vec.x, &out.x);
+        return out;
+    }
+    constexpr Vec4<double> mat4x4vec(const Mat4<double>& mat, const Vec4<double>& vec) {
+        if (std::is_constant_evaluated())
+            return mat4x4vec<double>(mat, vec);
+        Vec4<double> out = Vec4<double>();
+        simd::mat4Vec(&mat[0], &vec.x, &out.x);
+        return out;
     }
 
+    // Linear systems, the x that mat3x3vec(a, x) and the other sizes turn into b
+    // Found by LU factorization with partial pivoting instead of the inverse, a singular a gives infinities or NaN
+    // To solve many systems with one matrix factorize it once with a.lu()
     template<typename T>
-    Vec2<T> mat2x2vec(const Mat2<T>& mat, const Vec2<T>& vec) {
-        return Vec2<T>( vec.x*mat.values[0] + vec.y*mat.values[1], 
-                        vec.x*mat.values[2] + vec.y*mat.values[3]);
+    constexpr Vec2<T> solve(const Mat2<T>& a, const Vec2<T>& b) {
+        T x[2] = {b.x, b.y};
+        a.lu().solve(x, x);
+        return Vec2<T>(x[0], x[1]);
     }
     template<typename T>
-    Vec3<T> mat3x3vec(const Mat3<T>& mat, const Vec3<T>& vec) {
-        return Vec3<T>( vec.x*mat.values[0] + vec.y*mat.values[1] + vec.z*mat.values[2], 
-                        vec.x*mat.values[3] + vec.y*mat.values[4] + vec.z*mat.values[5],
-                        vec.x*mat.values[6] + vec.y*mat.values[7] + vec.z*mat.values[8]);
+    constexpr Vec3<T> solve(const Mat3<T>& a, const Vec3<T>& b) {
+        T x[3] = {b.x, b.y, b.z};
+        a.lu().solve(x, x);
+        return Vec3<T>(x[0], x[1], x[2]);
     }
     template<typename T>
-    Vec4<T> mat4x4vec(const Mat4<T>& mat, const Vec4<T>& vec) {
-        return Vec4<T>( vec.x*mat.values[0] + vec.y*mat.values[1] + vec.z*mat.values[2] + vec.w*mat.values[3], 
-                        vec.x*mat.values[4] + vec.y*mat.values[5] + vec.z*mat.values[6] + vec.w*mat.values[7],
-                        vec.x*mat.values[8] + vec.y*mat.values[9] + vec.z*mat.values[10] + vec.w*mat.values[11],
-                        vec.x*mat.values[12] + vec.y*mat.values[13] + vec.z*mat.values[14] + vec.w*mat.values[15]);
+    constexpr Vec4<T> solve(const Mat4<T>& a, const Vec4<T>& b) {
+        T x[4] = {b.x, b.y, b.z, b.w};
+        a.lu().solve(x, x);
+        return Vec4<T>(x[0], x[1], x[2], x[3]);
+    }
+    template<typename T, size_t N>
+    VecN<T, N> solve(const MatN<T, N>& a, const VecN<T, N>& b) {
+        VecN<T, N> x = b;
+        a.lu().solve(&x[0], &x[0]);
+        return x;
     }
 }
 
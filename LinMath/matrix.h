@@ -4,7 +4,12 @@
 #include "Matrix/mat2.h"
 #include "Matrix/mat3.h"
 #include "Matrix/mat4.h"
+#include "Matrix/affine3.h"
+#include "Matrix/matNM.h"
 #include "Matrix/matN.h"
+#include "Matrix/matX.h"
+#include "Matrix/sparse.h"
+#include "Matrix/rotationCache.h"
 
 namespace linmath {
 
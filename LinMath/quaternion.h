@@ -0,0 +1,7 @@
+#ifndef QUATERNION_H
+#define QUATERNION_H
+
+#include "Quaternion/quat.h"
+#include "Quaternion/dualQuat.h"
+
+#endif
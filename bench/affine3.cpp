@@ -0,0 +1,88 @@
+// Affine3 products against Mat4::dot and the product routed through Mat4 and back, and the dispatched affineDot kernel
+// against the sse4.2 one the avx2 and avx512 tiers used to share, both called in place
+// Independent products over arrays time throughput, a chain where each product is the next left operand times latency
+// g++ -std=c++20 -O2 -march=native -I LinMath bench/affine3.cpp -o affine3 -lpthread && ./affine3
+// LINMATH_ISA=scalar, sse4.2, avx2 or avx512 picks the tier
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+// Best of several runs of f, in seconds
+template <typename F>
+double best(F f, int runs = 7) {
+    double fastest = 1e9;
+    for (int r=0; r<runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+// ns per product of f(c, a, b), c = a * b, over independent products and over a chain of them
+template <typename M, typename F>
+void time(const char* name, std::vector<M>& a, std::vector<M>& b, F f) {
+    const size_t n = a.size(), rounds = 2000;
+    std::vector<M> c(n);
+    double throughput = best([&] {
+        for (size_t r=0; r<rounds; r++)
+            for (size_t i=0; i<n; i++)
+                f(c[i], a[i], b[(i + r)%n]);
+    });
+    M chain = a[0];
+    double latency = best([&] {
+        for (size_t r=0; r<rounds; r++)
+            for (size_t i=0; i<n; i++)
+                f(chain, chain, b[i]);
+    });
+    double products = double(n*rounds);
+    std::printf("  %-22s independent %6.2f ns  chained %6.2f ns  (%g)\n", name, throughput/products*1e9,
+        latency/products*1e9, double(c[n/2][0] + chain[0]));
+}
+
+template <typename T>
+void run() {
+    // Rotations with translations keep the chained products bounded
+    const size_t n = 1024;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> angle(-3, 3), offset(-1, 1);
+    std::vector<Affine3<T>> a(n), b(n);
+    std::vector<Mat4<T>> a4(n), b4(n);
+    for (size_t i=0; i<n; i++) {
+        a4[i] = Mat4<T>::rotationX(angle(rng)).dot(Mat4<T>::rotationY(angle(rng))).dot(Mat4<T>::translation(offset(rng), offset(rng), offset(rng)));
+        b4[i] = Mat4<T>::rotationZ(angle(rng)).dot(Mat4<T>::translation(offset(rng), offset(rng), offset(rng)));
+        a[i] = Affine3<T>(a4[i]);
+        b[i] = Affine3<T>(b4[i]);
+    }
+
+    std::printf("%s\n", sizeof(T) == 4 ? "float" : "double");
+    time<Mat4<T>>("Mat4::dot", a4, b4, [](Mat4<T>& c, Mat4<T>& x, Mat4<T>& y) {
+        c = x.dot(y);
+    });
+    time<Affine3<T>>("Affine3::dot", a, b, [](Affine3<T>& c, Affine3<T>& x, Affine3<T>& y) {
+        c = x.dot(y);
+    });
+    time<Affine3<T>>("simd::affineDot", a, b, [](Affine3<T>& c, Affine3<T>& x, Affine3<T>& y) {
+        simd::affineDot(&x[0], &y[0], &c[0]);
+    });
+#if LINMATH_X86
+    time<Affine3<T>>("sse4.2 affineDot", a, b, [](Affine3<T>& c, Affine3<T>& x, Affine3<T>& y) {
+        simd::sse42::affineDot(&x[0], &y[0], &c[0]);
+    });
+#endif
+    time<Affine3<T>>("through Mat4::dot", a, b, [](Affine3<T>& c, Affine3<T>& x, Affine3<T>& y) {
+        c = Affine3<T>(Mat4<T>(x).dot(Mat4<T>(y)));
+    });
+}
+
+int main() {
+    run<float>();
+    run<double>();
+}
@@ -0,0 +1,96 @@
+// Variadic construction of Mat3, Mat4 and VecN, the pack expansion initializers against the recursive constructors they replaced
+// The recursion matters in debug and sanitizer builds, so run it at each level:
+// for o in 0 1 2; do g++ -std=c++20 -O$o -I LinMath bench/construction.cpp -o construction -lpthread && ./construction; done
+// Compile time of one construction with N values, each generated TU includes this file and builds one vector:
+// for n in 16 64 256; do for t in none linmath before; do
+//     { echo '#define CONSTRUCTION_ONLY'; echo '#include "bench/construction.cpp"';
+//       [ $t != none ] && echo "auto v = $t::VecN<float, $n>($(seq -s, $n));"; } > /tmp/construction$n$t.cpp
+//     TIMEFORMAT="$t N=$n %Rs"; time g++ -std=c++20 -O0 -c -I . -I LinMath /tmp/construction$n$t.cpp -o /dev/null
+// done; done
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+#include "linmath.h"
+
+namespace before {
+
+    // The recursive form, one constructor frame per value and a copy of the finished vector into *this
+    template <typename T, size_t N>
+    class VecN {
+
+        protected:
+        T values[N];
+
+        public:
+        template <typename... Ts>
+        VecN(T t, Ts... ts) {
+            auto n = N;
+            *this = VecN(&n, t, ts...);
+        }
+        template <typename... Ts>
+        VecN(auto* n, T t, Ts... ts) : VecN(n, ts...) {
+            *n = *n - 1;
+            this->values[*n] = t;
+        }
+        VecN(auto*){}
+
+        T& operator[](size_t i) {
+            return values[i];
+        }
+    };
+}
+
+#ifndef CONSTRUCTION_ONLY
+
+using namespace linmath;
+
+// Best of several runs of f, in seconds
+template <typename F>
+double best(F f, int runs = 7) {
+    double fastest = 1e9;
+    for (int r=0; r<runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+// V built from the N values x, x + 1, ...
+template <typename V, size_t... I>
+V make(float x, std::index_sequence<I...>) {
+    return V((x + float(I))...);
+}
+
+// ns per construction of V and of the recursive form with as many values
+template <typename V, size_t N>
+void run(const char* name) {
+    const size_t rounds = 2000000 / N;
+    float sink = 0;
+    double now = best([&] {
+        for (size_t k=0; k<rounds; k++) {
+            V v = make<V>(float(k), std::make_index_sequence<N>());
+            sink += v[k%N];
+        }
+    });
+    double recursive = best([&] {
+        for (size_t k=0; k<rounds; k++) {
+            before::VecN<float, N> v = make<before::VecN<float, N>>(float(k), std::make_index_sequence<N>());
+            sink += v[k%N];
+        }
+    });
+    std::printf("%-16s pack expansion %8.1f ns  recursive %8.1f ns  %.2fx  (%g)\n", name,
+        now/rounds*1e9, recursive/rounds*1e9, recursive/now, double(sink));
+}
+
+int main() {
+    run<Mat3<float>, 9>("Mat3<float>");
+    run<Mat4<float>, 16>("Mat4<float>");
+    run<VecN<float, 8>, 8>("VecN<float, 8>");
+    run<VecN<float, 64>, 64>("VecN<float, 64>");
+}
+
+#endif
@@ -0,0 +1,67 @@
+// VecN arithmetic r = a*s + b*t - c evaluated eagerly, one temporary per operator as before the expression templates,
+// against the fused expression that makes one pass over the elements
+// g++ -std=c++20 -O2 -march=native -I LinMath bench/expression.cpp -o expression -lpthread && ./expression
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+// Best of several runs of f, in seconds
+template <typename F>
+double best(F f, int runs = 7) {
+    double fastest = 1e9;
+    for (int r=0; r<runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+template <typename T, size_t N>
+void run() {
+    // The scalars change every round so neither version can be hoisted out of the loop
+    const size_t rounds = 4000000 / N;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> uniform(-1, 1);
+    static VecN<T, N> a, b, c, r;
+    for (size_t i=0; i<N; i++) {
+        a[i] = uniform(rng);
+        b[i] = uniform(rng);
+        c[i] = uniform(rng);
+    }
+
+    T sink = 0;
+    double eager = best([&] {
+        for (size_t k=0; k<rounds; k++) {
+            T s = T(1) + T(k & 7), t = T(2) - T(k & 3);
+            VecN<T, N> as = a*s;
+            VecN<T, N> bt = b*t;
+            VecN<T, N> sum = as + bt;
+            r = sum - c;
+            sink += r[k%N];
+        }
+    });
+    double fused = best([&] {
+        for (size_t k=0; k<rounds; k++) {
+            T s = T(1) + T(k & 7), t = T(2) - T(k & 3);
+            r = a*s + b*t - c;
+            sink += r[k%N];
+        }
+    });
+
+    std::printf("%-6s N=%-5zu eager %8.1f ns  fused %8.1f ns  %.2fx  (%g)\n", sizeof(T) == 4 ? "float" : "double", N,
+        eager/rounds*1e9, fused/rounds*1e9, eager/fused, double(sink));
+}
+
+int main() {
+    run<float, 256>();
+    run<float, 4096>();
+    run<double, 256>();
+    run<double, 4096>();
+}
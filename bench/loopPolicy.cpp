@@ -0,0 +1,89 @@
+// VecN<float, N> loops under each LoopPolicy, ns per call of r = a*b + r, dot and lengthSquared for N in {3, 8, 16, 64, 256, 4096}
+// The policy is forced for every size by specializing LoopPolicy before anything uses it, so each policy is its own build:
+// for p in Unrolled Vectorized Plain; do g++ -std=c++20 -O2 -march=native -DLOOP=$p -I LinMath bench/loopPolicy.cpp -o loop$p -lpthread && ./loop$p; done
+// Without LOOP the library's own choice runs, the Unrolled build takes a couple of minutes for the 4096 wide folds
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#include "Expression/loop.h"
+
+#define LINMATH_NAME(x) #x
+#define LINMATH_STRING(x) LINMATH_NAME(x)
+
+#ifdef LOOP
+template <size_t N>
+struct linmath::LoopPolicy<float, N> {
+    static constexpr Loop loop = Loop::LOOP;
+};
+const char* policy = LINMATH_STRING(LOOP);
+#else
+const char* policy = "default";
+#endif
+
+#include "linmath.h"
+
+using namespace linmath;
+
+// Best of several runs of f, in seconds
+template <typename F>
+double best(F f, int runs = 7) {
+    double fastest = 1e9;
+    for (int r=0; r<runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+template <size_t N>
+void run() {
+    // Calls rotate over count vectors so they are independent of each other and the inputs stay in L2
+    constexpr size_t count = std::bit_floor(16384 / N);
+    const size_t rounds = 40000000 / (N + 16);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> uniform(-1, 1);
+    static VecN<float, N> a[count], b[count], r[count];
+    for (size_t j=0; j<count; j++)
+        for (size_t i=0; i<N; i++) {
+            a[j][i] = uniform(rng);
+            b[j][i] = uniform(rng)*1e-6f;
+            r[j][i] = 0;
+        }
+
+    double update = best([&] {
+        for (size_t k=0; k<rounds; k++) {
+            size_t j = k & (count - 1);
+            r[j] = a[j]*b[j] + r[j];
+        }
+    });
+    float sink = 0;
+    double dot = best([&] {
+        for (size_t k=0; k<rounds; k++) {
+            size_t j = k & (count - 1);
+            sink += a[j].dot(r[j]);
+        }
+    });
+    double squared = best([&] {
+        for (size_t k=0; k<rounds; k++) {
+            size_t j = k & (count - 1);
+            sink += r[j].lengthSquared();
+        }
+    });
+
+    std::printf("%-10s N=%-5zu a*b + r %8.1f ns  dot %8.1f ns  lengthSquared %8.1f ns  (%g)\n", policy, N,
+        update/rounds*1e9, dot/rounds*1e9, squared/rounds*1e9, double(sink));
+}
+
+int main() {
+    run<3>();
+    run<8>();
+    run<16>();
+    run<64>();
+    run<256>();
+    run<4096>();
+}
@@ -0,0 +1,64 @@
+// Batched Mat4 products, matricies per second of the lane interleaved Mat4Batch and of the array dot
+// against Mat4::dot called in a loop
+// g++ -std=c++20 -O2 -march=native -I LinMath bench/mat4Batch.cpp -o mat4Batch -lpthread && ./mat4Batch [matricies]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "linmath.h"
+#include "batch.h"
+
+using namespace linmath;
+
+// Best of several runs of f, in seconds
+template <typename F>
+double best(F f, int runs = 7) {
+    double fastest = 1e9;
+    for (int r=0; r<runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+template <typename T>
+void run(size_t n) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> uniform(-1, 1);
+    std::vector<Mat4<T>> parents(n), locals(n), worlds(n);
+    for (size_t i=0; i<n; i++)
+        for (size_t k=0; k<16; k++) {
+            parents[i][k] = uniform(rng);
+            locals[i][k] = uniform(rng);
+        }
+    Mat4Batch<T> parentBatch(parents.data(), n), localBatch(locals.data(), n), worldBatch(n);
+
+    double loop = best([&] {
+        for (size_t i=0; i<n; i++)
+            worlds[i] = parents[i].dot(locals[i]);
+    });
+    double array = best([&] {
+        dot(parents.data(), locals.data(), worlds.data(), n);
+    });
+    double batch = best([&] {
+        parentBatch.dot(localBatch, worldBatch);
+    });
+    double pool = best([&] {
+        parentBatch.dot(localBatch, worldBatch, ThreadPool::global());
+    });
+
+    std::printf("%-6s %zu matricies  loop %6.1f M/s  array %6.1f M/s  interleaved %6.1f M/s  pool %6.1f M/s  (%g)\n",
+        sizeof(T) == 4 ? "float" : "double", n, n/loop/1e6, n/array/1e6, n/batch/1e6, n/pool/1e6,
+        double(worlds[n/2][0] + worldBatch[n/2][0]));
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    run<float>(n);
+    run<double>(n);
+}
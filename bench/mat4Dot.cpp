@@ -0,0 +1,62 @@
+// Mat4 products one at a time, the dispatched kernel behind Mat4::dot against the scalar loop it replaced
+// g++ -std=c++20 -O2 -march=native -I LinMath bench/mat4Dot.cpp -o mat4Dot -lpthread && ./mat4Dot
+// LINMATH_ISA=scalar, sse4.2, avx2 or avx512 picks the tier
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+// Best of several runs of f, in seconds
+template <typename F>
+double best(F f, int runs = 7) {
+    double fastest = 1e9;
+    for (int r=0; r<runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+template <typename T>
+void run() {
+    // A few thousand matricies stay in cache, so the products and not the loads are timed
+    const size_t n = 1024, rounds = 2000;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> uniform(-1, 1);
+    std::vector<Mat4<T>> a(n), b(n), c(n);
+    for (size_t i=0; i<n; i++)
+        for (size_t k=0; k<16; k++) {
+            a[i][k] = uniform(rng);
+            b[i][k] = uniform(rng);
+        }
+
+    double scalar = best([&] {
+        for (size_t r=0; r<rounds; r++)
+            for (size_t i=0; i<n; i++)
+                simd::scalar::mat4Dot(&a[i][0], &b[(i + r)%n][0], &c[i][0]);
+    });
+    double dot = best([&] {
+        for (size_t r=0; r<rounds; r++)
+            for (size_t i=0; i<n; i++)
+                c[i] = a[i].dot(b[(i + r)%n]);
+    });
+
+    T sink = 0;
+    for (const Mat4<T>& m : c)
+        sink += m[12];
+    double products = double(n*rounds);
+    std::printf("%-6s scalar %7.1f M/s  Mat4::dot %7.1f M/s  %.2fx  (%g)\n", sizeof(T) == 4 ? "float" : "double",
+        products/scalar/1e6, products/dot/1e6, scalar/dot, double(sink));
+}
+
+int main() {
+    run<float>();
+    run<double>();
+}
@@ -0,0 +1,54 @@
+// MatX<float> products of 2048x2048 matricies, GFLOP/s per thread count of the pool the product runs on
+// g++ -std=c++20 -O2 -march=native -I LinMath bench/matX.cpp -o matX -lpthread && ./matX [size] [threads]
+// Thread counts double from 1 up to the hardware thread count, or the given one
+// LINMATH_ISA=scalar, sse4.2, avx2 or avx512 picks the tier
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+// Best of several runs of f, in seconds
+template <typename F>
+double best(F f, int runs = 3) {
+    double fastest = 1e9;
+    for (int r=0; r<runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2048;
+    size_t most = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> uniform(-1, 1);
+    MatX<float> a(n, n), b(n, n);
+    for (size_t i=0; i<n*n; i++) {
+        a[i] = uniform(rng);
+        b[i] = uniform(rng);
+    }
+
+    double flops = 2.0*double(n)*double(n)*double(n);
+    double single = 0;
+    for (size_t threads=1; threads<=most; threads = threads*2 > most && threads < most ? most : threads*2) {
+        ThreadPool pool(threads);
+        MatX<float> c;
+        double seconds = best([&] {
+            c = a.dot(b, pool);
+        });
+        if (threads == 1)
+            single = seconds;
+        std::printf("%zu^3  %3zu threads  %7.1f GFLOP/s  %6.1f GFLOP/s per thread  %5.2fx  (%g)\n", n, threads,
+            flops/seconds/1e9, flops/seconds/1e9/threads, single/seconds, double(c[n*n/2]));
+    }
+}
@@ -0,0 +1,154 @@
+// Precision::Fast against Exact for length and normalize of Vec3, Vec4, VecN<T, 16> and Vec3Batch
+// Reports the largest error relative to the long double result and ns per vector over a few thousand random vectors
+// Normalize errors are the largest component error, relative to the unit length of the result
+// g++ -std=c++20 -O2 -march=native -I LinMath bench/precision.cpp -o precision -lpthread && ./precision
+// LINMATH_ISA=scalar, sse4.2, avx2 or avx512 picks the tier of Vec3Batch
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+// Best of several runs of f, in seconds
+template <typename F>
+double best(F f, int runs = 7) {
+    double fastest = 1e9;
+    for (int r=0; r<runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+const size_t count = 4096, rounds = 200;
+
+// Random vectors with lengths spread over several orders of magnitude
+template <typename T, typename V, size_t D>
+std::vector<V> vectors() {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> uniform(-1, 1), exponent(-8, 8);
+    std::vector<V> vecs(count);
+    for (V& vec : vecs) {
+        double scale = std::exp2(exponent(rng));
+        for (size_t c=0; c<D; c++)
+            vec[c] = T(uniform(rng)*scale);
+    }
+    return vecs;
+}
+
+template <typename V, size_t D>
+long double exactLength(V vec) {
+    long double sq = 0;
+    for (size_t c=0; c<D; c++)
+        sq += (long double)vec[c]*vec[c];
+    return std::sqrt(sq);
+}
+
+// Largest relative error of len[i] and of the components of unit[i] against vecs[i]
+template <typename V, size_t D, typename L, typename U>
+void errors(std::vector<V>& vecs, L len, U unit, double& lengthError, double& normalizeError) {
+    lengthError = normalizeError = 0;
+    for (size_t i=0; i<vecs.size(); i++) {
+        long double exact = exactLength<V, D>(vecs[i]);
+        lengthError = std::max(lengthError, double(std::abs(len(i) - exact) / exact));
+        for (size_t c=0; c<D; c++)
+            normalizeError = std::max(normalizeError, double(std::abs(unit(i, c) - vecs[i][c] / exact)));
+    }
+}
+
+void report(const char* name, double exactError[2], double fastError[2], double exactTime[2], double fastTime[2]) {
+    const char* ops[2] = {"length", "normalize"};
+    for (int k=0; k<2; k++)
+        std::printf("%-16s %-9s exact %.2e %6.2f ns  fast %.2e %6.2f ns  %.2fx\n", name, ops[k], exactError[k],
+            exactTime[k]/(count*rounds)*1e9, fastError[k], fastTime[k]/(count*rounds)*1e9, exactTime[k]/fastTime[k]);
+}
+
+// Vec3, Vec4 and VecN one vector at a time
+template <typename T, typename V, size_t D, Precision p>
+void single(double error[2], double time[2]) {
+    std::vector<V> vecs = vectors<T, V, D>(), out(count);
+    std::vector<T> len(count);
+    for (size_t i=0; i<count; i++) {
+        len[i] = vecs[i].template length<p>();
+        out[i] = vecs[i].template normalized<p>();
+    }
+    errors<V, D>(vecs, [&](size_t i) { return (long double)len[i]; },
+        [&](size_t i, size_t c) { return (long double)out[i][c]; }, error[0], error[1]);
+
+    T sink = 0;
+    time[0] = best([&] {
+        for (size_t r=0; r<rounds; r++)
+            for (size_t i=0; i<count; i++)
+                len[i] = vecs[i].template length<p>();
+        sink += len[rounds%count];
+    });
+    time[1] = best([&] {
+        for (size_t r=0; r<rounds; r++)
+            for (size_t i=0; i<count; i++)
+                out[i] = vecs[i].template normalized<p>();
+        sink += out[rounds%count][0];
+    });
+    if (sink == 12345)
+        std::printf("\n");
+}
+
+// Vec3Batch, the dispatched kernels over the whole batch
+template <typename T, Precision p>
+void batch(double error[2], double time[2]) {
+    std::vector<Vec3<T>> vecs = vectors<T, Vec3<T>, 3>();
+    Vec3Batch<T> in(vecs);
+    std::vector<T> len = in.template length<p>();
+    Vec3Batch<T> out = in.template normalized<p>();
+    errors<Vec3<T>, 3>(vecs, [&](size_t i) { return (long double)len[i]; },
+        [&](size_t i, size_t c) { return (long double)out[i][c]; }, error[0], error[1]);
+
+    time[0] = best([&] {
+        for (size_t r=0; r<rounds; r++)
+            len = in.template length<p>();
+    });
+    time[1] = best([&] {
+        for (size_t r=0; r<rounds; r++) {
+            out = in;
+            out.template normalize<p>();
+        }
+    });
+}
+
+template <typename T>
+void run() {
+    const char* type = sizeof(T) == 4 ? "float" : "double";
+    char name[32];
+    double exactError[2], fastError[2], exactTime[2], fastTime[2];
+
+    single<T, Vec3<T>, 3, Precision::Exact>(exactError, exactTime);
+    single<T, Vec3<T>, 3, Precision::Fast>(fastError, fastTime);
+    std::snprintf(name, sizeof(name), "Vec3<%s>", type);
+    report(name, exactError, fastError, exactTime, fastTime);
+
+    single<T, Vec4<T>, 4, Precision::Exact>(exactError, exactTime);
+    single<T, Vec4<T>, 4, Precision::Fast>(fastError, fastTime);
+    std::snprintf(name, sizeof(name), "Vec4<%s>", type);
+    report(name, exactError, fastError, exactTime, fastTime);
+
+    single<T, VecN<T, 16>, 16, Precision::Exact>(exactError, exactTime);
+    single<T, VecN<T, 16>, 16, Precision::Fast>(fastError, fastTime);
+    std::snprintf(name, sizeof(name), "VecN<%s, 16>", type);
+    report(name, exactError, fastError, exactTime, fastTime);
+
+    batch<T, Precision::Exact>(exactError, exactTime);
+    batch<T, Precision::Fast>(fastError, fastTime);
+    std::snprintf(name, sizeof(name), "Vec3Batch<%s>", type);
+    report(name, exactError, fastError, exactTime, fastTime);
+}
+
+int main() {
+    run<float>();
+    run<double>();
+}
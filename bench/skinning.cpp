@@ -0,0 +1,82 @@
+// Linear blend and dual quaternion skinning of the positions of a 100k vertex mesh with 4 influences per vertex,
+// against the per vertex loop of weighted Mat4 sums and mat4x4vec it replaces
+// g++ -std=c++20 -O2 -march=native -I LinMath bench/skinning.cpp -o skinning -lpthread && ./skinning
+// LINMATH_ISA=scalar, sse4.2, avx2 or avx512 picks the tier
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "linmath.h"
+#include "batch.h"
+
+using namespace linmath;
+
+// Best of several runs of f, in seconds
+template <typename F>
+double best(F f, int runs = 7) {
+    double fastest = 1e9;
+    for (int r=0; r<runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+template <typename T>
+void run() {
+    const size_t n = 100000, bones = 64, influences = 4;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> uniform(-1, 1);
+
+    std::vector<DualQuat<T>> dualQuats(bones);
+    std::vector<Mat4<T>> palette(bones);
+    for (size_t b=0; b<bones; b++) {
+        dualQuats[b] = DualQuat<T>(Quat<T>(uniform(rng), uniform(rng), uniform(rng), uniform(rng)).normalized(), Vec3<T>(uniform(rng), uniform(rng), uniform(rng)));
+        palette[b] = dualQuats[b].mat4().transpozed();
+    }
+
+    SkinWeights<T> weights(n, influences);
+    Vec3Batch<T> positions(n), outPositions;
+    std::vector<Vec4<T>> points(n), skinned(n);
+    for (size_t i=0; i<n; i++) {
+        positions.set(i, Vec3<T>(uniform(rng), uniform(rng), uniform(rng)));
+        Vec3<T> p = positions[i];
+        points[i] = Vec4<T>(p.x, p.y, p.z, T(1));
+        for (size_t j=0; j<influences; j++)
+            weights.set(i, j, int32_t(rng()%bones), T(1)/T(influences));
+    }
+
+    double loop = best([&] {
+        for (size_t i=0; i<n; i++) {
+            Mat4<T> blend = palette[weights.bones(0)[i]]*weights.weights(0)[i];
+            for (size_t j=1; j<influences; j++)
+                blend = blend + palette[weights.bones(j)[i]]*weights.weights(j)[i];
+            skinned[i] = mat4x4vec(blend, points[i]);
+        }
+    });
+    double linear = best([&] {
+        skinLinear<T>(palette, weights, positions, outPositions);
+    });
+    double linearPool = best([&] {
+        skinLinear<T>(palette, weights, positions, outPositions, ThreadPool::global());
+    });
+    double dual = best([&] {
+        skinDualQuat<T>(dualQuats, weights, positions, outPositions);
+    });
+    double dualPool = best([&] {
+        skinDualQuat<T>(dualQuats, weights, positions, outPositions, ThreadPool::global());
+    });
+
+    std::printf("%-6s %zu vertices  loop %6.2f ms  linear %6.2f ms (pool %6.2f)  dual quaternion %6.2f ms (pool %6.2f)  (%g)\n",
+        sizeof(T) == 4 ? "float" : "double", n, loop*1e3, linear*1e3, linearPool*1e3, dual*1e3, dualPool*1e3,
+        double(skinned[n/2].x + outPositions[n/2].x));
+}
+
+int main() {
+    run<float>();
+    run<double>();
+}
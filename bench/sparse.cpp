@@ -0,0 +1,119 @@
+// Sparse products on synthetic Poisson matricies, the 7 point Laplacian of a cubic grid as CSR and
+// its vector form with 3x3 blocks as BSR3 and as CSR, with the COO build, SpMV and SpMM with 8 columns
+// g++ -std=c++20 -O2 -march=native -I LinMath bench/sparse.cpp -o sparse -lpthread && ./sparse [grid]
+// LINMATH_ISA=scalar, sse4.2, avx2 or avx512 picks the tier
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+// Best of several runs of f, in seconds
+template <typename F>
+double best(F f, int runs = 7) {
+    double fastest = 1e9;
+    for (int r=0; r<runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+// Calls add(row, column, diagonal) for every node of a g*g*g grid and add(row, column, off) for its neighbours,
+// nodes in shuffled order so the builder has to sort
+template <typename F>
+void poisson(size_t g, F add) {
+    size_t n = g*g*g;
+    std::vector<size_t> order(n);
+    for (size_t i=0; i<n; i++)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(1));
+    for (size_t i : order) {
+        size_t x = i%g, y = i/g%g, z = i/(g*g);
+        add(i, i, true);
+        if (x > 0)
+            add(i, i - 1, false);
+        if (x + 1 < g)
+            add(i, i + 1, false);
+        if (y > 0)
+            add(i, i - g, false);
+        if (y + 1 < g)
+            add(i, i + g, false);
+        if (z > 0)
+            add(i, i - g*g, false);
+        if (z + 1 < g)
+            add(i, i + g*g, false);
+    }
+}
+
+template <typename T>
+void run(size_t g) {
+    ThreadPool& pool = ThreadPool::global();
+    const size_t k = 8;
+    const char* name = sizeof(T) == 4 ? "float" : "double";
+
+    size_t n = g*g*g;
+    COO<T> coo(n, n);
+    coo.reserve(7*n);
+    poisson(g, [&](size_t row, size_t column, bool diagonal) {
+        coo.add(row, column, diagonal ? T(6) : T(-1));
+    });
+    CSR<T> a;
+    double build = best([&] {
+        a = coo.csr(pool);
+    }, 3);
+    std::vector<T> x(n, T(1)), y(n);
+    double spmv = best([&] {
+        a.dot(x.data(), y.data(), pool);
+    });
+    MatX<T> xs(n, k, T(1));
+    double spmm = best([&] {
+        MatX<T> ys = a.dot(xs, pool);
+    }, 5);
+    size_t bytes = a.nonzeros()*(sizeof(T) + sizeof(int32_t)) + (n + 1)*sizeof(size_t) + 2*n*sizeof(T);
+    std::printf("%-6s csr  %zu rows %zu nonzeros  build %6.1f ms  spmv %6.2f ms (%.1f GB/s)  spmm k=%zu %6.2f ms\n",
+        name, n, a.nonzeros(), build*1e3, spmv*1e3, bytes/spmv/1e9, k, spmm*1e3);
+
+    // A third fewer nodes per side keeps the block matrix close to the scalar one in size
+    size_t gb = 2*g/3, nb = gb*gb*gb;
+    Mat3<T> diagonal(T(6), T(0.5), T(0), T(0.5), T(6), T(0.5), T(0), T(0.5), T(6));
+    Mat3<T> neighbour(T(-1), T(0), T(0), T(0), T(-1), T(0), T(0), T(0), T(-1));
+    COO<T> blocks(3*nb, 3*nb);
+    poisson(gb, [&](size_t row, size_t column, bool isDiagonal) {
+        blocks.addBlock(row, column, isDiagonal ? diagonal : neighbour);
+    });
+    BSR3<T> b;
+    double blockBuild = best([&] {
+        b = blocks.bsr3(pool);
+    }, 3);
+    CSR<T> bc = blocks.csr(pool);
+    std::vector<T> xb(3*nb, T(1)), yb(3*nb);
+    double bsrmv = best([&] {
+        b.dot(xb.data(), yb.data(), pool);
+    });
+    double csrmv = best([&] {
+        bc.dot(xb.data(), yb.data(), pool);
+    });
+    MatX<T> xbs(3*nb, k, T(1));
+    double bsrmm = best([&] {
+        MatX<T> ys = b.dot(xbs, pool);
+    }, 5);
+    double csrmm = best([&] {
+        MatX<T> ys = bc.dot(xbs, pool);
+    }, 5);
+    std::printf("%-6s bsr3 %zu blocks  build %6.1f ms  spmv %6.2f ms (as csr %6.2f)  spmm k=%zu %6.2f ms (as csr %6.2f)  (%g)\n",
+        name, b.blocks(), blockBuild*1e3, bsrmv*1e3, csrmv*1e3, k, bsrmm*1e3, csrmm*1e3, double(y[n/2] + yb[nb]));
+}
+
+int main(int argc, char** argv) {
+    size_t g = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    run<float>(g);
+    run<double>(g);
+}
@@ -0,0 +1,62 @@
+// 3x3 singular value and polar decompositions, matricies per second of the batched kernels against Mat3::svd in a loop
+// g++ -std=c++20 -O2 -march=native -I LinMath bench/svd.cpp -o svd -lpthread && ./svd
+// LINMATH_ISA=scalar, sse4.2, avx2 or avx512 picks the tier
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "linmath.h"
+#include "batch.h"
+
+using namespace linmath;
+
+// Best of several runs of f, in seconds
+template <typename F>
+double best(F f, int runs = 7) {
+    double fastest = 1e9;
+    for (int r=0; r<runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+template <typename T>
+void run() {
+    const size_t n = 16384;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> uniform(-1, 1);
+    std::vector<Mat3<T>> mats(n);
+    for (Mat3<T>& m : mats)
+        for (size_t k=0; k<9; k++)
+            m[k] = uniform(rng);
+
+    Mat3Batch<T> batch(mats), u, v, rotation, stretch;
+    Vec3Batch<T> sigma;
+    T sink = 0;
+    double loop = best([&] {
+        for (const Mat3<T>& m : mats)
+            sink += Mat3<T>(m).svd().value(0);
+    });
+    double batched = best([&] {
+        svd(batch, u, sigma, v);
+    });
+    double pooled = best([&] {
+        svd(batch, u, sigma, v, ThreadPool::global());
+    });
+    double polars = best([&] {
+        polar(batch, rotation, stretch);
+    });
+
+    std::printf("%-6s Mat3::svd %6.2f M/s  svd %6.2f M/s (pool %6.2f)  polar %6.2f M/s  (%g)\n", sizeof(T) == 4 ? "float" : "double",
+        n/loop/1e6, n/batched/1e6, n/pooled/1e6, n/polars/1e6, double(sink));
+}
+
+int main() {
+    run<float>();
+    run<double>();
+}
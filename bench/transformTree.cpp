@@ -0,0 +1,67 @@
+// TransformTree update of a 1M node synthetic hierarchy with 1% of the locals changed per frame,
+// serially and over the global pool, against recomputing every world matrix
+// The pool only pays off with more than one core, on one core the two paths match
+// g++ -std=c++20 -O2 -march=native -I LinMath bench/transformTree.cpp -o transformTree -lpthread && ./transformTree [nodes]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "linmath.h"
+#include "batch.h"
+
+using namespace linmath;
+
+// Small rotations and offsets keep the worlds finite however deep the hierarchy goes
+template <typename T>
+Mat4<T> randomLocal(std::mt19937& rng) {
+    std::uniform_real_distribution<T> uniform(-1, 1);
+    return Mat4<T>::rotationZ(uniform(rng)).dot(Mat4<T>::rotationX(uniform(rng))).dot(Mat4<T>::translation(uniform(rng), uniform(rng), uniform(rng)));
+}
+
+int main(int argc, char** argv) {
+    using T = float;
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    const int frames = 20;
+
+    // A scene of 1024 node objects, the first node of an object is a root and every other one hangs below
+    // one of the 64 nodes before it in the same object, which gives long chains and wide fans
+    std::mt19937 rng(1);
+    TransformTree<T> tree;
+    tree.reserve(n);
+    std::vector<size_t> parents(n);
+    for (size_t i=0; i<n; i++) {
+        size_t k = i%1024;
+        parents[i] = k == 0 ? TransformTree<T>::root : i - 1 - rng()%(k < 64 ? k : 64);
+        tree.add(parents[i], randomLocal<T>(rng));
+    }
+    tree.update();
+    ThreadPool& pool = ThreadPool::global();
+
+    for (int parallel=0; parallel<2; parallel++) {
+        double total = 0;
+        for (int frame=0; frame<frames; frame++) {
+            for (size_t j=0; j<n/100; j++)
+                tree.setLocal(rng()%n, randomLocal<T>(rng));
+            auto start = std::chrono::steady_clock::now();
+            if (parallel)
+                tree.update(pool);
+            else
+                tree.update();
+            total += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        std::printf("%zu nodes, 1%% dirty  %-6s %7.2f ms/frame\n", n, parallel ? "pool" : "serial", total/frames);
+        if (parallel && pool.size() == 1)
+            std::printf("  the pool has one thread and runs the serial pass, LINMATH_THREADS sets its size\n");
+    }
+
+    // What every consumer did before, recompute the whole tree each frame
+    std::vector<Mat4<T>> worlds(n);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i=0; i<n; i++)
+        worlds[i] = parents[i] == TransformTree<T>::root ? tree.local(i) : Mat4<T>(tree.local(i)).dot(worlds[parents[i]]);
+    double full = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%zu nodes, full recompute %7.2f ms  (%g)\n", n, full, double(worlds[n - 1][12] - tree.world(n - 1)[12]));
+}
@@ -0,0 +1,89 @@
+// Compile check that the fixed size vectors, matricies and their builders fold in constant expressions,
+// builds and exits 0 when every static_assert holds
+// g++ -std=c++20 -I LinMath tests/constexpr.cpp -o constexpr -lpthread && ./constexpr
+
+#include <numbers>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+// Within tolerance, the constant sin and cos are series and do not round as the std ones do
+template <typename T>
+constexpr bool near(T a, T b, T tolerance = T(1e-6)) {
+    return a - b <= tolerance && b - a <= tolerance;
+}
+template <typename Mat>
+constexpr bool near(const Mat& a, const Mat& b, size_t size) {
+    for (size_t i=0; i<size; i++)
+        if (!near(a[i], b[i]))
+            return false;
+    return true;
+}
+
+// Vectors
+constexpr Vec2<float> v2(1.f, 2.f);
+constexpr Vec3<float> v3(1.f, 2.f, 3.f);
+constexpr Vec4<double> v4(1.0, 2.0, 3.0, 1.0);
+static_assert(v2.x == 1.f && v2.y == 2.f);
+static_assert(v3.z == 3.f);
+static_assert(v4.w == 1.0);
+static_assert(Vec3<float>(v3).dot(Vec3<float>(3.f, 0.f, -1.f)) == 0.f);
+
+// Matricies
+constexpr Mat2<float> m2(1.f, 2.f,
+                         3.f, 4.f);
+constexpr Mat3<float> m3(2.f, 0.f, 0.f,
+                         0.f, 3.f, 0.f,
+                         0.f, 0.f, 4.f);
+constexpr Mat4<double> m4(2.0, 0.0, 0.0, 0.0,
+                          0.0, 4.0, 0.0, 0.0,
+                          0.0, 0.0, 8.0, 0.0,
+                          1.0, 2.0, 3.0, 1.0);
+static_assert(m2[3] == 4.f);
+static_assert(m3[4] == 3.f);
+static_assert(m4[12] == 1.0);
+static_assert(Mat2<float>::identity()[0] == 1.f && Mat2<float>::identity()[1] == 0.f);
+static_assert(Mat3<float>::identity()[4] == 1.f);
+static_assert(Mat4<double>::identity()[15] == 1.0 && Mat4<double>::identity()[14] == 0.0);
+
+// Determinants and inverses
+static_assert(Mat2<float>(m2).determinant() == -2.f);
+static_assert(Mat3<float>(m3).determinant() == 24.f);
+static_assert(Mat4<double>(m4).determinant() == 64.0);
+static_assert(Mat4<double>(m4).inversed().dot(m4) == Mat4<double>::identity());
+static_assert(Mat3<float>(m3).inversed()[8] == 0.25f);
+
+// Builders and products, a row vector goes through the scale, then the rotation, then the translation
+constexpr Mat4<float> scale = Mat4<float>::scale(2.f, 2.f, 2.f);
+constexpr Mat4<float> turn = Mat4<float>::rotationZ(std::numbers::pi_v<float>/2);
+constexpr Mat4<float> move = Mat4<float>::translation(1.f, 2.f, 3.f);
+constexpr Mat4<float> model = Mat4<float>(scale).dot(turn).dot(move);
+static_assert(near(vec4x4mat(Vec4<float>(1.f, 0.f, 0.f, 1.f), model).x, 1.f));
+static_assert(near(vec4x4mat(Vec4<float>(1.f, 0.f, 0.f, 1.f), model).y, 4.f));
+static_assert(near(vec4x4mat(Vec4<float>(1.f, 0.f, 0.f, 1.f), model).z, 3.f));
+static_assert(mat4x4vec(Mat4<double>::identity(), v4).y == 2.0);
+static_assert(near(mat4x4vec(Mat4<float>(move).transpozed(), Vec4<float>(0.f, 0.f, 0.f, 1.f)).z, 3.f));
+
+// Rotations through the constant sin and cos, in radians and degrees
+static_assert(near(Mat4<float>::rotationX(std::numbers::pi_v<float>/2)[6], 1.f));
+static_assert(near(Mat4<float>::rotationY(std::numbers::pi_v<float>/2)[2], -1.f));
+static_assert(near(Mat4<float>::rotationZ(std::numbers::pi_v<float>/2)[1], 1.f));
+static_assert(near(Mat4<float>::rotationDegX(90.f), Mat4<float>::rotationX(std::numbers::pi_v<float>/2), 16));
+static_assert(near(Mat4<float>::rotationDegY(30.f), Mat4<float>::rotationY(std::numbers::pi_v<float>/6), 16));
+static_assert(near(Mat4<double>::rotationDegZ(-45.0), Mat4<double>::rotationZ(-std::numbers::pi/4), 16));
+static_assert(near(Mat3<float>::rotationDeg(60.f), Mat3<float>::rotation(std::numbers::pi_v<float>/3), 9));
+static_assert(near(Mat3<float>::rotation(std::numbers::pi_v<float>/6)[0], 0.8660254f));
+static_assert(Mat3<float>::translation(1.f, 2.f)[7] == 2.f && Mat3<float>::scale(3.f, 4.f)[4] == 4.f);
+
+// Affine3, the same transform in 12 values
+constexpr Affine3<float> affine = Affine3<float>::scale(2.f, 2.f, 2.f).dot(Affine3<float>::rotationZ(std::numbers::pi_v<float>/2)).dot(Affine3<float>::translation(1.f, 2.f, 3.f));
+static_assert(near(Mat4<float>(affine), model, 16));
+static_assert(near(affine.transformPoint(Vec3<float>(1.f, 0.f, 0.f)).y, 4.f));
+static_assert(near(Mat4<float>(affine.inversed().dot(affine)), Mat4<float>::identity(), 16));
+static_assert(near(Mat4<float>(Affine3<float>::rotationDegX(90.f)), Mat4<float>::rotationX(std::numbers::pi_v<float>/2), 16));
+static_assert(Affine3<float>(Mat3<float>::identity(), Vec3<float>(1.f, 2.f, 3.f)).translation().z == 3.f);
+
+int main() {
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Mat4::dot and Affine3::dot against the scalar kernels, exits 0 when every product is within 1 ulp of them
+// g++ -std=c++20 -O2 -march=native -I LinMath tests/mat4Dot.cpp -o mat4Dot -lpthread && ./mat4Dot
+// LINMATH_ISA=scalar, sse4.2, avx2 or avx512 picks the tier
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+// Position of t among the values of its type, so neighbouring values are 1 apart across zero too
+template <typename T>
+int64_t ordinal(T t) {
+    using Bits = std::conditional_t<sizeof(T) == 4, int32_t, int64_t>;
+    Bits bits;
+    std::memcpy(&bits, &t, sizeof(T));
+    return bits < 0 ? std::numeric_limits<Bits>::min() - int64_t(bits) : int64_t(bits);
+}
+
+// M products of random matricies with S values each against the scalar kernel reference
+template <typename M, typename T, size_t S>
+int check(const char* name, void (*reference)(const T*, const T*, T*)) {
+    const size_t n = 200000;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> uniform(-1, 1);
+    int failures = 0;
+    int64_t worst = 0;
+    for (size_t i=0; i<n; i++) {
+        M a, b;
+        for (size_t k=0; k<S; k++) {
+            a[k] = uniform(rng);
+            b[k] = uniform(rng);
+        }
+        T expected[S];
+        reference(&a[0], &b[0], expected);
+        M dot = a.dot(b);
+        for (size_t k=0; k<S; k++) {
+            int64_t ulps = ordinal(dot[k]) - ordinal(expected[k]);
+            ulps = ulps < 0 ? -ulps : ulps;
+            worst = ulps > worst ? ulps : worst;
+            failures += ulps > 1;
+        }
+    }
+    if (failures)
+        std::printf("%s: %d elements more than 1 ulp from the scalar kernel, %lld at worst\n", name, failures, (long long)worst);
+    return failures;
+}
+
+int main() {
+    int failures = check<Mat4<float>, float, 16>("Mat4<float>", simd::scalar::mat4Dot<float>) +
+                   check<Mat4<double>, double, 16>("Mat4<double>", simd::scalar::mat4Dot<double>) +
+                   check<Affine3<float>, float, 12>("Affine3<float>", simd::scalar::affineDot<float>) +
+                   check<Affine3<double>, double, 12>("Affine3<double>", simd::scalar::affineDot<double>);
+    return failures ? 1 : 0;
+}
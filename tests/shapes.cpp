@@ -0,0 +1,53 @@
+// Compile check for the shapes the decompositions accept and runtime check of the MatX shapes,
+// builds and exits 0 when they hold
+// g++ -std=c++20 -I LinMath tests/shapes.cpp -o shapes -lpthread && ./shapes
+
+#include <stdexcept>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+template <typename Mat>
+concept HasQR = requires(const Mat& mat) { mat.qr(); };
+template <typename Mat>
+concept HasLU = requires(const Mat& mat) { mat.lu(); };
+
+// Wide matricies exist, only the square and tall ones factorize
+static_assert(!HasQR<MatNM<float, 2, 3>>);
+static_assert(HasQR<MatNM<float, 3, 2>>);
+static_assert(HasQR<MatNM<double, 3, 3>>);
+static_assert(!HasLU<MatNM<float, 2, 3>>);
+
+// Whether f throws std::invalid_argument
+template <typename F>
+bool rejects(F f) {
+    try {
+        f();
+    }
+    catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    MatNM<float, 2, 3> wide(1.f, 0.f, 0.f,
+                            0.f, 1.f, 0.f);
+    MatNM<float, 3, 2> tall = wide.transpozed();
+    QR<float, 3, 2> qr = tall.qr();
+    int failures = !qr.fullRank();
+
+    // MatX shapes are only known at runtime, operands that do not fit throw
+    MatX<float> a(3, 4, 1.f), b(3, 4, 2.f), c(4, 2, 1.f);
+    failures += !rejects([&] { a.dot(b); });
+    failures += !rejects([&] { a + c; });
+    failures += !rejects([&] { a - c; });
+    failures += !rejects([&] { a * c; });
+    failures += !rejects([&] { a / c; });
+    failures += !rejects([&] { a += c; });
+    failures += !rejects([&] { a *= c; });
+    failures += rejects([&] { a + b; });
+    failures += rejects([&] { a.dot(c); });
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+// simd::sincos against the long double functions, exits 0 when every value is within 2 ulp of the correctly rounded one
+// Angles are random over the documented range plus the neighbours of every multiple of pi/2 in it, where the reduction cancels
+// g++ -std=c++20 -O2 -march=native -I LinMath tests/sincos.cpp -o sincos -lpthread && ./sincos
+// LINMATH_ISA=scalar, sse4.2, avx2 or avx512 picks the tier
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+// Position of t among the values of its type, so neighbouring values are 1 apart across zero too
+template <typename T>
+int64_t ordinal(T t) {
+    using Bits = std::conditional_t<sizeof(T) == 4, int32_t, int64_t>;
+    Bits bits;
+    std::memcpy(&bits, &t, sizeof(T));
+    return bits < 0 ? std::numeric_limits<Bits>::min() - int64_t(bits) : int64_t(bits);
+}
+
+int64_t distance(long double exact, auto value) {
+    int64_t ulps = ordinal(value) - ordinal(decltype(value)(exact));
+    return ulps < 0 ? -ulps : ulps;
+}
+
+// quadrants multiples of pi/2 from zero get their 8 neighbours on either side, the rest of the range is sampled
+template <typename T>
+int check(T limit, size_t quadrants) {
+    const long double halfPi = 1.570796326794896619231321691639751442L;
+    std::vector<T> x;
+    for (size_t j=0; j<=quadrants; j++) {
+        T below = T(j*halfPi), above = below;
+        for (int k=0; k<=8; k++) {
+            for (T v : {below, above})
+                if (std::abs(v) < limit) {
+                    x.push_back(v);
+                    x.push_back(-v);
+                }
+            below = std::nextafter(below, T(0));
+            above = std::nextafter(above, limit);
+        }
+    }
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> uniform(-limit, limit);
+    for (size_t i=0; i<(1 << 20); i++)
+        x.push_back(uniform(rng));
+
+    std::vector<T> s(x.size()), c(x.size());
+    simd::sincos<T>(x.size(), x.data(), s.data(), c.data());
+    int failures = 0;
+    int64_t worst = 0;
+    for (size_t i=0; i<x.size(); i++) {
+        int64_t ulps = std::max(distance(sinl(x[i]), s[i]), distance(cosl(x[i]), c[i]));
+        worst = ulps > worst ? ulps : worst;
+        failures += ulps > 2;
+    }
+    if (failures)
+        std::printf("%s: %d angles more than 2 ulp from the correctly rounded values, %lld at worst\n", sizeof(T) == 4 ? "float" : "double", failures, (long long)worst);
+    return failures;
+}
+
+int main() {
+    int failures = check<float>(8192, 5216) + check<double>(1e6, 640000) + check<double>(1073741824.0, 0);
+    return failures ? 1 : 0;
+}
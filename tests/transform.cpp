@@ -0,0 +1,74 @@
+// Batched transforms of builder matricies against vec4x4mat, exits 0 when every tier agrees
+// g++ -std=c++20 -march=native -I LinMath tests/transform.cpp -o transform -lpthread && ./transform
+// LINMATH_ISA=scalar, sse4.2, avx2 or avx512 picks the tier
+
+#include <cmath>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+template <typename T>
+bool close(const Vec4<T>& a, const Vec4<T>& b) {
+    T tolerance = T(1e-4);
+    return std::abs(a.x - b.x) <= tolerance*(1 + std::abs(b.x)) && std::abs(a.y - b.y) <= tolerance*(1 + std::abs(b.y)) &&
+        std::abs(a.z - b.z) <= tolerance*(1 + std::abs(b.z)) && std::abs(a.w - b.w) <= tolerance*(1 + std::abs(b.w));
+}
+
+template <typename T>
+int check() {
+    // A translation last keeps it in the bottom row, where the row vector builders put it
+    Mat4<T> mat = Mat4<T>::scale(2, 3, 4).dot(Mat4<T>::rotationZ(T(0.7))).dot(Mat4<T>::translation(1, 2, 3));
+    Affine3<T> affine(mat);
+
+    // An odd count runs the narrower packs of every tier
+    const size_t n = 37;
+    std::vector<Vec3<T>> points(n), rows(n), affines(n);
+    std::vector<Vec4<T>> vecs(n), fulls(n);
+    Vec3Batch<T> batch(n);
+    Vec4Batch<T> batch4(n);
+    for (size_t i=0; i<n; i++) {
+        points[i] = Vec3<T>(T(i), T(1) - T(0.5)*T(i), T(0.25)*T(i));
+        vecs[i] = Vec4<T>(points[i].x, points[i].y, points[i].z, T(i%3));
+        batch.set(i, points[i]);
+        batch4.set(i, vecs[i]);
+    }
+
+    Vec3Batch<T> batchOut;
+    Vec4Batch<T> batch4Out;
+    transformAffine<Convention::RowVectors>(mat, std::span<const Vec3<T>>(points), std::span<Vec3<T>>(rows));
+    transformAffine(affine, std::span<const Vec3<T>>(points), std::span<Vec3<T>>(affines));
+    transform<Convention::RowVectors>(mat, std::span<const Vec4<T>>(vecs), std::span<Vec4<T>>(fulls));
+    transformAffine(affine, batch, batchOut, ThreadPool::global());
+    transformAffine<Convention::RowVectors>(mat, batch4, batch4Out);
+
+    int failures = 0;
+    for (size_t i=0; i<n; i++) {
+        Vec4<T> point = vec4x4mat(Vec4<T>(points[i].x, points[i].y, points[i].z, T(1)), mat);
+        Vec4<T> vec = vec4x4mat(vecs[i], mat);
+        Vec3<T> fromBatch = batchOut[i];
+        Vec4<T> fromBatch4 = batch4Out[i];
+        failures += !close(Vec4<T>(rows[i].x, rows[i].y, rows[i].z, T(1)), point);
+        failures += !close(Vec4<T>(affines[i].x, affines[i].y, affines[i].z, T(1)), point);
+        failures += !close(Vec4<T>(fromBatch.x, fromBatch.y, fromBatch.z, T(1)), point);
+        failures += !close(fulls[i], vec);
+        // The affine form keeps the input w
+        failures += !close(fromBatch4, Vec4<T>(vec.x, vec.y, vec.z, vecs[i].w));
+    }
+
+    // Column vectors stay the default, the transpose gives the same points
+    transformAffine(mat.transpozed(), std::span<const Vec3<T>>(points), std::span<Vec3<T>>(rows));
+    for (size_t i=0; i<n; i++)
+        failures += !close(Vec4<T>(rows[i].x, rows[i].y, rows[i].z, T(1)), vec4x4mat(Vec4<T>(points[i].x, points[i].y, points[i].z, T(1)), mat));
+    return failures;
+}
+
+int main() {
+    int failures = check<float>() + check<double>();
+    if (failures)
+        std::printf("%d transforms differ from vec4x4mat\n", failures);
+    return failures ? 1 : 0;
+}
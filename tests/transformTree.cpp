@@ -0,0 +1,94 @@
+// Composition order of TransformTree with builder matricies and the pool update against the serial one,
+// exits 0 when both update paths agree with vec4x4mat and with each other
+// g++ -std=c++20 -I LinMath tests/transformTree.cpp -o transformTree -lpthread && ./transformTree
+
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <random>
+
+#include "linmath.h"
+
+using namespace linmath;
+
+template <typename T>
+bool close(const Vec4<T>& a, const Vec4<T>& b) {
+    T tolerance = T(1e-5);
+    return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance && std::abs(a.z - b.z) <= tolerance &&
+        std::abs(a.w - b.w) <= tolerance;
+}
+
+// A child moved along x below a parent turned a quarter about z ends up on y
+// Four threads whatever the host has, a pool of one runs the serial pass
+ThreadPool pool(4);
+
+template <typename T>
+int check(bool parallel) {
+    int failures = 0;
+    TransformTree<T> tree;
+    size_t parent = tree.add(Mat4<T>::rotationZ(std::numbers::pi_v<T>/2));
+    size_t child = tree.add(parent, Mat4<T>::translation(1, 0, 0));
+    size_t grandchild = tree.add(child, Mat4<T>::translation(0, 0, 2));
+    parallel ? tree.update(pool, 1) : tree.update();
+
+    Vec4<T> origin(0, 0, 0, 1);
+    failures += !close(vec4x4mat(origin, tree.world(child)), Vec4<T>(0, 1, 0, 1));
+    failures += !close(vec4x4mat(origin, tree.world(grandchild)), Vec4<T>(0, 1, 2, 1));
+
+    // A point of the child is moved by the child first, then by its parent
+    Vec4<T> point(0, 1, 0, 1);
+    failures += !close(vec4x4mat(point, tree.world(child)), vec4x4mat(vec4x4mat(point, tree.local(child)), tree.world(parent)));
+
+    // A dirty parent carries its new local down to the children
+    tree.setLocal(parent, Mat4<T>::translation(0, 0, 5));
+    parallel ? tree.update(pool, 1) : tree.update();
+    failures += !close(vec4x4mat(origin, tree.world(grandchild)), Vec4<T>(1, 0, 7, 1));
+
+    // Column vector trees take the transposed matricies and give the transposed worlds
+    TransformTree<T> columns(Convention::ColumnVectors);
+    parent = columns.add(Mat4<T>::rotationZ(std::numbers::pi_v<T>/2).transpozed());
+    child = columns.add(parent, Mat4<T>::translation(1, 0, 0).transpozed());
+    parallel ? columns.update(pool, 1) : columns.update();
+    failures += !close(mat4x4vec(columns.world(child), origin), Vec4<T>(0, 1, 0, 1));
+    return failures;
+}
+
+// Random forests updated a few dirty nodes at a time, the pool path computes the same products as the serial one
+int compare(size_t grain) {
+    int failures = 0;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> uniform(-1, 1);
+    auto local = [&] {
+        return Mat4<float>::rotationZ(uniform(rng)).dot(Mat4<float>::translation(uniform(rng), uniform(rng), uniform(rng)));
+    };
+    TransformTree<float> serial, parallel;
+    for (size_t i=0; i<20000; i++) {
+        // Shallow and deep parents, so subtree ranges overlap
+        size_t parent = i < 8 ? TransformTree<float>::root : (i%2 ? rng()%i : i - 1 - rng()%(i < 16 ? i : 16));
+        Mat4<float> mat = local();
+        serial.add(parent, mat);
+        parallel.add(parent, mat);
+    }
+    for (int frame=0; frame<10; frame++) {
+        serial.update();
+        parallel.update(pool, grain);
+        for (size_t i=0; i<serial.size(); i++)
+            for (size_t k=0; k<16; k++)
+                failures += serial.world(i)[k] != parallel.world(i)[k];
+        for (size_t j=0; j<50; j++) {
+            size_t node = rng()%serial.size();
+            Mat4<float> mat = local();
+            serial.setLocal(node, mat);
+            parallel.setLocal(node, mat);
+        }
+    }
+    return failures;
+}
+
+int main() {
+    int failures = check<float>(false) + check<float>(true) + check<double>(false) + check<double>(true);
+    failures += compare(1) + compare(1024);
+    if (failures)
+        std::printf("%d world matricies are wrong\n", failures);
+    return failures ? 1 : 0;
+}